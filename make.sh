@@ -31,11 +31,7 @@ mkdir -p $BUILD_OUTPUT_DIRECTORY
 # gcc:
 #
 
-if [ ! -n "$VARR_CFLAGS" ]; then
-   VARR_CFLAGS=$(pkg-config --cflags gsl)
-fi
-
-VARR_CFLAGS+=" -O3 -mtune=native -march=native -ffast-math -ffinite-math-only -mavx "
+VARR_CFLAGS+=" -O3 -mtune=native -ffast-math -ffinite-math-only "
 
 #
 # icc 2018/update-2:
@@ -43,10 +39,6 @@ VARR_CFLAGS+=" -O3 -mtune=native -march=native -ffast-math -ffinite-math-only -m
 
 # VARR_CFLAGS+="-O3 -xCOMMON-AVX512 -mtune=native -fp-model fast=2 -qopt-report=5 -qopt-report-phase=vec"
 
-if [ ! -n "$VARR_LDFLAGS" ]; then
-   VARR_LDFLAGS=$(pkg-config --libs gsl)
-fi
-
 COMMON_VARR_CFLAGS="-D_POSIX_C_SOURCE=200112L -std=c99"
 VARR_CFLAGS=$VARR_CFLAGS" "$COMMON_VARR_CFLAGS
 
@@ -54,7 +46,9 @@ rm -f $BUILD_OUTPUT_DIRECTORY/*.o
 rm -f $BUILD_OUTPUT_DIRECTORY/libvarr.so
 
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_sin.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sin.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_sincos.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sincos.o -Werror
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_cos.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_cos.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_cubic_spline.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_cubic_spline.o -Werror
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_phasor.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_phasor.o -Werror
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_sixth_root.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sixth_root.o -Werror
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_atan.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_atan.o -Werror
@@ -63,6 +57,15 @@ $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_exp.c -I./varr/ -c -o $BUILD_OUTPUT_DI
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_3_over_4.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_3_over_4.o -Werror
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_extimer.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_extimer.o -Werror
 $C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_general_bound_linbuf.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_general_bound_linbuf.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_simd.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_simd.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_table_layout.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_layout.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_table_cache.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_cache.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_table_file.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_file.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_table_memory.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_memory.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_allocator.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_allocator.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_octant.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_octant.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_thread_pool.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_thread_pool.o -Werror
+$C_COMPILER $VARR_CFLAGS -fPIC ./src/varr_progression.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_progression.o -Werror
 
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/entry.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/entry.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_sixthroot.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sixthroot.test.o -Werror
@@ -71,8 +74,19 @@ $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_phasor.test.c -I./varr
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_atan.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_atan.test.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_log.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_log.test.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_sin.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sin.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_sincos.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sincos.test.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_exp.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_exp.test.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_general_bound_linbuf.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_general_bound_linbuf.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_simd.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_simd.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_table_layout.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_layout.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_float.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_float.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_table_cache.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_cache.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_table_file.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_file.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_table_memory.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_table_memory.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_allocator.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_allocator.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_octant.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_octant.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_thread_pool.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_thread_pool.test.o -Werror
+$C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_progression.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_progression.test.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/varr_sequence_analysis.test.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_sequence_analysis.test.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/test_results.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/test_results.o -Werror
 
@@ -81,7 +95,7 @@ $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/timings_complex.c -I./varr/
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/sequence_generation.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/sequence_generation.o -Werror
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 -fPIC ./test/sequence_comparison.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/sequence_comparison.o -Werror
 
-$C_COMPILER $BUILD_OUTPUT_DIRECTORY/varr_extimer.o $BUILD_OUTPUT_DIRECTORY/varr_exp.o $BUILD_OUTPUT_DIRECTORY/varr_log.o $BUILD_OUTPUT_DIRECTORY/varr_sin.o $BUILD_OUTPUT_DIRECTORY/varr_cos.o $BUILD_OUTPUT_DIRECTORY/varr_phasor.o $BUILD_OUTPUT_DIRECTORY/varr_sixth_root.o $BUILD_OUTPUT_DIRECTORY/varr_3_over_4.o $BUILD_OUTPUT_DIRECTORY/varr_atan.o $BUILD_OUTPUT_DIRECTORY/varr_general_bound_linbuf.o -Werror --shared -o $BUILD_OUTPUT_DIRECTORY/libvarr.so $VARR_LDFLAGS -lm
+$C_COMPILER $BUILD_OUTPUT_DIRECTORY/varr_extimer.o $BUILD_OUTPUT_DIRECTORY/varr_exp.o $BUILD_OUTPUT_DIRECTORY/varr_log.o $BUILD_OUTPUT_DIRECTORY/varr_sin.o $BUILD_OUTPUT_DIRECTORY/varr_cos.o $BUILD_OUTPUT_DIRECTORY/varr_sincos.o $BUILD_OUTPUT_DIRECTORY/varr_cubic_spline.o $BUILD_OUTPUT_DIRECTORY/varr_phasor.o $BUILD_OUTPUT_DIRECTORY/varr_sixth_root.o $BUILD_OUTPUT_DIRECTORY/varr_3_over_4.o $BUILD_OUTPUT_DIRECTORY/varr_atan.o $BUILD_OUTPUT_DIRECTORY/varr_general_bound_linbuf.o $BUILD_OUTPUT_DIRECTORY/varr_simd.o $BUILD_OUTPUT_DIRECTORY/varr_table_layout.o $BUILD_OUTPUT_DIRECTORY/varr_table_cache.o $BUILD_OUTPUT_DIRECTORY/varr_table_file.o $BUILD_OUTPUT_DIRECTORY/varr_table_memory.o $BUILD_OUTPUT_DIRECTORY/varr_allocator.o $BUILD_OUTPUT_DIRECTORY/varr_octant.o $BUILD_OUTPUT_DIRECTORY/varr_thread_pool.o $BUILD_OUTPUT_DIRECTORY/varr_progression.o -Werror --shared -o $BUILD_OUTPUT_DIRECTORY/libvarr.so $VARR_LDFLAGS -lm -lpthread
 
 $C_COMPILER $COMMON_VARR_CFLAGS -O0 -g3 ./test/varr_utils.c -I./varr/ -c -o $BUILD_OUTPUT_DIRECTORY/varr_utils.o -Werror
-$C_COMPILER -O0 -g3 $BUILD_OUTPUT_DIRECTORY/entry.o $BUILD_OUTPUT_DIRECTORY/varr_utils.o $BUILD_OUTPUT_DIRECTORY/varr_sixthroot.test.o $BUILD_OUTPUT_DIRECTORY/varr_3_over_4.test.o $BUILD_OUTPUT_DIRECTORY/varr_exp.test.o $BUILD_OUTPUT_DIRECTORY/varr_phasor.test.o $BUILD_OUTPUT_DIRECTORY/varr_atan.test.o $BUILD_OUTPUT_DIRECTORY/varr_sin.test.o $BUILD_OUTPUT_DIRECTORY/varr_log.test.o $BUILD_OUTPUT_DIRECTORY/test_results.o $BUILD_OUTPUT_DIRECTORY/timings_double.o $BUILD_OUTPUT_DIRECTORY/timings_complex.o $BUILD_OUTPUT_DIRECTORY/sequence_comparison.o $BUILD_OUTPUT_DIRECTORY/sequence_generation.o $BUILD_OUTPUT_DIRECTORY/varr_sequence_analysis.test.o $BUILD_OUTPUT_DIRECTORY/varr_general_bound_linbuf.test.o -L$BUILD_OUTPUT_DIRECTORY/ -lvarr -o $BUILD_OUTPUT_DIRECTORY/test $VARR_LDFLAGS -lrt -lm
+$C_COMPILER -O0 -g3 $BUILD_OUTPUT_DIRECTORY/entry.o $BUILD_OUTPUT_DIRECTORY/varr_utils.o $BUILD_OUTPUT_DIRECTORY/varr_sixthroot.test.o $BUILD_OUTPUT_DIRECTORY/varr_3_over_4.test.o $BUILD_OUTPUT_DIRECTORY/varr_exp.test.o $BUILD_OUTPUT_DIRECTORY/varr_phasor.test.o $BUILD_OUTPUT_DIRECTORY/varr_atan.test.o $BUILD_OUTPUT_DIRECTORY/varr_sin.test.o $BUILD_OUTPUT_DIRECTORY/varr_sincos.test.o $BUILD_OUTPUT_DIRECTORY/varr_log.test.o $BUILD_OUTPUT_DIRECTORY/test_results.o $BUILD_OUTPUT_DIRECTORY/timings_double.o $BUILD_OUTPUT_DIRECTORY/timings_complex.o $BUILD_OUTPUT_DIRECTORY/sequence_comparison.o $BUILD_OUTPUT_DIRECTORY/sequence_generation.o $BUILD_OUTPUT_DIRECTORY/varr_sequence_analysis.test.o $BUILD_OUTPUT_DIRECTORY/varr_general_bound_linbuf.test.o $BUILD_OUTPUT_DIRECTORY/varr_simd.test.o $BUILD_OUTPUT_DIRECTORY/varr_table_layout.test.o $BUILD_OUTPUT_DIRECTORY/varr_float.test.o $BUILD_OUTPUT_DIRECTORY/varr_table_cache.test.o $BUILD_OUTPUT_DIRECTORY/varr_table_file.test.o $BUILD_OUTPUT_DIRECTORY/varr_table_memory.test.o $BUILD_OUTPUT_DIRECTORY/varr_allocator.test.o $BUILD_OUTPUT_DIRECTORY/varr_octant.test.o $BUILD_OUTPUT_DIRECTORY/varr_thread_pool.test.o $BUILD_OUTPUT_DIRECTORY/varr_progression.test.o -L$BUILD_OUTPUT_DIRECTORY/ -lvarr -o $BUILD_OUTPUT_DIRECTORY/test $VARR_LDFLAGS -lrt -lm -lpthread
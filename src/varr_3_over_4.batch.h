@@ -0,0 +1,114 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_3_over_4.c.  This file is included by
+ * varr_3_over_4.c (through varr_simd_instantiate.h) twice per SIMD target,
+ * see varr_simd_target.h.
+ */
+
+/*
+ * pow(x, 3/4) = pow(2**k, 3/4) * pow(m, 3/4), for x = m * 2**k and 
+ * 1 <= m < 2, where k and m are read from the exponent and mantissa fields
+ * of x:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(linear_sampling_normalizing_threequartersd_stride)(
+   register avxd_array_t x,
+   Sampling3Over4DAccelerator const * const accelerator
+   )
+{
+   register avxd_array_t const
+      __one = _avxd_stride_set_duplicates(1.),
+      prefix = _avxd_stride_gather_long(
+         accelerator->exponent_powers,
+         _avxd_stride_exponent_field(x)
+         );
+   x = (_avxd_stride_mantissa(x) - __one) * _avxd_stride_set_duplicates(
+      accelerator->step_x_inverse
+      );
+   return
+      prefix * _avxd_stride_interpolate(
+         &accelerator->table,
+         _avxd_stride_index(x),
+         x - _avxd_stride_floor(x)
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_sampling_normalizing_threequartersd_batch_evaluate)(
+   register double const * x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      linear_sampling_normalizing_threequartersd_batch_evaluate,
+      x,
+      out,
+      length,
+      __accelerator
+      );
+   register double const
+      * __x = x;
+   register double
+      * __out = out;
+   register Sampling3Over4DAccelerator const * const
+      accelerator = ((Sampling3Over4DAccelerator const *) __accelerator);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         __out,
+         __VARR_SIMD_NAME(linear_sampling_normalizing_threequartersd_stride)(
+            _avxd_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      __out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         __out,
+         lanes,
+         __VARR_SIMD_NAME(linear_sampling_normalizing_threequartersd_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(1.)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
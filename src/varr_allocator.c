@@ -0,0 +1,413 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_allocator.h"
+#include "varr_internal.h"
+
+#include <stdlib.h>
+
+/*
+ * The alignment of the memory of 'allocate', and the largest alignment of 
+ * 'allocate_aligned':
+ */
+#define __VARR_FUNDAMENTAL_ALIGNMENT__ ((size_t) 16u)
+#define __VARR_LARGEST_ALIGNMENT__ ((size_t) 64u)
+
+/*
+ * A contiguous block of the memory of an allocator, from which the 
+ * allocations of an evaluator are placed in turn.  The block holds a 
+ * reference for each allocation placed in it, and one for the construction 
+ * in progress, and is released with the last (by whichever thread drops 
+ * it, so that references are counted atomically).
+ */
+typedef struct tagVARRAllocationBlock
+{
+   VARRAllocator
+      allocator;
+   unsigned char *
+      memory;
+   size_t
+      bytes,
+      used,
+      references;
+} VARRAllocationBlock;
+
+/*
+ * An allocation of the memory of an allocator: either of a 'block', or of 
+ * 'allocator' directly, at 'memory'.
+ */
+typedef struct tagVARRAllocation
+{
+   void *
+      memory;
+   VARRAllocator
+      allocator;
+   VARRAllocationBlock *
+      block;
+} VARRAllocation;
+
+/*
+ * Every allocation of __varr_allocate is immediately preceded by a header,
+ * from which __varr_free tells memory of an allocator from memory of the 
+ * heap without a lookup: 'allocation' is NULL for memory of the heap, which
+ * was allocated 'offset' bytes before the allocation.  The header takes 
+ * __VARR_FUNDAMENTAL_ALIGNMENT__ bytes.
+ */
+typedef struct tagVARRAllocationHeader
+{
+   VARRAllocation *
+      allocation;
+   size_t
+      offset;
+} VARRAllocationHeader;
+
+/*
+ * The construction of an evaluator with an allocator, in the thread that
+ * constructs it.  A contiguous construction measures the 'measured' bytes 
+ * of its allocations (__VARR_ALLOCATION_MEASURING__), and then places them
+ * in a 'block' (__VARR_ALLOCATION_PRIVATE__).  Individual allocations (and 
+ * placement, if the block could not be allocated) are of the allocator 
+ * directly.
+ */
+typedef struct tagVARRAllocationContext
+{
+   VARRAllocator
+      allocator;
+   int
+      phase;
+   size_t
+      measured;
+   VARRAllocationBlock *
+      block;
+} VARRAllocationContext;
+
+static __thread VARRAllocationContext *
+   __varr_allocation_context = NULL;
+
+/*
+ * Returns 'offset' rounded up to a multiple of 'alignment':
+ */
+static
+size_t
+aligned_offset(size_t offset, size_t alignment)
+{
+   return
+      (offset + alignment - 1u) & ~(alignment - 1u);
+}
+
+static
+size_t
+allocation_alignment(size_t alignment)
+{
+   return
+      (alignment < __VARR_FUNDAMENTAL_ALIGNMENT__) ?
+         __VARR_FUNDAMENTAL_ALIGNMENT__
+         :
+         alignment;
+}
+
+/*
+ * Returns the bytes of a block that an allocation of 'bytes' takes: a cache
+ * line, for its header, followed by the allocation padded to whole cache 
+ * lines, so that the size of a block does not depend on the order of its 
+ * allocations.
+ */
+static
+size_t
+block_bytes(size_t bytes)
+{
+   return
+      __VARR_LARGEST_ALIGNMENT__
+    + aligned_offset(bytes, __VARR_LARGEST_ALIGNMENT__);
+}
+
+/*
+ * Writes the header of the allocation at 'memory', and returns 'memory':
+ */
+static
+void *
+with_header(unsigned char * memory, VARRAllocation * allocation, size_t offset)
+{
+   VARRAllocationHeader * const
+      header = (VARRAllocationHeader *) memory - 1;
+   header->allocation = allocation;
+   header->offset = offset;
+   return
+      (void *) memory;
+}
+
+void *
+__varr_begin_allocation(VARRAllocator const * allocator)
+{
+   VARRAllocationContext * const
+      previous = __varr_allocation_context;
+   VARRAllocationContext * const
+      context = (VARRAllocationContext *) calloc(
+         1u, sizeof(VARRAllocationContext)
+         );
+   if(context != NULL)
+   {
+      context->allocator = *allocator;
+      context->phase = allocator->contiguous ?
+         __VARR_ALLOCATION_MEASURING__ : __VARR_ALLOCATION_PRIVATE__;
+   }
+   // Without a context, the evaluator is of the heap:
+   __varr_allocation_context = context;
+   return
+      (void *) previous;
+}
+
+int
+__varr_allocation_phase(void)
+{
+   return
+      (__varr_allocation_context == NULL) ?
+         __VARR_ALLOCATION_NONE__ : __varr_allocation_context->phase;
+}
+
+void
+__varr_place_allocation(void)
+{
+   VARRAllocationContext * const
+      context = __varr_allocation_context;
+   if((context == NULL) || (context->phase != __VARR_ALLOCATION_MEASURING__))
+   {
+      return;
+   }
+   context->phase = __VARR_ALLOCATION_PRIVATE__;
+   VARRAllocationBlock * const
+      block = (VARRAllocationBlock *) calloc(1u, sizeof(VARRAllocationBlock));
+   if(block == NULL)
+   {
+      return;
+   }
+   block->allocator = context->allocator;
+   block->bytes = context->measured;
+   block->references = (size_t) 1u;
+   block->memory = (unsigned char *) context->allocator.allocate_aligned(
+      __VARR_LARGEST_ALIGNMENT__,
+      (block->bytes > (size_t) 0u) ? block->bytes : __VARR_LARGEST_ALIGNMENT__,
+      context->allocator.context
+      );
+   if(block->memory == NULL)
+   {
+      // Allocations are then individual:
+      free(block);
+      return;
+   }
+   context->block = block;
+}
+
+/*
+ * Drops a reference to a block, and releases it with the last:
+ */
+static
+void
+release_block(VARRAllocationBlock * block)
+{
+   if(__atomic_sub_fetch(&block->references, (size_t) 1u, __ATOMIC_ACQ_REL))
+   {
+      return;
+   }
+   if(block->allocator.release != NULL)
+   {
+      block->allocator.release(block->memory, block->allocator.context);
+   }
+   free(block);
+}
+
+void *
+__varr_suspend_allocation(void)
+{
+   VARRAllocationContext * const
+      context = __varr_allocation_context;
+   __varr_allocation_context = NULL;
+   return
+      (void *) context;
+}
+
+void
+__varr_resume_allocation(void * context)
+{
+   __varr_allocation_context = (VARRAllocationContext *) context;
+}
+
+void
+__varr_end_allocation(void * previous)
+{
+   VARRAllocationContext * const
+      context = __varr_allocation_context;
+   if(context != NULL)
+   {
+      if(context->block != NULL)
+      {
+         release_block(context->block);
+      }
+      free(context);
+   }
+   __varr_allocation_context = (VARRAllocationContext *) previous;
+}
+
+void
+__varr_allocation_measure(size_t bytes)
+{
+   VARRAllocationContext * const
+      context = __varr_allocation_context;
+   if((context != NULL) && (context->phase == __VARR_ALLOCATION_MEASURING__))
+   {
+      context->measured += block_bytes(bytes);
+   }
+}
+
+/*
+ * Returns 'bytes' of the memory of the allocator of 'context', placed in its
+ * block if there is room, or returns NULL.  Each allocation of a block is 
+ * cache line aligned; other allocations are preceded by 'alignment' bytes,
+ * for the header.
+ */
+static
+void *
+allocate_privately(
+   VARRAllocationContext * context,
+   size_t alignment,
+   size_t bytes
+   )
+{
+   VARRAllocation * const
+      allocation = (VARRAllocation *) calloc(1u, sizeof(VARRAllocation));
+   if(allocation == NULL)
+   {
+      return NULL;
+   }
+   VARRAllocationBlock * const
+      block = context->block;
+   if((block != NULL) && (block->used + block_bytes(bytes) <= block->bytes))
+   {
+      unsigned char * const
+         memory = block->memory + block->used + __VARR_LARGEST_ALIGNMENT__;
+      block->used += block_bytes(bytes);
+      allocation->block = block;
+      __atomic_add_fetch(&block->references, (size_t) 1u, __ATOMIC_RELAXED);
+      return
+         with_header(memory, allocation, (size_t) 0u);
+   }
+   allocation->allocator = context->allocator;
+   allocation->memory = (
+      (alignment > __VARR_FUNDAMENTAL_ALIGNMENT__)
+      || (context->allocator.allocate == NULL)
+      ) ?
+      context->allocator.allocate_aligned(
+         alignment, alignment + bytes, context->allocator.context
+         )
+      :
+      context->allocator.allocate(
+         alignment + bytes, context->allocator.context
+         );
+   if(allocation->memory == NULL)
+   {
+      free(allocation);
+      return NULL;
+   }
+   return
+      with_header(
+         (unsigned char *) allocation->memory + alignment,
+         allocation,
+         (size_t) 0u
+         );
+}
+
+void *
+__varr_allocate(size_t alignment, size_t bytes)
+{
+   VARRAllocationContext * const
+      context = __varr_allocation_context;
+   alignment = allocation_alignment(alignment);
+   if(
+      (context != NULL)
+      && (context->phase == __VARR_ALLOCATION_PRIVATE__)
+      && (alignment <= __VARR_LARGEST_ALIGNMENT__)
+      )
+   {
+      return
+         allocate_privately(context, alignment, bytes);
+   }
+   void *
+      memory = NULL;
+   if(posix_memalign(&memory, alignment, alignment + bytes))
+   {
+      return NULL;
+   }
+   return
+      with_header((unsigned char *) memory + alignment, NULL, alignment);
+}
+
+void
+__varr_free(void * memory)
+{
+   if(memory == NULL)
+   {
+      return;
+   }
+   VARRAllocationHeader const
+      header = ((VARRAllocationHeader const *) memory)[-1];
+   if(header.allocation == NULL)
+   {
+      free((unsigned char *) memory - header.offset);
+      return;
+   }
+   if(header.allocation->block != NULL)
+   {
+      release_block(header.allocation->block);
+   }
+   else if(header.allocation->allocator.release != NULL)
+   {
+      header.allocation->allocator.release(
+         header.allocation->memory, header.allocation->allocator.context
+         );
+   }
+   free(header.allocation);
+}
+
+VARRBoundGLBAccelerator
+bound_general_linbuf_with_allocator(
+   size_t number_of_samples,
+   double min_x,
+   double max_x,
+   double (* delegate) (double x, void *),
+   void * specialization,
+   VARRAllocator const * allocator
+   )
+{
+   void * const
+      previous = __varr_begin_allocation(allocator);
+   // The block is measured from the size of the grid, without sampling it:
+   if(__varr_allocation_phase() == __VARR_ALLOCATION_MEASURING__)
+   {
+      __varr_measure_bound_general_linbuf(number_of_samples);
+      __varr_place_allocation();
+   }
+   VARRBoundGLBAccelerator const
+      result = bound_general_linbuf(
+         number_of_samples, min_x, max_x, delegate, specialization
+         );
+   __varr_end_allocation(previous);
+   return
+      result;
+}
@@ -0,0 +1,199 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_atan.c.  This file is included by varr_atan.c
+ * (through varr_simd_instantiate.h) twice per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(sampling_atand_stride)(
+   register avxd_array_t x,
+   VARRSampleTable const * const table,
+   register avxd_array_t const step_x_inv
+   )
+{
+   register avxd_array_t const
+      __mavxd_sampling_atand_lower_limit =
+         _avxd_stride_set_duplicates(__sampling_atand_lower_limit),
+      __mavxd_sampling_atand_upper_limit =
+         _avxd_stride_set_duplicates(__sampling_atand_upper_limit);
+   x = _avxd_stride_max(x, __mavxd_sampling_atand_lower_limit);
+   x = _avxd_stride_min(x, __mavxd_sampling_atand_upper_limit);
+   x = (x - __mavxd_sampling_atand_lower_limit) * step_x_inv;
+   register avxi_array_t const
+      index = _avxd_stride_index(x);
+   return
+      _avxd_stride_interpolate(table, index, x - _avxd_stride_floor(x));
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sampling_atand_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      sampling_atand_batch_evaluate, __x, out, length, __accelerator
+      );
+   VARRSampleTable const * const
+      table = &((SamplingAtanDAccelerator const *) __accelerator)->table;
+   register avxd_array_t const
+      __step_x_inv_vector = _avxd_stride_set_duplicates(
+         ((SamplingAtanDAccelerator const *) __accelerator)->step_x_inv
+         );
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         out,
+         __VARR_SIMD_NAME(sampling_atand_stride)(
+            _avxd_stride_load(__x), table, __step_x_inv_vector
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(sampling_atand_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(0.)
+               ),
+            table,
+            __step_x_inv_vector
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * atan(x) = sign(x) atan(|x|), where atan(|x|) = pi/2 - atan(1/|x|) for
+ * |x| > 1:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxf_array_t
+__VARR_SIMD_NAME(sampling_atanf_stride)(
+   register avxf_array_t x,
+   SamplingAtanFAccelerator const * const accelerator
+   )
+{
+   register avxf_array_t const
+      __one = _avxf_stride_set_duplicates(1.f);
+   register avxfi_array_t const
+      sign = _avxfi_stride_and(
+         _avxf_stride_as_avxfi(x),
+         _avxfi_stride_set_duplicates((int) 0x80000000u)
+         );
+   x = _avxfi_stride_as_avxf(
+      _avxfi_stride_and(
+         _avxf_stride_as_avxfi(x),
+         _avxfi_stride_set_duplicates(0x7FFFFFFF)
+         )
+      );
+   register avxf_mask_t const
+      reflect = _avxf_stride_less_than(__one, x);
+   x = _avxf_stride_min(
+      _avxf_stride_min(x, __one / x)
+    * _avxf_stride_set_duplicates(accelerator->step_x_inv),
+      _avxf_stride_set_duplicates(accelerator->last_sample)
+      );
+   x = _avxf_stride_interpolate(
+      accelerator->table, _avxf_stride_index(x), x - _avxf_stride_floor(x)
+      );
+   x = _avxf_stride_blend(
+      reflect,
+      x,
+      _avxf_stride_set_duplicates(__sampling_atanf_half_pi) - x
+      );
+   return
+      _avxfi_stride_as_avxf(_avxfi_stride_or(_avxf_stride_as_avxfi(x), sign));
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sampling_atanf_batch_evaluate)(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      sampling_atanf_batch_evaluate, __x, out, length, __accelerator
+      );
+   register SamplingAtanFAccelerator const * const
+      accelerator = (SamplingAtanFAccelerator const *) __accelerator;
+   for(
+      ;
+      length >= __AVX_FLOAT_STRIDE__;
+      length -= __AVX_FLOAT_STRIDE__
+      )
+   {
+      _avxf_stride_store(
+         out,
+         __VARR_SIMD_NAME(sampling_atanf_stride)(
+            _avxf_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_FLOAT_STRIDE__;
+      out += __AVX_FLOAT_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxf_lanes_t const
+         lanes = _avxf_stride_lanes(length);
+      _avxf_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(sampling_atanf_stride)(
+            _avxf_stride_load_partial(
+               __x, lanes, _avxf_stride_set_duplicates(0.f)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
@@ -32,8 +32,8 @@ typedef struct tagSamplingAtanDAccelerator
       step_x_inv;
    size_t
       samples;
-   double const *
-      values;
+   VARRSampleTable
+      table;
 } SamplingAtanDAccelerator;
 
 static
@@ -46,13 +46,12 @@ __sampling_atand_disallocate(
    {
       return 1;
    }
-   free((void *) accelerator->values);
+   __varr_free_sample_table(&accelerator->table);
    accelerator->start_x = 0x7F800001;
    accelerator->step_x = 0x7F800001;
    accelerator->step_x_inv = 0x7F800001;
    accelerator->samples = (size_t) 0;
-   accelerator->values = NULL;
-   free(accelerator);
+   __varr_free(accelerator);
    return 0;
 }
 
@@ -77,36 +76,71 @@ static double const
    __sampling_atand_lower_limit = -50.,
    __sampling_atand_upper_limit = +50.;
 
+static
+double
+sampled_atan(double x, void * argument)
+{
+   (void) argument;
+   return
+      atan(x);
+}
+
+/*
+ * Returns the number_of_samples + 1 samples of atan over the clamping range
+ * (and beyond), of the table of clamping_linear_interpolating_atand:
+ */
+static
+double *
+sampling_atand_samples(size_t number_of_samples)
+{
+   double const
+      range = (__sampling_atand_upper_limit - __sampling_atand_lower_limit),
+      step_size = 
+         range / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_atan,
+         NULL,
+         __sampling_atand_lower_limit,
+         step_size,
+         number_of_samples + 1u
+         );
+}
+
 static
 SamplingAtanDAccelerator *
 allocate_sampling_atand(
-   size_t number_of_samples
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
    )
 {
    double const
       range = (__sampling_atand_upper_limit - __sampling_atand_lower_limit),
       step_size = 
          range / (double) (number_of_samples - (size_t) 1u);
+   VARRTableKey const
+      key = {
+         .function = "atan",
+         .method = "clamping linear sampling",
+         .number_of_samples = number_of_samples,
+         .layout = layout,
+         .precision = precision,
+         .lower = __sampling_atand_lower_limit,
+         .upper = __sampling_atand_upper_limit
+      };
    ++number_of_samples;
-   double * const
-      values = (double *) malloc(sizeof(double) * number_of_samples);
-   for(size_t i = (size_t) 0; i< number_of_samples; ++i)
-   {
-      double const
-         x = __sampling_atand_lower_limit + step_size * (double) i,
-         value = atan(x);
-      values[i] = value;
-      continue;
-   }
    SamplingAtanDAccelerator * const
-      result = (SamplingAtanDAccelerator *) malloc(
-         sizeof(SamplingAtanDAccelerator)
+      result = (SamplingAtanDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingAtanDAccelerator)
          );
    result->start_x = __sampling_atand_lower_limit;
    result->step_x = step_size;
    result->step_x_inv = 1.0 / step_size;
    result->samples = number_of_samples,
-   result->values = values;
+   result->table = __varr_shared_sample_table(
+      &key, sampling_atand_samples, number_of_samples, 1u
+      );
    return
       result;
 }
@@ -132,10 +166,8 @@ __sampling_atand_evaluate(
    register uint64_t const
       index = (uint64_t) step_frac;
    step_frac -= floor(step_frac);
-   double const * restrict
-      __values = (accelerator->values + index);
    return
-      *__values * (1. - step_frac) + __values[1] * step_frac;
+      __varr_interpolate(&accelerator->table, index, step_frac);
 }
 
 static
@@ -154,14 +186,13 @@ sampling_atand_evaluate(
 
 static
 void
-sampling_atand_batch_evaluate(
+sampling_atand_batch_evaluate_scalar(
    register double const * __x,
    register double * out,
    register size_t length,
    register void const * restrict __accelerator
    )
 {
-#ifndef __VARR_HAS_AVX__
    for(register size_t i = (size_t) 0u; i< length; ++i)
    {
       *out++ = __sampling_atand_evaluate(
@@ -169,211 +200,167 @@ sampling_atand_batch_evaluate(
          ((SamplingAtanDAccelerator const *) __accelerator)
          );
    }
-#else
-   register double const
-      __step_x_inv =
-         ((SamplingAtanDAccelerator const *) __accelerator)->step_x_inv;
-   register double const * const
-      values = ((SamplingAtanDAccelerator const *) __accelerator)->values;
-   register size_t const
-      length_axv_stride = length / __AVX_DOUBLE_STRIDE__;
-#ifdef __INTEL_COMPILER
-   for(size_t i = (size_t) 0u; i< length; ++i)
+   return;
+}
+
+/*
+ * The single precision arctangent, reflecting_linear_interpolating_atanf,
+ * samples atan on [0, 1]:
+ */
+typedef struct tagSamplingAtanFAccelerator
+{
+   float
+      step_x_inv,
+      last_sample;
+   size_t
+      samples;
+   float const *
+      table;
+} SamplingAtanFAccelerator;
+
+static float const
+   __sampling_atanf_half_pi = 1.57079632679489661923f;
+
+static
+int
+sampling_atanf_disallocate(
+   VARRAtanFEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
    {
-      double
-         x = __x[i];
-      if(x < __sampling_atand_lower_limit)
-         x = __sampling_atand_lower_limit;
-      if(x > __sampling_atand_upper_limit)
-         x = __sampling_atand_upper_limit;
-      x -= __sampling_atand_lower_limit;
-      register double
-         step_frac = x * __step_x_inv;
-      register unsigned const
-         index = (unsigned) step_frac;
-      step_frac -= floor(step_frac);
-      double const * restrict
-         __values = (values + index);
-      out[i] =
-         *__values * (1. - step_frac) + __values[1] * step_frac;
-      /*
-         note: icc -march=native -xHost:
-         remark #15388: vectorization support: reference __x[i] has aligned 
-                        access   [ ./src/varr_atan.c(148,14) ]
-         remark #15388: vectorization support: reference out[i] has aligned 
-                        access   [ ./src/varr_atan.c(161,7) ]
-         remark #15411: vectorization support: conversion from float to int 
-                        will be emulated   [ ./src/varr_atan.c(157,29) ]
-         remark #15328: vectorization support: indirect load was emulated for 
-                        the variable <*__values>, 64-bit indexed, part of 
-                        address is read from memory   
-                        [ ./src/varr_atan.c(162,11) ]
-         remark #15328: vectorization support: indirect load was emulated for 
-                        the variable <*(__values+8)>, 64-bit indexed, part of 
-                        address is read from memory   
-                        [ ./src/varr_atan.c(162,41) ]
-         remark #15305: vectorization support: vector length 4
-         remark #15309: vectorization support: normalized vectorization 
-                        overhead 0.084
-         remark #15300: LOOP WAS VECTORIZED
-         remark #15448: unmasked aligned unit stride loads: 1 
-         remark #15449: unmasked aligned unit stride stores: 1 
-         remark #15462: unmasked indexed (or gather) loads: 2 
-         remark #15475: --- begin vector cost summary ---
-         remark #15476: scalar cost: 147 
-         remark #15477: vector cost: 38.750 
-         remark #15478: estimated potential speedup: 3.780 
-         remark #15482: vectorized math library calls: 1 
-         remark #15487: type converts: 1 
-         remark #15488: --- end vector cost summary ---
-      */
+      return 1;
    }
-#else       // assume GCC:
-   double __attribute__((aligned(128)))
-      alignment_emulator[__AVX_DOUBLE_STRIDE__];
-   register avxd_array_t const
-      __mavxd_sampling_atand_lower_limit = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __sampling_atand_lower_limit,
-         __sampling_atand_lower_limit,
-         __sampling_atand_lower_limit,
-         __sampling_atand_lower_limit,
-#endif
-         __sampling_atand_lower_limit,
-         __sampling_atand_lower_limit,
-         __sampling_atand_lower_limit,
-         __sampling_atand_lower_limit
-         ),
-      __mavxd_sampling_atand_upper_limit = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __sampling_atand_upper_limit,
-         __sampling_atand_upper_limit,
-         __sampling_atand_upper_limit,
-         __sampling_atand_upper_limit,
-#endif
-         __sampling_atand_upper_limit,
-         __sampling_atand_upper_limit,
-         __sampling_atand_upper_limit,
-         __sampling_atand_upper_limit
-         ),
-       __one = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         1.0,
-         1.0,
-         1.0,
-         1.0,
-#endif
-         1.0,
-         1.0,
-         1.0,
-         1.0
-         ),
-       __step_x_inv_vector = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __step_x_inv,
-         __step_x_inv,
-         __step_x_inv,
-         __step_x_inv,
-#endif
-         __step_x_inv,
-         __step_x_inv,
-         __step_x_inv,
-         __step_x_inv
-         );
-   register avxd_array_t
-      alpha,
-      __values1,
-      __values2,
-    * const target = (avxd_array_t *) alignment_emulator;
-   register uint64_t
-      indexing[__AVX_DOUBLE_STRIDE__];
-   for(register size_t i = (size_t) 0u; i< length_axv_stride; ++i)
+   SamplingAtanFAccelerator * const
+      accelerator = (SamplingAtanFAccelerator *) evaluator->accelerator;
+   if(accelerator == NULL)
    {
-      alignment_emulator[0u] = __x[0u];
-      alignment_emulator[1u] = __x[1u];
-      alignment_emulator[2u] = __x[2u];
-      alignment_emulator[3u] = __x[3u];
-#ifdef __VARR_USE_AVX512__
-      alignment_emulator[4u] = __x[4u];
-      alignment_emulator[5u] = __x[5u];
-      alignment_emulator[6u] = __x[6u];
-      alignment_emulator[7u] = __x[7u];
-#endif
-      *target = _avxd_stride_max(*target, __mavxd_sampling_atand_lower_limit);
-      *target = _avxd_stride_min(*target, __mavxd_sampling_atand_upper_limit);
-      *target = *target - __mavxd_sampling_atand_lower_limit;
-      *target = *target * __step_x_inv_vector;
-      indexing[0u] = (uint64_t) alignment_emulator[0u];
-      indexing[1u] = (uint64_t) alignment_emulator[1u];
-      indexing[2u] = (uint64_t) alignment_emulator[2u];
-      indexing[3u] = (uint64_t) alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      indexing[4u] = (uint64_t) alignment_emulator[4u];
-      indexing[5u] = (uint64_t) alignment_emulator[5u];
-      indexing[6u] = (uint64_t) alignment_emulator[6u];
-      indexing[7u] = (uint64_t) alignment_emulator[7u];
-#endif
-      alpha = *target - _avxd_stride_floor(*target);
-      __values1 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[indexing[7u]++],
-         values[indexing[6u]++],
-         values[indexing[5u]++],
-         values[indexing[4u]++],
-#endif
-         values[indexing[3u]++],
-         values[indexing[2u]++],
-         values[indexing[1u]++],
-         values[indexing[0u]++]
+      return 1;
+   }
+   __varr_table_cache_release(accelerator->table);
+   accelerator->samples = (size_t) 0;
+   accelerator->table = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+/*
+ * Returns the number_of_samples + 2 samples of atan on [0, 1] (and beyond),
+ * of the table of reflecting_linear_interpolating_atanf:
+ */
+static
+double *
+sampling_atanf_samples(size_t number_of_samples)
+{
+   double const
+      step_size = 1. / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_atan, NULL, 0.0, step_size, number_of_samples + 2u
          );
-      __values2 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[indexing[7u]],
-         values[indexing[6u]],
-         values[indexing[5u]],
-         values[indexing[4u]],
-#endif
-         values[indexing[3u]],
-         values[indexing[2u]],
-         values[indexing[1u]],
-         values[indexing[0u]]
+}
+
+static
+SamplingAtanFAccelerator *
+allocate_sampling_atanf(
+   size_t number_of_samples
+   )
+{
+   double const
+      step_size = 1. / (double) (number_of_samples - (size_t) 1u);
+   VARRTableKey const
+      key = {
+         .function = "atan",
+         .method = "float reflecting linear sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_INTERLEAVED,
+         .precision = VARR_TABLE_FLOAT,
+         .lower = 0.0,
+         .upper = 1.0
+      };
+   SamplingAtanFAccelerator * const
+      result = (SamplingAtanFAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingAtanFAccelerator)
+         );
+   result->step_x_inv = (float) (1. / step_size);
+   result->last_sample = (float) (number_of_samples - (size_t) 1u);
+   result->samples = number_of_samples;
+   result->table = __varr_shared_float_table(
+      &key, sampling_atanf_samples, number_of_samples + 2u, 1u
+      );
+   return
+      result;
+}
+
+static inline
+float
+__sampling_atanf_evaluate(
+   register float x,
+   SamplingAtanFAccelerator const * restrict accelerator
+   )
+{
+   register uint32_t const
+      sign = __varr_float_bits(x) & 0x80000000u;
+   register float const
+      magnitude = __varr_bits_float(__varr_float_bits(x) & 0x7FFFFFFFu);
+   register int const
+      reflect = (magnitude > 1.f);
+   register float const
+      step_frac = fminf(
+         (reflect ? 1.f / magnitude : magnitude) * accelerator->step_x_inv,
+         accelerator->last_sample
          );
-      *target = __values2 * alpha;
-      alpha = __one - alpha;
-      *target = *target + (__values1 * alpha);
-      out[0u] = alignment_emulator[0u];
-      out[1u] = alignment_emulator[1u];
-      out[2u] = alignment_emulator[2u];
-      out[3u] = alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      out[4u] = alignment_emulator[4u];
-      out[5u] = alignment_emulator[5u];
-      out[6u] = alignment_emulator[6u];
-      out[7u] = alignment_emulator[7u];
-#endif
-      __x += __AVX_DOUBLE_STRIDE__;
-      out += __AVX_DOUBLE_STRIDE__;
-      continue;
+   register size_t const
+      index = (size_t) step_frac;
+   register float
+      value = __varr_interpolate_float_component(
+         accelerator->table, 1u, index, step_frac - (float) index, 0u
+         );
+   if(reflect)
+   {
+      value = __sampling_atanf_half_pi - value;
    }
-   
-   // Remainder loop:
+   return
+      __varr_bits_float(__varr_float_bits(value) | sign);
+}
 
-   for(
-      register size_t i = length_axv_stride * __AVX_DOUBLE_STRIDE__; 
-      i< length; 
-      ++i
-      )
+static
+float
+sampling_atanf_evaluate(
+   register float x,
+   register void const * restrict __accelerator
+   )
+{
+   return
+      __sampling_atanf_evaluate(
+         x,
+         (SamplingAtanFAccelerator const *) __accelerator
+         );
+}
+
+static
+void
+sampling_atanf_batch_evaluate_scalar(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(register size_t i = (size_t) 0u; i< length; ++i)
    {
-      *out++ = __sampling_atand_evaluate(
+      *out++ = __sampling_atanf_evaluate(
          *__x++,
-         ((SamplingAtanDAccelerator const *) __accelerator)
+         ((SamplingAtanFAccelerator const *) __accelerator)
          );
    }
-#endif
-#endif
    return;
 }
 
+#define __VARR_SIMD_KERNELS__ "varr_atan.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
 VARRAtanDEvaluator
 clamping_linear_interpolating_atand(size_t number_of_samples)
 {
@@ -381,12 +368,70 @@ clamping_linear_interpolating_atand(size_t number_of_samples)
       result;
    SamplingAtanDAccelerator * const
       accelerator = allocate_sampling_atand(
-         number_of_samples
+         number_of_samples,
+         __varr_table_format().layout,
+         __varr_table_format().precision
          );
    result.accelerator = (void *) accelerator;
    result.atan = sampling_atand_evaluate;
-   result.atan_array = sampling_atand_batch_evaluate;
+   result.atan_array = __varr_simd_select(sampling_atand_batch_evaluate);
    result.disallocate = sampling_atand_disallocate;
    return
       result;
 }
+
+VARRAtanFEvaluator
+reflecting_linear_interpolating_atanf(size_t number_of_samples)
+{
+   VARRAtanFEvaluator
+      result;
+   SamplingAtanFAccelerator * const
+      accelerator = allocate_sampling_atanf(number_of_samples);
+   result.accelerator = (void *) accelerator;
+   result.atanf = sampling_atanf_evaluate;
+   result.atanf_array = __varr_simd_select(sampling_atanf_batch_evaluate);
+   result.disallocate = sampling_atanf_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__):
+ */
+
+static
+void
+measure_clamping_linear_interpolating_atand(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingAtanDAccelerator));
+   __varr_measure_shared_sample_table(
+      number_of_samples + (size_t) 1u,
+      1u,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_reflecting_linear_interpolating_atanf(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingAtanFAccelerator));
+   __varr_measure_shared_float_table(number_of_samples + 2u, 1u);
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRAtanDEvaluator,
+   clamping_linear_interpolating_atand
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRAtanDEvaluator,
+   clamping_linear_interpolating_atand
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRAtanFEvaluator,
+   reflecting_linear_interpolating_atanf
+   )
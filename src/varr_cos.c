@@ -24,18 +24,17 @@
 #include <math.h>
 #include <stdlib.h>
 
-#include <gsl/gsl_errno.h>
-#include <gsl/gsl_spline.h>
 
 typedef struct tagSamplingCosDAccelerator
 {
    double
       start_x,
-      step_x;
+      step_x,
+      step_x_inverse;
    size_t
       samples;
-   double const *
-      values;
+   VARRSampleTable
+      table;
 } SamplingCosDAccelerator;
 
 static
@@ -48,12 +47,12 @@ __sampling_cosd_disallocate(
    {
       return 1;
    }
-   free((void *) accelerator->values);
+   __varr_free_sample_table(&accelerator->table);
    accelerator->start_x = 0x7F800001;
    accelerator->step_x = 0x7F800001;
+   accelerator->step_x_inverse = 0x7F800001;
    accelerator->samples = (size_t) 0;
-   accelerator->values = NULL;
-   free(accelerator);
+   __varr_free(accelerator);
    return 0;
 }
 
@@ -77,32 +76,62 @@ sampling_cosd_disallocate(
 static double const
    __2pi = 2.0 * M_PI;
 
+static
+double
+sampled_cos(double x, void * argument)
+{
+   (void) argument;
+   return
+      cos(x);
+}
+
+/*
+ * Returns the number_of_samples samples of cos over one period, of the 
+ * table of sampling_cosd (and of the spline of cubic_spline_sampling_cosd):
+ */
+static
+double *
+sampling_cosd_samples(size_t number_of_samples)
+{
+   double const
+      step_size = __2pi / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_cos, NULL, 0.0, step_size, number_of_samples
+         );
+}
+
 static
 SamplingCosDAccelerator *
 allocate_sampling_cosd(
-   size_t number_of_samples
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
    )
 {
    double const
       step_size = __2pi / (double) (number_of_samples - (size_t) 1u);
-   double * const
-      values = (double *) malloc(sizeof(double) * number_of_samples);
-   for(size_t i = (size_t) 0; i< number_of_samples; ++i)
-   {
-      double const
-         x = step_size * (double) i,
-         value = cos(x);
-      values[i] = value;
-      continue;
-   }
+   VARRTableKey const
+      key = {
+         .function = "cos",
+         .method = "sampling",
+         .number_of_samples = number_of_samples,
+         .layout = layout,
+         .precision = precision,
+         .lower = 0.0,
+         .upper = __2pi
+      };
    SamplingCosDAccelerator * const
-      result = (SamplingCosDAccelerator *) malloc(
-         sizeof(SamplingCosDAccelerator)
+      result = (SamplingCosDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingCosDAccelerator)
          );
    result->start_x = 0.0;
    result->step_x = step_size;
+   result->step_x_inverse = 1.0 / step_size;
    result->samples = number_of_samples,
-   result->values = values;
+   result->table = __varr_shared_sample_table(
+      &key, sampling_cosd_samples, number_of_samples, 1u
+      );
    return
       result;
 }
@@ -126,37 +155,41 @@ sampling_cosd_evaluate(
       step_frac = x / accelerator->step_x;
    step_frac -= floor(step_frac);
    return
-      (
-      accelerator->values[index] * (1. - step_frac) + 
-    + accelerator->values[index + 1] * step_frac
-      );
+      __varr_interpolate(&accelerator->table, index, step_frac);
 }
 
-VARRCosDEvaluator
-sampling_cosd(size_t number_of_samples)
+static
+void
+sampling_cosd_batch_evaluate_scalar(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
 {
-   VARRCosDEvaluator
-      result;
-   SamplingCosDAccelerator * const
-      accelerator = allocate_sampling_cosd(
-         number_of_samples
-         );
-   result.accelerator = (void *) accelerator;
-   result.cosd = sampling_cosd_evaluate;
-   result.disallocate = sampling_cosd_disallocate;
-   return
-      result;
+   for(
+      register size_t i = (size_t) 0u;
+      i< length;
+      ++i
+      )
+   {
+      *out++ = sampling_cosd_evaluate(*__x++, __accelerator);
+   }
+   return;
 }
 
 typedef struct tagCubicSplineSamplingCosDAccelerator {
    SamplingCosDAccelerator const *
       base;
-   gsl_interp_accel *
-      gsl_accelerator;
-   gsl_spline *
-      gsl_spline;
+   /*
+    * The spline, as per-interval polynomial coefficients (see
+    * __varr_natural_cubic_spline_coefficients), which are shared with other
+    * evaluators and only read:
+    */
    double const *
-      x_nodes;
+      coefficients;
+   double
+      last_coordinate;
 } CubicSplineSamplingCosDAccelerator;
 
 static
@@ -187,16 +220,10 @@ cubic_spline_sampling_cosd_disallocate(
       return base_disallocator_result;
    }
    
-   gsl_spline_free(accelerator->gsl_spline);
-   accelerator->gsl_spline = NULL;
-   
-   gsl_interp_accel_free(accelerator->gsl_accelerator);
-   accelerator->gsl_accelerator = NULL;
-   
-   free((double *) accelerator->x_nodes);
-   accelerator->x_nodes = NULL;
+   __varr_table_cache_release(accelerator->coefficients);
+   accelerator->coefficients = NULL;
    
-   free(accelerator);
+   __varr_free(accelerator);
    evaluator->accelerator = NULL;
    
    return 0;
@@ -211,17 +238,231 @@ cubic_spline_sampling_cosd_evaluate(
 {
    if((x <= 0.0) || (x >= __2pi))
    {
-      return 0.0;
+      return 1.0;
    }
    CubicSplineSamplingCosDAccelerator const * const
       accelerator = (CubicSplineSamplingCosDAccelerator const *) 
          __accelerator;
+   register double const
+      t = fmin(
+         x * accelerator->base->step_x_inverse,
+         accelerator->last_coordinate
+         );
+   register size_t const
+      index = (size_t) t;
+   return
+      __varr_evaluate_cubic_spline(
+         accelerator->coefficients, index, t - (double) index
+         );
+}
+
+static
+void
+cubic_spline_sampling_cosd_batch_evaluate_scalar(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(
+      register size_t i = (size_t) 0u;
+      i< length;
+      ++i
+      )
+   {
+      *out++ = cubic_spline_sampling_cosd_evaluate(*__x++, __accelerator);
+   }
+   return;
+}
+
+/*
+ * The single precision cosine, sampling_cosf, samples cos over one period:
+ */
+typedef struct tagSamplingCosFAccelerator
+{
+   float
+      step_x_inverse,
+      last_sample;
+   size_t
+      samples;
+   float const *
+      table;
+} SamplingCosFAccelerator;
+
+static
+int
+sampling_cosf_disallocate(
+   VARRCosFEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   SamplingCosFAccelerator * const
+      accelerator = (SamplingCosFAccelerator *) evaluator->accelerator;
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_table_cache_release(accelerator->table);
+   accelerator->samples = (size_t) 0;
+   accelerator->table = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+/*
+ * Returns the number_of_samples + 2 samples of cos over one period (and 
+ * beyond), of the table of sampling_cosf:
+ */
+static
+double *
+sampling_cosf_samples(size_t number_of_samples)
+{
+   double const
+      step_size = __2pi / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_cos, NULL, 0.0, step_size, number_of_samples + 2u
+         );
+}
+
+static
+SamplingCosFAccelerator *
+allocate_sampling_cosf(
+   size_t number_of_samples
+   )
+{
+   double const
+      step_size = __2pi / (double) (number_of_samples - (size_t) 1u);
+   VARRTableKey const
+      key = {
+         .function = "cos",
+         .method = "float sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_INTERLEAVED,
+         .precision = VARR_TABLE_FLOAT,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   SamplingCosFAccelerator * const
+      result = (SamplingCosFAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingCosFAccelerator)
+         );
+   result->step_x_inverse = (float) (1. / step_size);
+   result->last_sample = (float) (number_of_samples - (size_t) 1u);
+   result->samples = number_of_samples;
+   result->table = __varr_shared_float_table(
+      &key, sampling_cosf_samples, number_of_samples + 2u, 1u
+      );
+   return
+      result;
+}
+
+static inline
+float
+__sampling_cosf_evaluate(
+   register float x,
+   SamplingCosFAccelerator const * restrict accelerator
+   )
+{
+   register float
+      step_frac = (float) (
+         __varr_float_reduce_2pi(x) * (double) accelerator->step_x_inverse
+         );
+   step_frac = fminf(fmaxf(step_frac, 0.f), accelerator->last_sample);
+   register size_t const
+      index = (size_t) step_frac;
+   return
+      __varr_interpolate_float_component(
+         accelerator->table, 1u, index, step_frac - (float) index, 0u
+         );
+}
+
+static
+float
+sampling_cosf_evaluate(
+   register float x,
+   register void const * restrict accelerator
+   )
+{
    return
-      gsl_spline_eval(
-         accelerator->gsl_spline,
-         x,
-         accelerator->gsl_accelerator
+      __sampling_cosf_evaluate(
+         x, (SamplingCosFAccelerator const *) accelerator
+         );
+}
+
+static
+void
+sampling_cosf_batch_evaluate_scalar(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(register size_t i = (size_t) 0u; i< length; ++i)
+   {
+      *out++ = __sampling_cosf_evaluate(
+         *__x++,
+         ((SamplingCosFAccelerator const *) __accelerator)
          );
+   }
+   return;
+}
+
+#define __VARR_SIMD_KERNELS__ "varr_cos.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
+VARRCosDEvaluator
+sampling_cosd(size_t number_of_samples)
+{
+   VARRCosDEvaluator
+      result;
+   SamplingCosDAccelerator * const
+      accelerator = allocate_sampling_cosd(
+         number_of_samples,
+         __varr_table_format().layout,
+         __varr_table_format().precision
+         );
+   result.accelerator = (void *) accelerator;
+   result.cosd = sampling_cosd_evaluate;
+   result.cosd_array =
+      __varr_simd_select(sampling_cosd_batch_evaluate);
+   result.disallocate = sampling_cosd_disallocate;
+   return
+      result;
+}
+
+/*
+ * Builds the coefficients (see __varr_natural_cubic_spline_coefficients) of
+ * the spline through the samples 'values' of cubic_spline_sampling_cosd:
+ */
+static
+void *
+build_cubic_spline_coefficients(
+   VARRTableKey const * key,
+   void const * values
+   )
+{
+   size_t const
+      bytes = sizeof(double) * 4u * (key->number_of_samples - 1u);
+   double * const
+      coefficients = __varr_natural_cubic_spline_coefficients(
+         (double const *) values, key->number_of_samples
+         );
+   void * const
+      table = __varr_table_allocate(bytes);
+   if(table != NULL)
+   {
+      memcpy(table, coefficients, bytes);
+   }
+   free(coefficients);
+   return
+      table;
 }
 
 VARRCosDEvaluator
@@ -233,39 +474,127 @@ cubic_spline_sampling_cosd(size_t number_of_samples)
    CubicSplineSamplingCosDAccelerator * const
       cubic_accelerator = 
          (CubicSplineSamplingCosDAccelerator *)
-            malloc(sizeof(CubicSplineSamplingCosDAccelerator));
+            __varr_allocate(
+               __VARR_CACHE_LINE_BYTES__,
+               sizeof(CubicSplineSamplingCosDAccelerator)
+               );
    SamplingCosDAccelerator * const
       base_accelerator = allocate_sampling_cosd(
-         number_of_samples
+         number_of_samples, VARR_TABLE_VALUES, VARR_TABLE_DOUBLE
          );
    
    cubic_accelerator->base = base_accelerator;
+   // The coordinate of x is clamped into the last interval:
+   cubic_accelerator->last_coordinate =
+      nextafter((double) (number_of_samples - (size_t) 1u), 0.0);
    
-   cubic_accelerator->gsl_accelerator = gsl_interp_accel_alloc();
-   cubic_accelerator->gsl_spline = 
-      gsl_spline_alloc(gsl_interp_cspline, number_of_samples);
-   
-   double *
-      x_nodes = (double *) malloc(sizeof(double) * number_of_samples);
-   
-   for(size_t i = (size_t) 0u; i< number_of_samples; ++i)
-   {
-      x_nodes[i] = base_accelerator->step_x * i;
-   }
-   
-   cubic_accelerator->x_nodes = x_nodes;
-   
-   gsl_spline_init(
-      cubic_accelerator->gsl_spline,
-      x_nodes,
-      cubic_accelerator->base->values,
-      number_of_samples
+   VARRTableKey const
+      key = {
+         .function = "cos",
+         .method = "cubic spline sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   cubic_accelerator->coefficients = (double const *) __varr_shared_array(
+      &key,
+      sizeof(double),
+      4u * (number_of_samples - (size_t) 1u),
+      build_cubic_spline_coefficients,
+      cubic_accelerator->base->table.values
       );
    
    result.accelerator = (void *) cubic_accelerator;
    result.cosd = cubic_spline_sampling_cosd_evaluate;
+   result.cosd_array =
+      __varr_simd_select(cubic_spline_sampling_cosd_batch_evaluate);
    result.disallocate = cubic_spline_sampling_cosd_disallocate;
    return
       result;
 }
 
+VARRCosFEvaluator
+sampling_cosf(size_t number_of_samples)
+{
+   VARRCosFEvaluator
+      result;
+   SamplingCosFAccelerator * const
+      accelerator = allocate_sampling_cosf(number_of_samples);
+   result.accelerator = (void *) accelerator;
+   result.cosf = sampling_cosf_evaluate;
+   result.cosf_array = __varr_simd_select(sampling_cosf_batch_evaluate);
+   result.disallocate = sampling_cosf_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__):
+ */
+
+static
+void
+measure_sampling_cosd_with_format(
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   )
+{
+   __varr_allocation_measure(sizeof(SamplingCosDAccelerator));
+   __varr_measure_shared_sample_table(number_of_samples, 1u, layout, precision);
+}
+
+static
+void
+measure_sampling_cosd(size_t number_of_samples)
+{
+   measure_sampling_cosd_with_format(
+      number_of_samples,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_cubic_spline_sampling_cosd(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(CubicSplineSamplingCosDAccelerator));
+   measure_sampling_cosd_with_format(
+      number_of_samples, VARR_TABLE_VALUES, VARR_TABLE_DOUBLE
+      );
+   __varr_measure_shared_array(
+      sizeof(double), 4u * (number_of_samples - (size_t) 1u)
+      );
+}
+
+static
+void
+measure_sampling_cosf(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingCosFAccelerator));
+   __varr_measure_shared_float_table(number_of_samples + 2u, 1u);
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRCosDEvaluator,
+   sampling_cosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRCosDEvaluator,
+   sampling_cosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRCosDEvaluator,
+   cubic_spline_sampling_cosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRCosFEvaluator,
+   sampling_cosf
+   )
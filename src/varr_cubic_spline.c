@@ -0,0 +1,148 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_internal.h"
+
+#include <stdlib.h>
+
+/*
+ * The second derivatives, m[i] (scaled by the square of the step), of the
+ * natural spline satisfy
+ *
+ *    m[i - 1] + 4 * m[i] + m[i + 1] = 6 * (y[i + 1] - 2 * y[i] + y[i - 1])
+ *
+ * with m[0] = m[n - 1] = 0, which is solved here by forward elimination and
+ * back substitution.  On interval i, the spline is then
+ *
+ *    y[i] + t * (y[i + 1] - y[i] - (2 * m[i] + m[i + 1]) / 6)
+ *         + t**2 * m[i] / 2 + t**3 * (m[i + 1] - m[i]) / 6.
+ */
+double *
+__varr_natural_cubic_spline_coefficients(
+   double const * values,
+   size_t number_of_samples
+   )
+{
+   size_t const
+      number_of_intervals = number_of_samples - (size_t) 1u;
+   double * const
+      coefficients = (double *) malloc(
+         sizeof(double) * (size_t) 4u * number_of_intervals
+         );
+   double * const
+      m = (double *) malloc(sizeof(double) * number_of_samples);
+   double * const
+      elimination = (double *) malloc(sizeof(double) * number_of_samples);
+   m[0u] = 0.;
+   m[number_of_intervals] = 0.;
+   elimination[0u] = 0.;
+   for(size_t i = (size_t) 1u; i< number_of_intervals; ++i)
+   {
+      double const
+         pivot = 1. / (4. - elimination[i - 1u]);
+      elimination[i] = pivot;
+      m[i] = (
+         6. * (values[i + 1u] - 2. * values[i] + values[i - 1u])
+       - m[i - 1u]
+         ) * pivot;
+   }
+   for(size_t i = number_of_intervals - (size_t) 1u; i> (size_t) 0u; --i)
+   {
+      m[i] -= elimination[i] * m[i + 1u];
+   }
+   for(size_t i = (size_t) 0u; i< number_of_intervals; ++i)
+   {
+      double * const
+         coefficient = coefficients + (size_t) 4u * i;
+      coefficient[0u] = values[i];
+      coefficient[1u] =
+         values[i + 1u] - values[i] - (2. * m[i] + m[i + 1u]) / 6.;
+      coefficient[2u] = 0.5 * m[i];
+      coefficient[3u] = (m[i + 1u] - m[i]) / 6.;
+   }
+   free(elimination);
+   free(m);
+   return
+      coefficients;
+}
+
+/*
+ * The error of the natural end conditions decays by a factor of 2 - sqrt(3)
+ * per sample away from the ends, and is thus negligible past this number of
+ * samples:
+ */
+static size_t const
+   __padding = (size_t) 32u;
+
+/*
+ * The padded samples, function(step * (i - __padding)), as sampled by 
+ * __varr_sample_grid at x = i:
+ */
+typedef struct tagPaddedSamples
+{
+   double (* function) (double);
+   double
+      step;
+} PaddedSamples;
+
+static
+double
+sampled_padded(double i, void * argument)
+{
+   PaddedSamples const * const
+      samples = (PaddedSamples const *) argument;
+   return
+      samples->function(samples->step * (i - (double) __padding));
+}
+
+double *
+__varr_padded_cubic_spline_coefficients(
+   double (* function) (double),
+   double step,
+   size_t number_of_intervals
+   )
+{
+   size_t const
+      number_of_padded_samples =
+         number_of_intervals + (size_t) 1u + (size_t) 2u * __padding;
+   double * const
+      coefficients = (double *) malloc(
+         sizeof(double) * (size_t) 4u * number_of_intervals
+         );
+   PaddedSamples
+      padded = { function, step };
+   double * const
+      samples = __varr_sample_grid(
+         sampled_padded, &padded, 0., 1., number_of_padded_samples
+         );
+   double * const
+      padded_coefficients = __varr_natural_cubic_spline_coefficients(
+         samples,
+         number_of_padded_samples
+         );
+   for(size_t i = (size_t) 0; i< (size_t) 4u * number_of_intervals; ++i)
+   {
+      coefficients[i] = padded_coefficients[(size_t) 4u * __padding + i];
+   }
+   free(padded_coefficients);
+   free(samples);
+   return
+      coefficients;
+}
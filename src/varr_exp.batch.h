@@ -0,0 +1,343 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_exp.c.  This file is included by varr_exp.c
+ * (through varr_simd_instantiate.h) twice per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+/*
+ * exp(x) = exp(floor(x)) * exp(x - floor(x)), where the former is gathered
+ * from __integer_exp and the latter is interpolated linearly on [0, 1] (from
+ * a contiguous window of the table where the inputs are sorted):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(shifting_linear_sampling_expd_stride)(
+   register avxd_array_t x,
+   VARRSampleTable const * const table,
+   register avxd_array_t const step_x_inv
+   )
+{
+   register avxd_array_t const
+      __1024 = _avxd_stride_set_duplicates(1024.);
+   x = _avxd_stride_max(
+      x,
+      _avxd_stride_set_duplicates(__sampling_expd_lower_limit)
+      );
+   register avxd_array_t
+      prefix = _avxd_stride_floor(x),
+      alpha = (x - prefix) * step_x_inv;
+   prefix = _avxd_stride_gather(
+      __integer_exp,
+      _avxd_stride_index(prefix + __1024)
+      );
+   register avxi_array_t const
+      index = _avxd_stride_index(alpha);
+   alpha -= _avxd_stride_floor(alpha);
+   return
+      prefix * _avxd_stride_interpolate_window(table, index, alpha);
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(shifting_linear_sampling_expd_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      shifting_linear_sampling_expd_batch_evaluate,
+      __x,
+      out,
+      length,
+      __accelerator
+      );
+   VARRSampleTable const * const
+      table = &((SamplingExpDAccelerator const *) __accelerator)->table;
+   register avxd_array_t const
+      step_x_inv = _avxd_stride_set_duplicates(
+         ((SamplingExpDAccelerator const *) __accelerator)->
+            step_x_inverse
+         );
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         out,
+         __VARR_SIMD_NAME(shifting_linear_sampling_expd_stride)(
+            _avxd_stride_load(__x), table, step_x_inv
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(shifting_linear_sampling_expd_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(0.)
+               ),
+            table,
+            step_x_inv
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * exp(x) = 2**k * 2**(j/N) * exp(r), for x = (k N + j) log(2)/N + r, where
+ * 2**k * 2**(j/N) is assembled in the bits of the gathered 2**(j/N), see
+ * ScalingExpDAccelerator, and exp(r) is evaluated by its Taylor series:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(scaling_series_expd_stride)(
+   register avxd_array_t x,
+   ScalingExpDAccelerator const * const accelerator
+   )
+{
+   register avxd_array_t const
+      lower_limit = _avxd_stride_set_duplicates(__scaling_expd_lower_limit),
+      n = _avxd_stride_floor(
+         _avxd_stride_max(x, lower_limit) * _avxd_stride_set_duplicates(
+            accelerator->samples_per_log2
+            )
+         );
+   register avxl_array_t const
+      bits = _avxd_stride_as_avxl(
+         n + _avxd_stride_set_duplicates(__scaling_expd_shift)
+         );
+   register avxd_array_t
+      r = _avxd_stride_fnmadd(
+         n,
+         _avxd_stride_set_duplicates(accelerator->log2_per_sample_high),
+         x
+         );
+   r = _avxd_stride_fnmadd(
+      n,
+      _avxd_stride_set_duplicates(accelerator->log2_per_sample_low),
+      r
+      );
+   register avxd_array_t const
+      scale = _avxl_stride_as_avxd(
+         _avxl_stride_add(
+            _avxd_stride_as_avxl(
+               _avxd_stride_gather_long(
+                  (double const *) accelerator->scales,
+                  _avxl_stride_and(
+                     bits,
+                     _avxl_stride_set_duplicates(accelerator->mask)
+                     )
+                  )
+               ),
+            _avxl_stride_shift_left(bits, accelerator->shift)
+            )
+         );
+   register avxd_array_t
+      series = _avxd_stride_set_duplicates(__scaling_expd_series[4u]);
+   series = _avxd_stride_fmadd(
+      series, r, _avxd_stride_set_duplicates(__scaling_expd_series[3u])
+      );
+   series = _avxd_stride_fmadd(
+      series, r, _avxd_stride_set_duplicates(__scaling_expd_series[2u])
+      );
+   series = _avxd_stride_fmadd(
+      series, r, _avxd_stride_set_duplicates(__scaling_expd_series[1u])
+      );
+   series = _avxd_stride_fmadd(
+      series, r, _avxd_stride_set_duplicates(__scaling_expd_series[0u])
+      );
+   return
+      _avxd_stride_blend(
+         _avxd_stride_less_than(x, lower_limit),
+         _avxd_stride_fmadd(scale, r * series, scale),
+         _avxd_stride_set_duplicates(0.)
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(scaling_series_expd_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      scaling_series_expd_batch_evaluate, __x, out, length, __accelerator
+      );
+   register ScalingExpDAccelerator const * const
+      accelerator = ((ScalingExpDAccelerator const *) __accelerator);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         out,
+         __VARR_SIMD_NAME(scaling_series_expd_stride)(
+            _avxd_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(scaling_series_expd_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(0.)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * exp(x) = 2**k * 2**f, for x = (k + f) log(2), where 2**k is added to the
+ * exponent bits of the interpolated 2**f:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxf_array_t
+__VARR_SIMD_NAME(linear_sampling_expf_stride)(
+   register avxf_array_t x,
+   SamplingExpFAccelerator const * const accelerator
+   )
+{
+   x = _avxf_stride_max(
+      x, _avxf_stride_set_duplicates(__sampling_expf_lower_limit)
+      );
+   x = _avxf_stride_min(
+      x, _avxf_stride_set_duplicates(__sampling_expf_upper_limit)
+      );
+   register avxf_array_t const
+      k = _avxf_stride_floor(
+         x * _avxf_stride_set_duplicates(__sampling_expf_log2e)
+         );
+   register avxf_array_t
+      u = _avxf_stride_fnmadd(
+         k,
+         _avxf_stride_set_duplicates(__sampling_expf_log2_low),
+         _avxf_stride_fnmadd(
+            k, _avxf_stride_set_duplicates(__sampling_expf_log2_high), x
+            )
+         ) * _avxf_stride_set_duplicates(accelerator->samples_per_log2);
+   u = _avxf_stride_min(
+      _avxf_stride_max(u, _avxf_stride_set_duplicates(0.f)),
+      _avxf_stride_set_duplicates(accelerator->last_sample)
+      );
+   register avxfi_array_t const
+      index = _avxf_stride_index(u);
+   return
+      _avxfi_stride_as_avxf(
+         _avxfi_stride_add(
+            _avxf_stride_as_avxfi(
+               _avxf_stride_interpolate(
+                  accelerator->table, index, u - _avxf_stride_floor(u)
+                  )
+               ),
+            _avxfi_stride_shift_left(_avxf_stride_index(k), 23)
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_sampling_expf_batch_evaluate)(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      linear_sampling_expf_batch_evaluate, __x, out, length, __accelerator
+      );
+   register SamplingExpFAccelerator const * const
+      accelerator = (SamplingExpFAccelerator const *) __accelerator;
+   for(
+      ;
+      length >= __AVX_FLOAT_STRIDE__;
+      length -= __AVX_FLOAT_STRIDE__
+      )
+   {
+      _avxf_stride_store(
+         out,
+         __VARR_SIMD_NAME(linear_sampling_expf_stride)(
+            _avxf_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_FLOAT_STRIDE__;
+      out += __AVX_FLOAT_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxf_lanes_t const
+         lanes = _avxf_stride_lanes(length);
+      _avxf_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(linear_sampling_expf_stride)(
+            _avxf_stride_load_partial(
+               __x, lanes, _avxf_stride_set_duplicates(0.f)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
@@ -33,10 +33,32 @@ typedef struct tagSamplingExpDAccelerator
       step_x_inverse;
    size_t
       samples;
-   double const *
-      values;
+   VARRSampleTable
+      table;
 } SamplingExpDAccelerator;
 
+/*
+ * exp(x) = 2**k * 2**(j/N) * exp(r), for x = (k N + j) log(2)/N + r with
+ * 0 <= j < N and 0 <= r < log(2)/N.  N is a power of two, 'scales' holds
+ * the bits of 2**(j/N) less (j << shift), shift = 52 - log2(N), so that adding
+ * the bits of (k * N + j) << shift to scales[j] yields the bits of
+ * 2**k * 2**(j/N).
+ */
+typedef struct tagScalingExpDAccelerator
+{
+   double
+      samples_per_log2,
+      log2_per_sample_high,
+      log2_per_sample_low;
+   size_t
+      samples;
+   uint64_t
+      mask,
+      shift;
+   uint64_t const *
+      scales;
+} ScalingExpDAccelerator;
+
 static
 int
 __shifting_linear_sampling_expd_disallocate(
@@ -47,13 +69,12 @@ __shifting_linear_sampling_expd_disallocate(
    {
       return 1;
    }
-   free((void *) accelerator->values);
+   __varr_free_sample_table(&accelerator->table);
    accelerator->start_x = 0x7F800001;
    accelerator->step_x = 0x7F800001;
    accelerator->step_x_inverse = 0x7F800001;
    accelerator->samples = (size_t) 0;
-   accelerator->values = NULL;
-   free(accelerator);
+   __varr_free(accelerator);
    return 0;
 }
 
@@ -74,35 +95,62 @@ shifting_linear_sampling_expd_disallocate(
       __shifting_linear_sampling_expd_disallocate(accelerator);
 }
 
+static
+double
+sampled_exp(double x, void * argument)
+{
+   (void) argument;
+   return
+      exp(x);
+}
+
+/*
+ * Returns the number_of_samples + 2 samples of exp on [0, 1] (and beyond),
+ * of the table of shifting_linear_sampling_expd:
+ */
+static
+double *
+shifting_linear_sampling_expd_samples(size_t number_of_samples)
+{
+   double const
+      step_size = 1.0 / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_exp, NULL, 0.0, step_size, number_of_samples + 2u
+         );
+}
+
 static
 SamplingExpDAccelerator *
 shifting_linear_sampling_expd_allocate(
-   size_t number_of_samples
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
    )
 {
    double const
       step_size = 1.0 / (double) (number_of_samples - (size_t) 1u);
-   double * const
-      values = (double *) 
-         malloc(sizeof(double) * (number_of_samples + 2u)
-         );
-   for(size_t i = (size_t) 0; i< (number_of_samples + 2u); ++i)
-   {
-      double const
-         x = step_size * (double) i,
-         value = exp(x);
-      values[i] = value;
-      continue;
-   }
+   VARRTableKey const
+      key = {
+         .function = "exp",
+         .method = "shifting linear sampling",
+         .number_of_samples = number_of_samples,
+         .layout = layout,
+         .precision = precision,
+         .lower = 0.0,
+         .upper = 1.0
+      };
    SamplingExpDAccelerator * const
-      result = (SamplingExpDAccelerator *) malloc(
-         sizeof(SamplingExpDAccelerator)
+      result = (SamplingExpDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingExpDAccelerator)
          );
    result->start_x = 0.0;
    result->step_x = step_size;
    result->step_x_inverse = 1.0 / step_size;
    result->samples = number_of_samples,
-   result->values = values;
+   result->table = __varr_shared_sample_table(
+      &key, shifting_linear_sampling_expd_samples, number_of_samples + 2u, 1u
+      );
    return
       result;
 }
@@ -1870,10 +1918,8 @@ __shifting_linear_sampling_expd_evaluate(
    register uint64_t const
       index = (uint64_t) alpha;
    alpha -= index;
-   register double const * restrict
-      value = (accelerator->values + index);
    return
-      __prefix * (*value * (1.0 - alpha) + value[1] * alpha);
+      __prefix * __varr_interpolate(&accelerator->table, index, alpha);
 }
 
 static
@@ -1891,14 +1937,13 @@ shifting_linear_sampling_expd_evaluate(
 
 static
 void
-shifting_linear_sampling_expd_batch_evaluate(
+shifting_linear_sampling_expd_batch_evaluate_scalar(
    register double const * __x,
    register double * out,
    register size_t length,
    register void const * restrict __accelerator
    )
 {
-#ifndef __VARR_HAS_AVX__
    for(
       register size_t i = (size_t) 0u;
       i< length;
@@ -1910,156 +1955,375 @@ shifting_linear_sampling_expd_batch_evaluate(
          ((SamplingExpDAccelerator const *) __accelerator)
          );
    }
-#else
-   register double const * const
-      values = ((SamplingExpDAccelerator const *) __accelerator)->values;
-   register size_t const
-      length_axv_stride = length / __AVX_DOUBLE_STRIDE__;
-   double __attribute__((aligned(128)))
-      alignment_emulator[__AVX_DOUBLE_STRIDE__];
-   register avxd_array_t const
-      __avxd_sampling_expd_lower_limit = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __sampling_expd_lower_limit,
-         __sampling_expd_lower_limit,
-         __sampling_expd_lower_limit,
-         __sampling_expd_lower_limit,
-#endif
-         __sampling_expd_lower_limit,
-         __sampling_expd_lower_limit,
-         __sampling_expd_lower_limit,
-         __sampling_expd_lower_limit
+   return;
+}
+
+/*
+ * log(2) split into a high part, with trailing zero bits, and a low part:
+ */
+static double const
+   __scaling_expd_log2_high = 6.93147180369123816490e-01,
+   __scaling_expd_log2_low = 1.90821492927058770002e-10;
+
+/*
+ * Adding 1.5 * 2**52 to an integral double n, |n| < 2**51, leaves n in the
+ * low bits of the sum:
+ */
+static double const
+   __scaling_expd_shift = 6755399441055744.;
+
+/*
+ * exp(x) is below DBL_MIN, and 2**k is no longer a normal double, for
+ * x < -1022 log(2):
+ */
+static double const
+   __scaling_expd_lower_limit = -708.39;
+
+/*
+ * The Taylor coefficients of (exp(r) - 1)/r:
+ */
+static double const
+   __scaling_expd_series[5u] = {
+      1.,
+      1. / 2.,
+      1. / 6.,
+      1. / 24.,
+      1. / 120.
+   };
+
+static
+int
+scaling_series_expd_disallocate(
+   VARRExpDEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   ScalingExpDAccelerator * const
+      accelerator = (ScalingExpDAccelerator *) evaluator->accelerator;
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_free((void *) accelerator->scales);
+   accelerator->samples = (size_t) 0;
+   accelerator->scales = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+/*
+ * Returns log2(N), where N is number_of_samples rounded up to a power of 
+ * two, of at most 2**20:
+ */
+static
+uint64_t
+scaling_series_expd_log2_samples(size_t number_of_samples)
+{
+   uint64_t
+      log2_samples = 0u;
+   while(
+      (log2_samples < 20u)
+   && (((size_t) 1u << log2_samples) < number_of_samples)
+      )
+   {
+      ++log2_samples;
+   }
+   return
+      log2_samples;
+}
+
+static
+ScalingExpDAccelerator *
+scaling_series_expd_allocate(
+   size_t number_of_samples
+   )
+{
+   uint64_t const
+      log2_samples = scaling_series_expd_log2_samples(number_of_samples);
+   size_t const
+      samples = (size_t) 1u << log2_samples;
+   uint64_t const
+      shift = 52u - log2_samples;
+   uint64_t * const
+      scales = (uint64_t *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(uint64_t) * samples
          );
-   // register avxd_array_t
-   avxd_array_t
-      alpha,
-      __values1,
-      __values2,
-      prefix,
-    * const target = (avxd_array_t *) alignment_emulator;
-   avxd_array_t const
-      __one = _avxd_stride_set_duplicates(1.),
-      __1024 = _avxd_stride_set_duplicates(1024.),
-      step_x_inv = _avxd_stride_set_duplicates(
-         ((SamplingExpDAccelerator const *) __accelerator)->
-            step_x_inverse
+   for(size_t j = (size_t) 0; j< samples; ++j)
+   {
+      scales[j] =
+         __varr_double_bits(exp2((double) j / (double) samples))
+       - ((uint64_t) j << shift);
+   }
+   ScalingExpDAccelerator * const
+      result = (ScalingExpDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(ScalingExpDAccelerator)
          );
-#ifndef __INTEL_COMPILER
-   register
-#endif
-   int64_t
-      index_avx[__AVX_DOUBLE_STRIDE__];
-   for(register size_t i = (size_t) 0u; i< length_axv_stride; ++i)
+   result->samples_per_log2 = (double) samples / log(2.);
+   result->log2_per_sample_high = __scaling_expd_log2_high / (double) samples;
+   result->log2_per_sample_low = __scaling_expd_log2_low / (double) samples;
+   result->samples = samples;
+   result->mask = (uint64_t) (samples - (size_t) 1u);
+   result->shift = shift;
+   result->scales = scales;
+   return
+      result;
+}
+
+static
+double
+__scaling_series_expd_evaluate(
+   register double x,
+   ScalingExpDAccelerator const * restrict accelerator
+   )
+{
+   if(x < __scaling_expd_lower_limit)
    {
-      alignment_emulator[0u] = __x[0u];
-      alignment_emulator[1u] = __x[1u];
-      alignment_emulator[2u] = __x[2u];
-      alignment_emulator[3u] = __x[3u];
-#ifdef __VARR_USE_AVX512__
-      alignment_emulator[4u] = __x[4u];
-      alignment_emulator[5u] = __x[5u];
-      alignment_emulator[6u] = __x[6u];
-      alignment_emulator[7u] = __x[7u];
-#endif
-      *target = _avxd_stride_max(*target, __avxd_sampling_expd_lower_limit);
-      prefix = _avxd_stride_floor(*target);
-      alpha = (*target - prefix);
-      *target = (prefix + __1024);
-      index_avx[0u] = (int64_t) alignment_emulator[0u];
-      index_avx[1u] = (int64_t) alignment_emulator[1u];
-      index_avx[2u] = (int64_t) alignment_emulator[2u];
-      index_avx[3u] = (int64_t) alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = (int64_t) alignment_emulator[4u];
-      index_avx[5u] = (int64_t) alignment_emulator[5u];
-      index_avx[6u] = (int64_t) alignment_emulator[6u];
-      index_avx[7u] = (int64_t) alignment_emulator[7u];
-#endif
-      prefix = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __integer_exp[index_avx[7u]],
-         __integer_exp[index_avx[6u]],
-         __integer_exp[index_avx[5u]],
-         __integer_exp[index_avx[4u]],
-         
-#endif
-         __integer_exp[index_avx[3u]],
-         __integer_exp[index_avx[2u]],
-         __integer_exp[index_avx[1u]],
-         __integer_exp[index_avx[0u]]
+      return 0.;
+   }
+   register double const
+      n = floor(x * accelerator->samples_per_log2);
+   register uint64_t const
+      bits = __varr_double_bits(n + __scaling_expd_shift);
+   /*
+    * The low part takes n read back from the bits, which keeps -ffast-math
+    * from merging the two products (and log(2)/N) back together:
+    */
+   register double const
+      r = (x - n * accelerator->log2_per_sample_high)
+        - (double) (int64_t) (bits - __varr_double_bits(__scaling_expd_shift))
+        * accelerator->log2_per_sample_low;
+   register double const
+      scale = __varr_bits_double(
+         accelerator->scales[bits & accelerator->mask]
+       + (bits << accelerator->shift)
          );
-      *target = alpha * step_x_inv;
-      index_avx[0u] = (int64_t) alignment_emulator[0u];
-      index_avx[1u] = (int64_t) alignment_emulator[1u];
-      index_avx[2u] = (int64_t) alignment_emulator[2u];
-      index_avx[3u] = (int64_t) alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = (int64_t) alignment_emulator[4u];
-      index_avx[5u] = (int64_t) alignment_emulator[5u];
-      index_avx[6u] = (int64_t) alignment_emulator[6u];
-      index_avx[7u] = (int64_t) alignment_emulator[7u];
-#endif
-      alpha = *target -  _avxd_stride_floor(*target);
-      __values1 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[index_avx[7u]++],
-         values[index_avx[6u]++],
-         values[index_avx[5u]++],
-         values[index_avx[4u]++],
-#endif
-         values[index_avx[3u]++],
-         values[index_avx[2u]++],
-         values[index_avx[1u]++],
-         values[index_avx[0u]++]
+   register double
+      series = __scaling_expd_series[4u];
+   series = series * r + __scaling_expd_series[3u];
+   series = series * r + __scaling_expd_series[2u];
+   series = series * r + __scaling_expd_series[1u];
+   series = series * r + __scaling_expd_series[0u];
+   return
+      scale + scale * (r * series);
+}
+
+static
+double
+scaling_series_expd_evaluate(
+   register double x,
+   register void const * restrict accelerator
+   )
+{
+   return
+      __scaling_series_expd_evaluate(
+         x, (ScalingExpDAccelerator const * const) accelerator
          );
-      __values2 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[index_avx[7u]],
-         values[index_avx[6u]],
-         values[index_avx[5u]],
-         values[index_avx[4u]],
-#endif
-         values[index_avx[3u]],
-         values[index_avx[2u]],
-         values[index_avx[1u]],
-         values[index_avx[0u]]
+}
+
+static
+void
+scaling_series_expd_batch_evaluate_scalar(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(
+      register size_t i = (size_t) 0u;
+      i< length;
+      ++i
+      )
+   {
+      *out++ = __scaling_series_expd_evaluate(
+         *__x++,
+         ((ScalingExpDAccelerator const *) __accelerator)
          );
-      *target = __values2 * alpha;
-      alpha = (__one - alpha);
-      *target = (*target + __values1 * alpha);
-      *target = prefix * *target;
-      out[0u] = alignment_emulator[0u];
-      out[1u] = alignment_emulator[1u];
-      out[2u] = alignment_emulator[2u];
-      out[3u] = alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      out[4u] = alignment_emulator[4u];
-      out[5u] = alignment_emulator[5u];
-      out[6u] = alignment_emulator[6u];
-      out[7u] = alignment_emulator[7u];
-#endif
-      __x += __AVX_DOUBLE_STRIDE__;
-      out += __AVX_DOUBLE_STRIDE__;
-      continue;
    }
-   
-   // Remainder loop:
-   
+   return;
+}
+
+/*
+ * The single precision exponential, linear_sampling_expf, reduces x by 
+ * log(2) and interpolates 2**f on [0, 1]; its limits are the range of normal
+ * float values of exp(x).  The vector reduction subtracts k log(2) in two
+ * parts, the first of which is exact for |k| < 2**8:
+ */
+typedef struct tagSamplingExpFAccelerator
+{
+   float
+      samples_per_log2,
+      last_sample;
+   size_t
+      samples;
+   float const *
+      table;
+} SamplingExpFAccelerator;
+
+static float const
+   __sampling_expf_lower_limit = -87.33f,
+   __sampling_expf_upper_limit = 88.72f,
+   __sampling_expf_log2e = 1.44269504088896340736f,
+   __sampling_expf_log2_high = 0.693145751953125f,
+   __sampling_expf_log2_low = 1.42860682028622680e-6f;
+
+static
+int
+linear_sampling_expf_disallocate(
+   VARRExpFEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   SamplingExpFAccelerator * const
+      accelerator = (SamplingExpFAccelerator *) evaluator->accelerator;
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_table_cache_release(accelerator->table);
+   accelerator->samples = (size_t) 0;
+   accelerator->table = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+static
+double
+sampled_exp2(double x, void * argument)
+{
+   (void) argument;
+   return
+      exp2(x);
+}
+
+/*
+ * Returns the number_of_samples + 2 samples of exp2 on [0, 1] (and beyond),
+ * of the table of linear_sampling_expf:
+ */
+static
+double *
+linear_sampling_expf_samples(size_t number_of_samples)
+{
+   double const
+      step_size = 1.0 / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_exp2, NULL, 0.0, step_size, number_of_samples + 2u
+         );
+}
+
+static
+SamplingExpFAccelerator *
+linear_sampling_expf_allocate(
+   size_t number_of_samples
+   )
+{
+   double const
+      step_size = 1.0 / (double) (number_of_samples - (size_t) 1u);
+   VARRTableKey const
+      key = {
+         .function = "exp2",
+         .method = "float linear sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_INTERLEAVED,
+         .precision = VARR_TABLE_FLOAT,
+         .lower = 0.0,
+         .upper = 1.0
+      };
+   SamplingExpFAccelerator * const
+      result = (SamplingExpFAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingExpFAccelerator)
+         );
+   result->samples_per_log2 = (float) (1.0 / (step_size * log(2.)));
+   result->last_sample = (float) (number_of_samples - (size_t) 1u);
+   result->samples = number_of_samples;
+   result->table = __varr_shared_float_table(
+      &key, linear_sampling_expf_samples, number_of_samples + 2u, 1u
+      );
+   return
+      result;
+}
+
+static
+float
+__linear_sampling_expf_evaluate(
+   register float x,
+   SamplingExpFAccelerator const * restrict accelerator
+   )
+{
+   if(x < __sampling_expf_lower_limit)
+   {
+      x = __sampling_expf_lower_limit;
+   }
+   if(x > __sampling_expf_upper_limit)
+   {
+      x = __sampling_expf_upper_limit;
+   }
+   register float const
+      k = floorf(x * __sampling_expf_log2e);
+   // The scalar reduction is carried out in double precision:
+   register float
+      u = (float) (((double) x - (double) k * log(2.))
+        * (double) accelerator->samples_per_log2);
+   u = fminf(fmaxf(u, 0.f), accelerator->last_sample);
+   register size_t const
+      index = (size_t) u;
+   register float const
+      value = __varr_interpolate_float_component(
+         accelerator->table, 1u, index, u - (float) index, 0u
+         );
+   return
+      __varr_bits_float(
+         __varr_float_bits(value) + ((uint32_t) (int32_t) k << 23)
+         );
+}
+
+static
+float
+linear_sampling_expf_evaluate(
+   register float x,
+   register void const * restrict accelerator
+   )
+{
+   return
+      __linear_sampling_expf_evaluate(
+         x, (SamplingExpFAccelerator const * const) accelerator
+         );
+}
+
+static
+void
+linear_sampling_expf_batch_evaluate_scalar(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
    for(
-      register size_t i = length_axv_stride * __AVX_DOUBLE_STRIDE__;
-      i< length; 
+      register size_t i = (size_t) 0u;
+      i< length;
       ++i
       )
    {
-      *out++ = __shifting_linear_sampling_expd_evaluate(
+      *out++ = __linear_sampling_expf_evaluate(
          *__x++,
-         ((SamplingExpDAccelerator const *) __accelerator)
+         ((SamplingExpFAccelerator const *) __accelerator)
          );
    }
-#endif
    return;
 }
 
+#define __VARR_SIMD_KERNELS__ "varr_exp.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
 VARRExpDEvaluator
 shifting_linear_sampling_expd(
    size_t number_of_samples
@@ -2069,12 +2333,108 @@ shifting_linear_sampling_expd(
       result;
    SamplingExpDAccelerator * const
       accelerator = shifting_linear_sampling_expd_allocate(
-         number_of_samples
+         number_of_samples,
+         __varr_table_format().layout,
+         __varr_table_format().precision
          );
    result.accelerator = (void *) accelerator;
    result.expd = shifting_linear_sampling_expd_evaluate;
-   result.expd_array = shifting_linear_sampling_expd_batch_evaluate;
+   result.expd_array =
+      __varr_simd_select(shifting_linear_sampling_expd_batch_evaluate);
    result.disallocate = shifting_linear_sampling_expd_disallocate;
    return
       result;
 }
+
+VARRExpDEvaluator
+scaling_series_expd(
+   size_t number_of_samples
+   )
+{
+   VARRExpDEvaluator
+      result;
+   ScalingExpDAccelerator * const
+      accelerator = scaling_series_expd_allocate(number_of_samples);
+   result.accelerator = (void *) accelerator;
+   result.expd = scaling_series_expd_evaluate;
+   result.expd_array =
+      __varr_simd_select(scaling_series_expd_batch_evaluate);
+   result.disallocate = scaling_series_expd_disallocate;
+   return
+      result;
+}
+
+VARRExpFEvaluator
+linear_sampling_expf(
+   size_t number_of_samples
+   )
+{
+   VARRExpFEvaluator
+      result;
+   SamplingExpFAccelerator * const
+      accelerator = linear_sampling_expf_allocate(number_of_samples);
+   result.accelerator = (void *) accelerator;
+   result.expf = linear_sampling_expf_evaluate;
+   result.expf_array =
+      __varr_simd_select(linear_sampling_expf_batch_evaluate);
+   result.disallocate = linear_sampling_expf_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__):
+ */
+
+static
+void
+measure_shifting_linear_sampling_expd(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingExpDAccelerator));
+   __varr_measure_shared_sample_table(
+      number_of_samples + 2u,
+      1u,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_scaling_series_expd(size_t number_of_samples)
+{
+   __varr_allocation_measure(
+      sizeof(uint64_t)
+    * ((size_t) 1u << scaling_series_expd_log2_samples(number_of_samples))
+      );
+   __varr_allocation_measure(sizeof(ScalingExpDAccelerator));
+}
+
+static
+void
+measure_linear_sampling_expf(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingExpFAccelerator));
+   __varr_measure_shared_float_table(number_of_samples + 2u, 1u);
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRExpDEvaluator,
+   shifting_linear_sampling_expd
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRExpDEvaluator,
+   shifting_linear_sampling_expd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRExpDEvaluator,
+   scaling_series_expd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRExpFEvaluator,
+   linear_sampling_expf
+   )
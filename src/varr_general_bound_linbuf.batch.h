@@ -0,0 +1,105 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_general_bound_linbuf.c.  This file is included
+ * by varr_general_bound_linbuf.c (through varr_simd_instantiate.h) once per
+ * SIMD target, see varr_simd_target.h.
+ */
+
+/*
+ * Sorted inputs, eg. a monotone grid, are interpolated from a contiguous
+ * window of the table, see _avxd_stride_interpolate_window:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(evaluate_stride)(
+   register avxd_array_t x,
+   VARRBoundGLBEvaluator const * const accelerator
+   )
+{
+   register avxd_array_t const
+      avxd_lower_limit = _avxd_stride_set_duplicates(accelerator->start_x),
+      avxd_upper_limit = _avxd_stride_set_duplicates(accelerator->end_x),
+      avxd_normalization =
+         _avxd_stride_set_duplicates(accelerator->normalization);
+   x = _avxd_stride_max(x, avxd_lower_limit);
+   x = _avxd_stride_min(x, avxd_upper_limit);
+   x = (x - avxd_lower_limit) * avxd_normalization;
+   return
+      _avxd_stride_interpolate_window(
+         &accelerator->table,
+         _avxd_stride_index(x),
+         x - _avxd_stride_floor(x)
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(batch_evaluate, __x, out, length, __accelerator);
+   VARRBoundGLBEvaluator const * const
+      accelerator =
+         ((VARRBoundGLBEvaluator const *) __accelerator);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         out,
+         __VARR_SIMD_NAME(evaluate_stride)(
+            _avxd_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(evaluate_stride)(
+            _avxd_stride_load_partial(
+               __x,
+               lanes,
+               _avxd_stride_set_duplicates(accelerator->start_x)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
@@ -19,12 +19,50 @@
  */
 
 #include "varr_general_bound_linbuf.h"
+#include "varr_thread_pool.h"
 #include "varr_internal.h"
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <math.h>
 #include <inttypes.h>
 
+/*
+ * The samples of the table of a lazy linbuf (see lazy_bound_general_linbuf)
+ * are filled in blocks of a page (of doubles): block b holds the samples 
+ * [b * __VARR_LINBUF_BLOCK__, (b + 1) * __VARR_LINBUF_BLOCK__).  The first 
+ * thread to claim a block (changing its 'state' from __VARR_BLOCK_EMPTY__ to
+ * __VARR_BLOCK_FILLING__) evaluates the delegate for its samples, and any 
+ * other waits for it on 'filled'.  Blocks that are filled are read without 
+ * locking.
+ */
+#define __VARR_LINBUF_BLOCK__ ((size_t) 512u)
+
+#define __VARR_BLOCK_EMPTY__ ((unsigned char) 0u)
+#define __VARR_BLOCK_FILLING__ ((unsigned char) 1u)
+#define __VARR_BLOCK_FILLED__ ((unsigned char) 2u)
+
+typedef struct tagVARRLinbufBlocks
+{
+   unsigned char *
+      state;
+   double *
+      values;
+   size_t
+      number_of_values,
+      number_of_blocks;
+   pthread_mutex_t
+      mutex;
+   pthread_cond_t
+      filled;
+   void (* batch) (
+      double const *,
+      double *,
+      size_t,
+      void const *
+      );
+} VARRLinbufBlocks;
+
 typedef struct tagVARRBoundGLBEvaluator
 {
    double
@@ -39,13 +77,114 @@ typedef struct tagVARRBoundGLBEvaluator
       normalization;
    size_t
       samples;
-   double const *
-      linbuf_values;
+   VARRSampleTable
+      table;
    double (* delegate) (double, void *);
    void *
       delegate_argument;
+   VARRLinbufBlocks *
+      blocks;                             // NULL unless lazy
 } VARRBoundGLBEvaluator;
 
+/*
+ * Fills block b of the table of 'accelerator', or waits for the thread that
+ * claimed it to, at the same sampling points as __varr_sample_grid:
+ */
+static
+void
+fill_block(
+   VARRBoundGLBEvaluator const * const accelerator,
+   size_t b
+   )
+{
+   register VARRLinbufBlocks * const
+      blocks = accelerator->blocks;
+   unsigned char
+      expected = __VARR_BLOCK_EMPTY__;
+   if(
+      __atomic_compare_exchange_n(
+         blocks->state + b,
+         &expected,
+         __VARR_BLOCK_FILLING__,
+         0,
+         __ATOMIC_ACQUIRE,
+         __ATOMIC_ACQUIRE
+         )
+      )
+   {
+      register size_t const
+         end = (blocks->number_of_values - b * __VARR_LINBUF_BLOCK__ >
+               __VARR_LINBUF_BLOCK__) ?
+            (b + (size_t) 1u) * __VARR_LINBUF_BLOCK__
+            :
+            blocks->number_of_values;
+      // Evaluators the delegate constructs are not of the allocator (if 
+      // any) of the construction in progress in this thread:
+      void * const
+         construction = __varr_suspend_allocation();
+      for(register size_t i = b * __VARR_LINBUF_BLOCK__; i< end; ++i)
+      {
+         blocks->values[i] = accelerator->delegate(
+            accelerator->start_x + accelerator->step_x * (double) i,
+            accelerator->delegate_argument
+            );
+      }
+      __varr_resume_allocation(construction);
+      __atomic_store_n(
+         blocks->state + b, __VARR_BLOCK_FILLED__, __ATOMIC_RELEASE
+         );
+      pthread_mutex_lock(&blocks->mutex);
+      pthread_cond_broadcast(&blocks->filled);
+      pthread_mutex_unlock(&blocks->mutex);
+      return;
+   }
+   pthread_mutex_lock(&blocks->mutex);
+   while(
+      __atomic_load_n(blocks->state + b, __ATOMIC_ACQUIRE) 
+   != __VARR_BLOCK_FILLED__
+      )
+   {
+      pthread_cond_wait(&blocks->filled, &blocks->mutex);
+   }
+   pthread_mutex_unlock(&blocks->mutex);
+}
+
+/*
+ * Ensures that the samples interpolated at x (clamped to the domain) are 
+ * filled:
+ */
+static inline
+void
+fill_samples_of(
+   register double x,
+   VARRBoundGLBEvaluator const * const accelerator
+   )
+{
+   x = fmin(fmax(x, accelerator->start_x), accelerator->end_x);
+   register size_t const
+      index = (size_t) (
+         (x - accelerator->start_x) * accelerator->normalization
+         ),
+      first = index / __VARR_LINBUF_BLOCK__,
+      last = (index + (size_t) 1u) / __VARR_LINBUF_BLOCK__;
+   register unsigned char * const
+      state = accelerator->blocks->state;
+   if(
+      __atomic_load_n(state + first, __ATOMIC_ACQUIRE) 
+   != __VARR_BLOCK_FILLED__
+      )
+   {
+      fill_block(accelerator, first);
+   }
+   if(
+      __atomic_load_n(state + last, __ATOMIC_ACQUIRE) 
+   != __VARR_BLOCK_FILLED__
+      )
+   {
+      fill_block(accelerator, last);
+   }
+}
+
 static
 int
 disallocate_evaluator(
@@ -60,9 +199,15 @@ disallocate_evaluator(
    static double const
       __none = 0x7F800001;
    
-   if(accelerator->linbuf_values)
+   __varr_free_sample_table(&accelerator->table);
+   
+   if(accelerator->blocks != NULL)
    {
-      free((void *) accelerator->linbuf_values);
+      pthread_cond_destroy(&accelerator->blocks->filled);
+      pthread_mutex_destroy(&accelerator->blocks->mutex);
+      free(accelerator->blocks->state);
+      free(accelerator->blocks);
+      accelerator->blocks = NULL;
    }
    
    accelerator->start_x = __none;
@@ -80,11 +225,10 @@ disallocate_evaluator(
    accelerator->normalization = __none;
    
    accelerator->samples = (size_t) 0;
-   accelerator->linbuf_values = NULL;
    accelerator->delegate = NULL;
    accelerator->delegate_argument = NULL;
    
-   free(accelerator);
+   __varr_free(accelerator);
    
    return 0;
 }
@@ -115,37 +259,52 @@ allocate(
    double min_x,
    double max_x,
    double (* delegate) (double x, void *),
-   void * delegate_argument
+   void * delegate_argument,
+   VARRTableLayout layout,
+   VARRTablePrecision precision,
+   int lazy
    )
 {
    double const
       interval_size = (max_x - min_x),
       step_size =
          interval_size / (double) (number_of_samples - (size_t) 1u);
-   double * const
-      linbuf_values =
-         (double *)
-         malloc(
-            sizeof(double) * (number_of_samples + 2u)
+   size_t const
+      number_of_values = number_of_samples + 2u;
+   /*
+    * The delegate is called serially unless selected, see 
+    * varr_thread_pool.h, and evaluators it constructs are of the heap, not 
+    * of the allocator (if any) of this linbuf:
+    */
+   void * const
+      construction = __varr_suspend_allocation();
+   double *
+      linbuf_values = lazy ?
+         NULL
+         :
+         __varr_sample_grid_on(
+            varr_linbuf_construction_threads(),
+            delegate,
+            delegate_argument,
+            min_x,
+            step_size,
+            number_of_values
             );
-   for(
-      size_t i = (size_t) 0;
-      i< (number_of_samples + 2u);
-      ++i
-      )
+   __varr_resume_allocation(construction);
+   if(!lazy && (linbuf_values == NULL))
    {
-      double const
-         x = min_x + step_size * (double) i,
-         value = delegate(x, delegate_argument);
-      linbuf_values[i] = value;
-      
-      continue;
+      return NULL;
    }
    
    VARRBoundGLBEvaluator * const
-      result = (VARRBoundGLBEvaluator *) malloc(
-         sizeof(VARRBoundGLBEvaluator)
+      result = (VARRBoundGLBEvaluator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(VARRBoundGLBEvaluator)
          );
+   if(result == NULL)
+   {
+      free(linbuf_values);
+      return NULL;
+   }
    
    result->start_x = min_x;
    result->end_x = max_x;
@@ -156,15 +315,96 @@ allocate(
    result->interval_length = (max_x - min_x);
    result->interval_length_inv = 1./result->interval_length;
    
-   result->f_min_x = delegate(min_x, delegate_argument);
-   result->f_max_x = delegate(max_x, delegate_argument);
-   
    result->normalization = result->step_x_inverse;
    
    result->samples = number_of_samples,
-   result->linbuf_values = linbuf_values;
    result->delegate = delegate;
    result->delegate_argument = delegate_argument;
+   result->blocks = NULL;
+   if(lazy)
+   {
+      /*
+       * The samples are filled in place, as doubles, and the pages of blocks
+       * that are never filled need not be committed:
+       */
+      VARRLinbufBlocks * const
+         blocks = (VARRLinbufBlocks *) malloc(sizeof(VARRLinbufBlocks));
+      if(blocks == NULL)
+      {
+         __varr_free(result);
+         return NULL;
+      }
+      blocks->values = (double *) __varr_table_allocate(
+         sizeof(double) * number_of_values
+         );
+      blocks->number_of_values = number_of_values;
+      blocks->number_of_blocks = 
+         (number_of_values + __VARR_LINBUF_BLOCK__ - (size_t) 1u)
+       / __VARR_LINBUF_BLOCK__;
+      blocks->state = (unsigned char *) calloc(
+         blocks->number_of_blocks, sizeof(unsigned char)
+         );
+      if((blocks->values == NULL) || (blocks->state == NULL))
+      {
+         __varr_table_free(blocks->values);
+         free(blocks->state);
+         free(blocks);
+         __varr_free(result);
+         return NULL;
+      }
+      pthread_mutex_init(&blocks->mutex, NULL);
+      pthread_cond_init(&blocks->filled, NULL);
+      result->blocks = blocks;
+      result->table = (VARRSampleTable) {
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE,
+         .width = (size_t) 1u,
+         .values = blocks->values,
+         .floats = NULL,
+         .corrections = NULL,
+         .correction_scale = 0.,
+         .shared = NULL
+      };
+      fill_samples_of(min_x, result);
+      fill_samples_of(max_x, result);
+   }
+   else
+   {
+      result->table = __varr_sample_table(
+         linbuf_values, number_of_values, 1u, layout, precision
+         );
+      if(
+         (precision == VARR_TABLE_DOUBLE) ?
+            (result->table.values == NULL)
+            :
+            (
+               (result->table.floats == NULL)
+               || (
+                  (precision == VARR_TABLE_FLOAT_CORRECTED)
+                  && (result->table.corrections == NULL)
+                  )
+               )
+         )
+      {
+         disallocate_evaluator(result);
+         return NULL;
+      }
+   }
+   
+   /*
+    * The values at the endpoints are read back from the table, as the batch
+    * evaluators clamp x and interpolate, rather than taken from the delegate;
+    * the two only differ if the table is stored in single precision:
+    */
+   
+   register double const
+      normalized_max_x = (max_x - min_x) * result->normalization;
+   result->f_min_x = __varr_interpolate(&result->table, (size_t) 0u, 0.);
+   result->f_max_x = __varr_interpolate(
+      &result->table,
+      (size_t) floor(normalized_max_x),
+      normalized_max_x - floor(normalized_max_x)
+      );
    
    return
       result;
@@ -192,12 +432,14 @@ evaluate_delegate(
          (x - accelerator->start_x) * accelerator->normalization;
    register int64_t
       index = (int64_t) floor(normalized_x);
-   register double const * restrict
-      value = (accelerator->linbuf_values + index);
    register double
       alpha = (normalized_x - index);
    return
-      (*value * (1.0 - alpha) + value[1] * alpha);
+      __varr_interpolate(
+         &accelerator->table,
+         (size_t) index,
+         alpha
+         );
 }
 
 static
@@ -216,7 +458,7 @@ evaluate_scalar(
 
 static
 void
-batch_evaluate(
+batch_evaluate_scalar(
    register double const * __x,
    register double * out,
    register size_t length,
@@ -226,7 +468,6 @@ batch_evaluate(
    VARRBoundGLBEvaluator const * const
       accelerator =
          ((VARRBoundGLBEvaluator const *) __accelerator);
-#ifndef __VARR_HAS_AVX__
    for(
       register size_t i = (size_t) 0u;
       i< length;
@@ -242,126 +483,55 @@ batch_evaluate(
    }
    
    return;
-#else
-   register double const * const
-      linbuf_values =
-         ((VARRBoundGLBEvaluator const *) __accelerator)->linbuf_values;
-   register size_t const
-      length_axv_stride = length / __AVX_DOUBLE_STRIDE__;
-   double __attribute__((aligned(128)))
-      alignment_emulator[__AVX_DOUBLE_STRIDE__];
-   avxd_array_t
-      alpha,
-      __linbuf_values1,
-      __linbuf_values2,
-    * const target = (avxd_array_t *) alignment_emulator;
-   avxd_array_t
-      __one = _avxd_stride_set_duplicates(1.0),
-      avxd_lower_limit = _avxd_stride_set_duplicates(accelerator->start_x),
-      avxd_upper_limit = _avxd_stride_set_duplicates(accelerator->end_x),
-      avxd_normalization =
-         _avxd_stride_set_duplicates(accelerator->normalization);
-#ifndef __INTEL_COMPILER
-   register
-#endif
-   int64_t
-      index_avx[__AVX_DOUBLE_STRIDE__];
-   for(
-      register size_t i = (size_t) 0u;
-      i< length_axv_stride;
-      ++i
-      )
-   {
-      alignment_emulator[0u] = __x[0u];
-      alignment_emulator[1u] = __x[1u];
-      alignment_emulator[2u] = __x[2u];
-      alignment_emulator[3u] = __x[3u];
-#ifdef __VARR_USE_AVX512__
-      alignment_emulator[4u] = __x[4u];
-      alignment_emulator[5u] = __x[5u];
-      alignment_emulator[6u] = __x[6u];
-      alignment_emulator[7u] = __x[7u];
-#endif
-      *target = _avxd_stride_max(*target, avxd_lower_limit);
-      *target = _avxd_stride_min(*target, avxd_upper_limit);
-      *target -= avxd_lower_limit;
-      *target *= avxd_normalization;
-      alpha = (*target - _avxd_stride_floor(*target));
-      index_avx[0u] = (int64_t) alignment_emulator[0u];
-      index_avx[1u] = (int64_t) alignment_emulator[1u];
-      index_avx[2u] = (int64_t) alignment_emulator[2u];
-      index_avx[3u] = (int64_t) alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = (int64_t) alignment_emulator[4u];
-      index_avx[5u] = (int64_t) alignment_emulator[5u];
-      index_avx[6u] = (int64_t) alignment_emulator[6u];
-      index_avx[7u] = (int64_t) alignment_emulator[7u];
-#endif
-      __linbuf_values1 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         linbuf_values[index_avx[7u]++],
-         linbuf_values[index_avx[6u]++],
-         linbuf_values[index_avx[5u]++],
-         linbuf_values[index_avx[4u]++],
-#endif
-         linbuf_values[index_avx[3u]++],
-         linbuf_values[index_avx[2u]++],
-         linbuf_values[index_avx[1u]++],
-         linbuf_values[index_avx[0u]++]
-         );
-      __linbuf_values2 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         linbuf_values[index_avx[7u]],
-         linbuf_values[index_avx[6u]],
-         linbuf_values[index_avx[5u]],
-         linbuf_values[index_avx[4u]],
-#endif
-         linbuf_values[index_avx[3u]],
-         linbuf_values[index_avx[2u]],
-         linbuf_values[index_avx[1u]],
-         linbuf_values[index_avx[0u]]
+}
+
+/*
+ * The evaluators of lazy linbufs fill the samples of their arguments, and 
+ * interpolate as above:
+ */
+static
+double
+lazy_evaluate_scalar(
+   register double x,
+   register void const * restrict accelerator
+   )
+{
+   fill_samples_of(x, (VARRBoundGLBEvaluator const *) accelerator);
+   return
+      evaluate_delegate(
+         x,
+         (VARRBoundGLBEvaluator const * const) accelerator
          );
-      *target = __linbuf_values2 * alpha;
-      alpha = (__one - alpha);
-      *target = (*target + __linbuf_values1 * alpha);
-      out[0u] = alignment_emulator[0u];
-      out[1u] = alignment_emulator[1u];
-      out[2u] = alignment_emulator[2u];
-      out[3u] = alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      out[4u] = alignment_emulator[4u];
-      out[5u] = alignment_emulator[5u];
-      out[6u] = alignment_emulator[6u];
-      out[7u] = alignment_emulator[7u];
-#endif
-      __x += __AVX_DOUBLE_STRIDE__;
-      out += __AVX_DOUBLE_STRIDE__;
-      continue;
-   }
-   
-   //
-   // Remainder loop:
-   //
-   
+}
+
+static
+void
+lazy_batch_evaluate(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   VARRBoundGLBEvaluator const * const
+      accelerator =
+         ((VARRBoundGLBEvaluator const *) __accelerator);
    for(
-      register size_t i =
-         (length_axv_stride * __AVX_DOUBLE_STRIDE__);
+      register size_t i = (size_t) 0u;
       i< length;
       ++i
       )
    {
-      *out++ = evaluate_delegate(
-         *__x++,
-         accelerator
-         );
-      
-      continue;
+      fill_samples_of(__x[i], accelerator);
    }
-   
+   accelerator->blocks->batch(__x, out, length, accelerator);
    return;
-#endif
 }
 
+#define __VARR_SIMD_KERNELS__ "varr_general_bound_linbuf.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
 VARRBoundGLBAccelerator
 bound_general_linbuf(
    size_t number_of_samples,
@@ -380,12 +550,164 @@ bound_general_linbuf(
             min_x,
             max_x,
             delegate,
-            delegate_argument
+            delegate_argument,
+            __varr_table_format().layout,
+            __varr_table_format().precision,
+            0
             );
    result.accelerator = (void *) evaluator;
    result.scalar = evaluate_scalar;
-   result.batch = batch_evaluate;
+   result.batch = __varr_simd_select(batch_evaluate);
    result.disallocate = disallocate;
    return
       result;
 }
+
+VARRBoundGLBAccelerator
+bound_general_linbuf_with_table_format(
+   size_t number_of_samples,
+   double min_x,
+   double max_x,
+   double (* delegate) (double, void *),
+   void * delegate_argument,
+   VARRTableFormat format
+   )
+{
+   VARRTableFormat const
+      previous = __varr_select_table_format(format);
+   VARRBoundGLBAccelerator const
+      result = bound_general_linbuf(
+         number_of_samples, min_x, max_x, delegate, delegate_argument
+         );
+   __varr_select_table_format(previous);
+   return
+      result;
+}
+
+void
+__varr_measure_bound_general_linbuf(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(VARRBoundGLBEvaluator));
+   __varr_measure_sample_table(
+      number_of_samples + 2u,
+      (size_t) 1u,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+VARRBoundGLBAccelerator
+lazy_bound_general_linbuf(
+   size_t number_of_samples,
+   double min_x,
+   double max_x,
+   double (* delegate) (double, void *),
+   void * delegate_argument
+   )
+{
+   VARRBoundGLBAccelerator
+      result;
+   VARRBoundGLBEvaluator * const
+      evaluator =
+         allocate(
+            number_of_samples,
+            min_x,
+            max_x,
+            delegate,
+            delegate_argument,
+            VARR_TABLE_VALUES,
+            VARR_TABLE_DOUBLE,
+            1
+            );
+   if(evaluator != NULL)
+   {
+      evaluator->blocks->batch = __varr_simd_select(batch_evaluate);
+   }
+   result.accelerator = (void *) evaluator;
+   result.scalar = lazy_evaluate_scalar;
+   result.batch = lazy_batch_evaluate;
+   result.disallocate = disallocate;
+   return
+      result;
+}
+
+/*
+ * The blocks [first, first + count) of the table of 'accelerator', which are
+ * filled by varr_prefetch_linbuf:
+ */
+typedef struct tagVARRLinbufPrefetch
+{
+   VARRBoundGLBEvaluator const *
+      accelerator;
+   size_t
+      first;
+} VARRLinbufPrefetch;
+
+static
+void
+prefetch_blocks(size_t begin, size_t end, void const * argument)
+{
+   register VARRLinbufPrefetch const * const
+      prefetch = (VARRLinbufPrefetch const *) argument;
+   for(
+      register size_t b = prefetch->first + begin;
+      b< prefetch->first + end;
+      ++b
+      )
+   {
+      if(
+         __atomic_load_n(
+            prefetch->accelerator->blocks->state + b, __ATOMIC_ACQUIRE
+            )
+      != __VARR_BLOCK_FILLED__
+         )
+      {
+         fill_block(prefetch->accelerator, b);
+      }
+   }
+}
+
+int
+varr_prefetch_linbuf(
+   VARRBoundGLBAccelerator const * linbuf,
+   double from_x,
+   double to_x
+   )
+{
+   if((linbuf == NULL) || (linbuf->accelerator == NULL))
+   {
+      return 1;
+   }
+   VARRBoundGLBEvaluator const * const
+      accelerator = (VARRBoundGLBEvaluator const *) linbuf->accelerator;
+   if(accelerator->blocks == NULL)
+   {
+      return 0;
+   }
+   from_x = fmin(fmax(from_x, accelerator->start_x), accelerator->end_x);
+   to_x = fmin(fmax(to_x, accelerator->start_x), accelerator->end_x);
+   if(!(from_x <= to_x))
+   {
+      return 0;
+   }
+   VARRLinbufPrefetch const
+      prefetch = {
+         .accelerator = accelerator,
+         .first = (size_t) (
+            (from_x - accelerator->start_x) * accelerator->normalization
+            ) / __VARR_LINBUF_BLOCK__
+      };
+   register size_t const
+      last = ((size_t) (
+         (to_x - accelerator->start_x) * accelerator->normalization
+         ) + (size_t) 1u) / __VARR_LINBUF_BLOCK__;
+   // The blocks are filled on the threads selected for linbufs:
+   __varr_parallel_for(
+      varr_linbuf_construction_threads(),
+      last + (size_t) 1u - prefetch.first,
+      (size_t) 1u,
+      prefetch_blocks,
+      &prefetch
+      );
+   return 0;
+}
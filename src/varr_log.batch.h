@@ -0,0 +1,432 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_log.c.  This file is included by varr_log.c
+ * (through varr_simd_instantiate.h) twice per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+/*
+ * log(x) = k * log(2) + log(m), for x = m * 2**k and sqrt(1/2) <= m < sqrt(2),
+ * where k and m are read from the exponent and mantissa fields of x.  Sorted
+ * inputs share an exponent over long runs, in which log(m) is interpolated
+ * from a contiguous window of the table:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(linear_sampling_normalizing_logd_stride)(
+   register avxd_array_t x,
+   VARRSampleTable const * const table,
+   register avxd_array_t const start_x,
+   register avxd_array_t const step_x_inv
+   )
+{
+   register avxl_array_t const
+      bits = _avxd_stride_centred_bits(x);
+   register avxd_array_t const
+      exponent = _avxl_stride_centred_exponent(bits);
+   register avxd_array_t
+      alpha = (_avxl_stride_centred_mantissa(bits) - start_x) * step_x_inv;
+   register avxi_array_t const
+      index = _avxd_stride_index(alpha);
+   alpha -= _avxd_stride_floor(alpha);
+   x = _avxd_stride_interpolate_window(table, index, alpha);
+   return
+      _avxd_stride_fmadd(
+         exponent,
+         _avxd_stride_set_duplicates(__log2_high),
+         _avxd_stride_fmadd(
+            exponent,
+            _avxd_stride_set_duplicates(__log2_low),
+            x
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_sampling_normalizing_logd_batch_evaluate)(
+   register double const * x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      linear_sampling_normalizing_logd_batch_evaluate,
+      x,
+      out,
+      length,
+      __accelerator
+      );
+   register double const
+      * __x = x;
+   register double
+      * __out = out;
+   register SamplingLogDAccelerator const * const
+      accelerator = ((SamplingLogDAccelerator const *) __accelerator);
+   VARRSampleTable const * const
+      table = &accelerator->table;
+   register avxd_array_t const
+      start_x = _avxd_stride_set_duplicates(accelerator->start_x),
+      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inv);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         __out,
+         __VARR_SIMD_NAME(linear_sampling_normalizing_logd_stride)(
+            _avxd_stride_load(__x), table, start_x, step_x_inv
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      __out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         __out,
+         lanes,
+         __VARR_SIMD_NAME(linear_sampling_normalizing_logd_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(1.)
+               ),
+            table,
+            start_x,
+            step_x_inv
+            )
+         );
+   }
+   return;
+}
+
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(sublinear_sampling_normalizing_logd_stride)(
+   register avxd_array_t x,
+   register double const * const values,
+   register avxd_array_t const start_x,
+   register avxd_array_t const step_x_inv
+   )
+{
+   register avxl_array_t const
+      bits = _avxd_stride_centred_bits(x);
+   register avxd_array_t const
+      exponent = _avxl_stride_centred_exponent(bits);
+   x = _avxd_stride_gather(
+      values,
+      _avxi_stride_add(
+         _avxd_stride_index(
+            (_avxl_stride_centred_mantissa(bits) - start_x) * step_x_inv
+            ),
+         _avxi_stride_set_duplicates(1)
+         )
+      );
+   return
+      _avxd_stride_fmadd(
+         exponent,
+         _avxd_stride_set_duplicates(__log2_high),
+         _avxd_stride_fmadd(
+            exponent,
+            _avxd_stride_set_duplicates(__log2_low),
+            x
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sublinear_sampling_normalizing_logd_batch_evaluate)(
+   register double const * x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      sublinear_sampling_normalizing_logd_batch_evaluate,
+      x,
+      out,
+      length,
+      __accelerator
+      );
+   register double const
+      * __x = x;
+   register double
+      * __out = out;
+   register SamplingLogDAccelerator const * const
+      accelerator = ((SamplingLogDAccelerator const *) __accelerator);
+   register double const * const
+      values = accelerator->table.values;
+   register avxd_array_t const
+      start_x = _avxd_stride_set_duplicates(accelerator->start_x),
+      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inv);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         __out,
+         __VARR_SIMD_NAME(sublinear_sampling_normalizing_logd_stride)(
+            _avxd_stride_load(__x), values, start_x, step_x_inv
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      __out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         __out,
+         lanes,
+         __VARR_SIMD_NAME(sublinear_sampling_normalizing_logd_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(1.)
+               ),
+            values,
+            start_x,
+            step_x_inv
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * log(x) = k * log(2) + log(m), for x = m * 2**k and sqrt(1/2) <= m < sqrt(2),
+ * where k and m are read from the exponent and mantissa fields of x.  The
+ * series in z = (m - 1)**2/(m + 1)**2 is evaluated by Estrin's scheme in pairs
+ * of terms, (c[2j] + c[2j + 1] z), themselves combined by Horner's scheme in
+ * z**2:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(quad_series_logd_stride)(
+   register avxd_array_t x,
+   register size_t const number_of_terms
+   )
+{
+   register avxd_array_t const
+      __one = _avxd_stride_set_duplicates(1.);
+   register avxl_array_t const
+      bits = _avxd_stride_centred_bits(x);
+   register avxd_array_t const
+      k = _avxl_stride_centred_exponent(bits);
+   x = _avxl_stride_centred_mantissa(bits);
+   register avxd_array_t const
+      y = (x - __one) / (x + __one),
+      z = y * y,
+      z2 = z * z;
+   register size_t
+      i = number_of_terms;
+   register avxd_array_t
+      series = _avxd_stride_set_duplicates((i & 1u) ? __constants[--i] : 0.);
+   for(; i; i -= 2u)
+   {
+      series = _avxd_stride_fmadd(
+         series,
+         z2,
+         _avxd_stride_fmadd(
+            _avxd_stride_set_duplicates(__constants[i - 1u]),
+            z,
+            _avxd_stride_set_duplicates(__constants[i - 2u])
+            )
+         );
+   }
+   return
+      _avxd_stride_fmadd(
+         k,
+         _avxd_stride_set_duplicates(__log2_high),
+         _avxd_stride_fmadd(
+            k,
+            _avxd_stride_set_duplicates(__log2_low),
+            y * series
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(quad_series_logd_batch_evaluate)(
+   register double const * x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      quad_series_logd_batch_evaluate, x, out, length, __accelerator
+      );
+   register double const
+      * __x = x;
+   register double
+      * __out = out;
+   register size_t const
+      number_of_terms = (size_t) (ptrdiff_t) __accelerator;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         __out,
+         __VARR_SIMD_NAME(quad_series_logd_stride)(
+            _avxd_stride_load(__x), number_of_terms
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      __out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         __out,
+         lanes,
+         __VARR_SIMD_NAME(quad_series_logd_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(1.)
+               ),
+            number_of_terms
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * As linear_sampling_normalizing_logd_stride, for floats:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxf_array_t
+__VARR_SIMD_NAME(linear_sampling_normalizing_logf_stride)(
+   register avxf_array_t x,
+   SamplingLogFAccelerator const * const accelerator
+   )
+{
+   register avxfi_array_t const
+      bits = _avxf_stride_centred_bits(x);
+   register avxf_array_t const
+      exponent = _avxfi_stride_centred_exponent(bits);
+   register avxf_array_t
+      alpha = _avxf_stride_min(
+         (
+            _avxfi_stride_centred_mantissa(bits)
+          - _avxf_stride_set_duplicates(accelerator->start_x)
+         ) * _avxf_stride_set_duplicates(accelerator->step_x_inv),
+         _avxf_stride_set_duplicates(accelerator->last_sample)
+         );
+   register avxfi_array_t const
+      index = _avxf_stride_index(alpha);
+   alpha -= _avxf_stride_floor(alpha);
+   return
+      _avxf_stride_fmadd(
+         exponent,
+         _avxf_stride_set_duplicates(__logf_log2_high),
+         _avxf_stride_fmadd(
+            exponent,
+            _avxf_stride_set_duplicates(__logf_log2_low),
+            _avxf_stride_interpolate(accelerator->table, index, alpha)
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_sampling_normalizing_logf_batch_evaluate)(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      linear_sampling_normalizing_logf_batch_evaluate,
+      __x,
+      out,
+      length,
+      __accelerator
+      );
+   register SamplingLogFAccelerator const * const
+      accelerator = (SamplingLogFAccelerator const *) __accelerator;
+   for(
+      ;
+      length >= __AVX_FLOAT_STRIDE__;
+      length -= __AVX_FLOAT_STRIDE__
+      )
+   {
+      _avxf_stride_store(
+         out,
+         __VARR_SIMD_NAME(linear_sampling_normalizing_logf_stride)(
+            _avxf_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_FLOAT_STRIDE__;
+      out += __AVX_FLOAT_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxf_lanes_t const
+         lanes = _avxf_stride_lanes(length);
+      _avxf_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(linear_sampling_normalizing_logf_stride)(
+            _avxf_stride_load_partial(
+               __x, lanes, _avxf_stride_set_duplicates(1.f)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
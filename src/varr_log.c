@@ -27,13 +27,13 @@
 
 typedef struct tagSamplingLogDAccelerator {
    double
-      start_x,                                        // Interval [1, 2]
+      start_x,                           // Interval [sqrt(1/2), sqrt(2)]
       step_x,
       step_x_inv;
    size_t
       samples;
-   double const *
-      values;
+   VARRSampleTable
+      table;
 } SamplingLogDAccelerator;
 
 static
@@ -46,13 +46,12 @@ __linear_sampling_normalizing_logd_disallocate(
    {
       return 1;
    }
-   free((void *) accelerator->values);
+   __varr_free_sample_table(&accelerator->table);
    accelerator->start_x = 0x7F800001;
    accelerator->step_x = 0x7F800001;
    accelerator->step_x_inv = 0x7F800001;
    accelerator->samples = (size_t) 0;
-   accelerator->values = NULL;
-   free(accelerator);
+   __varr_free(accelerator);
    return 0;
 }
 
@@ -73,249 +72,130 @@ linear_sampling_normalizing_logd_disallocate(
       __linear_sampling_normalizing_logd_disallocate(accelerator);
 }
 
+static
+double
+sampled_log(double x, void * argument)
+{
+   (void) argument;
+   return
+      log(x);
+}
+
+/*
+ * Returns the number_of_samples + 2 samples of log from sqrt(1/2), of the
+ * table of both normalizing sampling logarithms:
+ */
+static
+double *
+normalizing_sampling_logd_samples(size_t number_of_samples)
+{
+   double const
+      start_x = __varr_bits_double(__VARR_SQRT_HALF_BITS__),
+      step_size = start_x / (double) (number_of_samples - (size_t) 1u);
+   return
+      __varr_sample_grid(
+         sampled_log, NULL, start_x, step_size, number_of_samples + 2u
+         );
+}
+
 static
 SamplingLogDAccelerator *
 allocate_linear_sampling_normalizing_logd(
-   size_t number_of_samples
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
    )
 {
    double const
-      step_size = 1.0 / (double) (number_of_samples - (size_t) 1u);
-   double * const
-      values = (double *) 
-         malloc(sizeof(double) * (number_of_samples + 2u)
-         );
-   for(size_t i = (size_t) 0; i< (number_of_samples + 2u); ++i)
-   {
-      double const
-         x = 1.0 + step_size * (double) i,
-         value = log(x);
-      values[i] = value;
-      continue;
-   }
+      start_x = __varr_bits_double(__VARR_SQRT_HALF_BITS__),
+      step_size = start_x / (double) (number_of_samples - (size_t) 1u);
+   // The sublinear evaluator reads the same table (of values, as doubles):
+   VARRTableKey const
+      key = {
+         .function = "log",
+         .method = "normalizing sampling",
+         .number_of_samples = number_of_samples,
+         .layout = layout,
+         .precision = precision,
+         .lower = start_x,
+         .upper = 2.0 * start_x
+      };
    SamplingLogDAccelerator * const
-      result = (SamplingLogDAccelerator *) malloc(
-         sizeof(SamplingLogDAccelerator)
+      result = (SamplingLogDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingLogDAccelerator)
          );
-   result->start_x = 1.0;
+   result->start_x = start_x;
    result->step_x = step_size;
    result->step_x_inv = 1./step_size;
    result->samples = number_of_samples,
-   result->values = values;
+   result->table = __varr_shared_sample_table(
+      &key, normalizing_sampling_logd_samples, number_of_samples + 2u, 1u
+      );
    return
       result;
 }
 
-#ifdef __INTEL_COMPILER
-static const int
-   __log2_table[128] = {
-   0, 1, 59, 0, 0, 2, 60, 0, 48, 0, 54, 0, 0, 3, 61, 0, 0, 40, 49, 0, 28, 0, 
-   55, 0, 34, 0, 43, 0, 0, 4, 62, 0, 0, 52, 38, 0, 0, 41, 50, 0, 0, 19, 29, 
-   0, 0, 21, 56, 0, 0, 31, 35, 0, 0, 12, 44, 0, 15, 0, 23, 0, 0, 5, 63, 0, 58, 
-   0, 0, 47, 53, 0, 0, 39, 0, 27, 0, 33, 42, 0, 0, 51, 37, 0, 0, 18, 0, 20, 0, 
-   30, 0, 11, 0, 14, 22, 0, 0, 57, 46, 0, 0, 26, 32, 0, 0, 36, 17, 0, 0, 10, 
-   13, 0, 0, 45, 25, 0, 0, 16, 9, 0, 0, 24, 0, 8, 0, 7, 6, 0, 0
-   };
-#endif
-
-static const double
-   __log_2k[] = {
-                      0.0,
-   0.69314718055994528623,
-    1.3862943611198905725,
-    2.0794415416798357477,
-    2.7725887222397811449,
-    3.4657359027997265422,
-    4.1588830833596714953,
-    4.8520302639196168926,
-    5.5451774444795622898,
-    6.2383246250395076871,
-    6.9314718055994530843,
-    7.6246189861593984816,
-    8.3177661667193429906,
-    9.0109133472792883879,
-    9.7040605278392337851,
-    10.397207708399179182,
-     11.09035488895912458,
-    11.783502069519069977,
-    12.476649250079015374,
-    13.169796430638960771,
-    13.862943611198906169,
-    14.556090791758851566,
-    15.249237972318796963,
-     15.94238515287874236,
-    16.635532333438685981,
-    17.328679513998633155,
-    18.021826694558576776,
-    18.714973875118523949,
-     19.40812105567846757,
-    20.101268236238414744,
-    20.794415416798358365,
-    21.487562597358305538,
-    22.180709777918249159,
-    22.873856958478196333,
-    23.567004139038139954,
-    24.260151319598087127,
-    24.953298500158030748,
-    25.646445680717977922,
-    26.339592861277921543,
-    27.032740041837868716,
-    27.725887222397812337,
-    28.419034402957755958,
-    29.112181583517703132,
-    29.805328764077646753,
-    30.498475944637593926,
-    31.191623125197537547,
-    31.884770305757484721,
-    32.577917486317431894,
-    33.271064666877371963,
-    33.964211847437319136,
-     34.65735902799726631,
-    35.350506208557213483,
-    36.043653389117153552,
-    36.736800569677100725,
-    37.429947750237047899,
-    38.123094930796995072,
-    38.816242111356935141,
-    39.509389291916882314,
-    40.202536472476829488,
-    40.895683653036776661,
-     41.58883083359671673,
-    42.281978014156663903,
-    42.975125194716611077,
-    43.668272375276551145
-   };
-
-#include "varr_floor_log2.h"
-
-static inline
-void
-unity_reflection(double * const x)
-{
-   *x = ((*x >= 1.) ? *x : 1./ *x);
-}
-
-static inline
-void
-conditional_sign_mirror(
-   double const * const x,
-   double * const y
-   )
-{
-   *y = ((*x >= 1.) ? *y : -*y);
-}
+/*
+ * log(2), split (as in fdlibm) so that k * __log2_high is exact for every 
+ * exponent k of a double:
+ */
+static double const
+   __log2_high = 6.93147180369123816490e-01,
+   __log2_low = 1.90821492927058770002e-10;
 
+/*
+ * An exponential split log(x) = k * log(2) + log(m), for x = m * 2**k and 
+ * sqrt(1/2) <= m < sqrt(2), where k and m are read from the exponent and
+ * mantissa fields of x, combined with linear interpolation of log(m):
+ */
 static
 double
 linear_sampling_normalizing_logd_evaluate(
-   register double __x,
+   register double x,
    register void const * restrict __accelerator
    )
 {
-   register char const
-      do_invert = (__x < 1.0);
-   register double const 
-      x = (do_invert ? (1.0/__x) : __x);
-#ifdef __INTEL_COMPILER
-   /*
-    * An exponential split log(x) = log(x/2**k) + log(2**k),
-    * for the least integer k such that x < 2**k, combined with linear
-    * interpolation in the range pow([0-1], 1/6) and a modified De-Bruijn-
-    * like method.
-    */
-   register uint64_t
-      __pow2_gt = (uint64_t) x;
-   __pow2_gt |= __pow2_gt >> 1;
-   __pow2_gt |= __pow2_gt >> 2;
-   __pow2_gt |= __pow2_gt >> 4;
-   __pow2_gt |= __pow2_gt >> 8;
-   __pow2_gt |= __pow2_gt >> 16;
-   __pow2_gt |= __pow2_gt >> 32;
-   __pow2_gt >>= 1;
-   ++__pow2_gt;
-   register double const
-      normalized_x = (x / (double) __pow2_gt) - 1.0;
    register SamplingLogDAccelerator const * const
-      accelerator = (SamplingLogDAccelerator const *) 
-         __accelerator;
-   register double
-      step_frac = (normalized_x / accelerator->step_x);
-   register uint64_t const
-      index = (uint64_t) step_frac;
-   step_frac -= index;
-   step_frac =
-      accelerator->values[index] * (1. - step_frac)
-    + accelerator->values[index + (uint64_t) 1] * step_frac;
-   return
-      (1 - 2 * do_invert) *
-      (
-      step_frac
-    + __log_2k[
-         __log2_table[
-            ((__pow2_gt - (uint64_t) 1) * 285673954929480801ul) >> 57
-            ]
-         ]
-      );
-#else // assume GCC:
-   register unsigned const
-      __pow2_exponent = 63u - __builtin_clzl((uint64_t) x);
-   register uint64_t
-      __pow2_gt = ((uint64_t) 1) << __pow2_exponent;
+      accelerator = (SamplingLogDAccelerator const *) __accelerator;
+   double
+      mantissa;
    register double const
-      normalized_x = (x / (double) __pow2_gt) - 1.0;
+      exponent = __varr_centred_exponent_split(x, &mantissa);
    register double
-      step_frac = (
-         normalized_x / 
-            ((SamplingLogDAccelerator const *) __accelerator)->step_x
-         );
+      step_frac = (mantissa - accelerator->start_x) * accelerator->step_x_inv;
    register uint64_t const
       index = (uint64_t) step_frac;
    step_frac -= index;
-   register double const *
-      value = ((SamplingLogDAccelerator const *) __accelerator)->values + index;
-   step_frac =
-      (*value) * (1. - step_frac) + value[1] * step_frac;
+   step_frac = __varr_interpolate(&accelerator->table, index, step_frac);
    return
-      (1 - 2 * do_invert)
-    * (step_frac + __log_2k[__pow2_exponent]);
-#endif
+      exponent * __log2_high + (exponent * __log2_low + step_frac);
 }
 
 static
 double
 sublinear_sampling_normalizing_logd_evaluate(
-   register double __x,
+   register double x,
    register void const * restrict __accelerator
    )
 {
-   register char const
-      do_invert = (__x < 1.0);
-   register double const 
-      x = (do_invert ? (1.0/__x) : __x);
-   register unsigned const
-      __pow2_exponent = 63u - __builtin_clzl((uint64_t) x);
-   register uint64_t
-      __pow2_gt = ((uint64_t) 1) << __pow2_exponent;
+   register SamplingLogDAccelerator const * const
+      accelerator = (SamplingLogDAccelerator const *) __accelerator;
+   double
+      mantissa;
    register double const
-      normalized_x = (x / (double) __pow2_gt) - 1.0;
-   register double
-      step_frac = (
-         normalized_x / 
-            ((SamplingLogDAccelerator const *) __accelerator)->step_x
-         );
+      exponent = __varr_centred_exponent_split(x, &mantissa);
    register uint64_t const
-      index = (uint64_t) step_frac + 1u;
-   register double const *
-      value = ((SamplingLogDAccelerator const *) __accelerator)->values + index;
-   step_frac = *value;
+      index = (uint64_t) (
+         (mantissa - accelerator->start_x) * accelerator->step_x_inv
+         ) + 1u;
    return
-      (1 - 2 * do_invert)
-    * (step_frac + __log_2k[__pow2_exponent]);
+      exponent * __log2_high
+    + (exponent * __log2_low + accelerator->table.values[index]);
 }
 
 static
 void
-linear_sampling_normalizing_logd_batch_evaluate(
+linear_sampling_normalizing_logd_batch_evaluate_scalar(
    register double const * x,
    register double * out,
    register size_t length,
@@ -326,7 +206,6 @@ linear_sampling_normalizing_logd_batch_evaluate(
       * __x = x;
    register double
       * __out = out;
-#ifndef __VARR_HAS_AVX__
    for(
       register size_t i = (size_t) 0u;
       i< length;
@@ -338,173 +217,12 @@ linear_sampling_normalizing_logd_batch_evaluate(
          __accelerator
          );
    }
-#else
-   register SamplingLogDAccelerator const * const
-      accelerator = ((SamplingLogDAccelerator const *) __accelerator);
-   register double const * const
-      values = accelerator->values;
-   register size_t const
-      length_axv_stride = length / __AVX_DOUBLE_STRIDE__;
-   double __attribute__((aligned(128)))
-      alignment_emulator[__AVX_DOUBLE_STRIDE__];
-   // register avxd_array_t
-   avxd_array_t
-      alpha,
-      __values1,
-      __values2,
-      prefix,
-      modifier,
-    * const target = (avxd_array_t *) alignment_emulator;
-   avxd_array_t const
-      __one = _avxd_stride_set_duplicates(1.),
-      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inv);
-#ifndef __INTEL_COMPILER
-   register
-#endif
-   int64_t
-      index_avx[__AVX_DOUBLE_STRIDE__];
-   for(register size_t i = (size_t) 0u; i< length_axv_stride; ++i)
-   {
-      alignment_emulator[0u] = __x[0u];
-      alignment_emulator[1u] = __x[1u];
-      alignment_emulator[2u] = __x[2u];
-      alignment_emulator[3u] = __x[3u];
-#ifdef __VARR_USE_AVX512__
-      alignment_emulator[4u] = __x[4u];
-      alignment_emulator[5u] = __x[5u];
-      alignment_emulator[6u] = __x[6u];
-      alignment_emulator[7u] = __x[7u];
-#endif
-      unity_reflection(alignment_emulator + 0u);
-      unity_reflection(alignment_emulator + 1u);
-      unity_reflection(alignment_emulator + 2u);
-      unity_reflection(alignment_emulator + 3u);
-#ifdef __VARR_USE_AVX512__
-      unity_reflection(alignment_emulator + 4u);
-      unity_reflection(alignment_emulator + 5u);
-      unity_reflection(alignment_emulator + 6u);
-      unity_reflection(alignment_emulator + 7u);
-#endif
-      index_avx[0u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[0u]);
-      index_avx[1u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[1u]);
-      index_avx[2u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[2u]);
-      index_avx[3u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[3u]);
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[4u]);
-      index_avx[5u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[5u]);
-      index_avx[6u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[6u]);
-      index_avx[7u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[7u]);
-#endif
-      prefix = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __log_2k[index_avx[7u]],
-         __log_2k[index_avx[6u]],
-         __log_2k[index_avx[5u]],
-         __log_2k[index_avx[4u]],
-         
-#endif
-         __log_2k[index_avx[3u]],
-         __log_2k[index_avx[2u]],
-         __log_2k[index_avx[1u]],
-         __log_2k[index_avx[0u]]
-         );
-      modifier = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         ((uint64_t) 1) << index_avx[7u],
-         ((uint64_t) 1) << index_avx[6u],
-         ((uint64_t) 1) << index_avx[5u],
-         ((uint64_t) 1) << index_avx[4u],
-#endif
-         ((uint64_t) 1) << index_avx[3u],
-         ((uint64_t) 1) << index_avx[2u],
-         ((uint64_t) 1) << index_avx[1u],
-         ((uint64_t) 1) << index_avx[0u]
-         );
-      *target = (*target / modifier - __one) * step_x_inv;
-      index_avx[0u] = (int64_t) alignment_emulator[0u];
-      index_avx[1u] = (int64_t) alignment_emulator[1u];
-      index_avx[2u] = (int64_t) alignment_emulator[2u];
-      index_avx[3u] = (int64_t) alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = (int64_t) alignment_emulator[4u];
-      index_avx[5u] = (int64_t) alignment_emulator[5u];
-      index_avx[6u] = (int64_t) alignment_emulator[6u];
-      index_avx[7u] = (int64_t) alignment_emulator[7u];
-#endif
-      alpha = *target -  _avxd_stride_floor(*target);
-      __values1 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[index_avx[7u]++],
-         values[index_avx[6u]++],
-         values[index_avx[5u]++],
-         values[index_avx[4u]++],
-#endif
-         values[index_avx[3u]++],
-         values[index_avx[2u]++],
-         values[index_avx[1u]++],
-         values[index_avx[0u]++]
-         );
-      __values2 = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[index_avx[7u]],
-         values[index_avx[6u]],
-         values[index_avx[5u]],
-         values[index_avx[4u]],
-#endif
-         values[index_avx[3u]],
-         values[index_avx[2u]],
-         values[index_avx[1u]],
-         values[index_avx[0u]]
-         );
-      *target = __values2 * alpha;
-      alpha = (__one - alpha);
-      *target = (*target + __values1 * alpha);
-      *target = prefix + *target;
-      conditional_sign_mirror(__x + 0u, alignment_emulator + 0u);
-      conditional_sign_mirror(__x + 1u, alignment_emulator + 1u);
-      conditional_sign_mirror(__x + 2u, alignment_emulator + 2u);
-      conditional_sign_mirror(__x + 3u, alignment_emulator + 3u);
-#ifdef __VARR_USE_AVX512__
-      conditional_sign_mirror(__x + 4u, alignment_emulator + 4u);
-      conditional_sign_mirror(__x + 5u, alignment_emulator + 5u);
-      conditional_sign_mirror(__x + 6u, alignment_emulator + 6u);
-      conditional_sign_mirror(__x + 7u, alignment_emulator + 7u);
-#endif
-      __out[0u] = alignment_emulator[0u];
-      __out[1u] = alignment_emulator[1u];
-      __out[2u] = alignment_emulator[2u];
-      __out[3u] = alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      __out[4u] = alignment_emulator[4u];
-      __out[5u] = alignment_emulator[5u];
-      __out[6u] = alignment_emulator[6u];
-      __out[7u] = alignment_emulator[7u];
-#endif
-      __x += __AVX_DOUBLE_STRIDE__;
-      __out += __AVX_DOUBLE_STRIDE__;
-      continue;
-   }
-   
-   // Remainder loop:
-   
-   for(
-      register size_t i = length_axv_stride * __AVX_DOUBLE_STRIDE__;
-      i< length; 
-      ++i
-      )
-   {
-      *__out++ = linear_sampling_normalizing_logd_evaluate(
-         *__x++,
-         __accelerator
-         );
-   }
-#endif
    return;
 }
 
 static
 void
-sublinear_sampling_normalizing_logd_batch_evaluate(
+sublinear_sampling_normalizing_logd_batch_evaluate_scalar(
    register double const * x,
    register double * out,
    register size_t length,
@@ -515,7 +233,6 @@ sublinear_sampling_normalizing_logd_batch_evaluate(
       * __x = x;
    register double
       * __out = out;
-#ifndef __VARR_HAS_AVX__
    for(
       register size_t i = (size_t) 0u;
       i< length;
@@ -527,190 +244,9 @@ sublinear_sampling_normalizing_logd_batch_evaluate(
          __accelerator
          );
    }
-#else
-   register SamplingLogDAccelerator const * const
-      accelerator = ((SamplingLogDAccelerator const *) __accelerator);
-   register double const * const
-      values = accelerator->values;
-   register size_t const
-      length_axv_stride = length / __AVX_DOUBLE_STRIDE__;
-   double __attribute__((aligned(128)))
-      alignment_emulator[__AVX_DOUBLE_STRIDE__];
-   // register avxd_array_t
-   avxd_array_t
-      __value,
-      prefix,
-      modifier,
-    * const target = (avxd_array_t *) alignment_emulator;
-   avxd_array_t const
-      __one = _avxd_stride_set_duplicates(1.),
-      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inv);
-#ifndef __INTEL_COMPILER
-   register
-#endif
-   int64_t
-      index_avx[__AVX_DOUBLE_STRIDE__];
-   for(register size_t i = (size_t) 0u; i< length_axv_stride; ++i)
-   {
-      alignment_emulator[0u] = __x[0u];
-      alignment_emulator[1u] = __x[1u];
-      alignment_emulator[2u] = __x[2u];
-      alignment_emulator[3u] = __x[3u];
-#ifdef __VARR_USE_AVX512__
-      alignment_emulator[4u] = __x[4u];
-      alignment_emulator[5u] = __x[5u];
-      alignment_emulator[6u] = __x[6u];
-      alignment_emulator[7u] = __x[7u];
-#endif
-      unity_reflection(alignment_emulator + 0u);
-      unity_reflection(alignment_emulator + 1u);
-      unity_reflection(alignment_emulator + 2u);
-      unity_reflection(alignment_emulator + 3u);
-#ifdef __VARR_USE_AVX512__
-      unity_reflection(alignment_emulator + 4u);
-      unity_reflection(alignment_emulator + 5u);
-      unity_reflection(alignment_emulator + 6u);
-      unity_reflection(alignment_emulator + 7u);
-#endif
-      index_avx[0u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[0u]);
-      index_avx[1u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[1u]);
-      index_avx[2u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[2u]);
-      index_avx[3u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[3u]);
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[4u]);
-      index_avx[5u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[5u]);
-      index_avx[6u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[6u]);
-      index_avx[7u] = 63u - __builtin_clzl((uint64_t) alignment_emulator[7u]);
-#endif
-      prefix = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         __log_2k[index_avx[7u]],
-         __log_2k[index_avx[6u]],
-         __log_2k[index_avx[5u]],
-         __log_2k[index_avx[4u]],
-         
-#endif
-         __log_2k[index_avx[3u]],
-         __log_2k[index_avx[2u]],
-         __log_2k[index_avx[1u]],
-         __log_2k[index_avx[0u]]
-         );
-      modifier = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         ((uint64_t) 1) << index_avx[7u],
-         ((uint64_t) 1) << index_avx[6u],
-         ((uint64_t) 1) << index_avx[5u],
-         ((uint64_t) 1) << index_avx[4u],
-#endif
-         ((uint64_t) 1) << index_avx[3u],
-         ((uint64_t) 1) << index_avx[2u],
-         ((uint64_t) 1) << index_avx[1u],
-         ((uint64_t) 1) << index_avx[0u]
-         );
-      *target = (*target / modifier - __one) * step_x_inv;
-      index_avx[0u] = (int64_t) alignment_emulator[0u] + 1u;
-      index_avx[1u] = (int64_t) alignment_emulator[1u] + 1u;
-      index_avx[2u] = (int64_t) alignment_emulator[2u] + 1u;
-      index_avx[3u] = (int64_t) alignment_emulator[3u] + 1u;
-#ifdef __VARR_USE_AVX512__
-      index_avx[4u] = (int64_t) alignment_emulator[4u] + 1u;
-      index_avx[5u] = (int64_t) alignment_emulator[5u] + 1u;
-      index_avx[6u] = (int64_t) alignment_emulator[6u] + 1u;
-      index_avx[7u] = (int64_t) alignment_emulator[7u] + 1u;
-#endif
-      __value = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         values[index_avx[7u]],
-         values[index_avx[6u]],
-         values[index_avx[5u]],
-         values[index_avx[4u]],
-#endif
-         values[index_avx[3u]],
-         values[index_avx[2u]],
-         values[index_avx[1u]],
-         values[index_avx[0u]]
-         );
-      *target = prefix + __value;
-      conditional_sign_mirror(__x + 0u, alignment_emulator + 0u);
-      conditional_sign_mirror(__x + 1u, alignment_emulator + 1u);
-      conditional_sign_mirror(__x + 2u, alignment_emulator + 2u);
-      conditional_sign_mirror(__x + 3u, alignment_emulator + 3u);
-#ifdef __VARR_USE_AVX512__
-      conditional_sign_mirror(__x + 4u, alignment_emulator + 4u);
-      conditional_sign_mirror(__x + 5u, alignment_emulator + 5u);
-      conditional_sign_mirror(__x + 6u, alignment_emulator + 6u);
-      conditional_sign_mirror(__x + 7u, alignment_emulator + 7u);
-#endif
-      __out[0u] = alignment_emulator[0u];
-      __out[1u] = alignment_emulator[1u];
-      __out[2u] = alignment_emulator[2u];
-      __out[3u] = alignment_emulator[3u];
-#ifdef __VARR_USE_AVX512__
-      __out[4u] = alignment_emulator[4u];
-      __out[5u] = alignment_emulator[5u];
-      __out[6u] = alignment_emulator[6u];
-      __out[7u] = alignment_emulator[7u];
-#endif
-      __x += __AVX_DOUBLE_STRIDE__;
-      __out += __AVX_DOUBLE_STRIDE__;
-      continue;
-   }
-   
-   // Remainder loop:
-   
-   for(
-      register size_t i = length_axv_stride * __AVX_DOUBLE_STRIDE__;
-      i< length; 
-      ++i
-      )
-   {
-      *__out++ = sublinear_sampling_normalizing_logd_evaluate(
-         *__x++,
-         __accelerator
-         );
-   }
-#endif
    return;
 }
 
-VARRLogDEvaluator
-normalizing_linear_sampling_logd(
-   size_t number_of_samples
-   )
-{
-   VARRLogDEvaluator
-      result;
-   SamplingLogDAccelerator * const
-      accelerator = allocate_linear_sampling_normalizing_logd(
-         number_of_samples
-         );
-   result.accelerator = (void *) accelerator;
-   result.logd = linear_sampling_normalizing_logd_evaluate;
-   result.logd_array = linear_sampling_normalizing_logd_batch_evaluate;
-   result.disallocate = linear_sampling_normalizing_logd_disallocate;
-   return
-      result;
-}
-
-VARRLogDEvaluator
-normalizing_sublinear_sampling_logd(
-   size_t number_of_samples
-   )
-{
-   VARRLogDEvaluator
-      result;
-   SamplingLogDAccelerator * const
-      accelerator = allocate_linear_sampling_normalizing_logd(
-         number_of_samples
-         );
-   result.accelerator = (void *) accelerator;
-   result.logd = sublinear_sampling_normalizing_logd_evaluate;
-   result.logd_array = sublinear_sampling_normalizing_logd_batch_evaluate;
-   result.disallocate = linear_sampling_normalizing_logd_disallocate;
-   return
-      result;
-}
-
 static
 int
 quad_series_logd_disallocate(
@@ -1226,6 +762,14 @@ static double const
       2.0/1003.0
    };
 
+/*
+ * log(x) = k * log(2) + log(m), for x = m * 2**k and sqrt(1/2) <= m < sqrt(2),
+ * where k and m are read from the exponent and mantissa fields of x, so that
+ * z = (m - 1)**2/(m + 1)**2 < 0.0295.  The series in z is evaluated in pairs 
+ * of terms, (c[2j] + c[2j + 1] z), combined by Horner's scheme in z**2, as 
+ * by the batch form (see quad_series_logd_stride in varr_log.batch.h), so 
+ * that both forms evaluate the same terms in the same order:
+ */
 static
 double
 quad_series_logd_evaluate(
@@ -1233,33 +777,256 @@ quad_series_logd_evaluate(
    void const * restrict __accelerator
    )
 {
-   static double const
-      __log10 = 2.302585092994045901093614,             // log(10.0)
-      __log_base10_of_2 = 0.301029995663981198017467;   // log10(2.0)
-   static double const
-      __pow10s[] = {
-         1./10000., 1./1000., 1./100., 1./10., 
-         1., 10., 100., 1000., 10000., 100000.
-         };
-   register int const
-      number_of_iterations = (int) (ptrdiff_t) __accelerator;
+   register size_t
+      i = (size_t) (ptrdiff_t) __accelerator;
+   double
+      m;
    register double const
-      __pow2_exponent = log2(x);
-   register int const
-      __pow10_exponent = (int) floor(__pow2_exponent * __log_base10_of_2);
-   register double
-      convergent = x / __pow10s[__pow10_exponent + 4];
+      k = __varr_centred_exponent_split(x, &m);
+   register double const
+      y = (m - 1.0) / (m + 1.0),
+      z = y * y,
+      z2 = z * z;
    register double
-      yp = (convergent - 1.0) / (convergent + 1.0);
+      series = (i & 1u) ? __constants[--i] : 0.;
+   for(; i; i -= 2u)
+   {
+      series = series * z2 + (__constants[i - 1u] * z + __constants[i - 2u]);
+   }
+   return
+      k * __log2_high + (k * __log2_low + y * series);
+}
+
+static
+void
+quad_series_logd_batch_evaluate_scalar(
+   register double const * x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
    register double const
-      y2 = (yp * yp);
-   convergent = yp * __constants[0u];
-   for(int i = 1u; i< number_of_iterations; ++i)
+      * __x = x;
+   register double
+      * __out = out;
+   for(
+      register size_t i = (size_t) 0u;
+      i< length;
+      ++i
+      )
    {
-      convergent += (yp *= y2) * __constants[i];
+      *__out++ = quad_series_logd_evaluate(
+         *__x++,
+         __accelerator
+         );
    }
+   return;
+}
+
+/*
+ * The single precision logarithm, normalizing_linear_sampling_logf, samples
+ * log(m) as does normalizing_linear_sampling_logd:
+ */
+typedef struct tagSamplingLogFAccelerator
+{
+   float
+      start_x,
+      step_x_inv,
+      last_sample;
+   size_t
+      samples;
+   float const *
+      table;
+} SamplingLogFAccelerator;
+
+/*
+ * log(2), split so that k * __logf_log2_high is exact for every exponent k
+ * of a float:
+ */
+static float const
+   __logf_log2_high = 0.693145751953125f,
+   __logf_log2_low = 1.42860682028622680e-6f;
+
+static
+int
+linear_sampling_normalizing_logf_disallocate(
+   VARRLogFEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   SamplingLogFAccelerator * const
+      accelerator = (SamplingLogFAccelerator *) evaluator->accelerator;
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_table_cache_release(accelerator->table);
+   accelerator->samples = (size_t) 0;
+   accelerator->table = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+/*
+ * Returns the number_of_samples + 2 samples of log from the float 
+ * sqrt(1/2), of the table of normalizing_linear_sampling_logf:
+ */
+static
+double *
+linear_sampling_normalizing_logf_samples(size_t number_of_samples)
+{
+   double const
+      start_x = (double) __varr_bits_float(__VARR_FLOAT_SQRT_HALF_BITS__),
+      step_size = start_x / (double) (number_of_samples - (size_t) 1u);
    return
-      __pow10_exponent * __log10 + convergent;
+      __varr_sample_grid(
+         sampled_log, NULL, start_x, step_size, number_of_samples + 2u
+         );
+}
+
+static
+SamplingLogFAccelerator *
+allocate_linear_sampling_normalizing_logf(
+   size_t number_of_samples
+   )
+{
+   double const
+      start_x = (double) __varr_bits_float(__VARR_FLOAT_SQRT_HALF_BITS__),
+      step_size = start_x / (double) (number_of_samples - (size_t) 1u);
+   VARRTableKey const
+      key = {
+         .function = "log",
+         .method = "float normalizing linear sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_INTERLEAVED,
+         .precision = VARR_TABLE_FLOAT,
+         .lower = start_x,
+         .upper = 2.0 * start_x
+      };
+   SamplingLogFAccelerator * const
+      result = (SamplingLogFAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingLogFAccelerator)
+         );
+   result->start_x = (float) start_x;
+   result->step_x_inv = (float) (1. / step_size);
+   result->last_sample = (float) (number_of_samples - (size_t) 1u);
+   result->samples = number_of_samples;
+   result->table = __varr_shared_float_table(
+      &key,
+      linear_sampling_normalizing_logf_samples,
+      number_of_samples + 2u,
+      1u
+      );
+   return
+      result;
+}
+
+static inline
+float
+__linear_sampling_normalizing_logf_evaluate(
+   register float x,
+   SamplingLogFAccelerator const * restrict accelerator
+   )
+{
+   float
+      mantissa;
+   register float const
+      exponent = __varr_float_centred_exponent_split(x, &mantissa);
+   register float
+      step_frac = (mantissa - accelerator->start_x) * accelerator->step_x_inv;
+   step_frac = fminf(step_frac, accelerator->last_sample);
+   register size_t const
+      index = (size_t) step_frac;
+   return
+      exponent * __logf_log2_high
+    + (
+         exponent * __logf_log2_low
+       + __varr_interpolate_float_component(
+            accelerator->table, 1u, index, step_frac - (float) index, 0u
+            )
+      );
+}
+
+static
+float
+linear_sampling_normalizing_logf_evaluate(
+   register float x,
+   register void const * restrict accelerator
+   )
+{
+   return
+      __linear_sampling_normalizing_logf_evaluate(
+         x, (SamplingLogFAccelerator const *) accelerator
+         );
+}
+
+static
+void
+linear_sampling_normalizing_logf_batch_evaluate_scalar(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(register size_t i = (size_t) 0u; i< length; ++i)
+   {
+      *out++ = __linear_sampling_normalizing_logf_evaluate(
+         *__x++,
+         ((SamplingLogFAccelerator const *) __accelerator)
+         );
+   }
+   return;
+}
+
+#define __VARR_SIMD_KERNELS__ "varr_log.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
+VARRLogDEvaluator
+normalizing_linear_sampling_logd(
+   size_t number_of_samples
+   )
+{
+   VARRLogDEvaluator
+      result;
+   SamplingLogDAccelerator * const
+      accelerator = allocate_linear_sampling_normalizing_logd(
+         number_of_samples,
+         __varr_table_format().layout,
+         __varr_table_format().precision
+         );
+   result.accelerator = (void *) accelerator;
+   result.logd = linear_sampling_normalizing_logd_evaluate;
+   result.logd_array =
+      __varr_simd_select(linear_sampling_normalizing_logd_batch_evaluate);
+   result.disallocate = linear_sampling_normalizing_logd_disallocate;
+   return
+      result;
+}
+
+VARRLogDEvaluator
+normalizing_sublinear_sampling_logd(
+   size_t number_of_samples
+   )
+{
+   VARRLogDEvaluator
+      result;
+   SamplingLogDAccelerator * const
+      accelerator = allocate_linear_sampling_normalizing_logd(
+         number_of_samples, VARR_TABLE_VALUES, VARR_TABLE_DOUBLE
+         );
+   result.accelerator = (void *) accelerator;
+   result.logd = sublinear_sampling_normalizing_logd_evaluate;
+   result.logd_array =
+      __varr_simd_select(sublinear_sampling_normalizing_logd_batch_evaluate);
+   result.disallocate = linear_sampling_normalizing_logd_disallocate;
+   return
+      result;
 }
 
 VARRLogDEvaluator
@@ -1270,8 +1037,96 @@ quad_series_logd(size_t number_of_iterations)
    result.accelerator =
       (void *) (ptrdiff_t) (int) (number_of_iterations + 1u);
    result.logd = quad_series_logd_evaluate;
-   result.logd_array = NULL;
+   result.logd_array =
+      __varr_simd_select(quad_series_logd_batch_evaluate);
    result.disallocate = quad_series_logd_disallocate;
    return
       result;
 }
+
+VARRLogFEvaluator
+normalizing_linear_sampling_logf(
+   size_t number_of_samples
+   )
+{
+   VARRLogFEvaluator
+      result;
+   SamplingLogFAccelerator * const
+      accelerator = allocate_linear_sampling_normalizing_logf(
+         number_of_samples
+         );
+   result.accelerator = (void *) accelerator;
+   result.logf = linear_sampling_normalizing_logf_evaluate;
+   result.logf_array =
+      __varr_simd_select(linear_sampling_normalizing_logf_batch_evaluate);
+   result.disallocate = linear_sampling_normalizing_logf_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__):
+ */
+
+static
+void
+measure_linear_sampling_normalizing_logd(
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   )
+{
+   __varr_allocation_measure(sizeof(SamplingLogDAccelerator));
+   __varr_measure_shared_sample_table(
+      number_of_samples + 2u, 1u, layout, precision
+      );
+}
+
+static
+void
+measure_normalizing_linear_sampling_logd(size_t number_of_samples)
+{
+   measure_linear_sampling_normalizing_logd(
+      number_of_samples,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_normalizing_sublinear_sampling_logd(size_t number_of_samples)
+{
+   measure_linear_sampling_normalizing_logd(
+      number_of_samples, VARR_TABLE_VALUES, VARR_TABLE_DOUBLE
+      );
+}
+
+static
+void
+measure_normalizing_linear_sampling_logf(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingLogFAccelerator));
+   __varr_measure_shared_float_table(number_of_samples + 2u, 1u);
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRLogDEvaluator,
+   normalizing_linear_sampling_logd
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRLogDEvaluator,
+   normalizing_linear_sampling_logd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRLogDEvaluator,
+   normalizing_sublinear_sampling_logd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRLogFEvaluator,
+   normalizing_linear_sampling_logf
+   )
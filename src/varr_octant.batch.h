@@ -0,0 +1,251 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_octant.c.  This file is included by
+ * varr_octant.c (through varr_simd_instantiate.h) twice per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+/*
+ * As __octant_sincosd: the swap of the second octant of a quadrant, and the
+ * rotation by the quadrant, are blends of (sin, cos) and their negations, 
+ * under masks compared from the (integral) quadrant as a double:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(octant_sincosd_stride)(
+   register avxd_array_t x,
+   OctantSamplingDAccelerator const * const accelerator,
+   avxd_array_t * const sin_x,
+   avxd_array_t * const cos_x
+   )
+{
+   register avxd_array_t const
+      __one = _avxd_stride_set_duplicates(1.),
+      __half = _avxd_stride_set_duplicates(0.5),
+      quadrant_length = _avxd_stride_set_duplicates(accelerator->quadrant);
+   x = _avxd_stride_fnmadd(
+      _avxd_stride_floor(x * _avxd_stride_set_duplicates(1.0 / __2pi)),
+      _avxd_stride_set_duplicates(__2pi),
+      x
+      );
+   // Rounding may leave x marginally below zero, or 2 pi:
+   x = _avxd_stride_max(
+      x * _avxd_stride_set_duplicates(accelerator->step_x_inverse),
+      _avxd_stride_set_duplicates(0.)
+      );
+   register avxd_array_t const
+      quadrant = _avxd_stride_min(
+         _avxd_stride_floor(
+            x * _avxd_stride_set_duplicates(accelerator->quadrant_inverse)
+            ),
+         _avxd_stride_set_duplicates(3.)
+         ),
+      half_turns = _avxd_stride_floor(quadrant * __half);
+   x = _avxd_stride_fnmadd(quadrant, quadrant_length, x);
+   register avxd_mask_t const
+      second_octant = _avxd_stride_less_than(
+         _avxd_stride_set_duplicates(accelerator->octant), x
+         ),
+      odd_quadrant = _avxd_stride_less_than(
+         __half, quadrant - (half_turns + half_turns)
+         );
+   register avxd_array_t const
+      reflected = _avxd_stride_max(
+         _avxd_stride_min(x, quadrant_length - x),
+         _avxd_stride_set_duplicates(0.)
+         ),
+      // 1 in quadrants 0 and 1, and -1 in quadrants 2 and 3:
+      sign = _avxd_stride_fnmadd(half_turns + half_turns, __one, __one);
+   avxd_array_t
+      s,
+      c;
+   _avxd_stride_interpolate_pair(
+      &accelerator->table,
+      _avxd_stride_index(reflected),
+      reflected - _avxd_stride_floor(reflected),
+      &s,
+      &c
+      );
+   register avxd_array_t const
+      octant_sin = _avxd_stride_blend(second_octant, s, c),
+      octant_cos = _avxd_stride_blend(second_octant, c, s);
+   *sin_x = sign * _avxd_stride_blend(odd_quadrant, octant_sin, octant_cos);
+   *cos_x = sign * _avxd_stride_blend(odd_quadrant, octant_cos, -octant_sin);
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(octant_sampling_sind_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      octant_sampling_sind_batch_evaluate, __x, out, length, __accelerator
+      );
+   register OctantSamplingDAccelerator const * const
+      accelerator = (OctantSamplingDAccelerator const *) __accelerator;
+   avxd_array_t
+      sin_x,
+      cos_x;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(octant_sincosd_stride)(
+         _avxd_stride_load(__x), accelerator, &sin_x, &cos_x
+         );
+      _avxd_stride_store(out, sin_x);
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      __VARR_SIMD_NAME(octant_sincosd_stride)(
+         _avxd_stride_load_partial(
+            __x, lanes, _avxd_stride_set_duplicates(0.)
+            ),
+         accelerator,
+         &sin_x,
+         &cos_x
+         );
+      _avxd_stride_store_partial(out, lanes, sin_x);
+   }
+   return;
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(octant_sampling_cosd_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      octant_sampling_cosd_batch_evaluate, __x, out, length, __accelerator
+      );
+   register OctantSamplingDAccelerator const * const
+      accelerator = (OctantSamplingDAccelerator const *) __accelerator;
+   avxd_array_t
+      sin_x,
+      cos_x;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(octant_sincosd_stride)(
+         _avxd_stride_load(__x), accelerator, &sin_x, &cos_x
+         );
+      _avxd_stride_store(out, cos_x);
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      __VARR_SIMD_NAME(octant_sincosd_stride)(
+         _avxd_stride_load_partial(
+            __x, lanes, _avxd_stride_set_duplicates(0.)
+            ),
+         accelerator,
+         &sin_x,
+         &cos_x
+         );
+      _avxd_stride_store_partial(out, lanes, cos_x);
+   }
+   return;
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(octant_linear_interpolating_phasord_batch_evaluate)(
+   register double const * restrict x,
+   register double complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      octant_linear_interpolating_phasord_batch_evaluate,
+      x,
+      out,
+      length,
+      __accelerator
+      );
+   register OctantSamplingDAccelerator const * const
+      accelerator = (OctantSamplingDAccelerator const *) __accelerator;
+   avxd_array_t
+      re,
+      im;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(octant_sincosd_stride)(
+         _avxd_stride_load(x), accelerator, &im, &re
+         );
+      _avxd_stride_store_interleaved((double *) out, re, im);
+      x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      __VARR_SIMD_NAME(octant_sincosd_stride)(
+         _avxd_stride_load_partial(
+            x,
+            _avxd_stride_lanes(length),
+            _avxd_stride_set_duplicates(0.)
+            ),
+         accelerator,
+         &im,
+         &re
+         );
+      _avxd_stride_store_interleaved_partial((double *) out, length, re, im);
+   }
+   return;
+}
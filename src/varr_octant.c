@@ -0,0 +1,462 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_octant.h"
+#include "varr_internal.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/*
+ * The accelerator of each of the octant evaluators.  With n = 8m samples 
+ * per period, of step 2 pi / n, x is reduced to the sampling coordinate 
+ * y = x n / (2 pi), for 0 <= y <= n, which is in quadrant q = floor(y / 2m)
+ * at r = y - 2mq, and in the second octant of that quadrant if m < r.  The
+ * table holds (sin, cos) at the m + 2 samples 0, ..., m + 1:
+ */
+typedef struct tagOctantSamplingDAccelerator
+{
+   double
+      step_x_inverse,
+      quadrant,                           // 2m
+      quadrant_inverse,
+      octant;                             // m
+   size_t
+      samples;
+   VARRSampleTable                        // (sin, cos), of width two
+      table;
+} OctantSamplingDAccelerator;
+
+static
+int
+__octant_sampling_disallocate(
+   OctantSamplingDAccelerator * accelerator
+   )
+{
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_free_sample_table(&accelerator->table);
+   accelerator->step_x_inverse = 0x7F800001;
+   accelerator->quadrant = 0x7F800001;
+   accelerator->quadrant_inverse = 0x7F800001;
+   accelerator->octant = 0x7F800001;
+   accelerator->samples = (size_t) 0;
+   __varr_free(accelerator);
+   return 0;
+}
+
+static
+int
+octant_sampling_sind_disallocate(
+   VARRSinDEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   return
+      __octant_sampling_disallocate(
+         (OctantSamplingDAccelerator *) evaluator->accelerator
+         );
+}
+
+static
+int
+octant_sampling_cosd_disallocate(
+   VARRCosDEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   return
+      __octant_sampling_disallocate(
+         (OctantSamplingDAccelerator *) evaluator->accelerator
+         );
+}
+
+static
+int
+octant_linear_interpolating_phasord_disallocate(
+   VARRPhasorDEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   return
+      __octant_sampling_disallocate(
+         (OctantSamplingDAccelerator *) evaluator->accelerator
+         );
+}
+
+static double const
+   __2pi = 2.0 * M_PI;
+
+/*
+ * Returns the m + 2 pairs (sin, cos) of the table of a period of 
+ * number_of_samples = 8m samples, by rotation (see __varr_sample_rotations):
+ */
+static
+double *
+octant_samples(size_t number_of_samples)
+{
+   return
+      __varr_sample_rotations(
+         __2pi / (double) number_of_samples,
+         number_of_samples / (size_t) 8u + (size_t) 2u,
+         1u
+         );
+}
+
+/*
+ * Returns number_of_samples rounded up to a nonzero multiple of 8:
+ */
+static
+size_t
+octant_number_of_samples(size_t number_of_samples)
+{
+   return
+      (number_of_samples < (size_t) 8u) ?
+         (size_t) 8u
+         :
+         (number_of_samples + (size_t) 7u) & ~((size_t) 7u);
+}
+
+static
+OctantSamplingDAccelerator *
+allocate_octant_sampling(size_t number_of_samples)
+{
+   number_of_samples = octant_number_of_samples(number_of_samples);
+   double const
+      octant = (double) (number_of_samples / (size_t) 8u);
+   VARRTableKey const
+      key = {
+         .function = "sincos",
+         .method = "octant sampling",
+         .number_of_samples = number_of_samples,
+         .layout = __varr_table_format().layout,
+         .precision = __varr_table_format().precision,
+         .lower = 0.0,
+         .upper = 0.25 * M_PI
+      };
+   OctantSamplingDAccelerator * const
+      result = (OctantSamplingDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(OctantSamplingDAccelerator)
+         );
+   if(result == NULL)
+      return NULL;
+   result->step_x_inverse = (double) number_of_samples / __2pi;
+   result->quadrant = 2. * octant;
+   result->quadrant_inverse = 1. / (2. * octant);
+   result->octant = octant;
+   result->samples = number_of_samples;
+   result->table = __varr_shared_sample_table(
+      &key,
+      octant_samples,
+      number_of_samples / (size_t) 8u + (size_t) 2u,
+      2u
+      );
+   return
+      result;
+}
+
+/*
+ * Assigns sin(x) and cos(x), of the (sin, cos) of the first octant 
+ * interpolated at the reflection of x, as the octant of x requires:
+ */
+static inline
+void
+__octant_sincosd(
+   register double x,
+   register OctantSamplingDAccelerator const * accelerator,
+   double * const sin_x,
+   double * const cos_x
+   )
+{
+   x -= __2pi * floor(x * (1.0 / __2pi));
+   // Rounding may leave x marginally below zero, or 2 pi:
+   x = fmax(x * accelerator->step_x_inverse, 0.);
+   register double const
+      quadrant = fmin(floor(x * accelerator->quadrant_inverse), 3.);
+   x -= quadrant * accelerator->quadrant;
+   register double const
+      reflected = fmax(fmin(x, accelerator->quadrant - x), 0.);
+   register size_t const
+      index = (size_t) reflected;
+   register double
+      s = __varr_interpolate_component(
+         &accelerator->table, index, reflected - floor(reflected), 0u
+         ),
+      c = __varr_interpolate_component(
+         &accelerator->table, index, reflected - floor(reflected), 1u
+         );
+   if(accelerator->octant < x)
+   {
+      register double const
+         swap = s;
+      s = c;
+      c = swap;
+   }
+   switch((unsigned) quadrant)
+   {
+      case 0u:
+         *sin_x = s;
+         *cos_x = c;
+         break;
+      case 1u:
+         *sin_x = c;
+         *cos_x = -s;
+         break;
+      case 2u:
+         *sin_x = -s;
+         *cos_x = -c;
+         break;
+      default:
+         *sin_x = -c;
+         *cos_x = s;
+         break;
+   }
+}
+
+static
+double
+octant_sampling_sind_evaluate(
+   register double x,
+   register void const * __accelerator
+   )
+{
+   double
+      sin_x,
+      cos_x;
+   __octant_sincosd(
+      x, (OctantSamplingDAccelerator const *) __accelerator, &sin_x, &cos_x
+      );
+   return
+      sin_x;
+}
+
+static
+double
+octant_sampling_cosd_evaluate(
+   register double x,
+   register void const * __accelerator
+   )
+{
+   double
+      sin_x,
+      cos_x;
+   __octant_sincosd(
+      x, (OctantSamplingDAccelerator const *) __accelerator, &sin_x, &cos_x
+      );
+   return
+      cos_x;
+}
+
+static
+double complex
+octant_linear_interpolating_phasord_evaluate(
+   register double phi,
+   register void const * __accelerator
+   )
+{
+   double
+      sin_phi,
+      cos_phi;
+   __octant_sincosd(
+      phi,
+      (OctantSamplingDAccelerator const *) __accelerator,
+      &sin_phi,
+      &cos_phi
+      );
+   return
+      cos_phi + sin_phi * I;
+}
+
+static
+void
+octant_sampling_sind_batch_evaluate_scalar(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(register size_t i = (size_t) 0u; i< length; ++i)
+   {
+      *out++ = octant_sampling_sind_evaluate(*__x++, __accelerator);
+   }
+   return;
+}
+
+static
+void
+octant_sampling_cosd_batch_evaluate_scalar(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(register size_t i = (size_t) 0u; i< length; ++i)
+   {
+      *out++ = octant_sampling_cosd_evaluate(*__x++, __accelerator);
+   }
+   return;
+}
+
+static
+void
+octant_linear_interpolating_phasord_batch_evaluate_scalar(
+   register double const * restrict x,
+   register double complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(register size_t i = (size_t) 0u; i< length; ++i)
+   {
+      out[i] = octant_linear_interpolating_phasord_evaluate(
+         x[i], __accelerator
+         );
+   }
+   return;
+}
+
+#define __VARR_SIMD_KERNELS__ "varr_octant.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
+VARRSinDEvaluator
+octant_sampling_sind(size_t number_of_samples)
+{
+   VARRSinDEvaluator
+      result;
+   result.accelerator = (void *) allocate_octant_sampling(number_of_samples);
+   result.sind = octant_sampling_sind_evaluate;
+   result.sind_array =
+      __varr_simd_select(octant_sampling_sind_batch_evaluate);
+   result.disallocate = octant_sampling_sind_disallocate;
+   return
+      result;
+}
+
+VARRCosDEvaluator
+octant_sampling_cosd(size_t number_of_samples)
+{
+   VARRCosDEvaluator
+      result;
+   result.accelerator = (void *) allocate_octant_sampling(number_of_samples);
+   result.cosd = octant_sampling_cosd_evaluate;
+   result.cosd_array =
+      __varr_simd_select(octant_sampling_cosd_batch_evaluate);
+   result.disallocate = octant_sampling_cosd_disallocate;
+   return
+      result;
+}
+
+VARRPhasorDEvaluator
+octant_linear_interpolating_phasord(size_t number_of_samples)
+{
+   VARRPhasorDEvaluator
+      result;
+   result.accelerator = (void *) allocate_octant_sampling(number_of_samples);
+   result.phasord = octant_linear_interpolating_phasord_evaluate;
+   result.phasord_array =
+      __varr_simd_select(octant_linear_interpolating_phasord_batch_evaluate);
+   result.disallocate = octant_linear_interpolating_phasord_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__), which are those of 
+ * allocate_octant_sampling:
+ */
+
+static
+void
+measure_octant_sampling(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(OctantSamplingDAccelerator));
+   __varr_measure_shared_sample_table(
+      octant_number_of_samples(number_of_samples) / (size_t) 8u + (size_t) 2u,
+      2u,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_octant_sampling_sind(size_t number_of_samples)
+{
+   measure_octant_sampling(number_of_samples);
+}
+
+static
+void
+measure_octant_sampling_cosd(size_t number_of_samples)
+{
+   measure_octant_sampling(number_of_samples);
+}
+
+static
+void
+measure_octant_linear_interpolating_phasord(size_t number_of_samples)
+{
+   measure_octant_sampling(number_of_samples);
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRSinDEvaluator,
+   octant_sampling_sind
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRSinDEvaluator,
+   octant_sampling_sind
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRCosDEvaluator,
+   octant_sampling_cosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRCosDEvaluator,
+   octant_sampling_cosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRPhasorDEvaluator,
+   octant_linear_interpolating_phasord
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRPhasorDEvaluator,
+   octant_linear_interpolating_phasord
+   )
@@ -0,0 +1,324 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_phasor.c.  This file is included by
+ * varr_phasor.c (through varr_simd_instantiate.h) twice per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+/*
+ * Returns the sampling coordinate, phi / step_phi, of phi reduced to one 
+ * period:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(phasord_coordinate)(
+   register avxd_array_t phi,
+   register avxd_array_t const step_phi_inv
+   )
+{
+   phi = _avxd_stride_fnmadd(
+      _avxd_stride_floor(phi * _avxd_stride_set_duplicates(1.0 / __2pi)),
+      _avxd_stride_set_duplicates(__2pi),
+      phi
+      );
+   // Rounding may leave phi marginally below zero:
+   return
+      _avxd_stride_max(
+         phi * step_phi_inv,
+         _avxd_stride_set_duplicates(0.)
+         );
+}
+
+/*
+ * Evaluates the phasors of the phases phi, as their real and imaginary
+ * parts, from the table of (real, imaginary) pairs, see 
+ * _avxd_stride_interpolate_pair:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_interpolating_phasord_stride)(
+   register avxd_array_t phi,
+   VARRSampleTable const * const table,
+   register avxd_array_t const step_phi_inv,
+   avxd_array_t * const re,
+   avxd_array_t * const im
+   )
+{
+   phi = __VARR_SIMD_NAME(phasord_coordinate)(phi, step_phi_inv);
+   _avxd_stride_interpolate_pair(
+      table, _avxd_stride_index(phi), phi - _avxd_stride_floor(phi), re, im
+      );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_interpolating_phasord_batch_evaluate)(
+   register double const * restrict x,
+   register double complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      linear_interpolating_phasord_batch_evaluate, x, out, length, __accelerator
+      );
+   register LinearInterpolatingPhasorDAccelerator const * const
+      accelerator = 
+          ((LinearInterpolatingPhasorDAccelerator const *) __accelerator);
+   VARRSampleTable const * const
+      table = &accelerator->table;
+   register avxd_array_t const
+      step_phi_inv = _avxd_stride_set_duplicates(accelerator->step_phi_inv);
+   avxd_array_t
+      re,
+      im;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(linear_interpolating_phasord_stride)(
+         _avxd_stride_load(x), table, step_phi_inv, &re, &im
+         );
+      _avxd_stride_store_interleaved((double *) out, re, im);
+      x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      __VARR_SIMD_NAME(linear_interpolating_phasord_stride)(
+         _avxd_stride_load_partial(
+            x,
+            _avxd_stride_lanes(length),
+            _avxd_stride_set_duplicates(0.)
+            ),
+         table,
+         step_phi_inv,
+         &re,
+         &im
+         );
+      _avxd_stride_store_interleaved_partial((double *) out, length, re, im);
+   }
+   return;
+}
+
+/*
+ * The four complex coefficients of the spline on each interval are gathered
+ * (at eight times its index) as two quads of doubles, and evaluated by 
+ * Horner's scheme:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(cubic_spline_sampling_phasord_stride)(
+   register avxd_array_t phi,
+   register double const * const coefficients,
+   register avxd_array_t const step_phi_inv,
+   avxd_array_t * const re,
+   avxd_array_t * const im
+   )
+{
+   phi = __VARR_SIMD_NAME(phasord_coordinate)(phi, step_phi_inv);
+   register avxi_array_t
+      index = _avxd_stride_index(phi);
+   register avxd_array_t const
+      alpha = phi - _avxd_stride_floor(phi);
+   avxd_array_t
+      lower[4u],
+      upper[4u];
+   index = _avxi_stride_add(index, index);
+   index = _avxi_stride_add(index, index);
+   index = _avxi_stride_add(index, index);
+   _avxd_stride_gather_quads(coefficients, index, lower);
+   _avxd_stride_gather_quads(coefficients + 4u, index, upper);
+   *re = _avxd_stride_fmadd(
+      _avxd_stride_fmadd(
+         _avxd_stride_fmadd(upper[2u], alpha, upper[0u]),
+         alpha,
+         lower[2u]
+         ),
+      alpha,
+      lower[0u]
+      );
+   *im = _avxd_stride_fmadd(
+      _avxd_stride_fmadd(
+         _avxd_stride_fmadd(upper[3u], alpha, upper[1u]),
+         alpha,
+         lower[3u]
+         ),
+      alpha,
+      lower[1u]
+      );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(cubic_spline_sampling_phasord_batch_evaluate)(
+   register double const * restrict x,
+   register double complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      cubic_spline_sampling_phasord_batch_evaluate,
+      x,
+      out,
+      length,
+      __accelerator
+      );
+   register CubicSplineInterpolatingPhasorDAccelerator const * const
+      accelerator = 
+         ((CubicSplineInterpolatingPhasorDAccelerator const *) __accelerator);
+   register double const * const
+      coefficients = (double const *) accelerator->coefficients;
+   register avxd_array_t const
+      step_phi_inv = _avxd_stride_set_duplicates(accelerator->step_phi_inv);
+   avxd_array_t
+      re,
+      im;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(cubic_spline_sampling_phasord_stride)(
+         _avxd_stride_load(x), coefficients, step_phi_inv, &re, &im
+         );
+      _avxd_stride_store_interleaved((double *) out, re, im);
+      x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      __VARR_SIMD_NAME(cubic_spline_sampling_phasord_stride)(
+         _avxd_stride_load_partial(
+            x,
+            _avxd_stride_lanes(length),
+            _avxd_stride_set_duplicates(0.)
+            ),
+         coefficients,
+         step_phi_inv,
+         &re,
+         &im
+         );
+      _avxd_stride_store_interleaved_partial((double *) out, length, re, im);
+   }
+   return;
+}
+
+/*
+ * As linear_interpolating_phasord_stride, for floats, from the float table 
+ * of (cos, sin) samples and their differences:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_interpolating_phasorf_stride)(
+   register avxf_array_t phi,
+   LinearInterpolatingPhasorFAccelerator const * const accelerator,
+   avxf_array_t * const re,
+   avxf_array_t * const im
+   )
+{
+   phi = _avxf_stride_reduce_2pi(
+      phi,
+      _avxf_stride_floor(
+         phi * _avxf_stride_set_duplicates((float) (1. / __2pi))
+         )
+      ) * _avxf_stride_set_duplicates(accelerator->step_phi_inv);
+   phi = _avxf_stride_min(
+      _avxf_stride_max(phi, _avxf_stride_set_duplicates(0.f)),
+      _avxf_stride_set_duplicates(accelerator->last_sample)
+      );
+   _avxf_stride_interpolate_pair(
+      accelerator->table,
+      _avxf_stride_index(phi),
+      phi - _avxf_stride_floor(phi),
+      re,
+      im
+      );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(linear_interpolating_phasorf_batch_evaluate)(
+   register float const * restrict x,
+   register float complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      linear_interpolating_phasorf_batch_evaluate, x, out, length, __accelerator
+      );
+   register LinearInterpolatingPhasorFAccelerator const * const
+      accelerator = 
+          ((LinearInterpolatingPhasorFAccelerator const *) __accelerator);
+   avxf_array_t
+      re,
+      im;
+   for(
+      ;
+      length >= __AVX_FLOAT_STRIDE__;
+      length -= __AVX_FLOAT_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(linear_interpolating_phasorf_stride)(
+         _avxf_stride_load(x), accelerator, &re, &im
+         );
+      _avxf_stride_store_interleaved((float *) out, re, im);
+      x += __AVX_FLOAT_STRIDE__;
+      out += __AVX_FLOAT_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      __VARR_SIMD_NAME(linear_interpolating_phasorf_stride)(
+         _avxf_stride_load_partial(
+            x,
+            _avxf_stride_lanes(length),
+            _avxf_stride_set_duplicates(0.f)
+            ),
+         accelerator,
+         &re,
+         &im
+         );
+      _avxf_stride_store_interleaved_partial((float *) out, length, re, im);
+   }
+   return;
+}
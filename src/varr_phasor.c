@@ -20,120 +20,10 @@
 
 #include "varr_phasor.h"
 #include "varr_internal.h"
-#include "varr_sin.h"
-#include "varr_cos.h"
 #include "math.h"
 
 #include <stdlib.h>
 
-typedef struct tagCubicSplineInterpolatingPhasorDAccelerator
-{
-   VARRSinDEvaluator
-      sind_evaluator;
-   VARRCosDEvaluator
-      cosd_evaluator;
-} CubicSplineInterpolatingPhasorDAccelerator;
-
-static
-int
-__cubic_spline_sampling_phasord_disallocate(
-   CubicSplineInterpolatingPhasorDAccelerator * accelerator
-   )
-{
-   if(accelerator == NULL)
-   {
-      return 1;
-   }
-   int
-      result = accelerator->sind_evaluator.disallocate(
-         &accelerator->sind_evaluator
-         );
-   result &= accelerator->cosd_evaluator.disallocate(
-      &accelerator->cosd_evaluator
-      );
-   free(accelerator);
-   return
-      result;
-}
-
-static
-int
-cubic_spline_sampling_phasord_disallocate(
-   VARRPhasorDEvaluator * evaluator
-   )
-{
-   if(evaluator == NULL)
-   {
-      return 1;
-   }
-   CubicSplineInterpolatingPhasorDAccelerator * const
-      accelerator = (CubicSplineInterpolatingPhasorDAccelerator *)
-         evaluator->accelerator;
-   return
-      __cubic_spline_sampling_phasord_disallocate(accelerator);
-}
-
-static
-CubicSplineInterpolatingPhasorDAccelerator *
-allocate_cubic_spline_sampling_phasord(
-   size_t number_of_samples
-   )
-{
-   CubicSplineInterpolatingPhasorDAccelerator * const
-      result = (CubicSplineInterpolatingPhasorDAccelerator *) malloc(
-         sizeof(CubicSplineInterpolatingPhasorDAccelerator)
-         );
-   result->sind_evaluator = 
-      cubic_spline_sampling_sind(number_of_samples);
-   result->cosd_evaluator = 
-      cubic_spline_sampling_cosd(number_of_samples);
-   return
-      result;
-}
-
-static
-double complex
-cubic_spline_sampling_phasord_evaluate(
-   double phi,
-   void const * __accelerator
-   )
-{
-   CubicSplineInterpolatingPhasorDAccelerator const * const
-      accelerator = (CubicSplineInterpolatingPhasorDAccelerator const *)
-         __accelerator;
-   double complex const
-      result = 
-         accelerator->cosd_evaluator.cosd(
-            phi,
-            accelerator->cosd_evaluator.accelerator
-            )
-       + accelerator->sind_evaluator.sind(
-            phi,
-            accelerator->sind_evaluator.accelerator
-            ) * I;
-   return
-      result;
-}
-
-VARRPhasorDEvaluator
-cubic_spline_sampling_phasord(size_t number_of_samples)
-{
-   VARRPhasorDEvaluator
-      result;
-   CubicSplineInterpolatingPhasorDAccelerator * const
-      accelerator = allocate_cubic_spline_sampling_phasord(
-         number_of_samples
-         );
-   result.accelerator = (void *) accelerator;
-   result.phasord = cubic_spline_sampling_phasord_evaluate;
-   result.phasord_array = NULL;
-   result.disallocate = cubic_spline_sampling_phasord_disallocate;
-   return
-      result;
-}
-
-#include "varr_internal.h"
-
 typedef struct 
    tagLinearInterpolatingPhasorDAccelerator
 {
@@ -143,8 +33,8 @@ typedef struct
       step_phi_inv;
    size_t
       samples;
-   double complex const * __attribute__((aligned(128)))
-      values;
+   VARRSampleTable                        // (re, im), of width two
+      table;
 } __attribute__((aligned(128))) LinearInterpolatingPhasorDAccelerator;
 
 static
@@ -157,13 +47,12 @@ __linear_interpolating_phasord_disallocate(
    {
       return 1;
    }
-   free((void *) (accelerator->values - 2u));
+   __varr_free_sample_table(&accelerator->table);
    accelerator->start_phi = 0x7F800001;
    accelerator->step_phi = 0x7F800001;
    accelerator->step_phi_inv = 0x7F800001;
    accelerator->samples = (size_t) 0;
-   accelerator->values = NULL;
-   free(accelerator);
+   __varr_free(accelerator);
    return 0;
 }
 
@@ -209,10 +98,9 @@ __linear_interpolating_phasord_evaluate(
       index = (size_t) step_frac;
    step_frac -= floor(step_frac);
    return
-      (
-      accelerator->values[index] * (1. - step_frac) + 
-    + accelerator->values[index + 1u] * step_frac
-      );
+      __varr_interpolate_component(&accelerator->table, index, step_frac, 0u)
+    + __varr_interpolate_component(&accelerator->table, index, step_frac, 1u)
+    * I;
 }
 
 static
@@ -230,48 +118,59 @@ linear_interpolating_phasord_evaluate(
          );
 }
 
+/*
+ * Returns the number_of_samples + 2 phasors of one period (and beyond), as
+ * (real, imaginary) pairs of doubles, of the table of 
+ * linear_interpolating_phasord, by rotation (see __varr_sample_rotations):
+ */
+static
+double *
+linear_interpolating_phasord_samples(size_t number_of_samples)
+{
+   return
+      __varr_sample_rotations(
+         __2pi / (double) number_of_samples, number_of_samples + 2u, 0u
+         );
+}
+
 static
 LinearInterpolatingPhasorDAccelerator *
 allocate_linear_interpolating_PhasorD(
-   size_t number_of_samples
+   size_t number_of_samples,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
    )
 {
    double const
       step_size = __2pi / (double) number_of_samples,
       step_size_inv = 1.0 / step_size;
-   double complex *
-      values = (double complex *) malloc(
-         sizeof(double complex) * (number_of_samples + 4u)
+   VARRTableKey const
+      key = {
+         .function = "phasor",
+         .method = "linear interpolation",
+         .number_of_samples = number_of_samples,
+         .layout = layout,
+         .precision = precision,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   LinearInterpolatingPhasorDAccelerator * const
+      result = (LinearInterpolatingPhasorDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__,
+         sizeof(LinearInterpolatingPhasorDAccelerator)
          );
-   values[0] = cexp(I * (-2.*step_size));
-   values[1] = cexp(I * (-step_size));
-   values += 2u;
-   for(size_t i = (size_t) 0; i<= (number_of_samples + 1u); ++i)
-   {
-      double const
-         phi = step_size * (double) i;
-      double complex const
-         value = cexp(I * phi);
-      values[i] = value;
-      continue;
-   }
-   void *
-      __result;
-   int const
-      alloc_result = 
-         posix_memalign(
-            &__result, 64,
-            sizeof(LinearInterpolatingPhasorDAccelerator)
-            );
-   if(alloc_result)
+   if(result == NULL)
       return NULL;
-   LinearInterpolatingPhasorDAccelerator * const
-      result = (LinearInterpolatingPhasorDAccelerator *) __result;
    result->start_phi = 0.0;
    result->step_phi = step_size;
    result->step_phi_inv = step_size_inv;
    result->samples = number_of_samples,
-   result->values = values;
+   result->table = __varr_shared_sample_table(
+      &key,
+      linear_interpolating_phasord_samples,
+      number_of_samples + 2u,
+      2u
+      );
    return
       result;
 }
@@ -280,7 +179,7 @@ allocate_linear_interpolating_PhasorD(
 
 static
 void
-linear_interpolating_phasord_batch_evaluate(
+linear_interpolating_phasord_batch_evaluate_scalar(
    register double const * restrict x,
    register double complex * restrict out,
    register size_t length,
@@ -290,7 +189,6 @@ linear_interpolating_phasord_batch_evaluate(
    register LinearInterpolatingPhasorDAccelerator const * const
       accelerator = 
           ((LinearInterpolatingPhasorDAccelerator const *) __accelerator);
-#ifndef __VARR_HAS_AVX__
    for(register size_t i = (size_t) 0u; i< length; ++i, ++x)
    {
       out[i] = __linear_interpolating_phasord_evaluate(
@@ -298,161 +196,335 @@ linear_interpolating_phasord_batch_evaluate(
          accelerator
          );
    }
-#else
-   static double const
-      __1_over_2pi = 1.0 / (2.0 * M_PI);
-   register double complex const * const
-      values = accelerator->values;
-   register size_t const
-      number_of_samples = accelerator->samples;
-   register size_t const
-      length_avx_stride = length / __AVX_DOUBLE_STRIDE__;
-   register avxd_array_t
-      alpha0,
-      alpha1;
-   register avxd_array_t const
-      __one = _avxd_stride_set_duplicates(1.);
-   register avxd_array_t const
-      step_phi_inv = _avxd_stride_set_duplicates(accelerator->step_phi_inv);
-   double __attribute__((aligned(128)))
-      workspace[__AVX_DOUBLE_STRIDE__ * (size_t) 2u];
-   double complex __attribute__((aligned(128)))
-      alignment_emulator[__AVX_DOUBLE_STRIDE__];
-   register avxd_array_t
-      * const lower = (avxd_array_t *) workspace,
-      * const upper = (lower + 1u);
-   register avxd_array_t
-      * __out = (avxd_array_t *) alignment_emulator;
-   register double complex
-      * export_target = out;
-#ifndef __INTEL_COMPILER
-   register
-#endif
+   return;
+}
+
+typedef struct tagCubicSplineInterpolatingPhasorDAccelerator
+{
+   double
+      step_phi,
+      step_phi_inv;
    size_t
-      indexing[__AVX_DOUBLE_STRIDE__];
-   register double
-      x0, x1;
-#ifdef __VARR_USE_AVX512__
+      samples;
+   /*
+    * The four coefficients of the spline on each interval (see 
+    * __varr_natural_cubic_spline_coefficients), the real and imaginary parts
+    * of which are those of the cosine and sine splines respectively:
+    */
+   double complex const *
+      coefficients;
+} CubicSplineInterpolatingPhasorDAccelerator;
+
+static
+int
+__cubic_spline_sampling_phasord_disallocate(
+   CubicSplineInterpolatingPhasorDAccelerator * accelerator
+   )
+{
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_table_cache_release(accelerator->coefficients);
+   accelerator->step_phi = 0x7F800001;
+   accelerator->step_phi_inv = 0x7F800001;
+   accelerator->samples = (size_t) 0;
+   accelerator->coefficients = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+static
+int
+cubic_spline_sampling_phasord_disallocate(
+   VARRPhasorDEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   CubicSplineInterpolatingPhasorDAccelerator * const
+      accelerator = (CubicSplineInterpolatingPhasorDAccelerator *)
+         evaluator->accelerator;
+   return
+      __cubic_spline_sampling_phasord_disallocate(accelerator);
+}
+
+/*
+ * Builds the complex coefficients of the spline of 
+ * cubic_spline_sampling_phasord:
+ */
+static
+void *
+build_cubic_spline_sampling_phasord_coefficients(
+   VARRTableKey const * key,
+   void const * argument
+   )
+{
+   (void) argument;
+   double const
+      step_size = __2pi / (double) key->number_of_samples;
+   // A range reduced phase may (by rounding) be as large as 2*pi:
+   size_t const
+      number_of_intervals = key->number_of_samples + (size_t) 1u;
+   double complex * const
+      coefficients = (double complex *) __varr_table_allocate(
+         sizeof(double complex) * (size_t) 4u * number_of_intervals
+         );
+   if(coefficients == NULL)
+   {
+      return NULL;
+   }
+   double * const
+      cos_coefficients = __varr_padded_cubic_spline_coefficients(
+         cos,
+         step_size,
+         number_of_intervals
+         );
+   double * const
+      sin_coefficients = __varr_padded_cubic_spline_coefficients(
+         sin,
+         step_size,
+         number_of_intervals
+         );
+   for(size_t i = (size_t) 0; i< (size_t) 4u * number_of_intervals; ++i)
+   {
+      coefficients[i] = cos_coefficients[i] + sin_coefficients[i] * I;
+   }
+   free(sin_coefficients);
+   free(cos_coefficients);
+   return
+      (void *) coefficients;
+}
+
+static
+CubicSplineInterpolatingPhasorDAccelerator *
+allocate_cubic_spline_sampling_phasord(
+   size_t number_of_samples
+   )
+{
+   double const
+      step_size = __2pi / (double) number_of_samples;
+   VARRTableKey const
+      key = {
+         .function = "phasor",
+         .method = "cubic spline sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   CubicSplineInterpolatingPhasorDAccelerator * const
+      result = (CubicSplineInterpolatingPhasorDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__,
+         sizeof(CubicSplineInterpolatingPhasorDAccelerator)
+         );
+   result->step_phi = step_size;
+   result->step_phi_inv = 1.0 / step_size;
+   result->samples = number_of_samples;
+   result->coefficients = (double complex const *) __varr_shared_array(
+      &key,
+      sizeof(double complex),
+      (size_t) 4u * (number_of_samples + (size_t) 1u),
+      build_cubic_spline_sampling_phasord_coefficients,
+      NULL
+      );
+   return
+      result;
+}
+
+static inline
+double complex
+__cubic_spline_sampling_phasord_evaluate(
+   register double phi,
+   register CubicSplineInterpolatingPhasorDAccelerator const * accelerator
+   )
+{
+   phi = fmod_phase_2pi(phi);
    register double
-      x2, x3;
-#endif
-   for(
-      register size_t i = 0u;
-      (i++) < length_avx_stride;
-      x += __AVX_DOUBLE_STRIDE__
-      )
+      alpha = phi * accelerator->step_phi_inv;
+   register size_t const
+      index = (size_t) alpha;
+   alpha -= floor(alpha);
+   register double complex const * restrict
+      coefficient = accelerator->coefficients + (size_t) 4u * index;
+   return
+      coefficient[0u] + alpha * (
+         coefficient[1u] + alpha * (coefficient[2u] + alpha * coefficient[3u])
+         );
+}
+
+static
+double complex
+cubic_spline_sampling_phasord_evaluate(
+   double phi,
+   void const * __accelerator
+   )
+{
+   return
+      __cubic_spline_sampling_phasord_evaluate(
+         phi,
+         (CubicSplineInterpolatingPhasorDAccelerator const *) __accelerator
+         );
+}
+
+static
+void
+cubic_spline_sampling_phasord_batch_evaluate_scalar(
+   register double const * restrict x,
+   register double complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   register CubicSplineInterpolatingPhasorDAccelerator const * const
+      accelerator = 
+         ((CubicSplineInterpolatingPhasorDAccelerator const *) __accelerator);
+   for(register size_t i = (size_t) 0u; i< length; ++i, ++x)
    {
-#ifdef __VARR_USE_AVX512__
-      x3 = x[3] - (x[3] < 0.) * ((int64_t) (x[3] * __1_over_2pi) - 1) * __2pi;
-      x2 = x[2] - (x[2] < 0.) * ((int64_t) (x[2] * __1_over_2pi) - 1) * __2pi;
-#endif
-      x1 = x[1] - (x[1] < 0.) * ((int64_t) (x[1] * __1_over_2pi) - 1) * __2pi;
-      x0 = x[0] - (x[0] < 0.) * ((int64_t) (x[0] * __1_over_2pi) - 1) * __2pi;
-      *lower = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         x3, x3,
-         x2, x2,
-#endif
-         x1, x1,
-         x0, x0
-         ); 
-      *lower *= step_phi_inv;
-#ifdef __VARR_USE_AVX512__
-      x3 = x[7] - (x[7] < 0.) * ((int64_t) (x[7] * __1_over_2pi) - 1) * __2pi;
-      x2 = x[6] - (x[6] < 0.) * ((int64_t) (x[6] * __1_over_2pi) - 1) * __2pi;
-      x1 = x[5] - (x[5] < 0.) * ((int64_t) (x[5] * __1_over_2pi) - 1) * __2pi;
-      x0 = x[4] - (x[4] < 0.) * ((int64_t) (x[4] * __1_over_2pi) - 1) * __2pi;
-#else
-      x1 = x[3] - (x[3] < 0.) * ((int64_t) (x[3] * __1_over_2pi) - 1) * __2pi;
-      x0 = x[2] - (x[2] < 0.) * ((int64_t) (x[2] * __1_over_2pi) - 1) * __2pi;
-#endif
-      *upper = _avxd_stride_set(
-#ifdef __VARR_USE_AVX512__
-         x3, x3,
-         x2, x2,
-#endif
-         x1, x1,
-         x0, x0
-         ); 
-      *upper *= step_phi_inv;
-      indexing[0u] = ((size_t) workspace[0u]) % number_of_samples;
-      indexing[1u] = ((size_t) workspace[2u]) % number_of_samples;
-      indexing[2u] = ((size_t) workspace[4u]) % number_of_samples;
-      indexing[3u] = ((size_t) workspace[6u]) % number_of_samples;
-#ifdef __VARR_USE_AVX512__
-      indexing[4u] = ((size_t) workspace[8u]) % number_of_samples;
-      indexing[5u] = ((size_t) workspace[10u]) % number_of_samples;
-      indexing[6u] = ((size_t) workspace[12u]) % number_of_samples;
-      indexing[7u] = ((size_t) workspace[14u]) % number_of_samples;
-#endif
-      alpha0 = *lower - _avxd_stride_floor(*lower);
-      alpha1 = *upper - _avxd_stride_floor(*upper);
-#ifdef __VARR_USE_AVX512__
-      *(double complex *) workspace        = values[indexing[0u]++];
-      *(double complex *) (workspace + 2u) = values[indexing[1u]++];
-      *(double complex *) (workspace + 4u) = values[indexing[2u]++];
-      *(double complex *) (workspace + 6u) = values[indexing[3u]++];
-      *(double complex *) (workspace + 8u) = values[indexing[0u]];
-      *(double complex *) (workspace + 10u) = values[indexing[1u]];
-      *(double complex *) (workspace + 12u) = values[indexing[2u]];
-      *(double complex *) (workspace + 14u) = values[indexing[3u]];
-      *__out = *upper * alpha0;
-      *__out = (*__out + (*lower * (__one - alpha0)));
-      *(double complex *) workspace        = values[indexing[4u]++];
-      *(double complex *) (workspace + 2u) = values[indexing[5u]++];
-      *(double complex *) (workspace + 4u) = values[indexing[6u]++];
-      *(double complex *) (workspace + 6u) = values[indexing[7u]++];
-      *(double complex *) (workspace + 8u) = values[indexing[4u]];
-      *(double complex *) (workspace + 10u) = values[indexing[5u]];
-      *(double complex *) (workspace + 12u) = values[indexing[6u]];
-      *(double complex *) (workspace + 14u) = values[indexing[7u]];
-      __out[1] = *upper * alpha1;
-      __out[1] = (__out[1] + (*lower * (__one - alpha1)));
-#else
-      *(double complex *) workspace        = values[indexing[0u]++];
-      *(double complex *) (workspace + 2u) = values[indexing[1u]++];
-      *(double complex *) (workspace + 4u) = values[indexing[0u]];
-      *(double complex *) (workspace + 6u) = values[indexing[1u]];
-      *__out = *upper * alpha0;
-      *__out = *__out + (*lower * (__one - alpha0));
-      *(double complex *) workspace        = values[indexing[2u]++];
-      *(double complex *) (workspace + 2u) = values[indexing[3u]++];
-      *(double complex *) (workspace + 4u) = values[indexing[2u]];
-      *(double complex *) (workspace + 6u) = values[indexing[3u]];
-      __out[1] = *upper * alpha1;
-      __out[1] = __out[1] + (*lower * (__one - alpha1));
-#endif
-      export_target[0] = alignment_emulator[0];
-      export_target[1] = alignment_emulator[1];
-      export_target[2] = alignment_emulator[2];
-      export_target[3] = alignment_emulator[3];
-#ifdef __VARR_USE_AVX512__
-      export_target[4] = alignment_emulator[4];
-      export_target[5] = alignment_emulator[5];
-      export_target[6] = alignment_emulator[6];
-      export_target[7] = alignment_emulator[7];
-#endif
-      export_target += __AVX_DOUBLE_STRIDE__;
-      continue;
+      out[i] = __cubic_spline_sampling_phasord_evaluate(*x, accelerator);
    }
-   
-   // Remainder loop:
-   
-   for(
-      register size_t i = length_avx_stride * __AVX_DOUBLE_STRIDE__;
-      i< length;
-      ++i, ++x
-      )
+   return;
+}
+
+/*
+ * The single precision phasor, linear_interpolating_phasorf, interpolates a
+ * float table of (cos, sin) samples of width two:
+ */
+typedef struct tagLinearInterpolatingPhasorFAccelerator
+{
+   float
+      step_phi_inv,
+      last_sample;
+   size_t
+      samples;
+   float const *
+      table;
+} LinearInterpolatingPhasorFAccelerator;
+
+static
+int
+linear_interpolating_phasorf_disallocate(
+   VARRPhasorFEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
    {
-      out[i] = __linear_interpolating_phasord_evaluate(
-         *x,
-         accelerator
+      return 1;
+   }
+   LinearInterpolatingPhasorFAccelerator * const
+      accelerator = (LinearInterpolatingPhasorFAccelerator *)
+         evaluator->accelerator;
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_table_cache_release(accelerator->table);
+   accelerator->samples = (size_t) 0;
+   accelerator->table = NULL;
+   __varr_free(accelerator);
+   return 0;
+}
+
+static
+LinearInterpolatingPhasorFAccelerator *
+allocate_linear_interpolating_phasorf(
+   size_t number_of_samples
+   )
+{
+   double const
+      step_size = __2pi / (double) number_of_samples;
+   // The float table is rounded from the samples of the double table:
+   VARRTableKey const
+      key = {
+         .function = "phasor",
+         .method = "float linear interpolation",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_INTERLEAVED,
+         .precision = VARR_TABLE_FLOAT,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   LinearInterpolatingPhasorFAccelerator * const
+      result = (LinearInterpolatingPhasorFAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__,
+         sizeof(LinearInterpolatingPhasorFAccelerator)
+         );
+   result->step_phi_inv = (float) (1. / step_size);
+   result->last_sample = (float) number_of_samples;
+   result->samples = number_of_samples;
+   result->table = __varr_shared_float_table(
+      &key,
+      linear_interpolating_phasord_samples,
+      number_of_samples + 2u,
+      2u
+      );
+   return
+      result;
+}
+
+static inline
+float complex
+__linear_interpolating_phasorf_evaluate(
+   register float phi,
+   register LinearInterpolatingPhasorFAccelerator const * accelerator
+   )
+{
+   register float
+      step_frac = (float) (
+         __varr_float_reduce_2pi(phi) * (double) accelerator->step_phi_inv
          );
+   step_frac = fminf(fmaxf(step_frac, 0.f), accelerator->last_sample);
+   register size_t const
+      index = (size_t) step_frac;
+   step_frac -= (float) index;
+   return
+      __varr_interpolate_float_component(
+         accelerator->table, 2u, index, step_frac, 0u
+         )
+    + __varr_interpolate_float_component(
+         accelerator->table, 2u, index, step_frac, 1u
+         ) * I;
+}
+
+static
+float complex
+linear_interpolating_phasorf_evaluate(
+   register float phi,
+   register void const * restrict accelerator
+   )
+{
+   return
+      __linear_interpolating_phasorf_evaluate(
+         phi, (LinearInterpolatingPhasorFAccelerator const *) accelerator
+         );
+}
+
+static
+void
+linear_interpolating_phasorf_batch_evaluate_scalar(
+   register float const * restrict x,
+   register float complex * restrict out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   register LinearInterpolatingPhasorFAccelerator const * const
+      accelerator = 
+          ((LinearInterpolatingPhasorFAccelerator const *) __accelerator);
+   for(register size_t i = (size_t) 0u; i< length; ++i, ++x)
+   {
+      out[i] = __linear_interpolating_phasorf_evaluate(*x, accelerator);
    }
-#endif
    return;
 }
 
+#define __VARR_SIMD_KERNELS__ "varr_phasor.batch.h"
+#define __VARR_SIMD_STREAMING__
+#include "varr_simd_instantiate.h"
+
 VARRPhasorDEvaluator
 linear_interpolating_phasord(size_t number_of_samples)
 {
@@ -460,12 +532,107 @@ linear_interpolating_phasord(size_t number_of_samples)
       result;
    LinearInterpolatingPhasorDAccelerator * const
       accelerator = allocate_linear_interpolating_PhasorD(
-         number_of_samples
+         number_of_samples,
+         __varr_table_format().layout,
+         __varr_table_format().precision
          );
    result.accelerator = (void *) accelerator;
    result.phasord = linear_interpolating_phasord_evaluate;
-   result.phasord_array = linear_interpolating_phasord_batch_evaluate;
+   result.phasord_array =
+      __varr_simd_select(linear_interpolating_phasord_batch_evaluate);
    result.disallocate = linear_interpolating_phasord_disallocate;
    return
       result;
 }
+
+VARRPhasorDEvaluator
+cubic_spline_sampling_phasord(size_t number_of_samples)
+{
+   VARRPhasorDEvaluator
+      result;
+   CubicSplineInterpolatingPhasorDAccelerator * const
+      accelerator = allocate_cubic_spline_sampling_phasord(
+         number_of_samples
+         );
+   result.accelerator = (void *) accelerator;
+   result.phasord = cubic_spline_sampling_phasord_evaluate;
+   result.phasord_array =
+      __varr_simd_select(cubic_spline_sampling_phasord_batch_evaluate);
+   result.disallocate = cubic_spline_sampling_phasord_disallocate;
+   return
+      result;
+}
+
+VARRPhasorFEvaluator
+linear_interpolating_phasorf(size_t number_of_samples)
+{
+   VARRPhasorFEvaluator
+      result;
+   LinearInterpolatingPhasorFAccelerator * const
+      accelerator = allocate_linear_interpolating_phasorf(number_of_samples);
+   result.accelerator = (void *) accelerator;
+   result.phasorf = linear_interpolating_phasorf_evaluate;
+   result.phasorf_array =
+      __varr_simd_select(linear_interpolating_phasorf_batch_evaluate);
+   result.disallocate = linear_interpolating_phasorf_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__):
+ */
+
+static
+void
+measure_linear_interpolating_phasord(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(LinearInterpolatingPhasorDAccelerator));
+   __varr_measure_shared_sample_table(
+      number_of_samples + 2u,
+      2u,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_cubic_spline_sampling_phasord(size_t number_of_samples)
+{
+   __varr_allocation_measure(
+      sizeof(CubicSplineInterpolatingPhasorDAccelerator)
+      );
+   __varr_measure_shared_array(
+      sizeof(double complex), (size_t) 4u * (number_of_samples + (size_t) 1u)
+      );
+}
+
+static
+void
+measure_linear_interpolating_phasorf(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(LinearInterpolatingPhasorFAccelerator));
+   __varr_measure_shared_float_table(number_of_samples + 2u, 2u);
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRPhasorDEvaluator,
+   cubic_spline_sampling_phasord
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRPhasorDEvaluator,
+   linear_interpolating_phasord
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRPhasorDEvaluator,
+   linear_interpolating_phasord
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRPhasorFEvaluator,
+   linear_interpolating_phasorf
+   )
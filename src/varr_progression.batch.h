@@ -0,0 +1,227 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD kernels of varr_progression.c.  This file is included by 
+ * varr_progression.c (through varr_simd_instantiate.h) once per SIMD target,
+ * see varr_simd_target.h.
+ */
+
+/*
+ * As progression_fill_scalar, with the indices begin + j kept in a vector
+ * of doubles (exact below 2**53):
+ */
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(progression_fill)(
+   double x0,
+   double dx,
+   size_t begin,
+   register double * x,
+   register size_t length
+   )
+{
+   double
+      lanes[__AVX_DOUBLE_STRIDE__];
+   for(size_t j = (size_t) 0u; j< __AVX_DOUBLE_STRIDE__; ++j)
+   {
+      lanes[j] = (double) (begin + j);
+   }
+   register avxd_array_t const
+      __x0 = _avxd_stride_set_duplicates(x0),
+      __dx = _avxd_stride_set_duplicates(dx),
+      __stride = _avxd_stride_set_duplicates((double) __AVX_DOUBLE_STRIDE__);
+   register avxd_array_t
+      k = _avxd_stride_load(lanes);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(x, __x0 + __dx * k);
+      k += __stride;
+      x += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      _avxd_stride_store_partial(
+         x, _avxd_stride_lanes(length), __x0 + __dx * k
+         );
+   }
+   return;
+}
+
+/*
+ * As progression_fillf_scalar, with the indices begin + j kept in a vector
+ * of 32-bit integers (for progressions of less than 2**31 floats):
+ */
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(progression_fillf)(
+   float x0,
+   float dx,
+   size_t begin,
+   register float * x,
+   register size_t length
+   )
+{
+   float
+      lanes[__AVX_FLOAT_STRIDE__];
+   for(size_t j = (size_t) 0u; j< __AVX_FLOAT_STRIDE__; ++j)
+   {
+      lanes[j] = (float) j;
+   }
+   register avxf_array_t const
+      __x0 = _avxf_stride_set_duplicates(x0),
+      __dx = _avxf_stride_set_duplicates(dx);
+   register avxfi_array_t const
+      __stride = _avxfi_stride_set_duplicates((int) __AVX_FLOAT_STRIDE__);
+   register avxfi_array_t
+      k = _avxfi_stride_add(
+         _avxf_stride_index(_avxf_stride_load(lanes)),
+         _avxfi_stride_set_duplicates((int) begin)
+         );
+   for(
+      ;
+      length >= __AVX_FLOAT_STRIDE__;
+      length -= __AVX_FLOAT_STRIDE__
+      )
+   {
+      _avxf_stride_store(x, __x0 + __dx * _avxfi_stride_to_avxf(k));
+      k = _avxfi_stride_add(k, __stride);
+      x += __AVX_FLOAT_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      _avxf_stride_store_partial(
+         x,
+         _avxf_stride_lanes(length),
+         __x0 + __dx * _avxfi_stride_to_avxf(k)
+         );
+   }
+   return;
+}
+
+/*
+ * As progression_rotate_scalar:
+ */
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(progression_rotate)(
+   double re,
+   double im,
+   register double const * cos_j,
+   register double const * sin_j,
+   register double complex * out,
+   register size_t length
+   )
+{
+   register avxd_array_t const
+      __re = _avxd_stride_set_duplicates(re),
+      __im = _avxd_stride_set_duplicates(im);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      register avxd_array_t const
+         c = _avxd_stride_load(cos_j),
+         s = _avxd_stride_load(sin_j);
+      _avxd_stride_store_interleaved(
+         (double *) out, __re * c - __im * s, __im * c + __re * s
+         );
+      cos_j += __AVX_DOUBLE_STRIDE__;
+      sin_j += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      register avxd_array_t const
+         c = _avxd_stride_load_partial(
+            cos_j, lanes, _avxd_stride_set_duplicates(0.)
+            ),
+         s = _avxd_stride_load_partial(
+            sin_j, lanes, _avxd_stride_set_duplicates(0.)
+            );
+      _avxd_stride_store_interleaved_partial(
+         (double *) out, length, __re * c - __im * s, __im * c + __re * s
+         );
+   }
+   return;
+}
+
+/*
+ * As progression_scale_scalar:
+ */
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(progression_scale)(
+   double anchor,
+   register double const * scales,
+   register double * out,
+   register size_t length
+   )
+{
+   register avxd_array_t const
+      __anchor = _avxd_stride_set_duplicates(anchor);
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(out, __anchor * _avxd_stride_load(scales));
+      scales += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __anchor * _avxd_stride_load_partial(
+            scales, lanes, _avxd_stride_set_duplicates(0.)
+            )
+         );
+   }
+   return;
+}
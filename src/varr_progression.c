@@ -0,0 +1,334 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_progression.h"
+#include "varr_internal.h"
+
+#include <complex.h>
+#include <math.h>
+#include <stddef.h>
+
+/*
+ * The inputs of varr_progression_batchd and varr_progression_batchf are 
+ * generated by chunks of this many (a first level cache resident 4 KB of 
+ * doubles):
+ */
+#define __VARR_PROGRESSION_CHUNK__ ((size_t) 512u)
+
+/*
+ * The phasors of varr_progression_phasord (and the exponentials of 
+ * varr_progression_expd) are rotated (or scaled) from an anchor by blocks 
+ * of this many, the anchors of 64 blocks being evaluated by one batch:
+ */
+#define __VARR_PROGRESSION_BLOCK__ ((size_t) 64u)
+#define __VARR_PROGRESSION_ANCHORS__ ((size_t) 64u)
+
+/*
+ * The exponentials of inputs within these bounds are normal:
+ */
+#define __VARR_PROGRESSION_EXP_LOWER__ (-708.)
+#define __VARR_PROGRESSION_EXP_UPPER__ 709.
+
+/*
+ * Assigns x[j] = x0 + dx * (begin + j), for j < length:
+ */
+static
+void
+progression_fill_scalar(
+   double x0,
+   double dx,
+   size_t begin,
+   register double * x,
+   register size_t length
+   )
+{
+   for(register size_t j = (size_t) 0u; j< length; ++j)
+   {
+      x[j] = x0 + dx * (double) (begin + j);
+   }
+}
+
+static
+void
+progression_fillf_scalar(
+   float x0,
+   float dx,
+   size_t begin,
+   register float * x,
+   register size_t length
+   )
+{
+   for(register size_t j = (size_t) 0u; j< length; ++j)
+   {
+      x[j] = x0 + dx * (float) (begin + j);
+   }
+}
+
+/*
+ * Assigns out[j] = (re + i im) * (cos_j[j] + i sin_j[j]), for j < length:
+ */
+static
+void
+progression_rotate_scalar(
+   double re,
+   double im,
+   register double const * cos_j,
+   register double const * sin_j,
+   register double complex * out,
+   register size_t length
+   )
+{
+   register double * const
+      values = (double *) out;
+   for(register size_t j = (size_t) 0u; j< length; ++j)
+   {
+      values[(size_t) 2u * j] = re * cos_j[j] - im * sin_j[j];
+      values[(size_t) 2u * j + (size_t) 1u] = im * cos_j[j] + re * sin_j[j];
+   }
+}
+
+/*
+ * Assigns out[j] = anchor * scales[j], for j < length:
+ */
+static
+void
+progression_scale_scalar(
+   double anchor,
+   register double const * scales,
+   register double * out,
+   register size_t length
+   )
+{
+   for(register size_t j = (size_t) 0u; j< length; ++j)
+   {
+      out[j] = anchor * scales[j];
+   }
+}
+
+#define __VARR_SIMD_KERNELS__ "varr_progression.batch.h"
+#include "varr_simd_instantiate.h"
+
+/*
+ * Evaluates 'batch' for the inputs x0 + k * dx, begin <= k < begin + length,
+ * into out[k - begin], by chunks:
+ */
+static
+void
+progression_batchd(
+   void (* batch) (double const *, double *, size_t, void const *),
+   double x0,
+   double dx,
+   size_t begin,
+   double * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   void (* const fill) (double, double, size_t, double *, size_t) =
+      __varr_simd_select(progression_fill);
+   double
+      x[__VARR_PROGRESSION_CHUNK__];
+   for(size_t done = (size_t) 0u; done< length;)
+   {
+      register size_t const
+         chunk = (length - done < __VARR_PROGRESSION_CHUNK__) ?
+            length - done
+            :
+            __VARR_PROGRESSION_CHUNK__;
+      fill(x0, dx, begin + done, x, chunk);
+      batch(x, out + done, chunk, accelerator);
+      done += chunk;
+   }
+}
+
+void
+varr_progression_batchd(
+   void (* batch) (double const *, double *, size_t, void const *),
+   double x0,
+   double dx,
+   double * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   progression_batchd(batch, x0, dx, (size_t) 0u, out, length, accelerator);
+}
+
+void
+varr_progression_batchf(
+   void (* batch) (float const *, float *, size_t, void const *),
+   float x0,
+   float dx,
+   float * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   void (* const fill) (float, float, size_t, float *, size_t) =
+      __varr_simd_select(progression_fillf);
+   float
+      x[__VARR_PROGRESSION_CHUNK__];
+   for(size_t begin = (size_t) 0u; begin< length;)
+   {
+      register size_t const
+         chunk = (length - begin < __VARR_PROGRESSION_CHUNK__) ?
+            length - begin
+            :
+            __VARR_PROGRESSION_CHUNK__;
+      fill(x0, dx, begin, x, chunk);
+      batch(x, out + begin, chunk, accelerator);
+      begin += chunk;
+   }
+}
+
+void
+varr_progression_expd(
+   void (* batch) (double const *, double *, size_t, void const *),
+   double x0,
+   double dx,
+   double * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   void (* const scale) (double, double const *, double *, size_t) =
+      __varr_simd_select(progression_scale);
+   register size_t const
+      number_of_scales = (length < __VARR_PROGRESSION_BLOCK__) ?
+         length
+         :
+         __VARR_PROGRESSION_BLOCK__;
+   double
+      scales[__VARR_PROGRESSION_BLOCK__],
+      x[__VARR_PROGRESSION_ANCHORS__],
+      e[__VARR_PROGRESSION_ANCHORS__];
+   // Scales that are not normal (or a step that is not finite) are not used:
+   if(
+      !(
+         fabs(dx) * (double) (__VARR_PROGRESSION_BLOCK__ - 1u)
+         <= -__VARR_PROGRESSION_EXP_LOWER__
+         )
+      )
+   {
+      progression_batchd(batch, x0, dx, (size_t) 0u, out, length, accelerator);
+      return;
+   }
+   for(size_t j = (size_t) 0u; j< number_of_scales; ++j)
+   {
+      scales[j] = exp(dx * (double) j);
+   }
+   for(size_t anchor = (size_t) 0u; anchor< length;)
+   {
+      register size_t
+         anchors = (size_t) 0u;
+      for(
+         ;
+         anchors< __VARR_PROGRESSION_ANCHORS__
+      && anchor + __VARR_PROGRESSION_BLOCK__ * anchors< length;
+         ++anchors
+         )
+      {
+         x[anchors] = 
+            x0 + dx * (double) (anchor + __VARR_PROGRESSION_BLOCK__ * anchors);
+      }
+      batch(x, e, anchors, accelerator);
+      for(register size_t a = (size_t) 0u; a< anchors; ++a)
+      {
+         register size_t const
+            block = (length - anchor < __VARR_PROGRESSION_BLOCK__) ?
+               length - anchor
+               :
+               __VARR_PROGRESSION_BLOCK__;
+         double const
+            last = x[a] + dx * (double) (block - 1u);
+         if(
+            (fmin(x[a], last) >= __VARR_PROGRESSION_EXP_LOWER__)
+            && (fmax(x[a], last) <= __VARR_PROGRESSION_EXP_UPPER__)
+            )
+         {
+            scale(e[a], scales, out + anchor, block);
+         }
+         else
+         {
+            progression_batchd(
+               batch, x0, dx, anchor, out + anchor, block, accelerator
+               );
+         }
+         anchor += block;
+      }
+   }
+}
+
+void
+varr_progression_phasord(
+   void (* batch) (double const *, double complex *, size_t, void const *),
+   double x0,
+   double dx,
+   double complex * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   void (* const rotate) (
+      double, double, double const *, double const *, double complex *, size_t
+      ) = __varr_simd_select(progression_rotate);
+   register size_t const
+      number_of_rotations = (length < __VARR_PROGRESSION_BLOCK__) ?
+         length
+         :
+         __VARR_PROGRESSION_BLOCK__;
+   double
+      cos_j[__VARR_PROGRESSION_BLOCK__],
+      sin_j[__VARR_PROGRESSION_BLOCK__],
+      x[__VARR_PROGRESSION_ANCHORS__];
+   double complex
+      z[__VARR_PROGRESSION_ANCHORS__];
+   for(size_t j = (size_t) 0u; j< number_of_rotations; ++j)
+   {
+      cos_j[j] = cos(dx * (double) j);
+      sin_j[j] = sin(dx * (double) j);
+   }
+   for(size_t anchor = (size_t) 0u; anchor< length;)
+   {
+      register size_t
+         anchors = (size_t) 0u;
+      for(
+         ;
+         anchors< __VARR_PROGRESSION_ANCHORS__
+      && anchor + __VARR_PROGRESSION_BLOCK__ * anchors< length;
+         ++anchors
+         )
+      {
+         x[anchors] = 
+            x0 + dx * (double) (anchor + __VARR_PROGRESSION_BLOCK__ * anchors);
+      }
+      batch(x, z, anchors, accelerator);
+      for(register size_t a = (size_t) 0u; a< anchors; ++a)
+      {
+         register size_t const
+            block = (length - anchor < __VARR_PROGRESSION_BLOCK__) ?
+               length - anchor
+               :
+               __VARR_PROGRESSION_BLOCK__;
+         rotate(creal(z[a]), cimag(z[a]), cos_j, sin_j, out + anchor, block);
+         anchor += block;
+      }
+   }
+}
@@ -0,0 +1,125 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_simd.h"
+#include "varr_internal.h"
+
+static int
+   __varr_simd_detected_level = -1;
+
+static VARRSimdLevel
+   __varr_simd_level_limit = VARR_SIMD_AVX512;
+
+__thread size_t
+   __varr_streaming_batch_bytes = (size_t) 0u;
+
+static
+VARRSimdLevel
+detect_simd_level(void)
+{
+#ifdef __VARR_HAS_SIMD_DISPATCH__
+   __builtin_cpu_init();
+   if(
+      __builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx2") &&
+      __builtin_cpu_supports("fma")
+      )
+   {
+      return VARR_SIMD_AVX512;
+   }
+   if(
+      __builtin_cpu_supports("avx2") &&
+      __builtin_cpu_supports("fma")
+      )
+   {
+      return VARR_SIMD_AVX2;
+   }
+#endif
+   return VARR_SIMD_SCALAR;
+}
+
+VARRSimdLevel
+varr_simd_supported_level(void)
+{
+   // Detection is idempotent, so concurrent first calls may each detect, as
+   // long as the level is published atomically:
+   register int
+      level = __atomic_load_n(&__varr_simd_detected_level, __ATOMIC_RELAXED);
+   if(level < 0)
+   {
+      level = (int) detect_simd_level();
+      __atomic_store_n(&__varr_simd_detected_level, level, __ATOMIC_RELAXED);
+   }
+   return
+      (VARRSimdLevel) level;
+}
+
+VARRSimdLevel
+varr_simd_level(void)
+{
+   register VARRSimdLevel const
+      supported = varr_simd_supported_level();
+   return
+      (supported < __varr_simd_level_limit) ?
+         supported
+         :
+         __varr_simd_level_limit;
+}
+
+VARRSimdLevel
+varr_set_simd_level(VARRSimdLevel level)
+{
+   __varr_simd_level_limit = 
+      (level < VARR_SIMD_SCALAR) ? VARR_SIMD_SCALAR : level;
+   return
+      varr_simd_level();
+}
+
+char const *
+varr_simd_level_name(VARRSimdLevel level)
+{
+   switch(level)
+   {
+   case VARR_SIMD_SCALAR:
+      return "scalar";
+   case VARR_SIMD_AVX2:
+      return "avx2";
+   case VARR_SIMD_AVX512:
+      return "avx512";
+   }
+   return "unknown";
+}
+
+size_t
+varr_set_streaming_batch_bytes(size_t bytes)
+{
+   size_t const
+      previous = __varr_streaming_batch_bytes;
+   __varr_streaming_batch_bytes = bytes;
+   return
+      previous;
+}
+
+size_t
+varr_streaming_batch_bytes(void)
+{
+   return
+      __varr_streaming_batch_bytes;
+}
@@ -0,0 +1,67 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Instantiates the batch kernels in the file named by __VARR_SIMD_KERNELS__
+ * once for each SIMD target, eg.
+ *
+ *    #define __VARR_SIMD_KERNELS__ "varr_exp.batch.h"
+ *    #include "varr_simd_instantiate.h"
+ *
+ * The kernel file is included after everything it refers to (accelerator
+ * structures, tables and scalar evaluators) has been defined.  Without
+ * run-time dispatch nothing is instantiated, and only the _scalar variants
+ * remain.
+ *
+ * If __VARR_SIMD_STREAMING__ is also defined, the kernels are first 
+ * instantiated for each target with non-temporal stores (see 
+ * __VARR_SIMD_STREAMED__ in varr_simd_target.h), for the streaming batches
+ * of the kernels stored as usual, each of which must then begin with 
+ * __VARR_SIMD_STREAMING_BATCH.
+ */
+
+#ifdef __VARR_HAS_SIMD_DISPATCH__
+
+#undef __VARR_SIMD_TARGET__
+#define __VARR_SIMD_TARGET__ __VARR_SIMD_TARGET_AVX2__
+#ifdef __VARR_SIMD_STREAMING__
+#define __VARR_SIMD_STREAMED__
+#include "varr_simd_target.h"
+#include __VARR_SIMD_KERNELS__
+#undef __VARR_SIMD_STREAMED__
+#endif
+#include "varr_simd_target.h"
+#include __VARR_SIMD_KERNELS__
+
+#undef __VARR_SIMD_TARGET__
+#define __VARR_SIMD_TARGET__ __VARR_SIMD_TARGET_AVX512__
+#ifdef __VARR_SIMD_STREAMING__
+#define __VARR_SIMD_STREAMED__
+#include "varr_simd_target.h"
+#include __VARR_SIMD_KERNELS__
+#undef __VARR_SIMD_STREAMED__
+#endif
+#include "varr_simd_target.h"
+#include __VARR_SIMD_KERNELS__
+
+#endif
+
+#undef __VARR_SIMD_KERNELS__
+#undef __VARR_SIMD_STREAMING__
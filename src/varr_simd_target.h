@@ -0,0 +1,2013 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Defines the vector types and stride macros of the SIMD target selected by
+ * __VARR_SIMD_TARGET__ (one of __VARR_SIMD_TARGET_AVX2__ and
+ * __VARR_SIMD_TARGET_AVX512__).  This file is deliberately not guarded, and
+ * is included once per target by varr_simd_instantiate.h; batch kernels are
+ * written against:
+ *
+ *    __VARR_SIMD_FUNCTION__     function attribute enabling the target ISA
+ *    __VARR_SIMD_NAME(name)     name, suffixed with the target (eg. name_avx2)
+ *    avxd_array_t               a vector of __AVX_DOUBLE_STRIDE__ doubles
+ *    avxd_mask_t                a lane mask, as returned by comparisons
+ *    avxi_array_t               __AVX_DOUBLE_STRIDE__ 32-bit (table) indices
+ *    avxl_array_t               __AVX_DOUBLE_STRIDE__ 64-bit integers
+ *    _avxd_stride_*             operations on avxd_array_t
+ *    _avxi_stride_*             operations on avxi_array_t
+ *    _avxl_stride_*             operations on avxl_array_t
+ *
+ * Partial strides (eg. the tail of a batch) are loaded and stored through
+ * the avxd_lanes_t returned by _avxd_stride_lanes(n), which selects the
+ * first n < __AVX_DOUBLE_STRIDE__ lanes; other lanes are neither read nor
+ * written, and take a caller supplied (safe) value on loading.
+ *
+ * Table lookups (_avxd_stride_gather) take 32-bit indices, as converted by
+ * _avxd_stride_index from non-negative doubles, which limits tables to 2**31
+ * entries.  _avxd_stride_gather_long takes 64-bit indices, eg. exponents
+ * extracted from the bits of an avxd_array_t.  Where a table interleaves
+ * several quantities, _avxd_stride_gather_quads(table, index, quads) instead
+ * loads the four consecutive doubles at each index (one vector load per
+ * lane), and transposes them to quads[0] to quads[3].
+ *
+ * _avxd_stride_interpolate(table, index, alpha) interpolates linearly
+ * between the samples index and index + 1 of a VARRSampleTable (see
+ * varr_internal.h) of width one, of any layout and precision, and 
+ * _avxd_stride_interpolate_pair(table, index, alpha, first, second) does so
+ * for both components of a table of width two.  Pairs of an interleaved 
+ * table of doubles are loaded by one 16 byte load per lane, as for 
+ * gather_quads, and pairs of floats by one 64-bit gather.
+ *
+ * _avxd_stride_interpolate_window(table, index, alpha) returns the same as
+ * _avxd_stride_interpolate, but first tests whether the indices of the 
+ * stride lie within a short window of consecutive samples, as they do for
+ * sorted inputs (eg. monotone grids).  The window of a table of doubles is 
+ * then read by contiguous masked loads, and permuted to the lanes, in place
+ * of the two gathers.  (Pairs are already loaded by one vector load per 
+ * lane, which a window does not improve upon.)
+ *
+ * The single precision evaluators (eg. linear_sampling_expf) are written
+ * against the float counterparts of these:
+ *
+ *    avxf_array_t               a vector of __AVX_FLOAT_STRIDE__ floats
+ *    avxf_mask_t                a lane mask, as returned by comparisons
+ *    avxfi_array_t              __AVX_FLOAT_STRIDE__ 32-bit integers
+ *    _avxf_stride_*             operations on avxf_array_t
+ *    _avxfi_stride_*            operations on avxfi_array_t
+ *
+ * whose partial strides are selected by the avxf_lanes_t returned by
+ * _avxf_stride_lanes(n).  _avxf_stride_interpolate(table, index, alpha)
+ * interpolates in a float table of interleaved (sample, difference) pairs
+ * (see __varr_float_interleaved_table in varr_internal.h) by one 64-bit 
+ * gather per lane, and _avxf_stride_interpolate_pair does so for tables of
+ * width two by two such gathers.
+ *
+ * If __VARR_SIMD_STREAMED__ is defined, the kernels are instead named
+ * name_avx2_streamed (and name_avx512_streamed), and their full 
+ * strides are stored by aligned non-temporal stores (_avxd_stride_store, 
+ * _avxf_stride_store and their interleaved variants; partial strides are 
+ * stored as usual).  Each batch kernel of a file instantiated so (see 
+ * varr_simd_instantiate.h) begins with
+ *
+ *    __VARR_SIMD_STREAMING_BATCH(name, x, out, length, accelerator);
+ *
+ * which, in the kernel stored as usual, evaluates a batch selected by 
+ * __varr_streaming_batch (see varr_internal.h) by the streamed kernel: first
+ * the outputs before the first vector aligned output (fewer than a stride, 
+ * so by a partial stride), then the others from there, and returns after a
+ * single store fence.
+ */
+
+#undef __VARR_SIMD_FUNCTION__
+#undef __VARR_SIMD_NAME
+#undef __VARR_SIMD_STREAMING_BATCH
+#undef avxd_array_t
+#undef __AVX_DOUBLE_STRIDE__
+#undef _avxd_stride_max
+#undef _avxd_stride_min
+#undef _avxd_stride_floor
+#undef _avxd_stride_set
+#undef _avxd_stride_set_duplicates
+#undef avxd_mask_t
+#undef avxi_array_t
+#undef avxl_array_t
+#undef _avxd_stride_load
+#undef _avxd_stride_store
+#undef _avxd_stride_fmadd
+#undef _avxd_stride_fnmadd
+#undef _avxd_stride_less_than
+#undef _avxd_stride_blend
+#undef _avxd_stride_index
+#undef _avxd_stride_gather
+#undef _avxd_stride_gather_long
+#undef _avxd_stride_gather_quads
+#undef _avxd_stride_interpolate
+#undef _avxd_stride_interpolate_pair
+#undef _avxd_stride_interpolate_window
+#undef _avxd_stride_as_avxl
+#undef _avxd_stride_store_interleaved
+#undef avxd_lanes_t
+#undef _avxd_stride_lanes
+#undef _avxd_stride_load_partial
+#undef _avxd_stride_store_partial
+#undef _avxd_stride_store_interleaved_partial
+#undef _avxi_stride_add
+#undef _avxi_stride_set_duplicates
+#undef _avxl_stride_as_avxd
+#undef _avxl_stride_shift_left
+#undef _avxl_stride_shift_right
+#undef _avxl_stride_and
+#undef _avxl_stride_or
+#undef _avxl_stride_add
+#undef _avxl_stride_sub
+#undef _avxl_stride_set_duplicates
+#undef avxf_array_t
+#undef __AVX_FLOAT_STRIDE__
+#undef avxf_mask_t
+#undef avxfi_array_t
+#undef _avxf_stride_max
+#undef _avxf_stride_min
+#undef _avxf_stride_floor
+#undef _avxf_stride_set_duplicates
+#undef _avxf_stride_load
+#undef _avxf_stride_store
+#undef _avxf_stride_fmadd
+#undef _avxf_stride_fnmadd
+#undef _avxf_stride_less_than
+#undef _avxf_stride_blend
+#undef _avxf_stride_index
+#undef _avxf_stride_gather
+#undef _avxf_stride_interpolate
+#undef _avxf_stride_interpolate_pair
+#undef _avxf_stride_as_avxfi
+#undef _avxf_stride_store_interleaved
+#undef avxf_lanes_t
+#undef _avxf_stride_lanes
+#undef _avxf_stride_load_partial
+#undef _avxf_stride_store_partial
+#undef _avxf_stride_store_interleaved_partial
+#undef _avxfi_stride_as_avxf
+#undef _avxfi_stride_to_avxf
+#undef _avxfi_stride_shift_left
+#undef _avxfi_stride_shift_right
+#undef _avxfi_stride_and
+#undef _avxfi_stride_or
+#undef _avxfi_stride_add
+#undef _avxfi_stride_sub
+#undef _avxfi_stride_set_duplicates
+
+#if __VARR_SIMD_TARGET__ == __VARR_SIMD_TARGET_AVX2__
+
+#define __VARR_SIMD_FUNCTION__ __attribute__((target("avx2,fma")))
+#define avxd_array_t __m256d
+#define __AVX_DOUBLE_STRIDE__ ((size_t) 4u)
+#define _avxd_stride_max _mm256_max_pd
+#define _avxd_stride_min _mm256_min_pd
+#define _avxd_stride_floor _mm256_floor_pd
+#define _avxd_stride_set _mm256_set_pd
+#define _avxd_stride_set_duplicates _mm256_set1_pd
+#define avxd_mask_t __m256d
+#define avxi_array_t __m128i
+#define avxl_array_t __m256i
+#define _avxd_stride_load _mm256_loadu_pd
+#define _avxd_stride_fmadd _mm256_fmadd_pd
+#define _avxd_stride_fnmadd _mm256_fnmadd_pd
+#define _avxd_stride_less_than(a, b) _mm256_cmp_pd((a), (b), _CMP_LT_OQ)
+#define _avxd_stride_blend(mask, a, b) _mm256_blendv_pd((a), (b), (mask))
+#define _avxd_stride_index _mm256_cvttpd_epi32
+#define _avxd_stride_gather(table, index) \
+   _mm256_i32gather_pd((table), (index), 8)
+#define _avxd_stride_gather_long(table, index) \
+   _mm256_i64gather_pd((table), (index), 8)
+#define _avxd_stride_gather_quads __varr_avx2_gather_quads
+#define _avxd_stride_interpolate __varr_avx2_interpolate
+#define _avxd_stride_interpolate_pair __varr_avx2_interpolate_pair
+#define _avxd_stride_interpolate_window __varr_avx2_interpolate_window
+#define _avxd_stride_as_avxl _mm256_castpd_si256
+#define avxd_lanes_t __m256i
+#define _avxd_stride_lanes(n) \
+   _mm256_cmpgt_epi64( \
+      _mm256_set1_epi64x((long long) (n)), \
+      _mm256_set_epi64x(3, 2, 1, 0) \
+      )
+#define _avxd_stride_load_partial(p, lanes, fill) \
+   _mm256_blendv_pd( \
+      (fill), _mm256_maskload_pd((p), (lanes)), _mm256_castsi256_pd(lanes) \
+      )
+#define _avxd_stride_store_partial(p, lanes, v) \
+   _mm256_maskstore_pd((p), (lanes), (v))
+#define _avxd_stride_store_interleaved_partial \
+   __varr_avx2_store_interleaved_partial
+#define _avxi_stride_add _mm_add_epi32
+#define _avxi_stride_set_duplicates _mm_set1_epi32
+#define _avxl_stride_as_avxd _mm256_castsi256_pd
+#define _avxl_stride_shift_left _mm256_slli_epi64
+#define _avxl_stride_shift_right _mm256_srli_epi64
+#define _avxl_stride_and _mm256_and_si256
+#define _avxl_stride_or _mm256_or_si256
+#define _avxl_stride_add _mm256_add_epi64
+#define _avxl_stride_sub _mm256_sub_epi64
+#define _avxl_stride_set_duplicates _mm256_set1_epi64x
+#define avxf_array_t __m256
+#define __AVX_FLOAT_STRIDE__ ((size_t) 8u)
+#define avxf_mask_t __m256
+#define avxfi_array_t __m256i
+#define _avxf_stride_max _mm256_max_ps
+#define _avxf_stride_min _mm256_min_ps
+#define _avxf_stride_floor _mm256_floor_ps
+#define _avxf_stride_set_duplicates _mm256_set1_ps
+#define _avxf_stride_load _mm256_loadu_ps
+#define _avxf_stride_fmadd _mm256_fmadd_ps
+#define _avxf_stride_fnmadd _mm256_fnmadd_ps
+#define _avxf_stride_less_than(a, b) _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define _avxf_stride_blend(mask, a, b) _mm256_blendv_ps((a), (b), (mask))
+#define _avxf_stride_index _mm256_cvttps_epi32
+#define _avxf_stride_gather(table, index) \
+   _mm256_i32gather_ps((table), (index), 4)
+#define _avxf_stride_interpolate __varr_avx2_interpolate_float
+#define _avxf_stride_interpolate_pair __varr_avx2_interpolate_float_pair
+#define _avxf_stride_as_avxfi _mm256_castps_si256
+#define avxf_lanes_t __m256i
+#define _avxf_stride_lanes(n) \
+   _mm256_cmpgt_epi32( \
+      _mm256_set1_epi32((int) (n)), \
+      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) \
+      )
+#define _avxf_stride_load_partial(p, lanes, fill) \
+   _mm256_blendv_ps( \
+      (fill), _mm256_maskload_ps((p), (lanes)), _mm256_castsi256_ps(lanes) \
+      )
+#define _avxf_stride_store_partial(p, lanes, v) \
+   _mm256_maskstore_ps((p), (lanes), (v))
+#define _avxf_stride_store_interleaved_partial \
+   __varr_avx2_store_interleaved_float_partial
+#define _avxfi_stride_as_avxf _mm256_castsi256_ps
+#define _avxfi_stride_to_avxf _mm256_cvtepi32_ps
+#define _avxfi_stride_shift_left _mm256_slli_epi32
+#define _avxfi_stride_shift_right _mm256_srli_epi32
+#define _avxfi_stride_and _mm256_and_si256
+#define _avxfi_stride_or _mm256_or_si256
+#define _avxfi_stride_add _mm256_add_epi32
+#define _avxfi_stride_sub _mm256_sub_epi32
+#define _avxfi_stride_set_duplicates _mm256_set1_epi32
+
+#ifdef __VARR_SIMD_STREAMED__
+#define __VARR_SIMD_NAME(name) name##_avx2_streamed
+#define __VARR_SIMD_STREAMING_BATCH(name, x, out, length, accelerator) \
+   ((void) 0)
+#define _avxd_stride_store _mm256_stream_pd
+#define _avxd_stride_store_interleaved __varr_avx2_stream_interleaved
+#define _avxf_stride_store _mm256_stream_ps
+#define _avxf_stride_store_interleaved __varr_avx2_stream_interleaved_float
+#else
+#define __VARR_SIMD_NAME(name) name##_avx2
+#define __VARR_SIMD_STREAMING_BATCH(name, x, out, length, accelerator) \
+   __varr_simd_streaming_batch( \
+      name##_avx2_streamed, x, out, length, accelerator, sizeof(__m256d) \
+      )
+#define _avxd_stride_store _mm256_storeu_pd
+#define _avxd_stride_store_interleaved __varr_avx2_store_interleaved
+#define _avxf_stride_store _mm256_storeu_ps
+#define _avxf_stride_store_interleaved __varr_avx2_store_interleaved_float
+#endif
+
+#ifndef __VARR_SIMD_TARGET_AVX2_HELPERS__
+#define __VARR_SIMD_TARGET_AVX2_HELPERS__
+
+/*
+ * Stores the pairs (re[k], im[k]) to the consecutive doubles out[2k] and
+ * out[2k + 1], eg. as double complex values:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_store_interleaved(
+   double * const out,
+   __m256d const re,
+   __m256d const im
+   )
+{
+   register __m256d const
+      lower = _mm256_unpacklo_pd(re, im),
+      upper = _mm256_unpackhi_pd(re, im);
+   _mm256_storeu_pd(out, _mm256_permute2f128_pd(lower, upper, 0x20));
+   _mm256_storeu_pd(out + 4u, _mm256_permute2f128_pd(lower, upper, 0x31));
+}
+
+/*
+ * As __varr_avx2_store_interleaved, by non-temporal stores to 32 byte 
+ * aligned 'out':
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_stream_interleaved(
+   double * const out,
+   __m256d const re,
+   __m256d const im
+   )
+{
+   register __m256d const
+      lower = _mm256_unpacklo_pd(re, im),
+      upper = _mm256_unpackhi_pd(re, im);
+   _mm256_stream_pd(out, _mm256_permute2f128_pd(lower, upper, 0x20));
+   _mm256_stream_pd(out + 4u, _mm256_permute2f128_pd(lower, upper, 0x31));
+}
+
+/*
+ * As __varr_avx2_store_interleaved, for the first n < 4 pairs only:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_store_interleaved_partial(
+   double * const out,
+   size_t const n,
+   __m256d const re,
+   __m256d const im
+   )
+{
+   register __m256d const
+      lower = _mm256_unpacklo_pd(re, im),
+      upper = _mm256_unpackhi_pd(re, im);
+   register __m256i const
+      lanes = _mm256_set_epi64x(3, 2, 1, 0);
+   _mm256_maskstore_pd(
+      out,
+      _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long) (2u * n)), lanes),
+      _mm256_permute2f128_pd(lower, upper, 0x20)
+      );
+   _mm256_maskstore_pd(
+      out + 4u,
+      _mm256_cmpgt_epi64(
+         _mm256_set1_epi64x((long long) (2u * n) - 4ll),
+         lanes
+         ),
+      _mm256_permute2f128_pd(lower, upper, 0x31)
+      );
+}
+
+/*
+ * Assigns table[index[k] + j] to lane k of quads[j], for j < 4:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_gather_quads(
+   double const * const table,
+   __m128i const index,
+   __m256d * const quads
+   )
+{
+   register __m256d const
+      row0 = _mm256_loadu_pd(table + _mm_cvtsi128_si32(index)),
+      row1 = _mm256_loadu_pd(table + _mm_extract_epi32(index, 1)),
+      row2 = _mm256_loadu_pd(table + _mm_extract_epi32(index, 2)),
+      row3 = _mm256_loadu_pd(table + _mm_extract_epi32(index, 3));
+   register __m256d const
+      even01 = _mm256_unpacklo_pd(row0, row1),
+      odd01 = _mm256_unpackhi_pd(row0, row1),
+      even23 = _mm256_unpacklo_pd(row2, row3),
+      odd23 = _mm256_unpackhi_pd(row2, row3);
+   quads[0u] = _mm256_permute2f128_pd(even01, even23, 0x20);
+   quads[1u] = _mm256_permute2f128_pd(odd01, odd23, 0x20);
+   quads[2u] = _mm256_permute2f128_pd(even01, even23, 0x31);
+   quads[3u] = _mm256_permute2f128_pd(odd01, odd23, 0x31);
+}
+
+/*
+ * Loads the two doubles at table + i, and at table + j, to the lower and
+ * upper halves of the result:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m256d
+__varr_avx2_load_pair_pair(
+   double const * const table,
+   int const i,
+   int const j
+   )
+{
+   return
+      _mm256_insertf128_pd(
+         _mm256_castpd128_pd256(_mm_loadu_pd(table + i)),
+         _mm_loadu_pd(table + j),
+         1
+         );
+}
+
+/*
+ * Assigns the two consecutive floats at table + index[k], converted to
+ * double, to lane k of first and second (one 64-bit gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_gather_float_pairs(
+   float const * const table,
+   __m128i const index,
+   __m256d * const first,
+   __m256d * const second
+   )
+{
+   register __m256 const
+      pairs = _mm256_castsi256_ps(
+         _mm256_i32gather_epi64((long long const *) table, index, 4)
+         ),
+      sorted = _mm256_permutevar8x32_ps(
+         pairs, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)
+         );
+   *first = _mm256_cvtps_pd(_mm256_castps256_ps128(sorted));
+   *second = _mm256_cvtps_pd(_mm256_extractf128_ps(sorted, 1));
+}
+
+/*
+ * Assigns the four consecutive floats at table + index[k], converted to
+ * double, to lane k of quads[j], for j < 4:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_gather_float_quads(
+   float const * const table,
+   __m128i const index,
+   __m256d * const quads
+   )
+{
+   __m128
+      row0 = _mm_loadu_ps(table + _mm_cvtsi128_si32(index)),
+      row1 = _mm_loadu_ps(table + _mm_extract_epi32(index, 1)),
+      row2 = _mm_loadu_ps(table + _mm_extract_epi32(index, 2)),
+      row3 = _mm_loadu_ps(table + _mm_extract_epi32(index, 3));
+   _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+   quads[0u] = _mm256_cvtps_pd(row0);
+   quads[1u] = _mm256_cvtps_pd(row1);
+   quads[2u] = _mm256_cvtps_pd(row2);
+   quads[3u] = _mm256_cvtps_pd(row3);
+}
+
+/*
+ * Assigns the two consecutive 16-bit corrections at corrections + index[k],
+ * times 'scale', to lane k of first and second (one 32-bit gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_gather_correction_pairs(
+   int16_t const * const corrections,
+   __m128i const index,
+   double const scale,
+   __m256d * const first,
+   __m256d * const second
+   )
+{
+   register __m128i const
+      pairs = _mm_i32gather_epi32((int const *) corrections, index, 2);
+   register __m256d const
+      __scale = _mm256_set1_pd(scale);
+   *first = _mm256_mul_pd(
+      _mm256_cvtepi32_pd(_mm_srai_epi32(_mm_slli_epi32(pairs, 16), 16)),
+      __scale
+      );
+   *second = _mm256_mul_pd(
+      _mm256_cvtepi32_pd(_mm_srai_epi32(pairs, 16)),
+      __scale
+      );
+}
+
+/*
+ * As __varr_avx2_gather_correction_pairs, for four consecutive corrections
+ * (one 64-bit gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_gather_correction_quads(
+   int16_t const * const corrections,
+   __m128i const index,
+   double const scale,
+   __m256d * const quads
+   )
+{
+   // The lower and upper pairs of each lane are sorted to separate halves:
+   register __m256i const
+      pairs = _mm256_permutevar8x32_epi32(
+         _mm256_i32gather_epi64((long long const *) corrections, index, 2),
+         _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)
+         );
+   register __m128i const
+      lower = _mm256_castsi256_si128(pairs),
+      upper = _mm256_extracti128_si256(pairs, 1);
+   register __m256d const
+      __scale = _mm256_set1_pd(scale);
+   quads[0u] = _mm256_mul_pd(
+      _mm256_cvtepi32_pd(_mm_srai_epi32(_mm_slli_epi32(lower, 16), 16)),
+      __scale
+      );
+   quads[1u] = _mm256_mul_pd(
+      _mm256_cvtepi32_pd(_mm_srai_epi32(lower, 16)),
+      __scale
+      );
+   quads[2u] = _mm256_mul_pd(
+      _mm256_cvtepi32_pd(_mm_srai_epi32(_mm_slli_epi32(upper, 16), 16)),
+      __scale
+      );
+   quads[3u] = _mm256_mul_pd(
+      _mm256_cvtepi32_pd(_mm_srai_epi32(upper, 16)),
+      __scale
+      );
+}
+
+/*
+ * Interpolates linearly, by alpha[k], between the samples index[k] and
+ * index[k] + 1 of a VARRSampleTable of width one:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m256d
+__varr_avx2_interpolate(
+   VARRSampleTable const * const table,
+   __m128i const index,
+   __m256d const alpha
+   )
+{
+   register __m128i const
+      row = _mm_add_epi32(index, index);
+   __m256d
+      lower,
+      upper;
+   if(table->precision == VARR_TABLE_DOUBLE)
+   {
+      register double const * const
+         values = table->values;
+      if(table->layout == VARR_TABLE_INTERLEAVED)
+      {
+         register __m256d const
+            pairs02 = __varr_avx2_load_pair_pair(
+               values, _mm_cvtsi128_si32(row), _mm_extract_epi32(row, 2)
+               ),
+            pairs13 = __varr_avx2_load_pair_pair(
+               values, _mm_extract_epi32(row, 1), _mm_extract_epi32(row, 3)
+               );
+         return
+            _mm256_fmadd_pd(
+               _mm256_unpackhi_pd(pairs02, pairs13),
+               alpha,
+               _mm256_unpacklo_pd(pairs02, pairs13)
+               );
+      }
+      return
+         _mm256_fmadd_pd(
+            _mm256_i32gather_pd(values + 1u, index, 8),
+            alpha,
+            _mm256_mul_pd(
+               _mm256_i32gather_pd(values, index, 8),
+               _mm256_sub_pd(_mm256_set1_pd(1.), alpha)
+               )
+            );
+   }
+   __varr_avx2_gather_float_pairs(
+      table->floats,
+      (table->layout == VARR_TABLE_INTERLEAVED) ? row : index,
+      &lower,
+      &upper
+      );
+   if(table->precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      __m256d
+         lower_correction,
+         upper_correction;
+      __varr_avx2_gather_correction_pairs(
+         table->corrections,
+         index,
+         table->correction_scale,
+         &lower_correction,
+         &upper_correction
+         );
+      lower = _mm256_add_pd(lower, lower_correction);
+      if(table->layout == VARR_TABLE_VALUES)
+      {
+         upper = _mm256_add_pd(upper, upper_correction);
+      }
+   }
+   if(table->layout == VARR_TABLE_INTERLEAVED)
+   {
+      return
+         _mm256_fmadd_pd(upper, alpha, lower);
+   }
+   return
+      _mm256_fmadd_pd(
+         upper,
+         alpha,
+         _mm256_mul_pd(lower, _mm256_sub_pd(_mm256_set1_pd(1.), alpha))
+         );
+}
+
+/*
+ * Interpolates linearly, by alpha[k], between the samples index[k] and
+ * index[k] + 1 of a VARRSampleTable of width two, and assigns the first and
+ * second components of the result.  The two components of a sample and of 
+ * the next sample (or of its differences to the next sample, for the 
+ * VARR_TABLE_INTERLEAVED layout) are four consecutive doubles or floats:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_interpolate_pair(
+   VARRSampleTable const * const table,
+   __m128i const index,
+   __m256d const alpha,
+   __m256d * const first,
+   __m256d * const second
+   )
+{
+   register __m128i const
+      sample = _mm_add_epi32(index, index),
+      row = (table->layout == VARR_TABLE_INTERLEAVED) ?
+         _mm_add_epi32(sample, sample)
+         :
+         sample;
+   __m256d
+      quads[4u];
+   if(table->precision == VARR_TABLE_DOUBLE)
+   {
+      __varr_avx2_gather_quads(table->values, row, quads);
+   }
+   else
+   {
+      __varr_avx2_gather_float_quads(table->floats, row, quads);
+   }
+   if(table->precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      __m256d
+         corrections[4u];
+      if(table->layout == VARR_TABLE_INTERLEAVED)
+      {
+         __varr_avx2_gather_correction_pairs(
+            table->corrections,
+            sample,
+            table->correction_scale,
+            corrections,
+            corrections + 1u
+            );
+      }
+      else
+      {
+         __varr_avx2_gather_correction_quads(
+            table->corrections, sample, table->correction_scale, corrections
+            );
+         quads[2u] = _mm256_add_pd(quads[2u], corrections[2u]);
+         quads[3u] = _mm256_add_pd(quads[3u], corrections[3u]);
+      }
+      quads[0u] = _mm256_add_pd(quads[0u], corrections[0u]);
+      quads[1u] = _mm256_add_pd(quads[1u], corrections[1u]);
+   }
+   if(table->layout == VARR_TABLE_INTERLEAVED)
+   {
+      *first = _mm256_fmadd_pd(quads[2u], alpha, quads[0u]);
+      *second = _mm256_fmadd_pd(quads[3u], alpha, quads[1u]);
+      return;
+   }
+   register __m256d const
+      beta = _mm256_sub_pd(_mm256_set1_pd(1.), alpha);
+   *first = _mm256_fmadd_pd(quads[2u], alpha, _mm256_mul_pd(quads[0u], beta));
+   *second = 
+      _mm256_fmadd_pd(quads[3u], alpha, _mm256_mul_pd(quads[1u], beta));
+}
+
+/*
+ * Returns whether the lanes of offset, the table indices of a stride less
+ * their first, all lie within [0, span] for a span (the offset of the last
+ * lane) less than width.  This holds for the indices of sorted inputs, whose
+ * samples then lie within a window of span + 2 consecutive samples:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+int
+__varr_avx2_within_window(
+   __m128i const offset,
+   int const span,
+   int const width
+   )
+{
+   register __m128i const
+      limit = _mm_set1_epi32(span);
+   return
+      ((unsigned) span < (unsigned) width)
+   && (
+         _mm_movemask_epi8(
+            _mm_cmpeq_epi32(_mm_max_epu32(offset, limit), limit)
+            ) == 0xffff
+         );
+}
+
+/*
+ * Returns, in lane k, the double at window + offset[k] for offsets below
+ * eight, of which only the first count doubles are read (by two masked loads
+ * and a permutation of each, in place of a gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m256d
+__varr_avx2_load_window(
+   double const * const window,
+   __m128i const offset,
+   int const count
+   )
+{
+   register __m256i const
+      wide = _mm256_cvtepu32_epi64(offset),
+      halves = _mm256_or_si256(
+         _mm256_or_si256(
+            _mm256_slli_epi64(wide, 1), _mm256_slli_epi64(wide, 33)
+            ),
+         _mm256_set1_epi64x(1ll << 32)
+         );
+   register __m256 const
+      lower = _mm256_castpd_ps(
+         _mm256_maskload_pd(
+            window,
+            _mm256_cmpgt_epi64(
+               _mm256_set1_epi64x(count), _mm256_set_epi64x(3, 2, 1, 0)
+               )
+            )
+         ),
+      upper = _mm256_castpd_ps(
+         _mm256_maskload_pd(
+            window + 4,
+            _mm256_cmpgt_epi64(
+               _mm256_set1_epi64x(count), _mm256_set_epi64x(7, 6, 5, 4)
+               )
+            )
+         );
+   return
+      _mm256_blendv_pd(
+         _mm256_castps_pd(_mm256_permutevar8x32_ps(lower, halves)),
+         _mm256_castps_pd(_mm256_permutevar8x32_ps(upper, halves)),
+         _mm256_castsi256_pd(_mm256_cmpgt_epi64(wide, _mm256_set1_epi64x(3)))
+         );
+}
+
+/*
+ * As __varr_avx2_interpolate, but where the indices of a table of doubles 
+ * lie within a window of eight samples (as for sorted inputs, see 
+ * __varr_avx2_within_window), the window is loaded contiguously.  The result
+ * is that of __varr_avx2_interpolate in either case:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m256d
+__varr_avx2_interpolate_window(
+   VARRSampleTable const * const table,
+   __m128i const index,
+   __m256d const alpha
+   )
+{
+   if(
+      (table->precision == VARR_TABLE_DOUBLE)
+   && (table->layout == VARR_TABLE_VALUES)
+      )
+   {
+      register int const
+         first = _mm_cvtsi128_si32(index);
+      register __m128i const
+         offset = _mm_sub_epi32(index, _mm_set1_epi32(first));
+      register int const
+         span = _mm_extract_epi32(offset, 3);
+      if(__varr_avx2_within_window(offset, span, 8))
+      {
+         register double const * const
+            window = table->values + first;
+         return
+            _mm256_fmadd_pd(
+               __varr_avx2_load_window(window + 1, offset, span + 1),
+               alpha,
+               _mm256_mul_pd(
+                  __varr_avx2_load_window(window, offset, span + 1),
+                  _mm256_sub_pd(_mm256_set1_pd(1.), alpha)
+                  )
+               );
+      }
+   }
+   return
+      __varr_avx2_interpolate(table, index, alpha);
+}
+
+/*
+ * Assigns the two consecutive floats at table + row[k] to lane k of first
+ * and second (two 64-bit gathers, of four lanes each):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_gather_float_rows(
+   float const * const table,
+   __m256i const row,
+   __m256 * const first,
+   __m256 * const second
+   )
+{
+   register __m256 const
+      lower = _mm256_castsi256_ps(
+         _mm256_i32gather_epi64(
+            (long long const *) table, _mm256_castsi256_si128(row), 4
+            )
+         ),
+      upper = _mm256_castsi256_ps(
+         _mm256_i32gather_epi64(
+            (long long const *) table, _mm256_extracti128_si256(row, 1), 4
+            )
+         );
+   // Shuffling leaves the lanes in the order 0, 1, 4, 5, 2, 3, 6, 7:
+   *first = _mm256_castpd_ps(
+      _mm256_permute4x64_pd(
+         _mm256_castps_pd(_mm256_shuffle_ps(lower, upper, 0x88)), 0xD8
+         )
+      );
+   *second = _mm256_castpd_ps(
+      _mm256_permute4x64_pd(
+         _mm256_castps_pd(_mm256_shuffle_ps(lower, upper, 0xDD)), 0xD8
+         )
+      );
+}
+
+/*
+ * Interpolates linearly, by alpha[k], in the float table of interleaved
+ * (sample, difference) pairs at row index[k]:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m256
+__varr_avx2_interpolate_float(
+   float const * const table,
+   __m256i const index,
+   __m256 const alpha
+   )
+{
+   __m256
+      sample,
+      difference;
+   __varr_avx2_gather_float_rows(
+      table, _mm256_add_epi32(index, index), &sample, &difference
+      );
+   return
+      _mm256_fmadd_ps(difference, alpha, sample);
+}
+
+/*
+ * As __varr_avx2_interpolate_float, for a table of width two, whose rows are
+ * the two components of a sample followed by their differences:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_interpolate_float_pair(
+   float const * const table,
+   __m256i const index,
+   __m256 const alpha,
+   __m256 * const first,
+   __m256 * const second
+   )
+{
+   register __m256i const
+      row = _mm256_slli_epi32(index, 2);
+   __m256
+      first_difference,
+      second_difference;
+   __varr_avx2_gather_float_rows(table, row, first, second);
+   __varr_avx2_gather_float_rows(
+      table + 2u, row, &first_difference, &second_difference
+      );
+   *first = _mm256_fmadd_ps(first_difference, alpha, *first);
+   *second = _mm256_fmadd_ps(second_difference, alpha, *second);
+}
+
+/*
+ * Stores the pairs (re[k], im[k]) to the consecutive floats out[2k] and
+ * out[2k + 1], eg. as float complex values:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_store_interleaved_float(
+   float * const out,
+   __m256 const re,
+   __m256 const im
+   )
+{
+   register __m256 const
+      lower = _mm256_unpacklo_ps(re, im),
+      upper = _mm256_unpackhi_ps(re, im);
+   _mm256_storeu_ps(out, _mm256_permute2f128_ps(lower, upper, 0x20));
+   _mm256_storeu_ps(out + 8u, _mm256_permute2f128_ps(lower, upper, 0x31));
+}
+
+/*
+ * As __varr_avx2_store_interleaved_float, by non-temporal stores to 32 byte 
+ * aligned 'out':
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_stream_interleaved_float(
+   float * const out,
+   __m256 const re,
+   __m256 const im
+   )
+{
+   register __m256 const
+      lower = _mm256_unpacklo_ps(re, im),
+      upper = _mm256_unpackhi_ps(re, im);
+   _mm256_stream_ps(out, _mm256_permute2f128_ps(lower, upper, 0x20));
+   _mm256_stream_ps(out + 8u, _mm256_permute2f128_ps(lower, upper, 0x31));
+}
+
+/*
+ * As __varr_avx2_store_interleaved_float, for the first n < 8 pairs only:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx2_store_interleaved_float_partial(
+   float * const out,
+   size_t const n,
+   __m256 const re,
+   __m256 const im
+   )
+{
+   register __m256 const
+      lower = _mm256_unpacklo_ps(re, im),
+      upper = _mm256_unpackhi_ps(re, im);
+   register __m256i const
+      lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+   _mm256_maskstore_ps(
+      out,
+      _mm256_cmpgt_epi32(_mm256_set1_epi32((int) (2u * n)), lanes),
+      _mm256_permute2f128_ps(lower, upper, 0x20)
+      );
+   _mm256_maskstore_ps(
+      out + 8u,
+      _mm256_cmpgt_epi32(_mm256_set1_epi32((int) (2u * n) - 8), lanes),
+      _mm256_permute2f128_ps(lower, upper, 0x31)
+      );
+}
+
+#endif
+
+#elif __VARR_SIMD_TARGET__ == __VARR_SIMD_TARGET_AVX512__
+
+#define __VARR_SIMD_FUNCTION__ __attribute__((target("avx512f,avx2,fma")))
+#define avxd_array_t __m512d
+#define __AVX_DOUBLE_STRIDE__ ((size_t) 8u)
+#define _avxd_stride_max _mm512_max_pd
+#define _avxd_stride_min _mm512_min_pd
+#define _avxd_stride_floor(x) \
+   _mm512_roundscale_pd((x), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+#define _avxd_stride_set _mm512_set_pd
+#define _avxd_stride_set_duplicates _mm512_set1_pd
+#define avxd_mask_t __mmask8
+#define avxi_array_t __m256i
+#define avxl_array_t __m512i
+#define _avxd_stride_load _mm512_loadu_pd
+#define _avxd_stride_fmadd _mm512_fmadd_pd
+#define _avxd_stride_fnmadd _mm512_fnmadd_pd
+#define _avxd_stride_less_than(a, b) _mm512_cmp_pd_mask((a), (b), _CMP_LT_OQ)
+#define _avxd_stride_blend(mask, a, b) _mm512_mask_blend_pd((mask), (a), (b))
+#define _avxd_stride_index _mm512_cvttpd_epi32
+#define _avxd_stride_gather(table, index) \
+   _mm512_i32gather_pd((index), (table), 8)
+#define _avxd_stride_gather_long(table, index) \
+   _mm512_i64gather_pd((index), (table), 8)
+#define _avxd_stride_gather_quads __varr_avx512_gather_quads
+#define _avxd_stride_interpolate __varr_avx512_interpolate
+#define _avxd_stride_interpolate_pair __varr_avx512_interpolate_pair
+#define _avxd_stride_interpolate_window __varr_avx512_interpolate_window
+#define _avxd_stride_as_avxl _mm512_castpd_si512
+#define avxd_lanes_t __mmask8
+#define _avxd_stride_lanes(n) ((__mmask8) ((1u << (n)) - 1u))
+#define _avxd_stride_load_partial(p, lanes, fill) \
+   _mm512_mask_loadu_pd((fill), (lanes), (p))
+#define _avxd_stride_store_partial(p, lanes, v) \
+   _mm512_mask_storeu_pd((p), (lanes), (v))
+#define _avxd_stride_store_interleaved_partial \
+   __varr_avx512_store_interleaved_partial
+#define _avxi_stride_add _mm256_add_epi32
+#define _avxi_stride_set_duplicates _mm256_set1_epi32
+#define _avxl_stride_as_avxd _mm512_castsi512_pd
+#define _avxl_stride_shift_left _mm512_slli_epi64
+#define _avxl_stride_shift_right _mm512_srli_epi64
+#define _avxl_stride_and _mm512_and_si512
+#define _avxl_stride_or _mm512_or_si512
+#define _avxl_stride_add _mm512_add_epi64
+#define _avxl_stride_sub _mm512_sub_epi64
+#define _avxl_stride_set_duplicates _mm512_set1_epi64
+#define avxf_array_t __m512
+#define __AVX_FLOAT_STRIDE__ ((size_t) 16u)
+#define avxf_mask_t __mmask16
+#define avxfi_array_t __m512i
+#define _avxf_stride_max _mm512_max_ps
+#define _avxf_stride_min _mm512_min_ps
+#define _avxf_stride_floor(x) \
+   _mm512_roundscale_ps((x), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+#define _avxf_stride_set_duplicates _mm512_set1_ps
+#define _avxf_stride_load _mm512_loadu_ps
+#define _avxf_stride_fmadd _mm512_fmadd_ps
+#define _avxf_stride_fnmadd _mm512_fnmadd_ps
+#define _avxf_stride_less_than(a, b) _mm512_cmp_ps_mask((a), (b), _CMP_LT_OQ)
+#define _avxf_stride_blend(mask, a, b) _mm512_mask_blend_ps((mask), (a), (b))
+#define _avxf_stride_index _mm512_cvttps_epi32
+#define _avxf_stride_gather(table, index) \
+   _mm512_i32gather_ps((index), (table), 4)
+#define _avxf_stride_interpolate __varr_avx512_interpolate_float
+#define _avxf_stride_interpolate_pair __varr_avx512_interpolate_float_pair
+#define _avxf_stride_as_avxfi _mm512_castps_si512
+#define avxf_lanes_t __mmask16
+#define _avxf_stride_lanes(n) ((__mmask16) ((1u << (n)) - 1u))
+#define _avxf_stride_load_partial(p, lanes, fill) \
+   _mm512_mask_loadu_ps((fill), (lanes), (p))
+#define _avxf_stride_store_partial(p, lanes, v) \
+   _mm512_mask_storeu_ps((p), (lanes), (v))
+#define _avxf_stride_store_interleaved_partial \
+   __varr_avx512_store_interleaved_float_partial
+#define _avxfi_stride_as_avxf _mm512_castsi512_ps
+#define _avxfi_stride_to_avxf _mm512_cvtepi32_ps
+#define _avxfi_stride_shift_left _mm512_slli_epi32
+#define _avxfi_stride_shift_right _mm512_srli_epi32
+#define _avxfi_stride_and _mm512_and_si512
+#define _avxfi_stride_or _mm512_or_si512
+#define _avxfi_stride_add _mm512_add_epi32
+#define _avxfi_stride_sub _mm512_sub_epi32
+#define _avxfi_stride_set_duplicates _mm512_set1_epi32
+
+#ifdef __VARR_SIMD_STREAMED__
+#define __VARR_SIMD_NAME(name) name##_avx512_streamed
+#define __VARR_SIMD_STREAMING_BATCH(name, x, out, length, accelerator) \
+   ((void) 0)
+#define _avxd_stride_store _mm512_stream_pd
+#define _avxd_stride_store_interleaved __varr_avx512_stream_interleaved
+#define _avxf_stride_store _mm512_stream_ps
+#define _avxf_stride_store_interleaved __varr_avx512_stream_interleaved_float
+#else
+#define __VARR_SIMD_NAME(name) name##_avx512
+#define __VARR_SIMD_STREAMING_BATCH(name, x, out, length, accelerator) \
+   __varr_simd_streaming_batch( \
+      name##_avx512_streamed, x, out, length, accelerator, sizeof(__m512d) \
+      )
+#define _avxd_stride_store _mm512_storeu_pd
+#define _avxd_stride_store_interleaved __varr_avx512_store_interleaved
+#define _avxf_stride_store _mm512_storeu_ps
+#define _avxf_stride_store_interleaved __varr_avx512_store_interleaved_float
+#endif
+
+#ifndef __VARR_SIMD_TARGET_AVX512_HELPERS__
+#define __VARR_SIMD_TARGET_AVX512_HELPERS__
+
+/*
+ * Stores the pairs (re[k], im[k]) to the consecutive doubles out[2k] and
+ * out[2k + 1], eg. as double complex values:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_store_interleaved(
+   double * const out,
+   __m512d const re,
+   __m512d const im
+   )
+{
+   register __m512d const
+      lower = _mm512_unpacklo_pd(re, im),
+      upper = _mm512_unpackhi_pd(re, im);
+   _mm512_storeu_pd(
+      out,
+      _mm512_permutex2var_pd(
+         lower, _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0), upper
+         )
+      );
+   _mm512_storeu_pd(
+      out + 8u,
+      _mm512_permutex2var_pd(
+         lower, _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4), upper
+         )
+      );
+}
+
+/*
+ * As __varr_avx512_store_interleaved, by non-temporal stores to 64 byte 
+ * aligned 'out':
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_stream_interleaved(
+   double * const out,
+   __m512d const re,
+   __m512d const im
+   )
+{
+   register __m512d const
+      lower = _mm512_unpacklo_pd(re, im),
+      upper = _mm512_unpackhi_pd(re, im);
+   _mm512_stream_pd(
+      out,
+      _mm512_permutex2var_pd(
+         lower, _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0), upper
+         )
+      );
+   _mm512_stream_pd(
+      out + 8u,
+      _mm512_permutex2var_pd(
+         lower, _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4), upper
+         )
+      );
+}
+
+/*
+ * As __varr_avx512_store_interleaved, for the first n < 8 pairs only:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_store_interleaved_partial(
+   double * const out,
+   size_t const n,
+   __m512d const re,
+   __m512d const im
+   )
+{
+   register __m512d const
+      lower = _mm512_unpacklo_pd(re, im),
+      upper = _mm512_unpackhi_pd(re, im);
+   register unsigned const
+      lanes = (1u << (2u * n)) - 1u;
+   _mm512_mask_storeu_pd(
+      out,
+      (__mmask8) lanes,
+      _mm512_permutex2var_pd(
+         lower, _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0), upper
+         )
+      );
+   _mm512_mask_storeu_pd(
+      out + 8u,
+      (__mmask8) (lanes >> 8),
+      _mm512_permutex2var_pd(
+         lower, _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4), upper
+         )
+      );
+}
+
+/*
+ * Loads the four doubles at table + i, and at table + j, to the lower and
+ * upper halves of the result:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m512d
+__varr_avx512_load_quad_pair(
+   double const * const table,
+   int const i,
+   int const j
+   )
+{
+   return
+      _mm512_insertf64x4(
+         _mm512_castpd256_pd512(_mm256_loadu_pd(table + i)),
+         _mm256_loadu_pd(table + j),
+         1
+         );
+}
+
+/*
+ * Assigns table[index[k] + j] to lane k of quads[j], for j < 4:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_gather_quads(
+   double const * const table,
+   __m256i const index,
+   __m512d * const quads
+   )
+{
+   // Rows k and k + 4 share a vector, and are transposed side by side:
+   register __m512d const
+      row04 = __varr_avx512_load_quad_pair(
+         table, _mm256_extract_epi32(index, 0), _mm256_extract_epi32(index, 4)
+         ),
+      row15 = __varr_avx512_load_quad_pair(
+         table, _mm256_extract_epi32(index, 1), _mm256_extract_epi32(index, 5)
+         ),
+      row26 = __varr_avx512_load_quad_pair(
+         table, _mm256_extract_epi32(index, 2), _mm256_extract_epi32(index, 6)
+         ),
+      row37 = __varr_avx512_load_quad_pair(
+         table, _mm256_extract_epi32(index, 3), _mm256_extract_epi32(index, 7)
+         );
+   register __m512d const
+      even01 = _mm512_unpacklo_pd(row04, row15),
+      odd01 = _mm512_unpackhi_pd(row04, row15),
+      even23 = _mm512_unpacklo_pd(row26, row37),
+      odd23 = _mm512_unpackhi_pd(row26, row37);
+   register __m512i const
+      lower = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0),
+      upper = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+   quads[0u] = _mm512_permutex2var_pd(even01, lower, even23);
+   quads[1u] = _mm512_permutex2var_pd(odd01, lower, odd23);
+   quads[2u] = _mm512_permutex2var_pd(even01, upper, even23);
+   quads[3u] = _mm512_permutex2var_pd(odd01, upper, odd23);
+}
+
+/*
+ * Loads the two doubles at each of table + i, j, k and l to consecutive
+ * quarters of the result:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m512d
+__varr_avx512_load_pair_quad(
+   double const * const table,
+   int const i,
+   int const j,
+   int const k,
+   int const l
+   )
+{
+   return
+      _mm512_insertf64x4(
+         _mm512_castpd256_pd512(
+            _mm256_insertf128_pd(
+               _mm256_castpd128_pd256(_mm_loadu_pd(table + i)),
+               _mm_loadu_pd(table + j),
+               1
+               )
+            ),
+         _mm256_insertf128_pd(
+            _mm256_castpd128_pd256(_mm_loadu_pd(table + k)),
+            _mm_loadu_pd(table + l),
+            1
+            ),
+         1
+         );
+}
+
+/*
+ * Assigns the two consecutive floats at table + index[k], converted to
+ * double, to lane k of first and second (one 64-bit gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_gather_float_pairs(
+   float const * const table,
+   __m256i const index,
+   __m512d * const first,
+   __m512d * const second
+   )
+{
+   register __m512i const
+      pairs = _mm512_i32gather_epi64(index, table, 4);
+   *first = _mm512_cvtps_pd(
+      _mm256_castsi256_ps(_mm512_cvtepi64_epi32(pairs))
+      );
+   *second = _mm512_cvtps_pd(
+      _mm256_castsi256_ps(
+         _mm512_cvtepi64_epi32(_mm512_srli_epi64(pairs, 32))
+         )
+      );
+}
+
+/*
+ * Assigns the four consecutive floats at table + index[k], converted to
+ * double, to lane k of quads[j], for j < 4:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_gather_float_quads(
+   float const * const table,
+   __m256i const index,
+   __m512d * const quads
+   )
+{
+   // Lanes 0 to 3, and 4 to 7, are transposed separately:
+   __m128
+      row0 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 0)),
+      row1 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 1)),
+      row2 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 2)),
+      row3 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 3)),
+      row4 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 4)),
+      row5 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 5)),
+      row6 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 6)),
+      row7 = _mm_loadu_ps(table + _mm256_extract_epi32(index, 7));
+   _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+   _MM_TRANSPOSE4_PS(row4, row5, row6, row7);
+   quads[0u] = _mm512_cvtps_pd(
+      _mm256_insertf128_ps(_mm256_castps128_ps256(row0), row4, 1)
+      );
+   quads[1u] = _mm512_cvtps_pd(
+      _mm256_insertf128_ps(_mm256_castps128_ps256(row1), row5, 1)
+      );
+   quads[2u] = _mm512_cvtps_pd(
+      _mm256_insertf128_ps(_mm256_castps128_ps256(row2), row6, 1)
+      );
+   quads[3u] = _mm512_cvtps_pd(
+      _mm256_insertf128_ps(_mm256_castps128_ps256(row3), row7, 1)
+      );
+}
+
+/*
+ * Assigns the two consecutive 16-bit corrections at corrections + index[k],
+ * times 'scale', to lane k of first and second (one 32-bit gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_gather_correction_pairs(
+   int16_t const * const corrections,
+   __m256i const index,
+   double const scale,
+   __m512d * const first,
+   __m512d * const second
+   )
+{
+   register __m256i const
+      pairs = _mm256_i32gather_epi32((int const *) corrections, index, 2);
+   register __m512d const
+      __scale = _mm512_set1_pd(scale);
+   *first = _mm512_mul_pd(
+      _mm512_cvtepi32_pd(
+         _mm256_srai_epi32(_mm256_slli_epi32(pairs, 16), 16)
+         ),
+      __scale
+      );
+   *second = _mm512_mul_pd(
+      _mm512_cvtepi32_pd(_mm256_srai_epi32(pairs, 16)),
+      __scale
+      );
+}
+
+/*
+ * As __varr_avx512_gather_correction_pairs, for four consecutive 
+ * corrections (one 64-bit gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_gather_correction_quads(
+   int16_t const * const corrections,
+   __m256i const index,
+   double const scale,
+   __m512d * const quads
+   )
+{
+   register __m512i const
+      corrections_quads = _mm512_i32gather_epi64(index, corrections, 2);
+   register __m512d const
+      __scale = _mm512_set1_pd(scale);
+   quads[0u] = _mm512_mul_pd(
+      _mm512_cvtepi32_pd(
+         _mm512_cvtepi64_epi32(
+            _mm512_srai_epi64(_mm512_slli_epi64(corrections_quads, 48), 48)
+            )
+         ),
+      __scale
+      );
+   quads[1u] = _mm512_mul_pd(
+      _mm512_cvtepi32_pd(
+         _mm512_cvtepi64_epi32(
+            _mm512_srai_epi64(_mm512_slli_epi64(corrections_quads, 32), 48)
+            )
+         ),
+      __scale
+      );
+   quads[2u] = _mm512_mul_pd(
+      _mm512_cvtepi32_pd(
+         _mm512_cvtepi64_epi32(
+            _mm512_srai_epi64(_mm512_slli_epi64(corrections_quads, 16), 48)
+            )
+         ),
+      __scale
+      );
+   quads[3u] = _mm512_mul_pd(
+      _mm512_cvtepi32_pd(
+         _mm512_cvtepi64_epi32(_mm512_srai_epi64(corrections_quads, 48))
+         ),
+      __scale
+      );
+}
+
+/*
+ * Interpolates linearly, by alpha[k], between the samples index[k] and
+ * index[k] + 1 of a VARRSampleTable of width one:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m512d
+__varr_avx512_interpolate(
+   VARRSampleTable const * const table,
+   __m256i const index,
+   __m512d const alpha
+   )
+{
+   register __m256i const
+      row = _mm256_add_epi32(index, index);
+   __m512d
+      lower,
+      upper;
+   if(table->precision == VARR_TABLE_DOUBLE)
+   {
+      register double const * const
+         values = table->values;
+      if(table->layout == VARR_TABLE_INTERLEAVED)
+      {
+         // The pairs of even and odd lanes are transposed side by side:
+         register __m512d const
+            even = __varr_avx512_load_pair_quad(
+               values,
+               _mm256_extract_epi32(row, 0),
+               _mm256_extract_epi32(row, 2),
+               _mm256_extract_epi32(row, 4),
+               _mm256_extract_epi32(row, 6)
+               ),
+            odd = __varr_avx512_load_pair_quad(
+               values,
+               _mm256_extract_epi32(row, 1),
+               _mm256_extract_epi32(row, 3),
+               _mm256_extract_epi32(row, 5),
+               _mm256_extract_epi32(row, 7)
+               );
+         return
+            _mm512_fmadd_pd(
+               _mm512_unpackhi_pd(even, odd),
+               alpha,
+               _mm512_unpacklo_pd(even, odd)
+               );
+      }
+      return
+         _mm512_fmadd_pd(
+            _mm512_i32gather_pd(index, values + 1u, 8),
+            alpha,
+            _mm512_mul_pd(
+               _mm512_i32gather_pd(index, values, 8),
+               _mm512_sub_pd(_mm512_set1_pd(1.), alpha)
+               )
+            );
+   }
+   __varr_avx512_gather_float_pairs(
+      table->floats,
+      (table->layout == VARR_TABLE_INTERLEAVED) ? row : index,
+      &lower,
+      &upper
+      );
+   if(table->precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      __m512d
+         lower_correction,
+         upper_correction;
+      __varr_avx512_gather_correction_pairs(
+         table->corrections,
+         index,
+         table->correction_scale,
+         &lower_correction,
+         &upper_correction
+         );
+      lower = _mm512_add_pd(lower, lower_correction);
+      if(table->layout == VARR_TABLE_VALUES)
+      {
+         upper = _mm512_add_pd(upper, upper_correction);
+      }
+   }
+   if(table->layout == VARR_TABLE_INTERLEAVED)
+   {
+      return
+         _mm512_fmadd_pd(upper, alpha, lower);
+   }
+   return
+      _mm512_fmadd_pd(
+         upper,
+         alpha,
+         _mm512_mul_pd(lower, _mm512_sub_pd(_mm512_set1_pd(1.), alpha))
+         );
+}
+
+/*
+ * As __varr_avx2_interpolate_pair, for a VARRSampleTable of width two:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_interpolate_pair(
+   VARRSampleTable const * const table,
+   __m256i const index,
+   __m512d const alpha,
+   __m512d * const first,
+   __m512d * const second
+   )
+{
+   register __m256i const
+      sample = _mm256_add_epi32(index, index),
+      row = (table->layout == VARR_TABLE_INTERLEAVED) ?
+         _mm256_add_epi32(sample, sample)
+         :
+         sample;
+   __m512d
+      quads[4u];
+   if(table->precision == VARR_TABLE_DOUBLE)
+   {
+      __varr_avx512_gather_quads(table->values, row, quads);
+   }
+   else
+   {
+      __varr_avx512_gather_float_quads(table->floats, row, quads);
+   }
+   if(table->precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      __m512d
+         corrections[4u];
+      if(table->layout == VARR_TABLE_INTERLEAVED)
+      {
+         __varr_avx512_gather_correction_pairs(
+            table->corrections,
+            sample,
+            table->correction_scale,
+            corrections,
+            corrections + 1u
+            );
+      }
+      else
+      {
+         __varr_avx512_gather_correction_quads(
+            table->corrections, sample, table->correction_scale, corrections
+            );
+         quads[2u] = _mm512_add_pd(quads[2u], corrections[2u]);
+         quads[3u] = _mm512_add_pd(quads[3u], corrections[3u]);
+      }
+      quads[0u] = _mm512_add_pd(quads[0u], corrections[0u]);
+      quads[1u] = _mm512_add_pd(quads[1u], corrections[1u]);
+   }
+   if(table->layout == VARR_TABLE_INTERLEAVED)
+   {
+      *first = _mm512_fmadd_pd(quads[2u], alpha, quads[0u]);
+      *second = _mm512_fmadd_pd(quads[3u], alpha, quads[1u]);
+      return;
+   }
+   register __m512d const
+      beta = _mm512_sub_pd(_mm512_set1_pd(1.), alpha);
+   *first = _mm512_fmadd_pd(quads[2u], alpha, _mm512_mul_pd(quads[0u], beta));
+   *second = 
+      _mm512_fmadd_pd(quads[3u], alpha, _mm512_mul_pd(quads[1u], beta));
+}
+
+/*
+ * As __varr_avx2_within_window, for the eight lanes of offset:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+int
+__varr_avx512_within_window(
+   __m256i const offset,
+   int const span,
+   int const width
+   )
+{
+   register __m256i const
+      limit = _mm256_set1_epi32(span);
+   return
+      ((unsigned) span < (unsigned) width)
+   && (
+         _mm256_movemask_epi8(
+            _mm256_cmpeq_epi32(_mm256_max_epu32(offset, limit), limit)
+            ) == -1
+         );
+}
+
+/*
+ * Returns, in lane k, the double at window + offset[k] for offsets below
+ * sixteen, of which only the first count doubles are read (by two masked 
+ * loads and one two-source permutation, in place of a gather):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m512d
+__varr_avx512_load_window(
+   double const * const window,
+   __m512i const offset,
+   int const count
+   )
+{
+   register unsigned const
+      lanes = (1u << count) - 1u;
+   return
+      _mm512_permutex2var_pd(
+         _mm512_maskz_loadu_pd((__mmask8) lanes, window),
+         offset,
+         _mm512_maskz_loadu_pd((__mmask8) (lanes >> 8), window + 8)
+         );
+}
+
+/*
+ * As __varr_avx512_interpolate, but where the indices of a table of doubles
+ * lie within a window of sixteen samples (as for sorted inputs, see 
+ * __varr_avx512_within_window), the window is loaded contiguously.  The 
+ * result is that of __varr_avx512_interpolate in either case:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m512d
+__varr_avx512_interpolate_window(
+   VARRSampleTable const * const table,
+   __m256i const index,
+   __m512d const alpha
+   )
+{
+   if(
+      (table->precision == VARR_TABLE_DOUBLE)
+   && (table->layout == VARR_TABLE_VALUES)
+      )
+   {
+      register int const
+         first = _mm256_cvtsi256_si32(index);
+      register __m256i const
+         offset = _mm256_sub_epi32(index, _mm256_set1_epi32(first));
+      register int const
+         span = _mm256_extract_epi32(offset, 7);
+      if(__varr_avx512_within_window(offset, span, 16))
+      {
+         register double const * const
+            window = table->values + first;
+         register __m512i const
+            wide = _mm512_cvtepu32_epi64(offset);
+         return
+            _mm512_fmadd_pd(
+               __varr_avx512_load_window(window + 1, wide, span + 1),
+               alpha,
+               _mm512_mul_pd(
+                  __varr_avx512_load_window(window, wide, span + 1),
+                  _mm512_sub_pd(_mm512_set1_pd(1.), alpha)
+                  )
+               );
+      }
+   }
+   return
+      __varr_avx512_interpolate(table, index, alpha);
+}
+
+/*
+ * Assigns the two consecutive floats at table + row[k] to lane k of first
+ * and second (two 64-bit gathers, of eight lanes each):
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_gather_float_rows(
+   float const * const table,
+   __m512i const row,
+   __m512 * const first,
+   __m512 * const second
+   )
+{
+   register __m512 const
+      lower = _mm512_castsi512_ps(
+         _mm512_i32gather_epi64(_mm512_castsi512_si256(row), table, 4)
+         ),
+      upper = _mm512_castsi512_ps(
+         _mm512_i32gather_epi64(_mm512_extracti64x4_epi64(row, 1), table, 4)
+         );
+   *first = _mm512_permutex2var_ps(
+      lower,
+      _mm512_setr_epi32(
+         0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30
+         ),
+      upper
+      );
+   *second = _mm512_permutex2var_ps(
+      lower,
+      _mm512_setr_epi32(
+         1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31
+         ),
+      upper
+      );
+}
+
+/*
+ * Interpolates linearly, by alpha[k], in the float table of interleaved
+ * (sample, difference) pairs at row index[k]:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+__m512
+__varr_avx512_interpolate_float(
+   float const * const table,
+   __m512i const index,
+   __m512 const alpha
+   )
+{
+   __m512
+      sample,
+      difference;
+   __varr_avx512_gather_float_rows(
+      table, _mm512_add_epi32(index, index), &sample, &difference
+      );
+   return
+      _mm512_fmadd_ps(difference, alpha, sample);
+}
+
+/*
+ * As __varr_avx512_interpolate_float, for a table of width two, whose rows
+ * are the two components of a sample followed by their differences:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_interpolate_float_pair(
+   float const * const table,
+   __m512i const index,
+   __m512 const alpha,
+   __m512 * const first,
+   __m512 * const second
+   )
+{
+   register __m512i const
+      row = _mm512_slli_epi32(index, 2);
+   __m512
+      first_difference,
+      second_difference;
+   __varr_avx512_gather_float_rows(table, row, first, second);
+   __varr_avx512_gather_float_rows(
+      table + 2u, row, &first_difference, &second_difference
+      );
+   *first = _mm512_fmadd_ps(first_difference, alpha, *first);
+   *second = _mm512_fmadd_ps(second_difference, alpha, *second);
+}
+
+/*
+ * Stores the pairs (re[k], im[k]) to the consecutive floats out[2k] and
+ * out[2k + 1], eg. as float complex values:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_store_interleaved_float(
+   float * const out,
+   __m512 const re,
+   __m512 const im
+   )
+{
+   _mm512_storeu_ps(
+      out,
+      _mm512_permutex2var_ps(
+         re,
+         _mm512_setr_epi32(
+            0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23
+            ),
+         im
+         )
+      );
+   _mm512_storeu_ps(
+      out + 16u,
+      _mm512_permutex2var_ps(
+         re,
+         _mm512_setr_epi32(
+            8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31
+            ),
+         im
+         )
+      );
+}
+
+/*
+ * As __varr_avx512_store_interleaved_float, by non-temporal stores to 64 
+ * byte aligned 'out':
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_stream_interleaved_float(
+   float * const out,
+   __m512 const re,
+   __m512 const im
+   )
+{
+   _mm512_stream_ps(
+      out,
+      _mm512_permutex2var_ps(
+         re,
+         _mm512_setr_epi32(
+            0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23
+            ),
+         im
+         )
+      );
+   _mm512_stream_ps(
+      out + 16u,
+      _mm512_permutex2var_ps(
+         re,
+         _mm512_setr_epi32(
+            8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31
+            ),
+         im
+         )
+      );
+}
+
+/*
+ * As __varr_avx512_store_interleaved_float, for the first n < 16 pairs only:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__varr_avx512_store_interleaved_float_partial(
+   float * const out,
+   size_t const n,
+   __m512 const re,
+   __m512 const im
+   )
+{
+   register unsigned long const
+      lanes = (1ul << (2u * n)) - 1ul;
+   _mm512_mask_storeu_ps(
+      out,
+      (__mmask16) lanes,
+      _mm512_permutex2var_ps(
+         re,
+         _mm512_setr_epi32(
+            0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23
+            ),
+         im
+         )
+      );
+   _mm512_mask_storeu_ps(
+      out + 16u,
+      (__mmask16) (lanes >> 16),
+      _mm512_permutex2var_ps(
+         re,
+         _mm512_setr_epi32(
+            8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31
+            ),
+         im
+         )
+      );
+}
+
+#endif
+
+#else
+#error "varr_simd_target.h: unknown __VARR_SIMD_TARGET__"
+#endif
+
+#ifndef __VARR_SIMD_TARGET_STREAMING__
+#define __VARR_SIMD_TARGET_STREAMING__
+
+/*
+ * The body of __VARR_SIMD_STREAMING_BATCH, for the streamed 'kernel' of a 
+ * target of vectors of 'alignment' bytes (see above):
+ */
+#define __varr_simd_streaming_batch( \
+   kernel, x, out, length, accelerator, alignment \
+   ) \
+   { \
+      size_t \
+         __head; \
+      if( \
+         __varr_streaming_batch( \
+            (void const *) (out), \
+            (length), \
+            sizeof(*(out)), \
+            (alignment), \
+            &__head \
+            ) \
+         ) \
+      { \
+         kernel((x), (out), __head, (accelerator)); \
+         kernel( \
+            (x) + __head, (out) + __head, (length) - __head, (accelerator) \
+            ); \
+         _mm_sfence(); \
+         return; \
+      } \
+   }
+
+#endif
+
+#ifndef __VARR_SIMD_TARGET_RANGE_REDUCTION__
+#define __VARR_SIMD_TARGET_RANGE_REDUCTION__
+
+/*
+ * Vector forms of the IEEE-754 range reduction of varr_internal.h, for 
+ * positive normal x = m * 2**k.  These are written in terms of the macros
+ * above, and so serve every target:
+ *
+ *    _avxd_stride_exponent_field(x)       k + 1023, as 64-bit integers (eg.
+ *                                         for _avxd_stride_gather_long)
+ *    _avxd_stride_mantissa(x)             m, for 1 <= m < 2
+ *    _avxd_stride_centred_bits(x)         the bits of x, offset so that
+ *                                         m is centred on unity, for:
+ *    _avxl_stride_centred_exponent(bits)  k, as doubles, and
+ *    _avxl_stride_centred_mantissa(bits)  m, for sqrt(1/2) <= m < sqrt(2)
+ *
+ * k is converted to double exactly, as the low bits of 2**52 + k + 1023.
+ *
+ * The float forms, _avxf_stride_exponent_field(x) (k + 127, as 32-bit 
+ * integers, eg. for _avxf_stride_gather), _avxf_stride_mantissa(x),
+ * _avxf_stride_centred_bits(x), _avxfi_stride_centred_exponent(bits) and
+ * _avxfi_stride_centred_mantissa(bits), are those of the float fields.
+ *
+ * _avxf_stride_reduce_2pi(x, k) returns x - 2 pi k, for k = floor(x/(2 pi)),
+ * see __VARR_FLOAT_2PI_HIGH__.
+ */
+#define _avxd_stride_exponent_field(x) \
+   _avxl_stride_shift_right(_avxd_stride_as_avxl(x), 52)
+#define _avxd_stride_mantissa(x) \
+   _avxl_stride_as_avxd( \
+      _avxl_stride_or( \
+         _avxl_stride_and( \
+            _avxd_stride_as_avxl(x), \
+            _avxl_stride_set_duplicates((long long) __VARR_MANTISSA_MASK__) \
+            ), \
+         _avxl_stride_set_duplicates(0x3FF0000000000000ll) \
+         ) \
+      )
+#define _avxd_stride_centred_bits(x) \
+   _avxl_stride_add( \
+      _avxd_stride_as_avxl(x), \
+      _avxl_stride_set_duplicates( \
+         (long long) (0x3FF0000000000000ull - __VARR_SQRT_HALF_BITS__) \
+         ) \
+      )
+#define _avxl_stride_centred_exponent(bits) \
+   (_avxl_stride_as_avxd( \
+      _avxl_stride_or( \
+         _avxl_stride_shift_right((bits), 52), \
+         _avxl_stride_set_duplicates(0x4330000000000000ll) \
+         ) \
+      ) - _avxd_stride_set_duplicates(0x1p52 + 1023.))
+#define _avxl_stride_centred_mantissa(bits) \
+   _avxl_stride_as_avxd( \
+      _avxl_stride_add( \
+         _avxl_stride_and( \
+            (bits), \
+            _avxl_stride_set_duplicates((long long) __VARR_MANTISSA_MASK__) \
+            ), \
+         _avxl_stride_set_duplicates((long long) __VARR_SQRT_HALF_BITS__) \
+         ) \
+      )
+#define _avxf_stride_reduce_2pi(x, k) \
+   _avxf_stride_fnmadd( \
+      (k), \
+      _avxf_stride_set_duplicates(__VARR_FLOAT_2PI_LOW__), \
+      _avxf_stride_fnmadd( \
+         (k), _avxf_stride_set_duplicates(__VARR_FLOAT_2PI_HIGH__), (x) \
+         ) \
+      )
+#define _avxf_stride_exponent_field(x) \
+   _avxfi_stride_shift_right(_avxf_stride_as_avxfi(x), 23)
+#define _avxf_stride_mantissa(x) \
+   _avxfi_stride_as_avxf( \
+      _avxfi_stride_or( \
+         _avxfi_stride_and( \
+            _avxf_stride_as_avxfi(x), \
+            _avxfi_stride_set_duplicates(__VARR_FLOAT_MANTISSA_MASK__) \
+            ), \
+         _avxfi_stride_set_duplicates(0x3F800000) \
+         ) \
+      )
+#define _avxf_stride_centred_bits(x) \
+   _avxfi_stride_add( \
+      _avxf_stride_as_avxfi(x), \
+      _avxfi_stride_set_duplicates( \
+         (int) (0x3F800000u - __VARR_FLOAT_SQRT_HALF_BITS__) \
+         ) \
+      )
+#define _avxfi_stride_centred_exponent(bits) \
+   (_avxfi_stride_to_avxf(_avxfi_stride_shift_right((bits), 23)) \
+      - _avxf_stride_set_duplicates(127.f))
+#define _avxfi_stride_centred_mantissa(bits) \
+   _avxfi_stride_as_avxf( \
+      _avxfi_stride_add( \
+         _avxfi_stride_and( \
+            (bits), \
+            _avxfi_stride_set_duplicates(__VARR_FLOAT_MANTISSA_MASK__) \
+            ), \
+         _avxfi_stride_set_duplicates((int) __VARR_FLOAT_SQRT_HALF_BITS__) \
+         ) \
+      )
+
+#endif
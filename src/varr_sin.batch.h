@@ -0,0 +1,338 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_sin.c.  This file is included by varr_sin.c
+ * (through varr_simd_instantiate.h) twice per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+/*
+ * Returns the (clamped) sampling coordinate of x, x / step_x, which is kept
+ * strictly below the index of the last sample so that both neighbouring
+ * samples (or the enclosing spline interval) may be read:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(sampling_sind_coordinate)(
+   register avxd_array_t const x,
+   register avxd_array_t const step_x_inv,
+   register avxd_array_t const last_coordinate
+   )
+{
+   return
+      _avxd_stride_min(
+         _avxd_stride_max(x * step_x_inv, _avxd_stride_set_duplicates(0.)),
+         last_coordinate
+         );
+}
+
+/*
+ * As for the scalar functions, sin(x) evaluates to 0 unless 0 < x < 2*pi:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(sampling_sind_outside_range)(
+   register avxd_array_t const x,
+   register avxd_array_t const value
+   )
+{
+   register avxd_array_t const
+      __edge = _avxd_stride_set_duplicates(0.0);
+   return
+      _avxd_stride_blend(
+         _avxd_stride_less_than(x, _avxd_stride_set_duplicates(__2pi)),
+         __edge,
+         _avxd_stride_blend(
+            _avxd_stride_less_than(_avxd_stride_set_duplicates(0.0), x),
+            __edge,
+            value
+            )
+         );
+}
+
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(sampling_sind_stride)(
+   register avxd_array_t const x,
+   VARRSampleTable const * const table,
+   register avxd_array_t const step_x_inv,
+   register avxd_array_t const last_coordinate
+   )
+{
+   register avxd_array_t const
+      t = __VARR_SIMD_NAME(sampling_sind_coordinate)(
+         x, step_x_inv, last_coordinate
+         );
+   return
+      __VARR_SIMD_NAME(sampling_sind_outside_range)(
+         x,
+         _avxd_stride_interpolate(
+            table, _avxd_stride_index(t), t - _avxd_stride_floor(t)
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sampling_sind_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      sampling_sind_batch_evaluate, __x, out, length, __accelerator
+      );
+   register SamplingSinDAccelerator const * const
+      accelerator = (SamplingSinDAccelerator const *) __accelerator;
+   VARRSampleTable const * const
+      table = &accelerator->table;
+   register avxd_array_t const
+      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inverse),
+      last_coordinate = _avxd_stride_set_duplicates(
+         nextafter((double) (accelerator->samples - (size_t) 1u), 0.0)
+         );
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         out,
+         __VARR_SIMD_NAME(sampling_sind_stride)(
+            _avxd_stride_load(__x), table, step_x_inv, last_coordinate
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(sampling_sind_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(0.)
+               ),
+            table,
+            step_x_inv,
+            last_coordinate
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * Evaluates the natural cubic spline by Horner's scheme in the fractional
+ * position, alpha, within the spline interval.  The four coefficients of
+ * each interval are adjacent, so are loaded by one vector load per lane (at
+ * four times its index) and transposed, in place of four gathers:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(cubic_spline_sampling_sind_stride)(
+   register avxd_array_t const x,
+   register double const * const coefficients,
+   register avxd_array_t const step_x_inv,
+   register avxd_array_t const last_coordinate
+   )
+{
+   register avxd_array_t const
+      t = __VARR_SIMD_NAME(sampling_sind_coordinate)(
+         x, step_x_inv, last_coordinate
+         );
+   register avxi_array_t
+      index = _avxd_stride_index(t);
+   register avxd_array_t const
+      alpha = t - _avxd_stride_floor(t);
+   avxd_array_t
+      coefficient[4u];
+   index = _avxi_stride_add(index, index);
+   index = _avxi_stride_add(index, index);
+   _avxd_stride_gather_quads(coefficients, index, coefficient);
+   return
+      __VARR_SIMD_NAME(sampling_sind_outside_range)(
+         x,
+         _avxd_stride_fmadd(
+            _avxd_stride_fmadd(
+               _avxd_stride_fmadd(coefficient[3u], alpha, coefficient[2u]),
+               alpha,
+               coefficient[1u]
+               ),
+            alpha,
+            coefficient[0u]
+            )
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(cubic_spline_sampling_sind_batch_evaluate)(
+   register double const * __x,
+   register double * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      cubic_spline_sampling_sind_batch_evaluate, __x, out, length, __accelerator
+      );
+   register CubicSplineSamplingSinDAccelerator const * const
+      accelerator = (CubicSplineSamplingSinDAccelerator const *) __accelerator;
+   register double const * const
+      coefficients = accelerator->coefficients;
+   register avxd_array_t const
+      step_x_inv = _avxd_stride_set_duplicates(
+         accelerator->base->step_x_inverse
+         ),
+      last_coordinate = _avxd_stride_set_duplicates(
+         nextafter((double) (accelerator->base->samples - (size_t) 1u), 0.0)
+         );
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      _avxd_stride_store(
+         out,
+         __VARR_SIMD_NAME(cubic_spline_sampling_sind_stride)(
+            _avxd_stride_load(__x), coefficients, step_x_inv, last_coordinate
+            )
+         );
+      __x += __AVX_DOUBLE_STRIDE__;
+      out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      _avxd_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(cubic_spline_sampling_sind_stride)(
+            _avxd_stride_load_partial(
+               __x, lanes, _avxd_stride_set_duplicates(0.)
+               ),
+            coefficients,
+            step_x_inv,
+            last_coordinate
+            )
+         );
+   }
+   return;
+}
+
+/*
+ * sin(x) = sin(r), for x = 2 pi k + r and 0 <= r < 2 pi:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxf_array_t
+__VARR_SIMD_NAME(sampling_sinf_stride)(
+   register avxf_array_t x,
+   SamplingSinFAccelerator const * const accelerator
+   )
+{
+   x = _avxf_stride_reduce_2pi(
+      x,
+      _avxf_stride_floor(
+         x * _avxf_stride_set_duplicates((float) (1. / __2pi))
+         )
+      ) * _avxf_stride_set_duplicates(accelerator->step_x_inverse);
+   x = _avxf_stride_min(
+      _avxf_stride_max(x, _avxf_stride_set_duplicates(0.f)),
+      _avxf_stride_set_duplicates(accelerator->last_sample)
+      );
+   return
+      _avxf_stride_interpolate(
+         accelerator->table, _avxf_stride_index(x), x - _avxf_stride_floor(x)
+         );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sampling_sinf_batch_evaluate)(
+   register float const * __x,
+   register float * out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   __VARR_SIMD_STREAMING_BATCH(
+      sampling_sinf_batch_evaluate, __x, out, length, __accelerator
+      );
+   register SamplingSinFAccelerator const * const
+      accelerator = (SamplingSinFAccelerator const *) __accelerator;
+   for(
+      ;
+      length >= __AVX_FLOAT_STRIDE__;
+      length -= __AVX_FLOAT_STRIDE__
+      )
+   {
+      _avxf_stride_store(
+         out,
+         __VARR_SIMD_NAME(sampling_sinf_stride)(
+            _avxf_stride_load(__x), accelerator
+            )
+         );
+      __x += __AVX_FLOAT_STRIDE__;
+      out += __AVX_FLOAT_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxf_lanes_t const
+         lanes = _avxf_stride_lanes(length);
+      _avxf_stride_store_partial(
+         out,
+         lanes,
+         __VARR_SIMD_NAME(sampling_sinf_stride)(
+            _avxf_stride_load_partial(
+               __x, lanes, _avxf_stride_set_duplicates(0.f)
+               ),
+            accelerator
+            )
+         );
+   }
+   return;
+}
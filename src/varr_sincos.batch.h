@@ -0,0 +1,234 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD batch kernels of varr_sincos.c.  This file is included by
+ * varr_sincos.c (through varr_simd_instantiate.h) once per SIMD target, see
+ * varr_simd_target.h.
+ */
+
+/*
+ * Returns the sampling coordinate, x / step_x, of x reduced to one period:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+avxd_array_t
+__VARR_SIMD_NAME(sincosd_coordinate)(
+   register avxd_array_t x,
+   register avxd_array_t const step_x_inv
+   )
+{
+   x = _avxd_stride_fnmadd(
+      _avxd_stride_floor(x * _avxd_stride_set_duplicates(1.0 / __2pi)),
+      _avxd_stride_set_duplicates(__2pi),
+      x
+      );
+   // Rounding may leave x marginally below zero:
+   return
+      _avxd_stride_max(x * step_x_inv, _avxd_stride_set_duplicates(0.));
+}
+
+/*
+ * The samples (sin, cos) at the index and the next index are four 
+ * consecutive doubles (or floats), gathered by one vector load per lane, as
+ * are the samples at the index and their differences to the next index with
+ * the VARR_TABLE_INTERLEAVED layout, see _avxd_stride_interpolate_pair:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sampling_sincosd_stride)(
+   register avxd_array_t const x,
+   VARRSampleTable const * const table,
+   register avxd_array_t const step_x_inv,
+   avxd_array_t * const sin_x,
+   avxd_array_t * const cos_x
+   )
+{
+   register avxd_array_t const
+      t = __VARR_SIMD_NAME(sincosd_coordinate)(x, step_x_inv);
+   _avxd_stride_interpolate_pair(
+      table, _avxd_stride_index(t), t - _avxd_stride_floor(t), sin_x, cos_x
+      );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(sampling_sincosd_batch_evaluate)(
+   register double const * __x,
+   register double * sin_out,
+   register double * cos_out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   register SamplingSinCosDAccelerator const * const
+      accelerator = (SamplingSinCosDAccelerator const *) __accelerator;
+   VARRSampleTable const * const
+      table = &accelerator->table;
+   register avxd_array_t const
+      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inverse);
+   avxd_array_t
+      sin_x,
+      cos_x;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(sampling_sincosd_stride)(
+         _avxd_stride_load(__x), table, step_x_inv, &sin_x, &cos_x
+         );
+      _avxd_stride_store(sin_out, sin_x);
+      _avxd_stride_store(cos_out, cos_x);
+      __x += __AVX_DOUBLE_STRIDE__;
+      sin_out += __AVX_DOUBLE_STRIDE__;
+      cos_out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      __VARR_SIMD_NAME(sampling_sincosd_stride)(
+         _avxd_stride_load_partial(
+            __x, lanes, _avxd_stride_set_duplicates(0.)
+            ),
+         table,
+         step_x_inv,
+         &sin_x,
+         &cos_x
+         );
+      _avxd_stride_store_partial(sin_out, lanes, sin_x);
+      _avxd_stride_store_partial(cos_out, lanes, cos_x);
+   }
+   return;
+}
+
+/*
+ * The four (sin, cos) pairs of spline coefficients of each interval are
+ * gathered (at eight times its index) as two quads, and evaluated by 
+ * Horner's scheme:
+ */
+static inline
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(cubic_spline_sampling_sincosd_stride)(
+   register avxd_array_t const x,
+   register double const * const values,
+   register avxd_array_t const step_x_inv,
+   avxd_array_t * const sin_x,
+   avxd_array_t * const cos_x
+   )
+{
+   register avxd_array_t const
+      t = __VARR_SIMD_NAME(sincosd_coordinate)(x, step_x_inv);
+   register avxi_array_t
+      index = _avxd_stride_index(t);
+   register avxd_array_t const
+      alpha = t - _avxd_stride_floor(t);
+   avxd_array_t
+      lower[4u],
+      upper[4u];
+   index = _avxi_stride_add(index, index);
+   index = _avxi_stride_add(index, index);
+   index = _avxi_stride_add(index, index);
+   _avxd_stride_gather_quads(values, index, lower);
+   _avxd_stride_gather_quads(values + 4u, index, upper);
+   *sin_x = _avxd_stride_fmadd(
+      _avxd_stride_fmadd(
+         _avxd_stride_fmadd(upper[2u], alpha, upper[0u]),
+         alpha,
+         lower[2u]
+         ),
+      alpha,
+      lower[0u]
+      );
+   *cos_x = _avxd_stride_fmadd(
+      _avxd_stride_fmadd(
+         _avxd_stride_fmadd(upper[3u], alpha, upper[1u]),
+         alpha,
+         lower[3u]
+         ),
+      alpha,
+      lower[1u]
+      );
+}
+
+static
+__VARR_SIMD_FUNCTION__
+void
+__VARR_SIMD_NAME(cubic_spline_sampling_sincosd_batch_evaluate)(
+   register double const * __x,
+   register double * sin_out,
+   register double * cos_out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   register SamplingSinCosDAccelerator const * const
+      accelerator = (SamplingSinCosDAccelerator const *) __accelerator;
+   register double const * const
+      values = accelerator->table.values;
+   register avxd_array_t const
+      step_x_inv = _avxd_stride_set_duplicates(accelerator->step_x_inverse);
+   avxd_array_t
+      sin_x,
+      cos_x;
+   for(
+      ;
+      length >= __AVX_DOUBLE_STRIDE__;
+      length -= __AVX_DOUBLE_STRIDE__
+      )
+   {
+      __VARR_SIMD_NAME(cubic_spline_sampling_sincosd_stride)(
+         _avxd_stride_load(__x), values, step_x_inv, &sin_x, &cos_x
+         );
+      _avxd_stride_store(sin_out, sin_x);
+      _avxd_stride_store(cos_out, cos_x);
+      __x += __AVX_DOUBLE_STRIDE__;
+      sin_out += __AVX_DOUBLE_STRIDE__;
+      cos_out += __AVX_DOUBLE_STRIDE__;
+   }
+   
+   // Remainder (masked) stride:
+   
+   if(length)
+   {
+      register avxd_lanes_t const
+         lanes = _avxd_stride_lanes(length);
+      __VARR_SIMD_NAME(cubic_spline_sampling_sincosd_stride)(
+         _avxd_stride_load_partial(
+            __x, lanes, _avxd_stride_set_duplicates(0.)
+            ),
+         values,
+         step_x_inv,
+         &sin_x,
+         &cos_x
+         );
+      _avxd_stride_store_partial(sin_out, lanes, sin_x);
+      _avxd_stride_store_partial(cos_out, lanes, cos_x);
+   }
+   return;
+}
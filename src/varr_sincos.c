@@ -0,0 +1,424 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_sincos.h"
+#include "varr_internal.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/*
+ * The accelerator of both sine-cosine evaluators.  The table is of width 
+ * two, ie. sine and cosine entries are interleaved, as (sin, cos) pairs of
+ * the samples at each multiple of step_x (linear sampling, of any layout and
+ * precision), or of each of the four polynomial coefficients of the spline
+ * on each interval (cubic spline sampling, as doubles of the 
+ * VARR_TABLE_VALUES layout):
+ */
+typedef struct tagSamplingSinCosDAccelerator
+{
+   double
+      step_x,
+      step_x_inverse;
+   size_t
+      samples;
+   VARRSampleTable
+      table;
+} SamplingSinCosDAccelerator;
+
+static
+int
+sampling_sincosd_disallocate(
+   VARRSinCosDEvaluator * evaluator
+   )
+{
+   if(evaluator == NULL)
+   {
+      return 1;
+   }
+   SamplingSinCosDAccelerator * const
+      accelerator = (SamplingSinCosDAccelerator *)
+         evaluator->accelerator;
+   if(accelerator == NULL)
+   {
+      return 1;
+   }
+   __varr_free_sample_table(&accelerator->table);
+   accelerator->step_x = 0x7F800001;
+   accelerator->step_x_inverse = 0x7F800001;
+   accelerator->samples = (size_t) 0;
+   __varr_free(accelerator);
+   evaluator->accelerator = NULL;
+   return 0;
+}
+
+static double const
+   __2pi = 2.0 * M_PI;
+
+/*
+ * Returns the sampling coordinate, x / step_x, of x reduced to one period 
+ * (as do the batch kernels, which is faster than fmod):
+ */
+static inline
+double
+sincosd_coordinate(
+   register double x,
+   register SamplingSinCosDAccelerator const * accelerator
+   )
+{
+   x -= floor(x * (1.0 / __2pi)) * __2pi;
+   // Rounding may leave x marginally below zero:
+   return
+      fmax(x * accelerator->step_x_inverse, 0.);
+}
+
+static
+SamplingSinCosDAccelerator *
+allocate_sampling_sincosd(
+   size_t number_of_samples,
+   VARRSampleTable table
+   )
+{
+   SamplingSinCosDAccelerator * const
+      result = (SamplingSinCosDAccelerator *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(SamplingSinCosDAccelerator)
+         );
+   result->step_x = __2pi / (double) number_of_samples;
+   result->step_x_inverse = 1.0 / result->step_x;
+   result->samples = number_of_samples;
+   result->table = table;
+   return
+      result;
+}
+
+/*
+ * Sampling (linear interpolation):
+ */
+
+static inline
+void
+__sampling_sincosd_evaluate(
+   register double x,
+   register double * restrict sin_x,
+   register double * restrict cos_x,
+   register SamplingSinCosDAccelerator const * accelerator
+   )
+{
+   register double
+      step_frac = sincosd_coordinate(x, accelerator);
+   register size_t const
+      index = (size_t) step_frac;
+   step_frac -= floor(step_frac);
+   *sin_x = __varr_interpolate_component(
+      &accelerator->table, index, step_frac, 0u
+      );
+   *cos_x = __varr_interpolate_component(
+      &accelerator->table, index, step_frac, 1u
+      );
+}
+
+static
+void
+sampling_sincosd_evaluate(
+   register double x,
+   register double * sin_x,
+   register double * cos_x,
+   register void const * __accelerator
+   )
+{
+   __sampling_sincosd_evaluate(
+      x,
+      sin_x,
+      cos_x,
+      (SamplingSinCosDAccelerator const *) __accelerator
+      );
+}
+
+static
+void
+sampling_sincosd_batch_evaluate_scalar(
+   register double const * __x,
+   register double * sin_out,
+   register double * cos_out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(
+      register size_t i = (size_t) 0u;
+      i< length;
+      ++i
+      )
+   {
+      __sampling_sincosd_evaluate(
+         *__x++,
+         sin_out++,
+         cos_out++,
+         (SamplingSinCosDAccelerator const *) __accelerator
+         );
+   }
+   return;
+}
+
+/*
+ * Cubic spline sampling:
+ */
+
+static inline
+void
+__cubic_spline_sampling_sincosd_evaluate(
+   register double x,
+   register double * restrict sin_x,
+   register double * restrict cos_x,
+   register SamplingSinCosDAccelerator const * accelerator
+   )
+{
+   register double
+      alpha = sincosd_coordinate(x, accelerator);
+   register size_t const
+      index = (size_t) alpha;
+   alpha -= floor(alpha);
+   register double const * restrict
+      coefficient = accelerator->table.values + (size_t) 8u * index;
+   *sin_x =
+      coefficient[0u] + alpha * (
+         coefficient[2u] + alpha * (coefficient[4u] + alpha * coefficient[6u])
+         );
+   *cos_x =
+      coefficient[1u] + alpha * (
+         coefficient[3u] + alpha * (coefficient[5u] + alpha * coefficient[7u])
+         );
+}
+
+static
+void
+cubic_spline_sampling_sincosd_evaluate(
+   register double x,
+   register double * sin_x,
+   register double * cos_x,
+   register void const * __accelerator
+   )
+{
+   __cubic_spline_sampling_sincosd_evaluate(
+      x,
+      sin_x,
+      cos_x,
+      (SamplingSinCosDAccelerator const *) __accelerator
+      );
+}
+
+static
+void
+cubic_spline_sampling_sincosd_batch_evaluate_scalar(
+   register double const * __x,
+   register double * sin_out,
+   register double * cos_out,
+   register size_t length,
+   register void const * restrict __accelerator
+   )
+{
+   for(
+      register size_t i = (size_t) 0u;
+      i< length;
+      ++i
+      )
+   {
+      __cubic_spline_sampling_sincosd_evaluate(
+         *__x++,
+         sin_out++,
+         cos_out++,
+         (SamplingSinCosDAccelerator const *) __accelerator
+         );
+   }
+   return;
+}
+
+#define __VARR_SIMD_KERNELS__ "varr_sincos.batch.h"
+#include "varr_simd_instantiate.h"
+
+/*
+ * Returns the number_of_samples + 2 (sin, cos) pairs of one period (and 
+ * beyond), of the table of sampling_sincosd, by rotation (see 
+ * __varr_sample_rotations):
+ */
+static
+double *
+sampling_sincosd_samples(size_t number_of_samples)
+{
+   // A range reduced phase may (by rounding) be as large as 2*pi:
+   return
+      __varr_sample_rotations(
+         __2pi / (double) number_of_samples, number_of_samples + 2u, 1u
+         );
+}
+
+/*
+ * Returns the four (sin, cos) pairs of coefficients of the splines on each 
+ * of the number_of_samples + 1 intervals of cubic_spline_sampling_sincosd:
+ */
+static
+double *
+cubic_spline_sampling_sincosd_samples(size_t number_of_samples)
+{
+   double const
+      step_size = __2pi / (double) number_of_samples;
+   // A range reduced phase may (by rounding) be as large as 2*pi:
+   size_t const
+      number_of_intervals = number_of_samples + (size_t) 1u;
+   double * const
+      values = (double *) malloc(
+         sizeof(double) * (size_t) 8u * number_of_intervals
+         );
+   if(values == NULL)
+   {
+      return NULL;
+   }
+   double * const
+      sin_coefficients = __varr_padded_cubic_spline_coefficients(
+         sin,
+         step_size,
+         number_of_intervals
+         );
+   double * const
+      cos_coefficients = __varr_padded_cubic_spline_coefficients(
+         cos,
+         step_size,
+         number_of_intervals
+         );
+   for(size_t i = (size_t) 0; i< (size_t) 4u * number_of_intervals; ++i)
+   {
+      values[(size_t) 2u * i] = sin_coefficients[i];
+      values[(size_t) 2u * i + (size_t) 1u] = cos_coefficients[i];
+   }
+   free(cos_coefficients);
+   free(sin_coefficients);
+   return
+      values;
+}
+
+VARRSinCosDEvaluator
+sampling_sincosd(size_t number_of_samples)
+{
+   VARRSinCosDEvaluator
+      result;
+   VARRTableKey const
+      key = {
+         .function = "sincos",
+         .method = "sampling",
+         .number_of_samples = number_of_samples,
+         .layout = __varr_table_format().layout,
+         .precision = __varr_table_format().precision,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   result.accelerator = (void *) allocate_sampling_sincosd(
+      number_of_samples,
+      __varr_shared_sample_table(
+         &key,
+         sampling_sincosd_samples,
+         number_of_samples + (size_t) 2u,
+         2u
+         )
+      );
+   result.sincosd = sampling_sincosd_evaluate;
+   result.sincosd_array =
+      __varr_simd_select(sampling_sincosd_batch_evaluate);
+   result.disallocate = sampling_sincosd_disallocate;
+   return
+      result;
+}
+
+VARRSinCosDEvaluator
+cubic_spline_sampling_sincosd(size_t number_of_samples)
+{
+   VARRSinCosDEvaluator
+      result;
+   VARRTableKey const
+      key = {
+         .function = "sincos",
+         .method = "cubic spline sampling",
+         .number_of_samples = number_of_samples,
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE,
+         .lower = 0.0,
+         .upper = __2pi
+      };
+   result.accelerator = (void *) allocate_sampling_sincosd(
+      number_of_samples,
+      __varr_shared_sample_table(
+         &key,
+         cubic_spline_sampling_sincosd_samples,
+         (size_t) 4u * (number_of_samples + (size_t) 1u),
+         2u
+         )
+      );
+   result.sincosd = cubic_spline_sampling_sincosd_evaluate;
+   result.sincosd_array =
+      __varr_simd_select(cubic_spline_sampling_sincosd_batch_evaluate);
+   result.disallocate = sampling_sincosd_disallocate;
+   return
+      result;
+}
+
+/*
+ * Measure the allocations of the constructors above (see 
+ * __VARR_CONSTRUCTOR_WITH_ALLOCATOR__):
+ */
+
+static
+void
+measure_sampling_sincosd(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingSinCosDAccelerator));
+   __varr_measure_shared_sample_table(
+      number_of_samples + (size_t) 2u,
+      2u,
+      __varr_table_format().layout,
+      __varr_table_format().precision
+      );
+}
+
+static
+void
+measure_cubic_spline_sampling_sincosd(size_t number_of_samples)
+{
+   __varr_allocation_measure(sizeof(SamplingSinCosDAccelerator));
+   __varr_measure_shared_sample_table(
+      (size_t) 4u * (number_of_samples + (size_t) 1u),
+      2u,
+      VARR_TABLE_VALUES,
+      VARR_TABLE_DOUBLE
+      );
+}
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRSinCosDEvaluator,
+   sampling_sincosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(
+   VARRSinCosDEvaluator,
+   sampling_sincosd
+   )
+
+__VARR_CONSTRUCTOR_WITH_ALLOCATOR__(
+   VARRSinCosDEvaluator,
+   cubic_spline_sampling_sincosd
+   )
@@ -0,0 +1,1029 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_table_cache.h"
+#include "varr_internal.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/*
+ * The cache is a list of entries, one per table, guarded by a single mutex.
+ * An entry is inserted (with 'ready' unset) before its table is built, so 
+ * that concurrent requests for the same key wait for it (on 
+ * __varr_table_cache_built) rather than building the table again.  Entries 
+ * of tables built while the cache is disabled are not 'shared', ie. they are
+ * never found by key, only by table.  The sections of the image of a table 
+ * are either allocated, or lie in a 'mapping' of a table file, in which case
+ * the entry is 'pinned' (holds a reference of its own) until 
+ * __varr_table_cache_unpin.
+ */
+typedef struct tagVARRTableCacheEntry
+{
+   struct tagVARRTableCacheEntry *
+      next;
+   VARRTableKey
+      key;
+   VARRTableKind const *
+      kind;
+   VARRTableImage
+      image;
+   void *
+      table;
+   void *
+      mapping;
+   size_t
+      mapping_bytes,
+      references;
+   int
+      shared,
+      ready,
+      pinned;
+} VARRTableCacheEntry;
+
+static pthread_mutex_t
+   __varr_table_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_cond_t
+   __varr_table_cache_built = PTHREAD_COND_INITIALIZER;
+
+static VARRTableCacheEntry *
+   __varr_table_cache = NULL;
+
+static int
+   __varr_table_cache_is_enabled = 1;
+
+static size_t
+   __varr_table_cache_hits = (size_t) 0u,
+   __varr_table_cache_misses = (size_t) 0u;
+
+/*
+ * The following functions are called with __varr_table_cache_mutex held:
+ */
+
+static
+int
+equal_keys(VARRTableKey const * a, VARRTableKey const * b)
+{
+   return
+      (a->number_of_samples == b->number_of_samples)
+      && (a->layout == b->layout)
+      && (a->precision == b->precision)
+      && (a->lower == b->lower)
+      && (a->upper == b->upper)
+      && (strcmp(a->function, b->function) == 0)
+      && (strcmp(a->method, b->method) == 0);
+}
+
+static
+VARRTableCacheEntry *
+find_by_key(VARRTableKey const * key)
+{
+   for(
+      VARRTableCacheEntry * entry = __varr_table_cache;
+      entry != NULL;
+      entry = entry->next
+      )
+   {
+      if(entry->shared && equal_keys(&entry->key, key))
+      {
+         return entry;
+      }
+   }
+   return NULL;
+}
+
+static
+VARRTableCacheEntry *
+find_by_table(void const * table)
+{
+   for(
+      VARRTableCacheEntry * entry = __varr_table_cache;
+      entry != NULL;
+      entry = entry->next
+      )
+   {
+      if(entry->ready && (entry->table == table))
+      {
+         return entry;
+      }
+   }
+   return NULL;
+}
+
+static
+void
+unlink_entry(VARRTableCacheEntry const * entry)
+{
+   for(
+      VARRTableCacheEntry ** link = &__varr_table_cache;
+      *link != NULL;
+      link = &(*link)->next
+      )
+   {
+      if(*link == entry)
+      {
+         *link = entry->next;
+         return;
+      }
+   }
+}
+
+/*
+ * Releases the table, and the sections, of an entry that has been unlinked:
+ */
+static
+void
+release_entry(VARRTableCacheEntry * entry)
+{
+   if(entry->kind->release_view != NULL)
+   {
+      entry->kind->release_view(entry->table);
+   }
+   if(entry->mapping != NULL)
+   {
+      munmap(entry->mapping, entry->mapping_bytes);
+   }
+   else
+   {
+      for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+      {
+         __varr_table_free(entry->image.sections[i]);
+      }
+   }
+   free(entry);
+}
+
+static
+size_t
+image_bytes(VARRTableImage const * image)
+{
+   size_t
+      result = (size_t) 0u;
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      result += image->bytes[i];
+   }
+   return
+      result;
+}
+
+/*
+ * Returns the shared table of 'key' (or a table of its own, if the cache is
+ * disabled), building it if need be:
+ */
+static
+void *
+acquire_table(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   void const * argument
+   )
+{
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   int
+      shared = __varr_table_cache_is_enabled;
+   VARRTableCacheEntry *
+      entry = shared ? find_by_key(key) : NULL;
+   while((entry != NULL) && !entry->ready)
+   {
+      pthread_cond_wait(&__varr_table_cache_built, &__varr_table_cache_mutex);
+      // The entry is removed if its build fails:
+      entry = find_by_key(key);
+   }
+   if(
+      (entry != NULL)
+      && ((entry->kind != kind) || !kind->fits(argument, &entry->image))
+      )
+   {
+      // The table of the key (eg. of a table file) is not the table of the
+      // request, which builds a table of its own:
+      entry = NULL;
+      shared = 0;
+   }
+   if(entry != NULL)
+   {
+      ++entry->references;
+      ++__varr_table_cache_hits;
+      pthread_mutex_unlock(&__varr_table_cache_mutex);
+      return
+         entry->table;
+   }
+   entry = (VARRTableCacheEntry *) calloc(1u, sizeof(VARRTableCacheEntry));
+   if(entry == NULL)
+   {
+      pthread_mutex_unlock(&__varr_table_cache_mutex);
+      return NULL;
+   }
+   entry->key = *key;
+   entry->kind = kind;
+   entry->references = (size_t) 1u;
+   entry->shared = shared;
+   entry->next = __varr_table_cache;
+   __varr_table_cache = entry;
+   if(shared)
+   {
+      ++__varr_table_cache_misses;
+   }
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   
+   VARRTableImage
+      image;
+   memset(&image, 0, sizeof(VARRTableImage));
+   void *
+      table = NULL;
+   if(kind->build(key, argument, &image) == 0)
+   {
+      table = kind->view(key, &image);
+   }
+   
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   entry->image = image;
+   if(table == NULL)
+   {
+      unlink_entry(entry);
+      for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+      {
+         __varr_table_free(image.sections[i]);
+      }
+      free(entry);
+   }
+   else
+   {
+      entry->table = table;
+      entry->ready = 1;
+   }
+   pthread_cond_broadcast(&__varr_table_cache_built);
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return
+      table;
+}
+
+void
+__varr_table_cache_release(void const * table)
+{
+   if(table == NULL)
+   {
+      return;
+   }
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   VARRTableCacheEntry * const
+      entry = find_by_table(table);
+   if((entry == NULL) || (--entry->references > (size_t) 0u))
+   {
+      pthread_mutex_unlock(&__varr_table_cache_mutex);
+      return;
+   }
+   unlink_entry(entry);
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   release_entry(entry);
+}
+
+int
+__varr_table_cache_insert_mapped(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   VARRTableImage const * image,
+   void * mapping,
+   size_t mapping_bytes
+   )
+{
+   VARRTableCacheEntry * const
+      entry = (VARRTableCacheEntry *) calloc(1u, sizeof(VARRTableCacheEntry));
+   if(entry == NULL)
+   {
+      munmap(mapping, mapping_bytes);
+      return 1;
+   }
+   entry->key = *key;
+   entry->kind = kind;
+   entry->image = *image;
+   entry->mapping = mapping;
+   entry->mapping_bytes = mapping_bytes;
+   entry->references = (size_t) 1u;
+   entry->shared = 1;
+   entry->ready = 1;
+   entry->pinned = 1;
+   entry->table = kind->view(key, image);
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   if((entry->table == NULL) || (find_by_key(key) != NULL))
+   {
+      pthread_mutex_unlock(&__varr_table_cache_mutex);
+      if(entry->table == NULL)
+      {
+         munmap(mapping, mapping_bytes);
+         free(entry);
+      }
+      else
+      {
+         release_entry(entry);
+      }
+      return 1;
+   }
+   entry->next = __varr_table_cache;
+   __varr_table_cache = entry;
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return 0;
+}
+
+size_t
+__varr_table_cache_unpin(void)
+{
+   VARRTableCacheEntry *
+      released = NULL;
+   size_t
+      result = (size_t) 0u;
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   VARRTableCacheEntry **
+      link = &__varr_table_cache;
+   while(*link != NULL)
+   {
+      VARRTableCacheEntry * const
+         entry = *link;
+      if(entry->pinned)
+      {
+         entry->pinned = 0;
+         if(--entry->references == (size_t) 0u)
+         {
+            *link = entry->next;
+            entry->next = released;
+            released = entry;
+            ++result;
+            continue;
+         }
+      }
+      link = &entry->next;
+   }
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   while(released != NULL)
+   {
+      VARRTableCacheEntry * const
+         next = released->next;
+      release_entry(released);
+      released = next;
+   }
+   return
+      result;
+}
+
+size_t
+__varr_table_cache_visit(
+   int (* visit) (
+      VARRTableKey const *,
+      VARRTableKind const *,
+      VARRTableImage const *,
+      void *
+      ),
+   void * context
+   )
+{
+   size_t
+      result = (size_t) 0u;
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   for(
+      VARRTableCacheEntry const * entry = __varr_table_cache;
+      entry != NULL;
+      entry = entry->next
+      )
+   {
+      if(
+         entry->ready
+         && entry->shared
+         && (visit(&entry->key, entry->kind, &entry->image, context) == 0)
+         )
+      {
+         ++result;
+      }
+   }
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return
+      result;
+}
+
+VARRTableCacheStatistics
+varr_table_cache_statistics(void)
+{
+   VARRTableCacheStatistics
+      result = {
+         .tables = (size_t) 0u,
+         .references = (size_t) 0u,
+         .bytes = (size_t) 0u,
+         .hits = (size_t) 0u,
+         .misses = (size_t) 0u
+      };
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   for(
+      VARRTableCacheEntry const * entry = __varr_table_cache;
+      entry != NULL;
+      entry = entry->next
+      )
+   {
+      if(entry->ready)
+      {
+         ++result.tables;
+         result.references += entry->references;
+         result.bytes += image_bytes(&entry->image);
+      }
+   }
+   result.hits = __varr_table_cache_hits;
+   result.misses = __varr_table_cache_misses;
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return
+      result;
+}
+
+int
+varr_table_cache_enabled(void)
+{
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   int const
+      result = __varr_table_cache_is_enabled;
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return
+      result;
+}
+
+int
+varr_set_table_cache_enabled(int enabled)
+{
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   __varr_table_cache_is_enabled = (enabled != 0);
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return
+      varr_table_cache_enabled();
+}
+
+/*
+ * Kinds of tables.  The image of a VARRSampleTable is its samples (of 
+ * either precision) and its corrections, if any:
+ */
+
+/*
+ * Returns a copy of the table of 'image', of a new entry that is not shared,
+ * in memory of __varr_table_allocate, or NULL:
+ */
+static
+void *
+copy_table(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   VARRTableImage const * image
+   )
+{
+   VARRTableCacheEntry * const
+      entry = (VARRTableCacheEntry *) calloc(1u, sizeof(VARRTableCacheEntry));
+   if(entry == NULL)
+   {
+      return NULL;
+   }
+   entry->key = *key;
+   entry->kind = kind;
+   entry->references = (size_t) 1u;
+   entry->image = *image;
+   int
+      failed = 0;
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      entry->image.sections[i] = NULL;
+      if(image->bytes[i] > (size_t) 0u)
+      {
+         entry->image.sections[i] = __varr_table_allocate(image->bytes[i]);
+         if(entry->image.sections[i] == NULL)
+         {
+            failed = 1;
+            continue;
+         }
+         memcpy(entry->image.sections[i], image->sections[i], image->bytes[i]);
+      }
+   }
+   entry->table = failed ? NULL : kind->view(key, &entry->image);
+   if(entry->table == NULL)
+   {
+      for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+      {
+         __varr_table_free(entry->image.sections[i]);
+      }
+      free(entry);
+      return NULL;
+   }
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   entry->ready = 1;
+   entry->next = __varr_table_cache;
+   __varr_table_cache = entry;
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   return
+      entry->table;
+}
+
+/*
+ * Evaluators of a VARRAllocator (see varr_allocator.h) hold copies of the 
+ * shared tables in their own memory (which __varr_measure_shared_* measure 
+ * beforehand if the evaluator is contiguous).  The shared table is built (or
+ * loaded) in memory of VARR's own, and is released once copied.
+ */
+void *
+__varr_table_cache_acquire(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   void const * argument
+   )
+{
+   int const
+      phase = __varr_allocation_phase();
+   void * const
+      construction = __varr_suspend_allocation();
+   void * const
+      table = acquire_table(key, kind, argument);
+   __varr_resume_allocation(construction);
+   if((table == NULL) || (phase == __VARR_ALLOCATION_NONE__))
+   {
+      return
+         table;
+   }
+   pthread_mutex_lock(&__varr_table_cache_mutex);
+   VARRTableImage const
+      image = find_by_table(table)->image;
+   pthread_mutex_unlock(&__varr_table_cache_mutex);
+   void * const
+      copy = copy_table(key, kind, &image);
+   __varr_table_cache_release(table);
+   return
+      copy;
+}
+
+/*
+ * Measures the sections of an image of 'kind' of the given width and number
+ * of values, as copied by __varr_table_cache_acquire:
+ */
+static
+void
+measure_image(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   size_t width,
+   size_t number_of_values
+   )
+{
+   VARRTableImage
+      image;
+   memset(&image, 0, sizeof(VARRTableImage));
+   image.width = width;
+   image.number_of_values = number_of_values;
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      size_t const
+         bytes = kind->section_bytes(key, &image, i);
+      if((bytes != SIZE_MAX) && (bytes > (size_t) 0u))
+      {
+         __varr_allocation_measure(bytes);
+      }
+   }
+}
+
+int
+__varr_table_image_is_valid(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   VARRTableImage const * image
+   )
+{
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      size_t const
+         expected = kind->section_bytes(key, image, i);
+      if((expected == SIZE_MAX) || (image->bytes[i] != expected))
+      {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+/*
+ * Returns nonzero if the width and number of values of 'image' are those of
+ * an image of at least 'minimum' values, the bytes of which (of at most 32 
+ * bytes by value) are of a size_t:
+ */
+static
+int
+valid_shape(VARRTableImage const * image, size_t minimum)
+{
+   return
+      (image->width > (size_t) 0u)
+      && (image->number_of_values >= minimum)
+      && (image->number_of_values <= (SIZE_MAX / 32u) / image->width);
+}
+
+typedef struct tagVARRSampleTableRecipe
+{
+   double * (* sample) (size_t);
+   size_t
+      number_of_values,
+      width;
+} VARRSampleTableRecipe;
+
+static
+int
+sample_recipe_fits(void const * argument, VARRTableImage const * image)
+{
+   VARRSampleTableRecipe const * const
+      recipe = (VARRSampleTableRecipe const *) argument;
+   return
+      (image->width == recipe->width)
+      && (image->number_of_values == recipe->number_of_values);
+}
+
+static
+size_t
+sample_section_bytes(
+   VARRTableKey const * key,
+   VARRTableImage const * image,
+   size_t section
+   )
+{
+   if(!valid_shape(image, (size_t) 2u))
+   {
+      return SIZE_MAX;
+   }
+   if(section > (size_t) 0u)
+   {
+      return
+         (key->precision == VARR_TABLE_FLOAT_CORRECTED) ?
+            sizeof(int16_t) * image->width * (image->number_of_values + 1u)
+            :
+            (size_t) 0u;
+   }
+   size_t const
+      length = (key->layout == VARR_TABLE_INTERLEAVED) ?
+         2u * image->width * (image->number_of_values - 1u)
+         :
+         image->width * image->number_of_values;
+   return
+      (key->precision == VARR_TABLE_DOUBLE) ?
+         sizeof(double) * length
+         :
+         sizeof(float) * length;
+}
+
+static
+int
+build_sample_table(
+   VARRTableKey const * key,
+   void const * argument,
+   VARRTableImage * image
+   )
+{
+   VARRSampleTableRecipe const * const
+      recipe = (VARRSampleTableRecipe const *) argument;
+   double * const
+      values = recipe->sample(key->number_of_samples);
+   if(values == NULL)
+   {
+      return 1;
+   }
+   VARRSampleTable const
+      table = __varr_sample_table(
+         values,
+         recipe->number_of_values,
+         recipe->width,
+         key->layout,
+         key->precision
+         );
+   image->width = recipe->width;
+   image->number_of_values = recipe->number_of_values;
+   image->scale = table.correction_scale;
+   image->sections[0u] = (key->precision == VARR_TABLE_DOUBLE) ?
+      (void *) table.values : (void *) table.floats;
+   image->sections[1u] = (void *) table.corrections;
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      image->bytes[i] = sample_section_bytes(key, image, i);
+   }
+   return
+      (image->sections[0u] == NULL);
+}
+
+static
+void *
+view_sample_table(VARRTableKey const * key, VARRTableImage const * image)
+{
+   VARRSampleTable * const
+      table = (VARRSampleTable *) malloc(sizeof(VARRSampleTable));
+   if(table == NULL)
+   {
+      return NULL;
+   }
+   table->layout = key->layout;
+   table->precision = key->precision;
+   table->width = image->width;
+   table->values = (key->precision == VARR_TABLE_DOUBLE) ?
+      (double const *) image->sections[0u] : NULL;
+   table->floats = (key->precision == VARR_TABLE_DOUBLE) ?
+      NULL : (float const *) image->sections[0u];
+   table->corrections = (int16_t const *) image->sections[1u];
+   table->correction_scale = image->scale;
+   table->shared = NULL;
+   return
+      (void *) table;
+}
+
+static VARRTableKind const
+   __varr_sample_table_kind = {
+      .identifier = __VARR_TABLE_KIND_SAMPLES__,
+      .build = build_sample_table,
+      .fits = sample_recipe_fits,
+      .section_bytes = sample_section_bytes,
+      .view = view_sample_table,
+      .release_view = free
+   };
+
+VARRSampleTable
+__varr_shared_sample_table(
+   VARRTableKey const * key,
+   double * (* sample) (size_t),
+   size_t number_of_values,
+   size_t width
+   )
+{
+   VARRSampleTableRecipe const
+      recipe = {
+         .sample = sample,
+         .number_of_values = number_of_values,
+         .width = width
+      };
+   VARRSampleTable const * const
+      shared = (VARRSampleTable const *) __varr_table_cache_acquire(
+         key, &__varr_sample_table_kind, &recipe
+         );
+   if(shared == NULL)
+   {
+      VARRSampleTable const
+         empty = {
+            .layout = key->layout,
+            .precision = key->precision,
+            .width = width
+         };
+      return
+         empty;
+   }
+   VARRSampleTable
+      result = *shared;
+   result.shared = (void const *) shared;
+   return
+      result;
+}
+
+void
+__varr_measure_shared_sample_table(
+   size_t number_of_values,
+   size_t width,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   )
+{
+   VARRTableKey const
+      key = {
+         .layout = layout,
+         .precision = precision
+      };
+   measure_image(&key, &__varr_sample_table_kind, width, number_of_values);
+}
+
+/*
+ * The image of a float table, or of an array, is the table itself:
+ */
+
+static
+void *
+view_array(VARRTableKey const * key, VARRTableImage const * image)
+{
+   (void) key;
+   return
+      image->sections[0u];
+}
+
+static
+size_t
+float_section_bytes(
+   VARRTableKey const * key,
+   VARRTableImage const * image,
+   size_t section
+   )
+{
+   (void) key;
+   if(!valid_shape(image, (size_t) 2u))
+   {
+      return SIZE_MAX;
+   }
+   return
+      (section > (size_t) 0u) ?
+         (size_t) 0u
+         :
+         sizeof(float) * 2u * image->width * (image->number_of_values - 1u);
+}
+
+static
+int
+build_float_table(
+   VARRTableKey const * key,
+   void const * argument,
+   VARRTableImage * image
+   )
+{
+   VARRSampleTableRecipe const * const
+      recipe = (VARRSampleTableRecipe const *) argument;
+   double * const
+      values = recipe->sample(key->number_of_samples);
+   if(values == NULL)
+   {
+      return 1;
+   }
+   image->sections[0u] = (void *) __varr_float_interleaved_table(
+      values, recipe->number_of_values, recipe->width
+      );
+   free(values);
+   image->width = recipe->width;
+   image->number_of_values = recipe->number_of_values;
+   image->bytes[0u] = float_section_bytes(key, image, 0u);
+   return
+      (image->sections[0u] == NULL);
+}
+
+static VARRTableKind const
+   __varr_float_table_kind = {
+      .identifier = __VARR_TABLE_KIND_FLOATS__,
+      .build = build_float_table,
+      .fits = sample_recipe_fits,
+      .section_bytes = float_section_bytes,
+      .view = view_array,
+      .release_view = NULL
+   };
+
+float const *
+__varr_shared_float_table(
+   VARRTableKey const * key,
+   double * (* sample) (size_t),
+   size_t number_of_values,
+   size_t width
+   )
+{
+   VARRSampleTableRecipe const
+      recipe = {
+         .sample = sample,
+         .number_of_values = number_of_values,
+         .width = width
+      };
+   return
+      (float const *) __varr_table_cache_acquire(
+         key, &__varr_float_table_kind, &recipe
+         );
+}
+
+/*
+ * The width of the image of an array is the bytes of its elements, and its
+ * number of values is its number of elements:
+ */
+typedef struct tagVARRArrayRecipe
+{
+   size_t
+      element_bytes,
+      number_of_elements;
+   void * (* build) (VARRTableKey const *, void const *);
+   void const *
+      argument;
+} VARRArrayRecipe;
+
+static
+int
+array_recipe_fits(void const * argument, VARRTableImage const * image)
+{
+   VARRArrayRecipe const * const
+      recipe = (VARRArrayRecipe const *) argument;
+   return
+      (image->width == recipe->element_bytes)
+      && (image->number_of_values == recipe->number_of_elements);
+}
+
+static
+size_t
+array_section_bytes(
+   VARRTableKey const * key,
+   VARRTableImage const * image,
+   size_t section
+   )
+{
+   (void) key;
+   if(!valid_shape(image, (size_t) 1u))
+   {
+      return SIZE_MAX;
+   }
+   return
+      (section > (size_t) 0u) ?
+         (size_t) 0u
+         :
+         image->width * image->number_of_values;
+}
+
+static
+int
+build_array(
+   VARRTableKey const * key,
+   void const * argument,
+   VARRTableImage * image
+   )
+{
+   VARRArrayRecipe const * const
+      recipe = (VARRArrayRecipe const *) argument;
+   image->width = recipe->element_bytes;
+   image->number_of_values = recipe->number_of_elements;
+   image->bytes[0u] = array_section_bytes(key, image, 0u);
+   image->sections[0u] = recipe->build(key, recipe->argument);
+   return
+      (image->sections[0u] == NULL);
+}
+
+static VARRTableKind const
+   __varr_array_kind = {
+      .identifier = __VARR_TABLE_KIND_ARRAY__,
+      .build = build_array,
+      .fits = array_recipe_fits,
+      .section_bytes = array_section_bytes,
+      .view = view_array,
+      .release_view = NULL
+   };
+
+void const *
+__varr_shared_array(
+   VARRTableKey const * key,
+   size_t element_bytes,
+   size_t number_of_elements,
+   void * (* build) (VARRTableKey const *, void const *),
+   void const * argument
+   )
+{
+   VARRArrayRecipe const
+      recipe = {
+         .element_bytes = element_bytes,
+         .number_of_elements = number_of_elements,
+         .build = build,
+         .argument = argument
+      };
+   return
+      __varr_table_cache_acquire(key, &__varr_array_kind, &recipe);
+}
+
+void
+__varr_measure_shared_float_table(size_t number_of_values, size_t width)
+{
+   VARRTableKey const
+      key = {
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE
+      };
+   measure_image(&key, &__varr_float_table_kind, width, number_of_values);
+}
+
+void
+__varr_measure_shared_array(size_t element_bytes, size_t number_of_elements)
+{
+   VARRTableKey const
+      key = {
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE
+      };
+   measure_image(&key, &__varr_array_kind, element_bytes, number_of_elements);
+}
+
+VARRTableKind const *
+__varr_table_kind(uint32_t identifier)
+{
+   switch(identifier)
+   {
+   case __VARR_TABLE_KIND_SAMPLES__:
+      return &__varr_sample_table_kind;
+   case __VARR_TABLE_KIND_FLOATS__:
+      return &__varr_float_table_kind;
+   case __VARR_TABLE_KIND_ARRAY__:
+      return &__varr_array_kind;
+   }
+   return NULL;
+}
@@ -0,0 +1,496 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_table_file.h"
+#include "varr_internal.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define __VARR_TABLE_FILE_VERSION__ 2u
+#define __VARR_TABLE_FILE_BYTE_ORDER__ 0x01020304u
+#define __VARR_TABLE_FILE_ALIGNMENT__ ((size_t) 64u)
+
+static char const
+   __varr_table_file_magic[8u] = "VARRTBL",
+   __varr_table_file_suffix[] = ".varrtable";
+
+static
+size_t
+aligned(size_t offset)
+{
+   return
+      (offset + __VARR_TABLE_FILE_ALIGNMENT__ - 1u)
+    & ~(__VARR_TABLE_FILE_ALIGNMENT__ - 1u);
+}
+
+/*
+ * FNV-1a, eight bytes at a time (and byte by byte for the remainder), over
+ * the sections of an image:
+ */
+static
+uint64_t
+table_checksum(void const * const * sections, uint64_t const * bytes)
+{
+   uint64_t
+      hash = UINT64_C(0xcbf29ce484222325);
+   uint64_t const
+      prime = UINT64_C(0x100000001b3);
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      unsigned char const * const
+         section = (unsigned char const *) sections[i];
+      size_t const
+         words = (size_t) bytes[i] / sizeof(uint64_t);
+      for(size_t j = (size_t) 0u; j< words; ++j)
+      {
+         uint64_t
+            word;
+         memcpy(&word, section + j * sizeof(uint64_t), sizeof(uint64_t));
+         hash = (hash ^ word) * prime;
+      }
+      for(size_t j = words * sizeof(uint64_t); j< (size_t) bytes[i]; ++j)
+      {
+         hash = (hash ^ (uint64_t) section[j]) * prime;
+      }
+   }
+   return
+      hash;
+}
+
+/*
+ * Writes the file name of the table of 'key', of the characters of the 
+ * function and method names (with others replaced by '_'), to 'name' (of 
+ * PATH_MAX characters):
+ */
+static
+int
+table_file_path(
+   char * path,
+   size_t length,
+   char const * directory,
+   VARRTableKey const * key
+   )
+{
+   int const
+      written = snprintf(
+         path,
+         length,
+         "%s/%s-%s-%zu-%s-%s%s",
+         directory,
+         key->function,
+         key->method,
+         key->number_of_samples,
+         varr_table_layout_name(key->layout),
+         varr_table_precision_name(key->precision),
+         __varr_table_file_suffix
+         );
+   if((written < 0) || ((size_t) written >= length))
+   {
+      return 1;
+   }
+   for(
+      char * c = path + strlen(directory) + 1u;
+      *c != '\0';
+      ++c
+      )
+   {
+      if(
+         !(((*c >= 'a') && (*c <= 'z'))
+         || ((*c >= 'A') && (*c <= 'Z'))
+         || ((*c >= '0') && (*c <= '9'))
+         || (*c == '-')
+         || (*c == '.'))
+         )
+      {
+         *c = '_';
+      }
+   }
+   return 0;
+}
+
+static
+int
+write_fully(int descriptor, void const * data, size_t bytes)
+{
+   unsigned char const *
+      cursor = (unsigned char const *) data;
+   while(bytes > (size_t) 0u)
+   {
+      ssize_t const
+         written = write(descriptor, cursor, bytes);
+      if(written <= 0)
+      {
+         return 1;
+      }
+      cursor += written;
+      bytes -= (size_t) written;
+   }
+   return 0;
+}
+
+typedef struct tagVARRTableFileSaving
+{
+   char const *
+      directory;
+   int
+      failures;
+} VARRTableFileSaving;
+
+static
+int
+save_table(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   VARRTableImage const * image,
+   void * context
+   )
+{
+   VARRTableFileSaving * const
+      saving = (VARRTableFileSaving *) context;
+   VARRTableFileHeader
+      header;
+   char
+      path[4096u],
+      temporary_path[4096u + 32u];
+   
+   if(
+      (strlen(key->function) >= __VARR_TABLE_FILE_NAME_LENGTH__)
+      || (strlen(key->method) >= __VARR_TABLE_FILE_NAME_LENGTH__)
+      || table_file_path(path, sizeof(path), saving->directory, key)
+      )
+   {
+      ++saving->failures;
+      return 1;
+   }
+   memset(&header, 0, sizeof(VARRTableFileHeader));
+   memcpy(header.magic, __varr_table_file_magic, sizeof(header.magic));
+   header.version = __VARR_TABLE_FILE_VERSION__;
+   header.contents = __VARR_TABLE_CONTENTS_VERSION__;
+   header.byte_order = __VARR_TABLE_FILE_BYTE_ORDER__;
+   header.kind = kind->identifier;
+   header.layout = (uint32_t) key->layout;
+   header.precision = (uint32_t) key->precision;
+   header.number_of_samples = (uint64_t) key->number_of_samples;
+   header.width = (uint64_t) image->width;
+   header.number_of_values = (uint64_t) image->number_of_values;
+   header.lower = key->lower;
+   header.upper = key->upper;
+   header.scale = image->scale;
+   strcpy(header.function, key->function);
+   strcpy(header.method, key->method);
+   size_t
+      offset = aligned(sizeof(VARRTableFileHeader));
+   // Empty sections are of offset zero, so that the file ends at its last byte:
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      if(image->bytes[i] > (size_t) 0u)
+      {
+         header.offsets[i] = (uint64_t) offset;
+         header.bytes[i] = (uint64_t) image->bytes[i];
+         offset = aligned(offset + image->bytes[i]);
+      }
+   }
+   header.checksum = table_checksum(
+      (void const * const *) image->sections, header.bytes
+      );
+   
+   snprintf(
+      temporary_path,
+      sizeof(temporary_path),
+      "%s.%ld.tmp",
+      path,
+      (long) getpid()
+      );
+   int const
+      descriptor = open(
+         temporary_path, O_WRONLY | O_CREAT | O_TRUNC, (mode_t) 0644
+         );
+   if(descriptor < 0)
+   {
+      ++saving->failures;
+      return 1;
+   }
+   static unsigned char const
+      padding[__VARR_TABLE_FILE_ALIGNMENT__] = { 0u };
+   int
+      failed = write_fully(descriptor, &header, sizeof(VARRTableFileHeader));
+   offset = sizeof(VARRTableFileHeader);
+   for(size_t i = (size_t) 0u; (i< __VARR_TABLE_SECTIONS__) && !failed; ++i)
+   {
+      if(header.bytes[i] == 0u)
+      {
+         continue;
+      }
+      failed = 
+         write_fully(
+            descriptor, padding, (size_t) header.offsets[i] - offset
+            )
+         || write_fully(descriptor, image->sections[i], image->bytes[i]);
+      offset = (size_t) (header.offsets[i] + header.bytes[i]);
+   }
+   failed = (close(descriptor) != 0) || failed;
+   if(failed || (rename(temporary_path, path) != 0))
+   {
+      unlink(temporary_path);
+      ++saving->failures;
+      return 1;
+   }
+   return 0;
+}
+
+int
+varr_save_tables(char const * directory)
+{
+   VARRTableFileSaving
+      saving = {
+         .directory = directory,
+         .failures = 0
+      };
+   size_t const
+      saved = __varr_table_cache_visit(save_table, &saving);
+   return
+      saving.failures ? -1 : (int) saved;
+}
+
+/*
+ * Returns the key of 'header', the names of which are those of the header:
+ */
+static
+VARRTableKey
+header_key(VARRTableFileHeader const * header)
+{
+   VARRTableKey const
+      key = {
+         .function = header->function,
+         .method = header->method,
+         .number_of_samples = (size_t) header->number_of_samples,
+         .layout = (VARRTableLayout) header->layout,
+         .precision = (VARRTablePrecision) header->precision,
+         .lower = header->lower,
+         .upper = header->upper
+      };
+   return
+      key;
+}
+
+/*
+ * Returns nonzero if the header (of a file of 'size' bytes) is that of a
+ * valid table file of this version, and of the contents of this version, 
+ * the sections of which are of the bytes that its kind implies for its key:
+ */
+static
+int
+valid_header(VARRTableFileHeader const * header, size_t size)
+{
+   if(
+      (size < sizeof(VARRTableFileHeader))
+      || memcmp(header->magic, __varr_table_file_magic, sizeof(header->magic))
+      || (header->version != __VARR_TABLE_FILE_VERSION__)
+      || (header->contents != __VARR_TABLE_CONTENTS_VERSION__)
+      || (header->byte_order != __VARR_TABLE_FILE_BYTE_ORDER__)
+      || (__varr_table_kind(header->kind) == NULL)
+      || (header->layout > (uint32_t) VARR_TABLE_INTERLEAVED)
+      || (header->precision > (uint32_t) VARR_TABLE_FLOAT_CORRECTED)
+      || (memchr(header->function, '\0', sizeof(header->function)) == NULL)
+      || (memchr(header->method, '\0', sizeof(header->method)) == NULL)
+      || (header->bytes[0u] == 0u)
+      )
+   {
+      return 0;
+   }
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      if(
+         (header->offsets[i] % __VARR_TABLE_FILE_ALIGNMENT__)
+         || (header->offsets[i] > (uint64_t) size)
+         || (header->bytes[i] > (uint64_t) size - header->offsets[i])
+         )
+      {
+         return 0;
+      }
+   }
+   if(
+      (header->width > (uint64_t) SIZE_MAX)
+      || (header->number_of_values > (uint64_t) SIZE_MAX)
+      )
+   {
+      return 0;
+   }
+   VARRTableKey const
+      key = header_key(header);
+   VARRTableImage
+      image;
+   memset(&image, 0, sizeof(VARRTableImage));
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      image.bytes[i] = (size_t) header->bytes[i];
+   }
+   image.width = (size_t) header->width;
+   image.number_of_values = (size_t) header->number_of_values;
+   return
+      __varr_table_image_is_valid(
+         &key, __varr_table_kind(header->kind), &image
+         );
+}
+
+/*
+ * Maps the table file at 'path' into the table cache, and returns zero, or 
+ * returns nonzero if the file is not loaded:
+ */
+static
+int
+load_table(char const * path, int verify)
+{
+   int const
+      descriptor = open(path, O_RDONLY);
+   if(descriptor < 0)
+   {
+      return 1;
+   }
+   struct stat
+      status;
+   if(fstat(descriptor, &status) || (status.st_size <= 0))
+   {
+      close(descriptor);
+      return 1;
+   }
+   size_t const
+      size = (size_t) status.st_size;
+   // The header is validated before the file is mapped:
+   VARRTableFileHeader
+      read_header;
+   if(
+      (read(descriptor, &read_header, sizeof(VARRTableFileHeader))
+         != (ssize_t) sizeof(VARRTableFileHeader))
+      || !valid_header(&read_header, size)
+      )
+   {
+      close(descriptor);
+      return 1;
+   }
+   void * const
+      mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, descriptor, 0);
+   close(descriptor);
+   if(mapping == MAP_FAILED)
+   {
+      return 1;
+   }
+   VARRTableFileHeader const * const
+      header = (VARRTableFileHeader const *) mapping;
+   // The file may have been written in place since its header was read:
+   if(memcmp(header, &read_header, sizeof(VARRTableFileHeader)))
+   {
+      munmap(mapping, size);
+      return 1;
+   }
+   VARRTableImage
+      image;
+   memset(&image, 0, sizeof(VARRTableImage));
+   for(size_t i = (size_t) 0u; i< __VARR_TABLE_SECTIONS__; ++i)
+   {
+      image.bytes[i] = (size_t) header->bytes[i];
+      image.sections[i] = (header->bytes[i] > 0u) ?
+         (void *) ((unsigned char *) mapping + header->offsets[i])
+         :
+         NULL;
+   }
+   image.width = (size_t) header->width;
+   image.number_of_values = (size_t) header->number_of_values;
+   image.scale = header->scale;
+   if(
+      verify
+      && (table_checksum((void const * const *) image.sections, header->bytes)
+         != header->checksum)
+      )
+   {
+      munmap(mapping, size);
+      return 1;
+   }
+   // The names of the key lie in the mapping, which outlives the key:
+   VARRTableKey const
+      key = header_key(header);
+   return
+      __varr_table_cache_insert_mapped(
+         &key, __varr_table_kind(header->kind), &image, mapping, size
+         );
+}
+
+int
+varr_load_tables(char const * directory, int verify)
+{
+   DIR * const
+      listing = opendir(directory);
+   if(listing == NULL)
+   {
+      return -1;
+   }
+   size_t const
+      suffix_length = strlen(__varr_table_file_suffix);
+   char
+      path[4096u];
+   int
+      result = 0;
+   for(
+      struct dirent const * file = readdir(listing);
+      file != NULL;
+      file = readdir(listing)
+      )
+   {
+      size_t const
+         length = strlen(file->d_name);
+      if(
+         (length <= suffix_length)
+         || strcmp(file->d_name + length - suffix_length,
+            __varr_table_file_suffix)
+         )
+      {
+         continue;
+      }
+      int const
+         written = snprintf(
+            path, sizeof(path), "%s/%s", directory, file->d_name
+            );
+      if(
+         (written > 0)
+         && ((size_t) written < sizeof(path))
+         && (load_table(path, verify) == 0)
+         )
+      {
+         ++result;
+      }
+   }
+   closedir(listing);
+   return
+      result;
+}
+
+size_t
+varr_unload_tables(void)
+{
+   return
+      __varr_table_cache_unpin();
+}
@@ -0,0 +1,347 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_table_layout.h"
+#include "varr_internal.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+/*
+ * The table format of the constructions of this thread, as selected by the
+ * *_with_table_format constructor in progress (if any):
+ */
+static __thread VARRTableFormat
+   __varr_construction_table_format = {
+      .layout = VARR_TABLE_VALUES,
+      .precision = VARR_TABLE_DOUBLE,
+      .pages = VARR_TABLE_PAGES_DEFAULT
+   };
+
+VARRTableFormat
+__varr_table_format(void)
+{
+   return
+      __varr_construction_table_format;
+}
+
+VARRTableFormat
+__varr_select_table_format(VARRTableFormat format)
+{
+   VARRTableFormat const
+      previous = __varr_construction_table_format;
+   __varr_construction_table_format.layout = 
+      (format.layout == VARR_TABLE_INTERLEAVED) ?
+         VARR_TABLE_INTERLEAVED
+         :
+         VARR_TABLE_VALUES;
+   switch(format.precision)
+   {
+   case VARR_TABLE_FLOAT:
+   case VARR_TABLE_FLOAT_CORRECTED:
+      __varr_construction_table_format.precision = format.precision;
+      break;
+   default:
+      __varr_construction_table_format.precision = VARR_TABLE_DOUBLE;
+      break;
+   }
+   switch(format.pages)
+   {
+   case VARR_TABLE_PAGES_TRANSPARENT:
+   case VARR_TABLE_PAGES_EXPLICIT:
+      __varr_construction_table_format.pages = format.pages;
+      break;
+   default:
+      __varr_construction_table_format.pages = VARR_TABLE_PAGES_DEFAULT;
+      break;
+   }
+   return
+      previous;
+}
+
+char const *
+varr_table_layout_name(VARRTableLayout layout)
+{
+   switch(layout)
+   {
+   case VARR_TABLE_VALUES:
+      return "values";
+   case VARR_TABLE_INTERLEAVED:
+      return "interleaved";
+   }
+   return "unknown";
+}
+
+char const *
+varr_table_precision_name(VARRTablePrecision precision)
+{
+   switch(precision)
+   {
+   case VARR_TABLE_DOUBLE:
+      return "double";
+   case VARR_TABLE_FLOAT:
+      return "float";
+   case VARR_TABLE_FLOAT_CORRECTED:
+      return "float (corrected)";
+   }
+   return "unknown";
+}
+
+double *
+__varr_interleaved_table(
+   double const * values,
+   size_t number_of_samples,
+   size_t width
+   )
+{
+   size_t const
+      row = 2u * width;
+   double * const
+      table = (double *) __varr_table_allocate(
+         sizeof(double) * row * (number_of_samples - 1u)
+         );
+   if(table == NULL)
+   {
+      return NULL;
+   }
+   for(size_t i = (size_t) 0u; i< number_of_samples - 1u; ++i)
+   {
+      for(size_t j = (size_t) 0u; j< width; ++j)
+      {
+         table[i * row + j] = values[i * width + j];
+         table[i * row + width + j] = 
+            values[(i + 1u) * width + j] - values[i * width + j];
+      }
+   }
+   return
+      table;
+}
+
+float *
+__varr_float_interleaved_table(
+   double const * values,
+   size_t number_of_samples,
+   size_t width
+   )
+{
+   size_t const
+      row = 2u * width;
+   float * const
+      table = (float *) __varr_table_allocate(
+         sizeof(float) * row * (number_of_samples - 1u)
+         );
+   if(table == NULL)
+   {
+      return NULL;
+   }
+   for(size_t i = (size_t) 0u; i< number_of_samples - 1u; ++i)
+   {
+      for(size_t j = (size_t) 0u; j< width; ++j)
+      {
+         table[i * row + j] = (float) values[i * width + j];
+         table[i * row + width + j] = (float) (
+            values[(i + 1u) * width + j] - (double) table[i * row + j]
+            );
+      }
+   }
+   return
+      table;
+}
+
+/*
+ * Rounds the 'length' doubles of a table (of either layout) to floats, in a
+ * table allocation, or returns NULL:
+ */
+static
+float *
+__varr_float_table(double const * table, size_t length)
+{
+   float * const
+      floats = (float *) __varr_table_allocate(sizeof(float) * length);
+   if(floats == NULL)
+   {
+      return NULL;
+   }
+   for(size_t i = (size_t) 0u; i< length; ++i)
+   {
+      floats[i] = (float) table[i];
+   }
+   return
+      floats;
+}
+
+/*
+ * Returns the 16-bit corrections (of 'length' components) from the float
+ * rounding of 'values' back to 'values', in units of *scale, which is chosen
+ * so that the largest correction is 32767.  The corrections are followed by
+ * 'width' zeros, so that a SIMD lookup of the corrections to a sample and 
+ * the next one never reads past the end of the allocation.
+ */
+static
+int16_t *
+__varr_float_corrections(
+   double const * values,
+   size_t length,
+   size_t width,
+   double * scale
+   )
+{
+   int16_t * const
+      corrections = (int16_t *) __varr_table_allocate(
+         sizeof(int16_t) * (length + width)
+         );
+   double
+      largest = 0.;
+   if(corrections == NULL)
+   {
+      return NULL;
+   }
+   for(size_t i = (size_t) 0u; i< length; ++i)
+   {
+      largest = fmax(largest, fabs(values[i] - (double) (float) values[i]));
+   }
+   *scale = largest / 32767.;
+   for(size_t i = (size_t) 0u; i< length; ++i)
+   {
+      corrections[i] = (largest > 0.) ?
+         (int16_t) lround((values[i] - (double) (float) values[i]) / *scale)
+         :
+         (int16_t) 0;
+   }
+   for(size_t j = (size_t) 0u; j< width; ++j)
+   {
+      corrections[length + j] = (int16_t) 0;
+   }
+   return
+      corrections;
+}
+
+VARRSampleTable
+__varr_sample_table(
+   double * values,
+   size_t number_of_samples,
+   size_t width,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   )
+{
+   VARRSampleTable
+      result = {
+         .layout = layout,
+         .precision = precision,
+         .width = width,
+         .values = NULL,
+         .floats = NULL,
+         .corrections = NULL,
+         .correction_scale = 0.,
+         .shared = NULL
+      };
+   double *
+      table = values;
+   size_t const
+      length = (layout == VARR_TABLE_INTERLEAVED) ?
+         2u * width * (number_of_samples - 1u)
+         :
+         width * number_of_samples;
+   if(layout == VARR_TABLE_INTERLEAVED)
+   {
+      table = __varr_interleaved_table(values, number_of_samples, width);
+   }
+   else if(precision == VARR_TABLE_DOUBLE)
+   {
+      // The samples are moved to a table allocation:
+      table = (double *) __varr_table_allocate(sizeof(double) * length);
+      if(table != NULL)
+      {
+         memcpy(table, values, sizeof(double) * length);
+      }
+   }
+   if(precision == VARR_TABLE_DOUBLE)
+   {
+      free(values);
+      result.values = table;
+      return
+         result;
+   }
+   result.floats = __varr_float_table(table, length);
+   if(precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      result.corrections = __varr_float_corrections(
+         values, width * number_of_samples, width, &result.correction_scale
+         );
+   }
+   if(table != values)
+   {
+      __varr_table_free(table);
+   }
+   free(values);
+   return
+      result;
+}
+
+void
+__varr_measure_sample_table(
+   size_t number_of_samples,
+   size_t width,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   )
+{
+   size_t const
+      length = (layout == VARR_TABLE_INTERLEAVED) ?
+         2u * width * (number_of_samples - 1u)
+         :
+         width * number_of_samples;
+   // The allocations of __varr_sample_table, in turn:
+   if((layout == VARR_TABLE_INTERLEAVED) || (precision == VARR_TABLE_DOUBLE))
+   {
+      __varr_allocation_measure(sizeof(double) * length);
+   }
+   if(precision == VARR_TABLE_DOUBLE)
+   {
+      return;
+   }
+   __varr_allocation_measure(sizeof(float) * length);
+   if(precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      __varr_allocation_measure(
+         sizeof(int16_t) * width * (number_of_samples + 1u)
+         );
+   }
+}
+
+void
+__varr_free_sample_table(VARRSampleTable * table)
+{
+   if(table->shared != NULL)
+   {
+      __varr_table_cache_release(table->shared);
+   }
+   else
+   {
+      __varr_table_free((void *) table->values);
+      __varr_table_free((void *) table->floats);
+      __varr_table_free((void *) table->corrections);
+   }
+   table->shared = NULL;
+   table->values = NULL;
+   table->floats = NULL;
+   table->corrections = NULL;
+}
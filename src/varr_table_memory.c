@@ -0,0 +1,358 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * mmap(MAP_ANONYMOUS), madvise and their huge page flags are not POSIX:
+ */
+#define _DEFAULT_SOURCE
+
+#include "varr_table_memory.h"
+#include "varr_internal.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#define __VARR_HUGE_PAGE_BYTES__ ((size_t) 2u << 20)
+
+/*
+ * The origin of the memory of a table:
+ */
+typedef enum tagVARRTableOrigin {
+   __VARR_TABLE_HEAP__,                   // posix_memalign
+   __VARR_TABLE_TRANSPARENT__,            // mmap and madvise(MADV_HUGEPAGE)
+   __VARR_TABLE_EXPLICIT__                // mmap(MAP_HUGETLB)
+} VARRTableOrigin;
+
+/*
+ * Every table is recorded in a list, guarded by a single mutex, so that it
+ * may be released by address, and so that statistics may be gathered.  
+ * 'mapped_bytes' is the size of the mapping of mapped tables, which is a 
+ * multiple of __VARR_HUGE_PAGE_BYTES__.
+ */
+typedef struct tagVARRTableAllocation
+{
+   struct tagVARRTableAllocation *
+      next;
+   void *
+      table;
+   size_t
+      bytes,
+      mapped_bytes;
+   VARRTableOrigin
+      origin;
+} VARRTableAllocation;
+
+static pthread_mutex_t
+   __varr_table_memory_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static VARRTableAllocation *
+   __varr_table_allocations = NULL;
+
+char const *
+varr_table_pages_name(VARRTablePages pages)
+{
+   switch(pages)
+   {
+   case VARR_TABLE_PAGES_DEFAULT:
+      return "default";
+   case VARR_TABLE_PAGES_TRANSPARENT:
+      return "transparent";
+   case VARR_TABLE_PAGES_EXPLICIT:
+      return "explicit";
+   }
+   return "unknown";
+}
+
+/*
+ * Maps 'mapped_bytes' (a multiple of __VARR_HUGE_PAGE_BYTES__), aligned to 
+ * __VARR_HUGE_PAGE_BYTES__, of transparent huge page candidates, or returns
+ * NULL.  Alignment is obtained by mapping another huge page, and unmapping 
+ * the excess on either side.
+ */
+static
+void *
+map_transparent_huge_pages(size_t mapped_bytes)
+{
+#ifdef MADV_HUGEPAGE
+   size_t const
+      padded_bytes = mapped_bytes + __VARR_HUGE_PAGE_BYTES__;
+   unsigned char * const
+      mapping = (unsigned char *) mmap(
+         NULL,
+         padded_bytes,
+         PROT_READ | PROT_WRITE,
+         MAP_PRIVATE | MAP_ANONYMOUS,
+         -1,
+         0
+         );
+   if((void *) mapping == MAP_FAILED)
+   {
+      return NULL;
+   }
+   size_t const
+      head = (__VARR_HUGE_PAGE_BYTES__
+         - (size_t) ((uintptr_t) mapping % __VARR_HUGE_PAGE_BYTES__))
+       % __VARR_HUGE_PAGE_BYTES__;
+   if(head > (size_t) 0u)
+   {
+      munmap(mapping, head);
+   }
+   munmap(mapping + head + mapped_bytes, __VARR_HUGE_PAGE_BYTES__ - head);
+   madvise(mapping + head, mapped_bytes, MADV_HUGEPAGE);
+   return
+      (void *) (mapping + head);
+#else
+   (void) mapped_bytes;
+   return NULL;
+#endif
+}
+
+/*
+ * Maps 'mapped_bytes' of the reserved huge pages of the system, or returns 
+ * NULL:
+ */
+static
+void *
+map_explicit_huge_pages(size_t mapped_bytes)
+{
+#ifdef MAP_HUGETLB
+   void * const
+      mapping = mmap(
+         NULL,
+         mapped_bytes,
+         PROT_READ | PROT_WRITE,
+         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+         -1,
+         0
+         );
+   return
+      (mapping == MAP_FAILED) ? NULL : mapping;
+#else
+   (void) mapped_bytes;
+   return NULL;
+#endif
+}
+
+void *
+__varr_table_allocate(size_t bytes)
+{
+   // Tables of evaluators of allocators (see varr_allocator.h) are theirs:
+   if(__varr_allocation_phase() == __VARR_ALLOCATION_PRIVATE__)
+   {
+      return
+         __varr_allocate(__VARR_CACHE_LINE_BYTES__, bytes);
+   }
+   VARRTableAllocation * const
+      allocation = (VARRTableAllocation *) malloc(sizeof(VARRTableAllocation));
+   if(allocation == NULL)
+   {
+      return NULL;
+   }
+   VARRTablePages const
+      pages = __varr_table_format().pages;
+   allocation->table = NULL;
+   allocation->bytes = bytes;
+   allocation->mapped_bytes = (
+      (bytes + __VARR_HUGE_PAGE_BYTES__ - 1u) / __VARR_HUGE_PAGE_BYTES__
+      ) * __VARR_HUGE_PAGE_BYTES__;
+   allocation->origin = __VARR_TABLE_HEAP__;
+   // Tables of less than a huge page are kept on the heap regardless:
+   if(
+      (pages != VARR_TABLE_PAGES_DEFAULT) 
+      && (bytes >= __VARR_HUGE_PAGE_BYTES__)
+      )
+   {
+      if(pages == VARR_TABLE_PAGES_EXPLICIT)
+      {
+         allocation->table = map_explicit_huge_pages(allocation->mapped_bytes);
+         allocation->origin = __VARR_TABLE_EXPLICIT__;
+      }
+      if(allocation->table == NULL)
+      {
+         allocation->table = 
+            map_transparent_huge_pages(allocation->mapped_bytes);
+         allocation->origin = __VARR_TABLE_TRANSPARENT__;
+      }
+   }
+   if(allocation->table == NULL)
+   {
+      allocation->origin = __VARR_TABLE_HEAP__;
+      allocation->mapped_bytes = (size_t) 0u;
+      if(
+         posix_memalign(
+            &allocation->table,
+            __VARR_CACHE_LINE_BYTES__,
+            (bytes > (size_t) 0u) ? bytes : __VARR_CACHE_LINE_BYTES__
+            )
+         )
+      {
+         free(allocation);
+         return NULL;
+      }
+   }
+   pthread_mutex_lock(&__varr_table_memory_mutex);
+   allocation->next = __varr_table_allocations;
+   __varr_table_allocations = allocation;
+   pthread_mutex_unlock(&__varr_table_memory_mutex);
+   return
+      allocation->table;
+}
+
+void
+__varr_table_free(void * table)
+{
+   if(table == NULL)
+   {
+      return;
+   }
+   VARRTableAllocation *
+      allocation = NULL;
+   pthread_mutex_lock(&__varr_table_memory_mutex);
+   for(
+      VARRTableAllocation ** link = &__varr_table_allocations;
+      *link != NULL;
+      link = &(*link)->next
+      )
+   {
+      if((*link)->table == table)
+      {
+         allocation = *link;
+         *link = allocation->next;
+         break;
+      }
+   }
+   pthread_mutex_unlock(&__varr_table_memory_mutex);
+   // Tables not in the list are those of allocators (see above):
+   if(allocation == NULL)
+   {
+      __varr_free(table);
+      return;
+   }
+   if(allocation->origin == __VARR_TABLE_HEAP__)
+   {
+      free(allocation->table);
+   }
+   else
+   {
+      munmap(allocation->table, allocation->mapped_bytes);
+   }
+   free(allocation);
+}
+
+/*
+ * Returns the number of bytes of [begin, end) that lie in transparent huge 
+ * pages, per /proc/self/smaps, which lists each mapping ("begin-end ...") 
+ * followed by its fields, of which "AnonHugePages: n kB" is the size of its
+ * transparent huge pages.  Those of a mapping that extends beyond [begin, 
+ * end) are attributed to [begin, end) up to its overlap with the mapping.
+ */
+static
+size_t
+transparent_huge_page_bytes(FILE * smaps, uintptr_t begin, uintptr_t end)
+{
+   char
+      line[256u];
+   unsigned long
+      mapping_begin,
+      mapping_end,
+      kilobytes;
+   size_t
+      overlap = (size_t) 0u,
+      result = (size_t) 0u;
+   rewind(smaps);
+   while(fgets(line, (int) sizeof(line), smaps) != NULL)
+   {
+      if(sscanf(line, "%lx-%lx ", &mapping_begin, &mapping_end) == 2)
+      {
+         uintptr_t const
+            lower = ((uintptr_t) mapping_begin > begin) ?
+               (uintptr_t) mapping_begin : begin,
+            upper = ((uintptr_t) mapping_end < end) ?
+               (uintptr_t) mapping_end : end;
+         overlap = (upper > lower) ? (size_t) (upper - lower) : (size_t) 0u;
+      }
+      else if(
+         (overlap > (size_t) 0u)
+         && (sscanf(line, "AnonHugePages: %lu kB", &kilobytes) == 1)
+         )
+      {
+         size_t const
+            bytes = (size_t) kilobytes << 10;
+         result += (bytes < overlap) ? bytes : overlap;
+      }
+   }
+   return
+      result;
+}
+
+VARRTableMemoryStatistics
+varr_table_memory_statistics(void)
+{
+   VARRTableMemoryStatistics
+      result = {
+         .tables = (size_t) 0u,
+         .bytes = (size_t) 0u,
+         .huge_page_requests = (size_t) 0u,
+         .huge_page_bytes = (size_t) 0u
+      };
+   FILE *
+      smaps = NULL;
+   pthread_mutex_lock(&__varr_table_memory_mutex);
+   for(
+      VARRTableAllocation const * allocation = __varr_table_allocations;
+      allocation != NULL;
+      allocation = allocation->next
+      )
+   {
+      ++result.tables;
+      result.bytes += allocation->bytes;
+      if(allocation->origin == __VARR_TABLE_HEAP__)
+      {
+         continue;
+      }
+      ++result.huge_page_requests;
+      if(allocation->origin == __VARR_TABLE_EXPLICIT__)
+      {
+         result.huge_page_bytes += allocation->bytes;
+         continue;
+      }
+      if(smaps == NULL)
+      {
+         smaps = fopen("/proc/self/smaps", "r");
+      }
+      if(smaps != NULL)
+      {
+         result.huge_page_bytes += transparent_huge_page_bytes(
+            smaps,
+            (uintptr_t) allocation->table,
+            (uintptr_t) allocation->table + allocation->bytes
+            );
+      }
+   }
+   pthread_mutex_unlock(&__varr_table_memory_mutex);
+   if(smaps != NULL)
+   {
+      fclose(smaps);
+   }
+   return
+      result;
+}
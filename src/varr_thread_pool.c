@@ -0,0 +1,936 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * pthread_setaffinity_np (for pinned pools) is not POSIX:
+ */
+#define _GNU_SOURCE
+
+#include "varr_thread_pool.h"
+#include "varr_internal.h"
+
+#include <complex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define __VARR_MAX_THREADS__ ((size_t) 256u)
+
+/*
+ * The blocks [next, end) of a job that are held by one of its participants
+ * (the calling thread, 0, or thread i - 1 of the pool), which takes them 
+ * from 'next' on, and from which others steal the second half once they 
+ * have none left.  Ranges are padded to a cache line of their own.
+ */
+typedef struct tagVARRWorkRange
+{
+   pthread_mutex_t
+      mutex;
+   size_t
+      next,
+      end;
+   unsigned char
+      padding[__VARR_CACHE_LINE_BYTES__];
+} VARRWorkRange;
+
+/*
+ * A pool of threads, and its job: body(begin, end, argument) is called for
+ * the blocks [k * grain, (k + 1) * grain) of [0, count), by the calling 
+ * thread and the first 'helpers' threads of the pool, 'active' of which 
+ * are taking part in it.  The blocks are initially split evenly between the
+ * ranges of the participants.  A job is posted by incrementing 
+ * 'generation', on which the threads of the pool wait.  'mutex' guards the
+ * pool, and 'job_mutex' admits one job at a time.
+ */
+struct tagVARRThreadPool
+{
+   pthread_mutex_t
+      mutex,
+      job_mutex;
+   pthread_cond_t
+      posted,
+      done;
+   void (* body) (size_t, size_t, void const *);
+   void const *
+      argument;
+   size_t
+      count,
+      grain,
+      helpers,
+      active,
+      threads;                            // started, of 'workers'
+   unsigned long
+      generation;
+   int
+      pin,
+      stopping;
+   pthread_t
+      workers[__VARR_MAX_THREADS__];
+   VARRWorkRange
+      ranges[__VARR_MAX_THREADS__ + 1u];
+};
+
+/*
+ * The thread 'index' of a pool, as passed to pool_thread:
+ */
+typedef struct tagVARRPoolThread
+{
+   VARRThreadPool *
+      pool;
+   size_t
+      index;
+} VARRPoolThread;
+
+static pthread_mutex_t
+   __varr_construction_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static VARRThreadPool *
+   __varr_construction_pool = NULL;
+
+/*
+ * The numbers of threads selected by varr_set_table_construction_threads and
+ * varr_set_linbuf_construction_threads, which are read and written 
+ * atomically:
+ */
+static size_t
+   __varr_construction_threads = (size_t) 0u,
+   __varr_linbuf_construction_threads = (size_t) 1u;
+
+static
+size_t
+online_processors(void)
+{
+   long const
+      processors = sysconf(_SC_NPROCESSORS_ONLN);
+   return
+      (processors < 1l) ? (size_t) 1u : (size_t) processors;
+}
+
+size_t
+varr_table_construction_threads(void)
+{
+   register size_t
+      threads = __atomic_load_n(&__varr_construction_threads, __ATOMIC_RELAXED);
+   if(threads == (size_t) 0u)
+   {
+      threads = online_processors();
+   }
+   return
+      (threads < __VARR_MAX_THREADS__) ? threads : __VARR_MAX_THREADS__;
+}
+
+size_t
+varr_set_table_construction_threads(size_t threads)
+{
+   __atomic_store_n(&__varr_construction_threads, threads, __ATOMIC_RELAXED);
+   return
+      varr_table_construction_threads();
+}
+
+size_t
+varr_linbuf_construction_threads(void)
+{
+   register size_t const
+      threads = __atomic_load_n(
+         &__varr_linbuf_construction_threads, __ATOMIC_RELAXED
+         );
+   return
+      (threads < __VARR_MAX_THREADS__) ? threads : __VARR_MAX_THREADS__;
+}
+
+size_t
+varr_set_linbuf_construction_threads(size_t threads)
+{
+   __atomic_store_n(
+      &__varr_linbuf_construction_threads,
+      (threads == (size_t) 0u) ? (size_t) 1u : threads,
+      __ATOMIC_RELAXED
+      );
+   return
+      varr_linbuf_construction_threads();
+}
+
+/*
+ * Takes the next block of 'range' into *block, and returns 1, or returns 0 
+ * if it has none:
+ */
+static
+int
+take_block(VARRWorkRange * const range, size_t * const block)
+{
+   pthread_mutex_lock(&range->mutex);
+   register int const
+      taken = (range->next < range->end);
+   if(taken)
+   {
+      *block = range->next++;
+   }
+   pthread_mutex_unlock(&range->mutex);
+   return
+      taken;
+}
+
+/*
+ * Moves the second half of the blocks of the first range of another 
+ * participant (after 'participant') that has any into the range of 
+ * 'participant', and returns 1, or returns 0 if none has any:
+ */
+static
+int
+steal_blocks(
+   VARRThreadPool * const pool,
+   size_t participant,
+   size_t participants
+   )
+{
+   for(size_t i = (size_t) 1u; i< participants; ++i)
+   {
+      VARRWorkRange * const
+         victim = pool->ranges + (participant + i) % participants;
+      pthread_mutex_lock(&victim->mutex);
+      register size_t const
+         remaining = victim->end - victim->next;
+      if(remaining == (size_t) 0u)
+      {
+         pthread_mutex_unlock(&victim->mutex);
+         continue;
+      }
+      register size_t const
+         end = victim->end,
+         begin = end - (remaining + (size_t) 1u) / (size_t) 2u;
+      victim->end = begin;
+      pthread_mutex_unlock(&victim->mutex);
+      VARRWorkRange * const
+         range = pool->ranges + participant;
+      pthread_mutex_lock(&range->mutex);
+      range->next = begin;
+      range->end = end;
+      pthread_mutex_unlock(&range->mutex);
+      return 1;
+   }
+   return 0;
+}
+
+/*
+ * Evaluates the blocks of the range of 'participant', and then those it 
+ * steals, until no participant has any left:
+ */
+static
+void
+work(VARRThreadPool * const pool, size_t participant)
+{
+   register size_t const
+      participants = pool->helpers + (size_t) 1u,
+      count = pool->count,
+      grain = pool->grain;
+   size_t
+      block;
+   for(;;)
+   {
+      if(!take_block(pool->ranges + participant, &block))
+      {
+         if(steal_blocks(pool, participant, participants))
+         {
+            continue;
+         }
+         return;
+      }
+      register size_t const
+         begin = block * grain;
+      pool->body(
+         begin,
+         (count - begin > grain) ? begin + grain : count,
+         pool->argument
+         );
+   }
+}
+
+/*
+ * Binds the calling thread, thread 'index' of a pinned pool, to processor 
+ * index + 1 (the calling threads of jobs being left as they are):
+ */
+static
+void
+pin_thread(size_t index)
+{
+   cpu_set_t
+      processors;
+   CPU_ZERO(&processors);
+   CPU_SET((int) ((index + 1u) % online_processors()), &processors);
+   pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &processors);
+}
+
+static
+void *
+pool_thread(void * argument)
+{
+   VARRPoolThread const
+      thread = *((VARRPoolThread const *) argument);
+   VARRThreadPool * const
+      pool = thread.pool;
+   unsigned long
+      generation;
+   free(argument);
+   if(pool->pin)
+   {
+      pin_thread(thread.index);
+   }
+   pthread_mutex_lock(&pool->mutex);
+   generation = pool->generation;
+   for(;;)
+   {
+      while((pool->generation == generation) && !pool->stopping)
+      {
+         pthread_cond_wait(&pool->posted, &pool->mutex);
+      }
+      if(pool->stopping)
+      {
+         break;
+      }
+      generation = pool->generation;
+      // Threads that wake after the job is done take no part in it:
+      if(thread.index < pool->helpers)
+      {
+         ++pool->active;
+         pthread_mutex_unlock(&pool->mutex);
+         work(pool, thread.index + (size_t) 1u);
+         pthread_mutex_lock(&pool->mutex);
+         if(--pool->active == (size_t) 0u)
+         {
+            pthread_cond_broadcast(&pool->done);
+         }
+      }
+   }
+   pthread_mutex_unlock(&pool->mutex);
+   return NULL;
+}
+
+/*
+ * Starts threads of 'pool' until there are 'threads' of them, and returns 
+ * the number there are.  Called with pool->mutex held:
+ */
+static
+size_t
+start_pool_threads(VARRThreadPool * const pool, size_t threads)
+{
+   if(threads > __VARR_MAX_THREADS__)
+   {
+      threads = __VARR_MAX_THREADS__;
+   }
+   while(pool->threads < threads)
+   {
+      VARRPoolThread * const
+         thread = (VARRPoolThread *) malloc(sizeof(VARRPoolThread));
+      if(thread == NULL)
+      {
+         break;
+      }
+      thread->pool = pool;
+      thread->index = pool->threads;
+      if(
+         pthread_create(
+            pool->workers + pool->threads, NULL, pool_thread, thread
+            )
+         )
+      {
+         free(thread);
+         break;
+      }
+      ++pool->threads;
+   }
+   return
+      pool->threads;
+}
+
+VARRThreadPool *
+varr_create_thread_pool(size_t threads, int pin)
+{
+   VARRThreadPool * const
+      pool = (VARRThreadPool *) __varr_allocate(
+         __VARR_CACHE_LINE_BYTES__, sizeof(VARRThreadPool)
+         );
+   if(pool == NULL)
+   {
+      return NULL;
+   }
+   pthread_mutex_init(&pool->mutex, NULL);
+   pthread_mutex_init(&pool->job_mutex, NULL);
+   pthread_cond_init(&pool->posted, NULL);
+   pthread_cond_init(&pool->done, NULL);
+   for(size_t i = (size_t) 0u; i<= __VARR_MAX_THREADS__; ++i)
+   {
+      pthread_mutex_init(&pool->ranges[i].mutex, NULL);
+      pool->ranges[i].next = (size_t) 0u;
+      pool->ranges[i].end = (size_t) 0u;
+   }
+   pool->body = NULL;
+   pool->argument = NULL;
+   pool->count = (size_t) 0u;
+   pool->grain = (size_t) 1u;
+   pool->helpers = (size_t) 0u;
+   pool->active = (size_t) 0u;
+   pool->threads = (size_t) 0u;
+   pool->generation = 0ul;
+   pool->pin = pin;
+   pool->stopping = 0;
+   if(threads == (size_t) 0u)
+   {
+      threads = online_processors();
+   }
+   pthread_mutex_lock(&pool->mutex);
+   start_pool_threads(pool, threads - (size_t) 1u);
+   pthread_mutex_unlock(&pool->mutex);
+   return
+      pool;
+}
+
+size_t
+varr_thread_pool_threads(VARRThreadPool const * pool)
+{
+   return
+      (pool == NULL) ? (size_t) 1u : pool->threads + (size_t) 1u;
+}
+
+int
+varr_destroy_thread_pool(VARRThreadPool * pool)
+{
+   if(pool == NULL)
+   {
+      return 1;
+   }
+   pthread_mutex_lock(&pool->mutex);
+   pool->stopping = 1;
+   pthread_cond_broadcast(&pool->posted);
+   pthread_mutex_unlock(&pool->mutex);
+   for(size_t i = (size_t) 0u; i< pool->threads; ++i)
+   {
+      pthread_join(pool->workers[i], NULL);
+   }
+   for(size_t i = (size_t) 0u; i<= __VARR_MAX_THREADS__; ++i)
+   {
+      pthread_mutex_destroy(&pool->ranges[i].mutex);
+   }
+   pthread_cond_destroy(&pool->done);
+   pthread_cond_destroy(&pool->posted);
+   pthread_mutex_destroy(&pool->job_mutex);
+   pthread_mutex_destroy(&pool->mutex);
+   __varr_free(pool);
+   return 0;
+}
+
+/*
+ * Runs a job on 'pool' (or on the calling thread alone, if 'pool' is NULL 
+ * or busy) on up to 'threads' threads, including the calling thread, having
+ * first started up to threads - 1 threads of the pool if 'grow' is set:
+ */
+static
+void
+run_job(
+   VARRThreadPool * const pool,
+   size_t threads,
+   int grow,
+   size_t count,
+   size_t grain,
+   void (* body) (size_t, size_t, void const *),
+   void const * argument
+   )
+{
+   if(grain == (size_t) 0u)
+   {
+      grain = (size_t) 1u;
+   }
+   register size_t const
+      blocks = count / grain + (size_t) ((count % grain) != (size_t) 0u);
+   size_t
+      helpers = ((blocks < threads) ? blocks : threads) - (size_t) 1u;
+   if(
+      (count == (size_t) 0u)
+   || (helpers == (size_t) 0u)
+   || (pool == NULL)
+   || (pthread_mutex_trylock(&pool->job_mutex) != 0)
+      )
+   {
+      if(count != (size_t) 0u)
+      {
+         body((size_t) 0u, count, argument);
+      }
+      return;
+   }
+   pthread_mutex_lock(&pool->mutex);
+   {
+      register size_t const
+         started = grow ? start_pool_threads(pool, helpers) : pool->threads;
+      helpers = (started < helpers) ? started : helpers;
+   }
+   register size_t const
+      participants = helpers + (size_t) 1u;
+   for(size_t i = (size_t) 0u; i< participants; ++i)
+   {
+      pool->ranges[i].next = (blocks * i) / participants;
+      pool->ranges[i].end = (blocks * (i + (size_t) 1u)) / participants;
+   }
+   pool->body = body;
+   pool->argument = argument;
+   pool->count = count;
+   pool->grain = grain;
+   pool->helpers = helpers;
+   ++pool->generation;
+   pthread_cond_broadcast(&pool->posted);
+   pthread_mutex_unlock(&pool->mutex);
+   work(pool, (size_t) 0u);
+   pthread_mutex_lock(&pool->mutex);
+   while(pool->active != (size_t) 0u)
+   {
+      pthread_cond_wait(&pool->done, &pool->mutex);
+   }
+   pool->helpers = (size_t) 0u;
+   pthread_mutex_unlock(&pool->mutex);
+   pthread_mutex_unlock(&pool->job_mutex);
+}
+
+void
+__varr_parallel_for(
+   size_t threads,
+   size_t count,
+   size_t grain,
+   void (* body) (size_t begin, size_t end, void const * argument),
+   void const * argument
+   )
+{
+   VARRThreadPool *
+      pool = NULL;
+   if(threads > (size_t) 1u)
+   {
+      pthread_mutex_lock(&__varr_construction_pool_mutex);
+      if(__varr_construction_pool == NULL)
+      {
+         __varr_construction_pool = varr_create_thread_pool((size_t) 1u, 0);
+      }
+      pool = __varr_construction_pool;
+      pthread_mutex_unlock(&__varr_construction_pool_mutex);
+   }
+   run_job(pool, threads, 1, count, grain, body, argument);
+}
+
+/*
+ * The batches of varr_parallel_batch*: the batch function of the evaluator 
+ * is called for chunks of __VARR_BATCH_CHUNK__ inputs (of up to 64 KB, with
+ * their outputs, and a multiple of the SIMD strides), and so with the 
+ * alignment of x and out.  'streaming' is the streaming batch size of the 
+ * threads evaluating chunks (see varr_set_streaming_batch_bytes): one if 
+ * the whole batch is streamed, or zero.
+ */
+#define __VARR_BATCH_CHUNK__ ((size_t) 4096u)
+
+typedef struct tagVARRParallelBatch
+{
+   void (* batchd) (double const *, double *, size_t, void const *);
+   void (* batchf) (float const *, float *, size_t, void const *);
+   void (* phasord) (double const *, double complex *, size_t, void const *);
+   void (* phasorf) (float const *, float complex *, size_t, void const *);
+   void const *
+      x;
+   void *
+      out;
+   void const *
+      accelerator;
+   size_t
+      streaming;
+} VARRParallelBatch;
+
+/*
+ * Returns the 'streaming' of a parallel batch of 'bytes' of outputs:
+ */
+static
+size_t
+batch_streaming(size_t bytes)
+{
+   size_t const
+      threshold = varr_streaming_batch_bytes();
+   return
+      ((threshold > (size_t) 0u) && (bytes >= threshold)) ?
+         (size_t) 1u
+         :
+         (size_t) 0u;
+}
+
+static
+void
+batchd_chunks(size_t begin, size_t end, void const * argument)
+{
+   register VARRParallelBatch const * const
+      batch = (VARRParallelBatch const *) argument;
+   size_t const
+      previous = varr_set_streaming_batch_bytes(batch->streaming);
+   batch->batchd(
+      (double const *) batch->x + begin,
+      (double *) batch->out + begin,
+      end - begin,
+      batch->accelerator
+      );
+   varr_set_streaming_batch_bytes(previous);
+}
+
+static
+void
+batchf_chunks(size_t begin, size_t end, void const * argument)
+{
+   register VARRParallelBatch const * const
+      batch = (VARRParallelBatch const *) argument;
+   size_t const
+      previous = varr_set_streaming_batch_bytes(batch->streaming);
+   batch->batchf(
+      (float const *) batch->x + begin,
+      (float *) batch->out + begin,
+      end - begin,
+      batch->accelerator
+      );
+   varr_set_streaming_batch_bytes(previous);
+}
+
+static
+void
+phasord_chunks(size_t begin, size_t end, void const * argument)
+{
+   register VARRParallelBatch const * const
+      batch = (VARRParallelBatch const *) argument;
+   size_t const
+      previous = varr_set_streaming_batch_bytes(batch->streaming);
+   batch->phasord(
+      (double const *) batch->x + begin,
+      (double complex *) batch->out + begin,
+      end - begin,
+      batch->accelerator
+      );
+   varr_set_streaming_batch_bytes(previous);
+}
+
+static
+void
+phasorf_chunks(size_t begin, size_t end, void const * argument)
+{
+   register VARRParallelBatch const * const
+      batch = (VARRParallelBatch const *) argument;
+   size_t const
+      previous = varr_set_streaming_batch_bytes(batch->streaming);
+   batch->phasorf(
+      (float const *) batch->x + begin,
+      (float complex *) batch->out + begin,
+      end - begin,
+      batch->accelerator
+      );
+   varr_set_streaming_batch_bytes(previous);
+}
+
+void
+varr_parallel_batchd(
+   VARRThreadPool * pool,
+   void (* batch) (double const *, double *, size_t, void const *),
+   double const * x,
+   double * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   VARRParallelBatch const
+      parallel = {
+         .batchd = batch,
+         .x = x,
+         .out = out,
+         .accelerator = accelerator,
+         .streaming = batch_streaming(sizeof(double) * length)
+      };
+   run_job(
+      pool,
+      varr_thread_pool_threads(pool),
+      0,
+      length,
+      __VARR_BATCH_CHUNK__,
+      batchd_chunks,
+      &parallel
+      );
+}
+
+void
+varr_parallel_batchf(
+   VARRThreadPool * pool,
+   void (* batch) (float const *, float *, size_t, void const *),
+   float const * x,
+   float * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   VARRParallelBatch const
+      parallel = {
+         .batchf = batch,
+         .x = x,
+         .out = out,
+         .accelerator = accelerator,
+         .streaming = batch_streaming(sizeof(float) * length)
+      };
+   run_job(
+      pool,
+      varr_thread_pool_threads(pool),
+      0,
+      length,
+      __VARR_BATCH_CHUNK__,
+      batchf_chunks,
+      &parallel
+      );
+}
+
+void
+varr_parallel_batch_phasord(
+   VARRThreadPool * pool,
+   void (* batch) (double const *, double complex *, size_t, void const *),
+   double const * x,
+   double complex * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   VARRParallelBatch const
+      parallel = {
+         .phasord = batch,
+         .x = x,
+         .out = out,
+         .accelerator = accelerator,
+         .streaming = batch_streaming(sizeof(double complex) * length)
+      };
+   run_job(
+      pool,
+      varr_thread_pool_threads(pool),
+      0,
+      length,
+      __VARR_BATCH_CHUNK__,
+      phasord_chunks,
+      &parallel
+      );
+}
+
+void
+varr_parallel_batch_phasorf(
+   VARRThreadPool * pool,
+   void (* batch) (float const *, float complex *, size_t, void const *),
+   float const * x,
+   float complex * out,
+   size_t length,
+   void const * accelerator
+   )
+{
+   VARRParallelBatch const
+      parallel = {
+         .phasorf = batch,
+         .x = x,
+         .out = out,
+         .accelerator = accelerator,
+         .streaming = batch_streaming(sizeof(float complex) * length)
+      };
+   run_job(
+      pool,
+      varr_thread_pool_threads(pool),
+      0,
+      length,
+      __VARR_BATCH_CHUNK__,
+      phasorf_chunks,
+      &parallel
+      );
+}
+
+/*
+ * The blocks of samples of __varr_sample_grid and __varr_sample_rotations:
+ */
+#define __VARR_SAMPLE_GRAIN__ ((size_t) 4096u)
+
+typedef struct tagVARRSampleGrid
+{
+   double (* function) (double, void *);
+   void *
+      argument;
+   double
+      start_x,
+      step_x;
+   double *
+      values;
+} VARRSampleGrid;
+
+static
+void
+sample_grid_block(size_t begin, size_t end, void const * argument)
+{
+   register VARRSampleGrid const * const
+      grid = (VARRSampleGrid const *) argument;
+   for(register size_t i = begin; i< end; ++i)
+   {
+      grid->values[i] = grid->function(
+         grid->start_x + grid->step_x * (double) i, grid->argument
+         );
+   }
+}
+
+double *
+__varr_sample_grid(
+   double (* function) (double x, void * argument),
+   void * argument,
+   double start_x,
+   double step_x,
+   size_t number_of_values
+   )
+{
+   return
+      __varr_sample_grid_on(
+         varr_table_construction_threads(),
+         function,
+         argument,
+         start_x,
+         step_x,
+         number_of_values
+         );
+}
+
+double *
+__varr_sample_grid_on(
+   size_t threads,
+   double (* function) (double x, void * argument),
+   void * argument,
+   double start_x,
+   double step_x,
+   size_t number_of_values
+   )
+{
+   VARRSampleGrid const
+      grid = {
+         .function = function,
+         .argument = argument,
+         .start_x = start_x,
+         .step_x = step_x,
+         .values = (double *) malloc(sizeof(double) * number_of_values)
+      };
+   if(grid.values == NULL)
+   {
+      return NULL;
+   }
+   __varr_parallel_for(
+      threads,
+      number_of_values,
+      __VARR_SAMPLE_GRAIN__,
+      sample_grid_block,
+      &grid
+      );
+   return
+      grid.values;
+}
+
+/*
+ * The rotations of __varr_sample_rotations: sample i = a * R + j, for 
+ * R = __VARR_ROTATION_BLOCK__, is the rotation of sample a * R (the anchor
+ * of its block, from libm) by the angle j * step (from the table of the R 
+ * rotations).  Both are correctly rounded, and so is the rotation to within
+ * a few ulps, independently of i.
+ */
+#define __VARR_ROTATION_BLOCK__ ((size_t) 64u)
+
+typedef struct tagVARRSampleRotations
+{
+   double
+      step_phi;
+   size_t
+      cos_component;
+   double const *
+      rotations;                          // (cos, sin) of j * step_phi
+   double *
+      values;
+} VARRSampleRotations;
+
+static
+void
+sample_rotations_block(size_t begin, size_t end, void const * argument)
+{
+   register VARRSampleRotations const * const
+      samples = (VARRSampleRotations const *) argument;
+   register size_t const
+      c = samples->cos_component,
+      s = (size_t) 1u - c;
+   for(register size_t anchor = begin; anchor< end;)
+   {
+      register double const
+         phi = samples->step_phi * (double) anchor,
+         cos_anchor = cos(phi),
+         sin_anchor = sin(phi);
+      register size_t const
+         block = (end - anchor < __VARR_ROTATION_BLOCK__) ?
+            end - anchor
+            :
+            __VARR_ROTATION_BLOCK__;
+      register double * const
+         values = samples->values + (size_t) 2u * anchor;
+      for(register size_t j = (size_t) 0u; j< block; ++j)
+      {
+         register double const
+            cos_j = samples->rotations[(size_t) 2u * j],
+            sin_j = samples->rotations[(size_t) 2u * j + (size_t) 1u];
+         values[(size_t) 2u * j + c] = cos_anchor * cos_j - sin_anchor * sin_j;
+         values[(size_t) 2u * j + s] = sin_anchor * cos_j + cos_anchor * sin_j;
+      }
+      anchor += block;
+   }
+}
+
+double *
+__varr_sample_rotations(
+   double step_phi,
+   size_t number_of_values,
+   size_t cos_component
+   )
+{
+   double
+      rotations[(size_t) 2u * __VARR_ROTATION_BLOCK__];
+   for(size_t j = (size_t) 0u; j< __VARR_ROTATION_BLOCK__; ++j)
+   {
+      rotations[(size_t) 2u * j] = cos(step_phi * (double) j);
+      rotations[(size_t) 2u * j + (size_t) 1u] = sin(step_phi * (double) j);
+   }
+   VARRSampleRotations const
+      samples = {
+         .step_phi = step_phi,
+         .cos_component = cos_component,
+         .rotations = rotations,
+         .values = (double *) malloc(
+            sizeof(double) * (size_t) 2u * number_of_values
+            )
+      };
+   if(samples.values == NULL)
+   {
+      return NULL;
+   }
+   // The grain is a multiple of the block, so that blocks start at anchors:
+   __varr_parallel_for(
+      varr_table_construction_threads(),
+      number_of_values,
+      __VARR_SAMPLE_GRAIN__,
+      sample_rotations_block,
+      &samples
+      );
+   return
+      samples.values;
+}
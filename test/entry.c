@@ -27,6 +27,20 @@ main(int argc, char ** argv) {
    UnitTestResult
       result = create_test_results();
    
+   combine_test_results(test_varr_simd(), &result);
+   
+   combine_test_results(test_varr_table_layout(), &result);
+   
+   combine_test_results(test_varr_float(), &result);
+   
+   combine_test_results(test_varr_table_cache(), &result);
+   combine_test_results(test_varr_table_file(), &result);
+   combine_test_results(test_varr_table_memory(), &result);
+   combine_test_results(test_varr_allocator(), &result);
+   combine_test_results(test_varr_octant(), &result);
+   combine_test_results(test_varr_thread_pool(), &result);
+   combine_test_results(test_varr_progression(), &result);
+   
    combine_test_results(test_varr_general_bound_linbuf(), &result);
    
    combine_test_results(test_varr_3_over_4(), &result);
@@ -43,6 +57,8 @@ main(int argc, char ** argv) {
    
    combine_test_results(test_varr_sin(), &result);
    
+   combine_test_results(test_varr_sincos(), &result);
+   
    combine_test_results(test_varr_exp(), &result);
    
    print_test_results(&result);
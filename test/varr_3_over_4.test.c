@@ -48,6 +48,36 @@ threequartersd_machine_evaluate(double x)
       pow(x, 3./4.);
 }
 
+static
+void
+threequartersd_machine_batch_evaluate(
+   double const * restrict in,
+   double * restrict out,
+   size_t length
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+      out[i] = pow(in[i], 3./4.);
+   return;
+}
+
+static
+void
+threequartersd_batch_evaluate(
+   double const * restrict in,
+   double * restrict out,
+   size_t length
+   )
+{
+   threequartersd_evaluator.threequartersd_array(
+      in,
+      out,
+      length,
+      threequartersd_evaluator.accelerator
+      );
+   return;
+}
+
 static
 double
 threequartersd_test(void)
@@ -69,29 +99,126 @@ threequartersd_test(void)
       worst_numerical_difference;
 }
 
+static
+double
+threequartersd_test_batch_evaluation_with_remainder_loop(void)
+{
+   threequartersd_evaluator =
+      linear_sampling_normalizing_3over4d(3000000u);
+   
+   // batch evaluation:
+   printf("Vector evaluation:\n");
+   double const
+      worst_numerical_difference =
+         evaluate_batch_performanced(
+            1.e-18,
+            1.e18,         // note 2**64 ~ 1.8e19
+            50000003u,
+            1,
+            threequartersd_machine_batch_evaluate,
+            threequartersd_batch_evaluate,
+            0
+            );
+   threequartersd_evaluator.disallocate(&threequartersd_evaluator);
+   return
+      worst_numerical_difference;
+}
+
+static
+double
+threequartersd_test_full_domain_batch_evaluation(void)
+{
+   threequartersd_evaluator =
+      linear_sampling_normalizing_3over4d(3000000u);
+   
+   // batch evaluation, over (almost) all positive normal doubles:
+   printf("Vector evaluation:\n");
+   double const
+      worst_numerical_difference =
+         evaluate_batch_performanced(
+            1.e-300,
+            1.e300,
+            50000003u,
+            1,
+            threequartersd_machine_batch_evaluate,
+            threequartersd_batch_evaluate,
+            0
+            );
+   threequartersd_evaluator.disallocate(&threequartersd_evaluator);
+   return
+      worst_numerical_difference;
+}
+
 UnitTestResult
 test_varr_3_over_4(void)
 {
    UnitTestResult
       result = create_test_results();
    
-   {
-   declare_start_of_unit_test();
-   printf("pow(x, 3/4) numerical tests:\n");
    static double const
       worst_allowed_numerical_error = 1.12e-14;
+   
+   printf("pow(x, 3/4) numerical tests:\n");
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
    double const
       numerical_error = threequartersd_test();
-   result.test_message = create_message_specific_to_numerical_error_test_case(
-      "varr-3_over_4/pow(x, 3/4)",
-      "Sampling evaluation",
-      numerical_error,
-      worst_allowed_numerical_error
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-3_over_4/pow(x, 3/4)",
+         "Sampling evaluation",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   double const
+      numerical_error = 
+         threequartersd_test_batch_evaluation_with_remainder_loop();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-3_over_4/pow(x, 3/4) (batch evaluation, with remainder loop)",
+         "Sampling evaluation",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
       );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   double const
+      numerical_error = threequartersd_test_full_domain_batch_evaluation();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-3_over_4/pow(x, 3/4) (batch evaluation, full domain)",
+         "Sampling evaluation",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
    update_test_results_for_numerical_error_test_case(
-      &result, numerical_error, worst_allowed_numerical_error
+      &test_outcome, numerical_error, worst_allowed_numerical_error
       );
    declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
    }
    
    return
@@ -0,0 +1,635 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+#include "varr_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#define ALLOCATOR_TEST_SAMPLES ((size_t) 4096u)
+#define ALLOCATOR_TEST_LENGTH ((size_t) 1031u)
+#define ALLOCATOR_ARENA_BYTES ((size_t) 1u << 20)
+
+/*
+ * An arena of ALLOCATOR_ARENA_BYTES, from which memory is allocated in turn,
+ * and which counts the calls of the allocator:
+ */
+typedef struct tagTestArena
+{
+   unsigned char *
+      memory;
+   size_t
+      used,
+      allocations,
+      releases,
+      misaligned;
+} TestArena;
+
+static
+void *
+arena_allocate_aligned(size_t alignment, size_t bytes, void * context)
+{
+   TestArena * const
+      arena = (TestArena *) context;
+   size_t const
+      offset = (arena->used + alignment - 1u) & ~(alignment - 1u);
+   if(offset + bytes > ALLOCATOR_ARENA_BYTES)
+   {
+      return NULL;
+   }
+   arena->used = offset + bytes;
+   ++arena->allocations;
+   return
+      (void *) (arena->memory + offset);
+}
+
+static
+void *
+arena_allocate(size_t bytes, void * context)
+{
+   return
+      arena_allocate_aligned((size_t) 16u, bytes, context);
+}
+
+static
+void
+arena_release(void * memory, void * context)
+{
+   TestArena * const
+      arena = (TestArena *) context;
+   unsigned char const * const
+      byte = (unsigned char const *) memory;
+   arena->misaligned += (size_t) (
+      (byte < arena->memory) || (byte >= arena->memory + arena->used)
+      );
+   ++arena->releases;
+}
+
+static
+TestArena
+create_arena(void)
+{
+   TestArena
+      arena;
+   void *
+      memory = NULL;
+   memset(&arena, 0, sizeof(TestArena));
+   if(posix_memalign(&memory, (size_t) 64u, ALLOCATOR_ARENA_BYTES) == 0)
+   {
+      arena.memory = (unsigned char *) memory;
+   }
+   return
+      arena;
+}
+
+static
+VARRAllocator
+arena_allocator(TestArena * arena, int contiguous)
+{
+   VARRAllocator const
+      allocator = {
+         .allocate = arena_allocate,
+         .allocate_aligned = arena_allocate_aligned,
+         .release = arena_release,
+         .context = (void *) arena,
+         .contiguous = contiguous
+      };
+   return
+      allocator;
+}
+
+/*
+ * Returns nonzero if 'pointer' does not lie in the part of the arena used:
+ */
+static
+int
+outside_arena(TestArena const * arena, void const * pointer)
+{
+   unsigned char const * const
+      byte = (unsigned char const *) pointer;
+   return
+      (byte < arena->memory) || (byte >= arena->memory + arena->used);
+}
+
+static
+void
+fill_inputs(double * x, double lower, double upper)
+{
+   for(size_t i = 0u; i< ALLOCATOR_TEST_LENGTH; ++i)
+   {
+      x[i] = lower + (upper - lower) * (double) i / ALLOCATOR_TEST_LENGTH;
+   }
+}
+
+static
+double
+linbuf_delegate(double x, void * specialization)
+{
+   (void) specialization;
+   return
+      exp(-x * x);
+}
+
+/*
+ * Constructs evaluators of the arena (contiguous or not) and of the heap, 
+ * and returns the number of results that differ, of allocations of the 
+ * arena beyond 'allocations_allowed' per evaluator, of accelerators that 
+ * lie outside the arena, and of allocations that are not released:
+ */
+static
+double
+arena_test(int contiguous, size_t allocations_allowed)
+{
+   static double
+      x[ALLOCATOR_TEST_LENGTH],
+      out[ALLOCATOR_TEST_LENGTH],
+      heap_out[ALLOCATOR_TEST_LENGTH];
+   static double complex
+      phasor_out[ALLOCATOR_TEST_LENGTH],
+      heap_phasor_out[ALLOCATOR_TEST_LENGTH];
+   static float
+      x_float[ALLOCATOR_TEST_LENGTH],
+      float_out[ALLOCATOR_TEST_LENGTH],
+      heap_float_out[ALLOCATOR_TEST_LENGTH];
+   TestArena
+      arena = create_arena();
+   VARRAllocator const
+      allocator = arena_allocator(&arena, contiguous);
+   double
+      errors = 0.;
+   size_t
+      allocations = (size_t) 0u;
+   
+   fill_inputs(x, 0., 6.);
+   VARRSinDEvaluator
+      sin = sampling_sind_with_allocator(ALLOCATOR_TEST_SAMPLES, &allocator),
+      heap_sin = sampling_sind(ALLOCATOR_TEST_SAMPLES);
+   sin.sind_array(x, out, ALLOCATOR_TEST_LENGTH, sin.accelerator);
+   heap_sin.sind_array(
+      x, heap_out, ALLOCATOR_TEST_LENGTH, heap_sin.accelerator
+      );
+   errors += (double) (memcmp(out, heap_out, sizeof(out)) != 0)
+    + (double) outside_arena(&arena, sin.accelerator)
+    + (double) (arena.allocations - allocations > allocations_allowed);
+   allocations = arena.allocations;
+   
+   VARRExpDEvaluator
+      exp_evaluator = shifting_linear_sampling_expd_with_allocator(
+         ALLOCATOR_TEST_SAMPLES, &allocator
+         ),
+      heap_exp = shifting_linear_sampling_expd(ALLOCATOR_TEST_SAMPLES);
+   exp_evaluator.expd_array(
+      x, out, ALLOCATOR_TEST_LENGTH, exp_evaluator.accelerator
+      );
+   heap_exp.expd_array(
+      x, heap_out, ALLOCATOR_TEST_LENGTH, heap_exp.accelerator
+      );
+   errors += (double) (memcmp(out, heap_out, sizeof(out)) != 0)
+    + (double) outside_arena(&arena, exp_evaluator.accelerator)
+    + (double) (arena.allocations - allocations > allocations_allowed);
+   allocations = arena.allocations;
+   
+   VARRPhasorDEvaluator
+      phasor = cubic_spline_sampling_phasord_with_allocator(
+         ALLOCATOR_TEST_SAMPLES, &allocator
+         ),
+      heap_phasor = cubic_spline_sampling_phasord(ALLOCATOR_TEST_SAMPLES);
+   phasor.phasord_array(
+      x, phasor_out, ALLOCATOR_TEST_LENGTH, phasor.accelerator
+      );
+   heap_phasor.phasord_array(
+      x, heap_phasor_out, ALLOCATOR_TEST_LENGTH, heap_phasor.accelerator
+      );
+   errors += (double) (
+      memcmp(phasor_out, heap_phasor_out, sizeof(phasor_out)) != 0
+      )
+    + (double) outside_arena(&arena, phasor.accelerator)
+    + (double) (arena.allocations - allocations > allocations_allowed);
+   allocations = arena.allocations;
+   
+   for(size_t i = 0u; i< ALLOCATOR_TEST_LENGTH; ++i)
+   {
+      x_float[i] = (float) x[i];
+   }
+   VARRLogFEvaluator
+      log = normalizing_linear_sampling_logf_with_allocator(
+         ALLOCATOR_TEST_SAMPLES, &allocator
+         ),
+      heap_log = normalizing_linear_sampling_logf(ALLOCATOR_TEST_SAMPLES);
+   log.logf_array(x_float, float_out, ALLOCATOR_TEST_LENGTH, log.accelerator);
+   heap_log.logf_array(
+      x_float, heap_float_out, ALLOCATOR_TEST_LENGTH, heap_log.accelerator
+      );
+   errors += (double) (
+      memcmp(float_out, heap_float_out, sizeof(float_out)) != 0
+      )
+    + (double) outside_arena(&arena, log.accelerator)
+    + (double) (arena.allocations - allocations > allocations_allowed);
+   allocations = arena.allocations;
+   
+   VARRBoundGLBAccelerator
+      linbuf = bound_general_linbuf_with_allocator(
+         ALLOCATOR_TEST_SAMPLES, -3., 3., linbuf_delegate, NULL, &allocator
+         ),
+      heap_linbuf = bound_general_linbuf(
+         ALLOCATOR_TEST_SAMPLES, -3., 3., linbuf_delegate, NULL
+         );
+   linbuf.batch(x, out, ALLOCATOR_TEST_LENGTH, linbuf.accelerator);
+   heap_linbuf.batch(
+      x, heap_out, ALLOCATOR_TEST_LENGTH, heap_linbuf.accelerator
+      );
+   errors += (double) (memcmp(out, heap_out, sizeof(out)) != 0)
+    + (double) outside_arena(&arena, linbuf.accelerator)
+    + (double) (arena.allocations - allocations > allocations_allowed);
+   
+   printf(
+      "   %s: %zu allocations, %zu bytes of the arena\n",
+      contiguous ? "contiguous" : "individual",
+      arena.allocations,
+      arena.used
+      );
+   sin.disallocate(&sin);
+   heap_sin.disallocate(&heap_sin);
+   exp_evaluator.disallocate(&exp_evaluator);
+   heap_exp.disallocate(&heap_exp);
+   phasor.disallocate(&phasor);
+   heap_phasor.disallocate(&heap_phasor);
+   log.disallocate(&log);
+   heap_log.disallocate(&heap_log);
+   linbuf.disallocate(&linbuf);
+   heap_linbuf.disallocate(&heap_linbuf);
+   errors += fabs((double) arena.releases - (double) arena.allocations)
+    + (double) arena.misaligned;
+   free(arena.memory);
+   return
+      errors;
+}
+
+static size_t
+   linbuf_delegate_calls = (size_t) 0u;
+
+static
+double
+counting_linbuf_delegate(double x, void * specialization)
+{
+   ++linbuf_delegate_calls;
+   return
+      linbuf_delegate(x, specialization);
+}
+
+/*
+ * Returns the number of contiguous linbufs, of each table layout and 
+ * precision, that make more than one allocation of the arena, or that call 
+ * their delegate other than once per sample.  The format is selected as the
+ * *_with_table_format constructors do, around the allocator's constructor:
+ */
+static
+double
+contiguous_linbuf_test(void)
+{
+   static VARRTableLayout const
+      layouts[2u] = { VARR_TABLE_VALUES, VARR_TABLE_INTERLEAVED };
+   static VARRTablePrecision const
+      precisions[3u] = {
+         VARR_TABLE_DOUBLE, VARR_TABLE_FLOAT, VARR_TABLE_FLOAT_CORRECTED
+      };
+   double
+      errors = 0.;
+   for(size_t l = 0u; l< 2u; ++l)
+   {
+      for(size_t p = 0u; p< 3u; ++p)
+      {
+         TestArena
+            arena = create_arena();
+         VARRAllocator const
+            allocator = arena_allocator(&arena, 1);
+         VARRTableFormat const
+            format = { .layout = layouts[l], .precision = precisions[p] },
+            previous = __varr_select_table_format(format);
+         linbuf_delegate_calls = (size_t) 0u;
+         VARRBoundGLBAccelerator
+            linbuf = bound_general_linbuf_with_allocator(
+               ALLOCATOR_TEST_SAMPLES,
+               -3.,
+               3.,
+               counting_linbuf_delegate,
+               NULL,
+               &allocator
+               );
+         __varr_select_table_format(previous);
+         errors += (double) (arena.allocations != (size_t) 1u)
+          + (double) (linbuf_delegate_calls != ALLOCATOR_TEST_SAMPLES + 2u)
+          + (double) outside_arena(&arena, linbuf.accelerator);
+         linbuf.disallocate(&linbuf);
+         free(arena.memory);
+      }
+   }
+   return
+      errors;
+}
+
+/*
+ * Constructs an evaluator of constructor##_with_allocator in a contiguous 
+ * arena, and counts an error unless it makes (and releases) exactly one 
+ * allocation, which holds its accelerator:
+ */
+#define CONTIGUOUS_CONSTRUCTION_TEST(evaluator_type, constructor) \
+   { \
+      TestArena \
+         arena = create_arena(); \
+      VARRAllocator const \
+         allocator = arena_allocator(&arena, 1); \
+      evaluator_type \
+         evaluator = constructor##_with_allocator( \
+            ALLOCATOR_TEST_SAMPLES, &allocator \
+            ); \
+      errors += (double) (arena.allocations != (size_t) 1u) \
+       + (double) outside_arena(&arena, evaluator.accelerator); \
+      evaluator.disallocate(&evaluator); \
+      errors += (double) (arena.releases != (size_t) 1u); \
+      free(arena.memory); \
+   }
+
+/*
+ * Returns the number of contiguous evaluators, of each constructor and of 
+ * each table layout and precision, whose measured block does not hold all 
+ * of their allocations:
+ */
+static
+double
+contiguous_constructors_test(void)
+{
+   static VARRTableLayout const
+      layouts[2u] = { VARR_TABLE_VALUES, VARR_TABLE_INTERLEAVED };
+   static VARRTablePrecision const
+      precisions[3u] = {
+         VARR_TABLE_DOUBLE, VARR_TABLE_FLOAT, VARR_TABLE_FLOAT_CORRECTED
+      };
+   double
+      errors = 0.;
+   for(size_t l = 0u; l< 2u; ++l)
+   {
+      for(size_t p = 0u; p< 3u; ++p)
+      {
+         VARRTableFormat const
+            format = { .layout = layouts[l], .precision = precisions[p] },
+            previous = __varr_select_table_format(format);
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRSinDEvaluator, sampling_sind)
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRSinDEvaluator, cubic_spline_sampling_sind
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRSinFEvaluator, sampling_sinf)
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRCosDEvaluator, sampling_cosd)
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRCosDEvaluator, cubic_spline_sampling_cosd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRCosFEvaluator, sampling_cosf)
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRSinCosDEvaluator, sampling_sincosd)
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRSinCosDEvaluator, cubic_spline_sampling_sincosd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRPhasorDEvaluator, linear_interpolating_phasord
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRPhasorDEvaluator, cubic_spline_sampling_phasord
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRPhasorFEvaluator, linear_interpolating_phasorf
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRSinDEvaluator, octant_sampling_sind)
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRCosDEvaluator, octant_sampling_cosd)
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRPhasorDEvaluator, octant_linear_interpolating_phasord
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRExpDEvaluator, shifting_linear_sampling_expd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRExpDEvaluator, scaling_series_expd)
+         CONTIGUOUS_CONSTRUCTION_TEST(VARRExpFEvaluator, linear_sampling_expf)
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRLogDEvaluator, normalizing_linear_sampling_logd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRLogDEvaluator, normalizing_sublinear_sampling_logd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRLogFEvaluator, normalizing_linear_sampling_logf
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRAtanDEvaluator, clamping_linear_interpolating_atand
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRAtanFEvaluator, reflecting_linear_interpolating_atanf
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRSixthRootDEvaluator, linear_sampling_normalizing_sixth_rootd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRSixthRootDEvaluator, sublinear_sampling_normalizing_sixth_rootd
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARRSixthRootFEvaluator, linear_sampling_normalizing_sixth_rootf
+            )
+         CONTIGUOUS_CONSTRUCTION_TEST(
+            VARR3Over4DEvaluator, linear_sampling_normalizing_3over4d
+            )
+         __varr_select_table_format(previous);
+      }
+   }
+   return
+      errors;
+}
+
+static TestArena *
+   constructing_delegate_arena = NULL;
+
+static size_t
+   constructing_delegate_errors = (size_t) 0u;
+
+/*
+ * A delegate that constructs (and disallocates) an evaluator of its own at 
+ * each sample, and counts an error if the evaluator is of the arena:
+ */
+static
+double
+constructing_linbuf_delegate(double x, void * specialization)
+{
+   VARRSinDEvaluator
+      sin = sampling_sind((size_t) 64u);
+   constructing_delegate_errors += (size_t) !outside_arena(
+      constructing_delegate_arena, sin.accelerator
+      );
+   sin.disallocate(&sin);
+   return
+      linbuf_delegate(x, specialization);
+}
+
+/*
+ * Returns the number of evaluators that the delegate of a linbuf of an 
+ * allocator constructs in the allocator's memory (rather than the heap), 
+ * and of allocations of the arena other than the linbuf's one:
+ */
+static
+double
+delegate_isolation_test(void)
+{
+   TestArena
+      arena = create_arena();
+   VARRAllocator const
+      allocator = arena_allocator(&arena, 1);
+   constructing_delegate_arena = &arena;
+   constructing_delegate_errors = (size_t) 0u;
+   VARRBoundGLBAccelerator
+      linbuf = bound_general_linbuf_with_allocator(
+         ALLOCATOR_TEST_SAMPLES,
+         -3.,
+         3.,
+         constructing_linbuf_delegate,
+         NULL,
+         &allocator
+         );
+   double const
+      errors = (double) constructing_delegate_errors
+    + (double) (arena.allocations != (size_t) 1u);
+   linbuf.disallocate(&linbuf);
+   free(arena.memory);
+   return
+      errors;
+}
+
+/*
+ * Returns the number of failures to report an allocator that is out of 
+ * memory, by a linbuf of a NULL accelerator:
+ */
+static
+double
+exhausted_arena_test(void)
+{
+   TestArena
+      arena = create_arena();
+   VARRAllocator const
+      allocator = arena_allocator(&arena, 0);
+   arena.used = ALLOCATOR_ARENA_BYTES;
+   VARRBoundGLBAccelerator
+      linbuf = bound_general_linbuf_with_allocator(
+         ALLOCATOR_TEST_SAMPLES, -3., 3., linbuf_delegate, NULL, &allocator
+         );
+   double const
+      errors = (double) (linbuf.accelerator != NULL)
+    + (double) (varr_prefetch_linbuf(&linbuf, -3., 3.) != 1)
+    + (double) (linbuf.disallocate(&linbuf) != 1)
+    + (double) arena.allocations;
+   free(arena.memory);
+   return
+      errors;
+}
+
+UnitTestResult
+test_varr_allocator(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   
+   printf("Allocator tests:\n");
+   declare_start_of_unit_test();
+   
+   VARRTableCacheStatistics const
+      before = varr_table_cache_statistics();
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Evaluators of an allocator agree with evaluators of the heap, and "
+      "release all of their memory",
+      arena_test(0, (size_t) 8u),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Contiguous evaluators make one allocation, and release it once",
+      arena_test(1, (size_t) 1u),
+      0.5
+      );
+   int const
+      cached = varr_table_cache_enabled();
+   varr_set_table_cache_enabled(0);
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Contiguous evaluators make one allocation with the cache disabled",
+      arena_test(1, (size_t) 1u),
+      0.5
+      );
+   varr_set_table_cache_enabled(cached);
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Contiguous linbufs of every table layout and precision make one "
+      "allocation, and sample their grid once",
+      contiguous_linbuf_test(),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Contiguous evaluators of every constructor, table layout and "
+      "precision make one allocation",
+      contiguous_constructors_test(),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Evaluators constructed by the delegate of a linbuf of an allocator "
+      "are of the heap",
+      delegate_isolation_test(),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "A linbuf of an exhausted allocator has a NULL accelerator",
+      exhausted_arena_test(),
+      0.5
+      );
+   VARRTableCacheStatistics const
+      after = varr_table_cache_statistics();
+   numerical_error_unit_test(
+      &result,
+      "varr-allocator",
+      "Evaluators of allocators release their tables",
+      fabs((double) after.tables - (double) before.tables)
+    + fabs((double) after.bytes - (double) before.bytes),
+      0.5
+      );
+   
+   declare_end_of_unit_test();
+   
+   return
+      result;
+}
@@ -184,6 +184,51 @@ expd_test_with_remainder_loop_in_place_transform(void)
       numerical_error;
 }
 
+static
+double
+expd_scaling_series_test_with_remainder_loop(
+   double const lower,
+   double const upper
+   )
+{
+   double
+      numerical_error = -1.0;
+   
+   expd_evaluator = 
+      scaling_series_expd(256u);
+   
+   printf("Scalar evaluation:\n");
+   numerical_error = 
+      evaluate_performanced(
+         lower,
+         upper,
+         50000003u,
+         0,
+         exp,
+         expd_evaluate
+         );
+   
+   // batch evaluation:
+   printf("Vector evaluation:\n");
+   numerical_error = fmax(
+      numerical_error,
+      evaluate_batch_performanced(
+         lower,
+         upper,
+         50000003u,
+         0,
+         expd_machine_batch_evaluate,
+         expd_batch_evaluate,
+         0
+         )
+      );
+   
+   expd_evaluator.disallocate(&expd_evaluator);
+   
+   return
+      numerical_error;
+}
+
 UnitTestResult
 test_varr_exp(void)
 {
@@ -255,6 +300,53 @@ test_varr_exp(void)
    combine_test_results(test_outcome, &result);
    }
    
+   static double const
+      worst_allowed_scaling_numerical_error = 9.e-16;
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   double const
+      numerical_error = expd_scaling_series_test_with_remainder_loop(
+         -10.0, +10.0
+         );
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-exp/exp(x)",
+         "Scaling evaluation (with remainder loop)",
+         numerical_error,
+         worst_allowed_scaling_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_scaling_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   double const
+      numerical_error = expd_scaling_series_test_with_remainder_loop(
+         -708.0, +709.0
+         );
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-exp/exp(x)",
+         "Scaling evaluation (full range)",
+         numerical_error,
+         worst_allowed_scaling_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_scaling_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
    return
       result;
 }
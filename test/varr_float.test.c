@@ -0,0 +1,628 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <float.h>
+#include <time.h>
+
+#define FLOAT_TEST_LENGTH ((size_t) 4099u)
+#define FLOAT_TEST_SAMPLES ((size_t) 16384u)
+#define FLOAT_BENCHMARK_LENGTH ((size_t) 65536u)
+#define FLOAT_BENCHMARK_REPETITIONS ((size_t) 32u)
+#define FLOAT_BENCHMARK_ELEMENTS \
+   (FLOAT_BENCHMARK_LENGTH * FLOAT_BENCHMARK_REPETITIONS)
+#define FLOAT_NUMBER_OF_CASES ((size_t) 7u)
+
+#define FLOAT_REPORT_SIZES ((size_t) 4u)
+
+static size_t const
+   float_report_samples[FLOAT_REPORT_SIZES] = {
+      1024u, 4096u, 16384u, 65536u
+   };
+
+typedef void (* FloatBatchFunction) (
+   float const *, float *, size_t, void const *
+   );
+
+/*
+ * A batch function of a single precision evaluator, its input range, and 
+ * the double precision function(s) it approximates, as well as the libm
+ * float function(s) that it replaces.  Evaluators with a second reference
+ * function (eg. the phasor) write two outputs per input.  The errors of 
+ * 'relative' cases are relative to the reference value, and those of other
+ * cases are relative to the greater of the reference value and unity.
+ */
+typedef struct tagFloatTestCase {
+   char const *
+      name;
+   FloatBatchFunction
+      batch;
+   void const *
+      accelerator;
+   double (* reference) (double);
+   double (* second_reference) (double);
+   float (* stock) (float);
+   float (* second_stock) (float);
+   double
+      lower,
+      upper;
+   int
+      log_sampling,
+      relative;
+} FloatTestCase;
+
+typedef struct tagFloatTestEvaluators {
+   VARRExpFEvaluator
+      exp;
+   VARRLogFEvaluator
+      log;
+   VARRSixthRootFEvaluator
+      sixth_root;
+   VARRAtanFEvaluator
+      atan;
+   VARRSinFEvaluator
+      sin;
+   VARRCosFEvaluator
+      cos;
+   VARRPhasorFEvaluator
+      phasor;
+} FloatTestEvaluators;
+
+static
+double
+sixth_root(double x)
+{
+   return
+      pow(x, 1. / 6.);
+}
+
+static
+float
+stock_sixth_rootf(float x)
+{
+   return
+      powf(x, 1.f / 6.f);
+}
+
+static
+void
+phasorf_batch(
+   float const * x,
+   float * out,
+   size_t length,
+   void const * evaluator
+   )
+{
+   VARRPhasorFEvaluator const * const
+      phasor = (VARRPhasorFEvaluator const *) evaluator;
+   phasor->phasorf_array(
+      x, (float complex *) out, length, phasor->accelerator
+      );
+}
+
+/*
+ * Constructs the single precision evaluators with 'number_of_samples' 
+ * samples, for the current varr_simd_level(), and lists them in 'cases' (of
+ * FLOAT_NUMBER_OF_CASES elements).
+ */
+static
+void
+construct_evaluators(
+   FloatTestEvaluators * evaluators,
+   FloatTestCase * cases,
+   size_t number_of_samples
+   )
+{
+   evaluators->exp = linear_sampling_expf(number_of_samples);
+   evaluators->log = normalizing_linear_sampling_logf(number_of_samples);
+   evaluators->sixth_root =
+      linear_sampling_normalizing_sixth_rootf(number_of_samples);
+   evaluators->atan = reflecting_linear_interpolating_atanf(number_of_samples);
+   evaluators->sin = sampling_sinf(number_of_samples);
+   evaluators->cos = sampling_cosf(number_of_samples);
+   evaluators->phasor = linear_interpolating_phasorf(number_of_samples);
+   
+   FloatTestCase const
+      all_cases[FLOAT_NUMBER_OF_CASES] = {
+         {
+            "expf_array",
+            evaluators->exp.expf_array,
+            evaluators->exp.accelerator,
+            exp, NULL, expf, NULL,
+            -87., 88., 0, 1
+         },
+         {
+            "logf_array",
+            evaluators->log.logf_array,
+            evaluators->log.accelerator,
+            log, NULL, logf, NULL,
+            1.e-37, 1.e38, 1, 0
+         },
+         {
+            "sixthrootf_array",
+            evaluators->sixth_root.sixthrootf_array,
+            evaluators->sixth_root.accelerator,
+            sixth_root, NULL, stock_sixth_rootf, NULL,
+            1.e-37, 1.e38, 1, 1
+         },
+         {
+            "atanf_array",
+            evaluators->atan.atanf_array,
+            evaluators->atan.accelerator,
+            atan, NULL, atanf, NULL,
+            -100., 100., 0, 0
+         },
+         {
+            "sinf_array",
+            evaluators->sin.sinf_array,
+            evaluators->sin.accelerator,
+            sin, NULL, sinf, NULL,
+            -1000., 1000., 0, 0
+         },
+         {
+            "cosf_array",
+            evaluators->cos.cosf_array,
+            evaluators->cos.accelerator,
+            cos, NULL, cosf, NULL,
+            -1000., 1000., 0, 0
+         },
+         {
+            "phasorf_array",
+            phasorf_batch,
+            &evaluators->phasor,
+            cos, sin, cosf, sinf,
+            -1000., 1000., 0, 0
+         }
+      };
+   for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+   {
+      cases[i] = all_cases[i];
+   }
+}
+
+static
+void
+release_evaluators(FloatTestEvaluators * evaluators)
+{
+   evaluators->exp.disallocate(&evaluators->exp);
+   evaluators->log.disallocate(&evaluators->log);
+   evaluators->sixth_root.disallocate(&evaluators->sixth_root);
+   evaluators->atan.disallocate(&evaluators->atan);
+   evaluators->sin.disallocate(&evaluators->sin);
+   evaluators->cos.disallocate(&evaluators->cos);
+   evaluators->phasor.disallocate(&evaluators->phasor);
+}
+
+static
+size_t
+case_width(FloatTestCase const * test_case)
+{
+   return
+      (test_case->second_reference == NULL) ? 1u : 2u;
+}
+
+static
+double
+case_difference(
+   FloatTestCase const * test_case,
+   double observed,
+   double expected
+   )
+{
+   register double const
+      scale = test_case->relative ? 
+         fabs(expected)
+         :
+         ((fabs(expected) > 1.) ? fabs(expected) : 1.);
+   return
+      fabs(observed - expected) / scale;
+}
+
+static
+void
+fill_inputs(
+   float * restrict x,
+   size_t length,
+   double lower,
+   double upper,
+   int log_sampling
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+   {
+      // A multiplicative congruence scatters the samples over the range:
+      double const
+         t = (double) ((i * 7919u) % length) / (double) (length - 1u);
+      x[i] = (float) (
+         log_sampling ?
+            exp(log(lower) + t * (log(upper) - log(lower)))
+            :
+            lower + t * (upper - lower)
+         );
+   }
+}
+
+/*
+ * Returns the worst error of the batch function of 'test_case' over 
+ * FLOAT_TEST_LENGTH inputs, with respect to its double precision reference
+ * function(s) evaluated at the same (float) inputs:
+ */
+static
+double
+accuracy_test(FloatTestCase const * test_case)
+{
+   static float
+      x[FLOAT_TEST_LENGTH],
+      out[2u * FLOAT_TEST_LENGTH];
+   size_t const
+      width = case_width(test_case);
+   double
+      worst = 0.;
+   fill_inputs(
+      x,
+      FLOAT_TEST_LENGTH,
+      test_case->lower,
+      test_case->upper,
+      test_case->log_sampling
+      );
+   test_case->batch(x, out, FLOAT_TEST_LENGTH, test_case->accelerator);
+   for(size_t i = 0u; i< FLOAT_TEST_LENGTH; ++i)
+   {
+      worst = fmax(
+         worst,
+         case_difference(
+            test_case,
+            (double) out[width * i],
+            test_case->reference((double) x[i])
+            )
+         );
+      if(width == 2u)
+      {
+         worst = fmax(
+            worst,
+            case_difference(
+               test_case,
+               (double) out[width * i + 1u],
+               test_case->second_reference((double) x[i])
+               )
+            );
+      }
+   }
+   return
+      worst;
+}
+
+/*
+ * Returns the worst error of any single precision evaluator of 
+ * 'number_of_samples' samples, for the current varr_simd_level():
+ */
+static
+double
+float_accuracy_test(size_t number_of_samples)
+{
+   FloatTestEvaluators
+      evaluators;
+   FloatTestCase
+      cases[FLOAT_NUMBER_OF_CASES];
+   double
+      worst = 0.;
+   construct_evaluators(&evaluators, cases, number_of_samples);
+   for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+   {
+      double const
+         error = accuracy_test(cases + i);
+      printf("   %s: %e\n", cases[i].name, error);
+      worst = fmax(worst, error);
+   }
+   release_evaluators(&evaluators);
+   return
+      worst;
+}
+
+/*
+ * Returns the worst difference between the batch functions of the single
+ * precision evaluators for the current varr_simd_level() and for 
+ * VARR_SIMD_SCALAR:
+ */
+static
+double
+float_batch_versus_scalar_test(void)
+{
+   static float
+      x[FLOAT_TEST_LENGTH],
+      observed_out[2u * FLOAT_TEST_LENGTH],
+      expected_out[2u * FLOAT_TEST_LENGTH];
+   FloatTestEvaluators
+      observed_evaluators,
+      expected_evaluators;
+   FloatTestCase
+      observed_cases[FLOAT_NUMBER_OF_CASES],
+      expected_cases[FLOAT_NUMBER_OF_CASES];
+   VARRSimdLevel const
+      level = varr_simd_level();
+   double
+      worst = 0.;
+   construct_evaluators(
+      &observed_evaluators, observed_cases, FLOAT_TEST_SAMPLES
+      );
+   varr_set_simd_level(VARR_SIMD_SCALAR);
+   construct_evaluators(
+      &expected_evaluators, expected_cases, FLOAT_TEST_SAMPLES
+      );
+   varr_set_simd_level(level);
+   for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+   {
+      double
+         difference = 0.;
+      fill_inputs(
+         x,
+         FLOAT_TEST_LENGTH,
+         expected_cases[i].lower,
+         expected_cases[i].upper,
+         expected_cases[i].log_sampling
+         );
+      observed_cases[i].batch(
+         x, observed_out, FLOAT_TEST_LENGTH, observed_cases[i].accelerator
+         );
+      expected_cases[i].batch(
+         x, expected_out, FLOAT_TEST_LENGTH, expected_cases[i].accelerator
+         );
+      for(
+         size_t j = 0u;
+         j< case_width(expected_cases + i) * FLOAT_TEST_LENGTH;
+         ++j
+         )
+      {
+         difference = fmax(
+            difference,
+            case_difference(
+               expected_cases + i, observed_out[j], expected_out[j]
+               )
+            );
+      }
+      printf("   %s: %e\n", expected_cases[i].name, difference);
+      worst = fmax(worst, difference);
+   }
+   release_evaluators(&observed_evaluators);
+   release_evaluators(&expected_evaluators);
+   return
+      worst;
+}
+
+/*
+ * Reports the worst error of each single precision evaluator, by number of
+ * samples, for the current varr_simd_level():
+ */
+static
+void
+float_accuracy_report(void)
+{
+   FloatTestEvaluators
+      evaluators;
+   FloatTestCase
+      cases[FLOAT_NUMBER_OF_CASES];
+   double
+      errors[FLOAT_REPORT_SIZES][FLOAT_NUMBER_OF_CASES];
+   
+   for(size_t k = 0u; k< FLOAT_REPORT_SIZES; ++k)
+   {
+      construct_evaluators(&evaluators, cases, float_report_samples[k]);
+      for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+      {
+         errors[k][i] = accuracy_test(cases + i);
+      }
+      release_evaluators(&evaluators);
+   }
+   printf(
+      "Single precision accuracy by number of samples (worst error, %s SIMD "
+      "level):\n   %-20s",
+      varr_simd_level_name(varr_simd_level()),
+      ""
+      );
+   for(size_t k = 0u; k< FLOAT_REPORT_SIZES; ++k)
+   {
+      printf(" %10zu", float_report_samples[k]);
+   }
+   printf("\n");
+   for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+   {
+      printf("   %-20s", cases[i].name);
+      for(size_t k = 0u; k< FLOAT_REPORT_SIZES; ++k)
+      {
+         printf(" %10.3e", errors[k][i]);
+      }
+      printf("\n");
+   }
+}
+
+/*
+ * Reports the throughput of the libm float functions, and of the batch 
+ * functions of the single precision evaluators (of FLOAT_TEST_SAMPLES 
+ * samples) at every supported SIMD level:
+ */
+static
+void
+float_benchmark(VARRSimdLevel supported_level)
+{
+   static float
+      x[FLOAT_BENCHMARK_LENGTH],
+      out[2u * FLOAT_BENCHMARK_LENGTH];
+   FloatTestEvaluators
+      evaluators;
+   FloatTestCase
+      cases[FLOAT_NUMBER_OF_CASES];
+   double
+      timings[4u][FLOAT_NUMBER_OF_CASES];
+   
+   for(
+      int level = (int) VARR_SIMD_SCALAR;
+      level <= (int) supported_level;
+      ++level
+      )
+   {
+      varr_set_simd_level((VARRSimdLevel) level);
+      construct_evaluators(&evaluators, cases, FLOAT_TEST_SAMPLES);
+      for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+      {
+         fill_inputs(
+            x,
+            FLOAT_BENCHMARK_LENGTH,
+            cases[i].lower,
+            cases[i].upper,
+            cases[i].log_sampling
+            );
+         clock_t const
+            begin = clock();
+         for(size_t r = 0u; r< FLOAT_BENCHMARK_REPETITIONS; ++r)
+         {
+            cases[i].batch(
+               x, out, FLOAT_BENCHMARK_LENGTH, cases[i].accelerator
+               );
+         }
+         timings[1 + level][i] =
+            timing_in_nanoseconds_per_element(
+               begin, clock(), FLOAT_BENCHMARK_ELEMENTS
+               );
+      }
+      release_evaluators(&evaluators);
+   }
+   for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+   {
+      fill_inputs(
+         x,
+         FLOAT_BENCHMARK_LENGTH,
+         cases[i].lower,
+         cases[i].upper,
+         cases[i].log_sampling
+         );
+      size_t const
+         width = case_width(cases + i);
+      clock_t const
+         begin = clock();
+      for(size_t r = 0u; r< FLOAT_BENCHMARK_REPETITIONS; ++r)
+      {
+         for(size_t j = 0u; j< FLOAT_BENCHMARK_LENGTH; ++j)
+         {
+            out[width * j] = cases[i].stock(x[j]);
+            if(width == 2u)
+            {
+               out[width * j + 1u] = cases[i].second_stock(x[j]);
+            }
+         }
+      }
+      timings[0u][i] =
+         timing_in_nanoseconds_per_element(
+            begin, clock(), FLOAT_BENCHMARK_ELEMENTS
+            );
+   }
+   
+   printf("Single precision throughput (ns per element, libm float and "
+      "VARR batch, %zu samples):\n",
+      FLOAT_TEST_SAMPLES
+      );
+   for(size_t i = 0u; i< FLOAT_NUMBER_OF_CASES; ++i)
+   {
+      printf("   %-20s libm: %6.3f", cases[i].name, timings[0u][i]);
+      for(
+         int level = (int) VARR_SIMD_SCALAR;
+         level <= (int) supported_level;
+         ++level
+         )
+      {
+         printf(
+            " %s: %6.3f (%4.2fx)",
+            varr_simd_level_name((VARRSimdLevel) level),
+            timings[1 + level][i],
+            timings[0u][i] / timings[1 + level][i]
+            );
+      }
+      printf("\n");
+   }
+}
+
+UnitTestResult
+test_varr_float(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   VARRSimdLevel const
+      supported_level = varr_simd_supported_level();
+   char
+      unit_test_name[96];
+   
+   printf("Single precision evaluator tests:\n");
+   for(
+      int level = (int) VARR_SIMD_SCALAR;
+      level <= (int) supported_level;
+      ++level
+      )
+   {
+      declare_start_of_unit_test();
+      VARRSimdLevel const
+         selected_level = varr_set_simd_level((VARRSimdLevel) level);
+      snprintf(
+         unit_test_name,
+         sizeof(unit_test_name),
+         "Float evaluation versus double reference (%s, %zu samples)",
+         varr_simd_level_name(selected_level),
+         FLOAT_TEST_SAMPLES
+         );
+      printf("%s:\n", unit_test_name);
+      numerical_error_unit_test(
+         &result,
+         "varr-float",
+         unit_test_name,
+         float_accuracy_test(FLOAT_TEST_SAMPLES),
+         1.32e-6
+         );
+      if(selected_level != VARR_SIMD_SCALAR)
+      {
+         snprintf(
+            unit_test_name,
+            sizeof(unit_test_name),
+            "Float batch versus scalar evaluation (%s)",
+            varr_simd_level_name(selected_level)
+            );
+         printf("%s:\n", unit_test_name);
+         numerical_error_unit_test(
+            &result,
+            "varr-float",
+            unit_test_name,
+            float_batch_versus_scalar_test(),
+            1.31e-6
+            );
+      }
+      declare_end_of_unit_test();
+   }
+   
+   float_accuracy_report();
+   float_benchmark(supported_level);
+   varr_set_simd_level(VARR_SIMD_AVX512);
+   
+   return
+      result;
+}
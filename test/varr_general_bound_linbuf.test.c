@@ -22,13 +22,19 @@
 #include "varr_test.h"
 #include "timings.h"
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <float.h>
+#include <time.h>
 
 #define M_PI (3.14159265358979323846)
 
+#define LAZY_TEST_SAMPLES ((size_t) 1000000u)
+#define LAZY_TEST_LENGTH ((size_t) 100003u)
+#define LAZY_NUMBER_OF_THREADS ((size_t) 4u)
+
 static
 double
 cos_ax_delegate(
@@ -290,6 +296,280 @@ delegate_test_with_remainder_loop_in_place_transform(void)
       numerical_error;
 }
 
+/*
+ * cos_ax_delegate, counting its calls (from any thread):
+ */
+static
+size_t
+counted_delegate_calls = 0u;
+
+static
+double
+counted_cos_ax_delegate(
+   double x,
+   void * p
+   )
+{
+   __atomic_fetch_add(&counted_delegate_calls, 1u, __ATOMIC_RELAXED);
+   return
+      cos_ax_delegate(x, p);
+}
+
+static
+double
+lazy_argument = 2.2;
+
+/*
+ * Assigns 'length' uniformly random points of [lower, upper) to x:
+ */
+static
+void
+random_points(double * x, size_t length, double lower, double upper)
+{
+   for(size_t i = 0u; i< length; ++i)
+   {
+      x[i] = lower
+       + (upper - lower) * ((double) rand() / ((double) RAND_MAX + 1.));
+   }
+}
+
+/*
+ * Returns the greatest difference between the batch and scalar values of
+ * 'lazy' and 'eager' at the points x:
+ */
+static
+double
+lazy_difference(
+   VARRBoundGLBAccelerator const * lazy,
+   VARRBoundGLBAccelerator const * eager,
+   double const * x,
+   size_t length
+   )
+{
+   double * const
+      lazy_out = (double *) malloc(sizeof(double) * length);
+   double * const
+      eager_out = (double *) malloc(sizeof(double) * length);
+   double
+      difference = 0.;
+   lazy->batch(x, lazy_out, length, lazy->accelerator);
+   eager->batch(x, eager_out, length, eager->accelerator);
+   for(size_t i = 0u; i< length; ++i)
+   {
+      difference = fmax(difference, fabs(lazy_out[i] - eager_out[i]));
+      difference = fmax(
+         difference,
+         fabs(
+            lazy->scalar(x[i], lazy->accelerator)
+          - eager->scalar(x[i], eager->accelerator)
+            )
+         );
+   }
+   free(eager_out);
+   free(lazy_out);
+   return
+      difference;
+}
+
+/*
+ * Returns the fraction of the samples of a lazy linbuf that are filled to 
+ * evaluate points of a narrow part (a hundredth) of its domain, plus the 
+ * worst difference of its values from those of the eager linbuf there:
+ */
+static
+double
+lazy_narrow_test(void)
+{
+   double * const
+      x = (double *) malloc(sizeof(double) * LAZY_TEST_LENGTH);
+   VARRBoundGLBAccelerator
+      eager = bound_general_linbuf(
+         LAZY_TEST_SAMPLES, 0., 2. * M_PI, cos_ax_delegate, &lazy_argument
+         );
+   counted_delegate_calls = 0u;
+   VARRBoundGLBAccelerator
+      lazy = lazy_bound_general_linbuf(
+         LAZY_TEST_SAMPLES,
+         0.,
+         2. * M_PI,
+         counted_cos_ax_delegate,
+         &lazy_argument
+         );
+   random_points(x, LAZY_TEST_LENGTH, 1., 1. + 0.02 * M_PI);
+   double const
+      difference = lazy_difference(&lazy, &eager, x, LAZY_TEST_LENGTH);
+   double const
+      filled = (double) counted_delegate_calls
+       / (double) (LAZY_TEST_SAMPLES + 2u);
+   printf(
+      "Lazy linbuf: %zu of %zu samples filled for a hundredth of the "
+      "domain\n",
+      counted_delegate_calls,
+      LAZY_TEST_SAMPLES + 2u
+      );
+   lazy.disallocate(&lazy);
+   eager.disallocate(&eager);
+   free(x);
+   return
+      filled + difference;
+}
+
+typedef struct tagLazyEvaluation
+{
+   VARRBoundGLBAccelerator const *
+      linbuf;
+   double *
+      x,
+      * out;
+} LazyEvaluation;
+
+static
+void *
+lazy_evaluate(void * argument)
+{
+   LazyEvaluation * const
+      evaluation = (LazyEvaluation *) argument;
+   evaluation->linbuf->batch(
+      evaluation->x,
+      evaluation->out,
+      LAZY_TEST_LENGTH,
+      evaluation->linbuf->accelerator
+      );
+   return NULL;
+}
+
+/*
+ * Returns the number of samples of a lazy linbuf, evaluated over its domain
+ * by LAZY_NUMBER_OF_THREADS threads at once, that were not filled exactly 
+ * once, plus the worst difference of its values from those of the eager 
+ * linbuf:
+ */
+static
+double
+lazy_concurrent_test(void)
+{
+   pthread_t
+      threads[LAZY_NUMBER_OF_THREADS];
+   LazyEvaluation
+      evaluations[LAZY_NUMBER_OF_THREADS];
+   double
+      difference = 0.;
+   double * const
+      eager_out = (double *) malloc(sizeof(double) * LAZY_TEST_LENGTH);
+   VARRBoundGLBAccelerator
+      eager = bound_general_linbuf(
+         LAZY_TEST_SAMPLES, 0., 2. * M_PI, cos_ax_delegate, &lazy_argument
+         );
+   counted_delegate_calls = 0u;
+   VARRBoundGLBAccelerator
+      lazy = lazy_bound_general_linbuf(
+         LAZY_TEST_SAMPLES,
+         0.,
+         2. * M_PI,
+         counted_cos_ax_delegate,
+         &lazy_argument
+         );
+   for(size_t i = 0u; i< LAZY_NUMBER_OF_THREADS; ++i)
+   {
+      evaluations[i].linbuf = &lazy;
+      evaluations[i].x = (double *) malloc(sizeof(double) * LAZY_TEST_LENGTH);
+      evaluations[i].out = 
+         (double *) malloc(sizeof(double) * LAZY_TEST_LENGTH);
+      random_points(evaluations[i].x, LAZY_TEST_LENGTH, -1., 2. * M_PI + 1.);
+   }
+   for(size_t i = 0u; i< LAZY_NUMBER_OF_THREADS; ++i)
+   {
+      pthread_create(threads + i, NULL, lazy_evaluate, evaluations + i);
+   }
+   for(size_t i = 0u; i< LAZY_NUMBER_OF_THREADS; ++i)
+   {
+      pthread_join(threads[i], NULL);
+   }
+   // The remaining samples are filled by prefetching:
+   varr_prefetch_linbuf(&lazy, 0., 2. * M_PI);
+   double const
+      unfilled = fabs(
+         (double) counted_delegate_calls - (double) (LAZY_TEST_SAMPLES + 2u)
+         );
+   for(size_t i = 0u; i< LAZY_NUMBER_OF_THREADS; ++i)
+   {
+      eager.batch(
+         evaluations[i].x, eager_out, LAZY_TEST_LENGTH, eager.accelerator
+         );
+      for(size_t j = 0u; j< LAZY_TEST_LENGTH; ++j)
+      {
+         difference = fmax(
+            difference, fabs(evaluations[i].out[j] - eager_out[j])
+            );
+      }
+      free(evaluations[i].out);
+      free(evaluations[i].x);
+   }
+   lazy.disallocate(&lazy);
+   eager.disallocate(&eager);
+   free(eager_out);
+   return
+      unfilled + difference;
+}
+
+/*
+ * Returns the number of delegate calls of a lazy linbuf that are made after
+ * its domain was prefetched (which should be none), and reports the time 
+ * taken to construct the eager linbuf, and the lazy one with and without 
+ * prefetching its domain:
+ */
+static
+double
+lazy_prefetch_test(void)
+{
+   double * const
+      x = (double *) malloc(sizeof(double) * LAZY_TEST_LENGTH);
+   double * const
+      out = (double *) malloc(sizeof(double) * LAZY_TEST_LENGTH);
+   clock_t
+      begin = clock();
+   VARRBoundGLBAccelerator
+      eager = bound_general_linbuf(
+         LAZY_TEST_SAMPLES, 0., 2. * M_PI, cos_ax_delegate, &lazy_argument
+         );
+   double const
+      eager_time = (double) (clock() - begin) / CLOCKS_PER_SEC;
+   counted_delegate_calls = 0u;
+   begin = clock();
+   VARRBoundGLBAccelerator
+      lazy = lazy_bound_general_linbuf(
+         LAZY_TEST_SAMPLES,
+         0.,
+         2. * M_PI,
+         counted_cos_ax_delegate,
+         &lazy_argument
+         );
+   double const
+      lazy_time = (double) (clock() - begin) / CLOCKS_PER_SEC;
+   begin = clock();
+   varr_prefetch_linbuf(&lazy, -1., 2. * M_PI + 1.);
+   double const
+      prefetch_time = (double) (clock() - begin) / CLOCKS_PER_SEC;
+   size_t const
+      prefetched_calls = counted_delegate_calls;
+   random_points(x, LAZY_TEST_LENGTH, -1., 2. * M_PI + 1.);
+   lazy.batch(x, out, LAZY_TEST_LENGTH, lazy.accelerator);
+   printf(
+      "Linbuf of %zu samples constructed in %.3f ms; lazily in %.3f ms, "
+      "and prefetched in %.3f ms\n",
+      LAZY_TEST_SAMPLES,
+      1.e3 * eager_time,
+      1.e3 * lazy_time,
+      1.e3 * prefetch_time
+      );
+   lazy.disallocate(&lazy);
+   eager.disallocate(&eager);
+   free(out);
+   free(x);
+   return
+      (double) (counted_delegate_calls - prefetched_calls);
+}
+
 UnitTestResult
 test_varr_general_bound_linbuf(void)
 {
@@ -364,6 +644,74 @@ test_varr_general_bound_linbuf(void)
    combine_test_results(test_outcome, &result);
    }
    
+   srand(20u);
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 0.02;
+   double const
+      numerical_error = lazy_narrow_test();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr general bound linbuf (cos specialization)",
+         "Lazy evaluation of a hundredth of the domain (fraction filled)",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 0.5;
+   double const
+      numerical_error = lazy_concurrent_test();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr general bound linbuf (cos specialization)",
+         "Concurrent lazy evaluation fills each sample once",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 0.5;
+   double const
+      numerical_error = lazy_prefetch_test();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr general bound linbuf (cos specialization)",
+         "Prefetched lazy evaluation calls no delegate",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
    return
       result;
 }
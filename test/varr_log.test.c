@@ -108,7 +108,24 @@ logd_test(void)
       );
    logd_evaluator.disallocate(&logd_evaluator);
    
-   printf("Case 3: batch normalizing sampling log:\n");
+   printf("Case 3: batch quad series convergent:\n");
+   logd_evaluator = 
+      quad_series_logd(100u);
+   numerical_error = fmax(
+      numerical_error,
+      evaluate_batch_performanced(
+         1.e-3,
+         1.e+3,
+         50000000u,
+         1,
+         logd_machine_batch_evaluate,
+         logd_batch_evaluate,
+         1
+         )
+      ); 
+   logd_evaluator.disallocate(&logd_evaluator);
+   
+   printf("Case 4: batch normalizing sampling log:\n");
    logd_evaluator = 
       normalizing_linear_sampling_logd(100000u);
    numerical_error = fmax(
@@ -125,6 +142,23 @@ logd_test(void)
       ); 
    logd_evaluator.disallocate(&logd_evaluator);
    
+   printf("Case 5: batch normalizing sampling log, full domain:\n");
+   logd_evaluator = 
+      normalizing_linear_sampling_logd(100000u);
+   numerical_error = fmax(
+      numerical_error,
+      evaluate_batch_performanced(
+         1.e-300,
+         1.e+300,
+         50000000u,
+         1,
+         logd_machine_batch_evaluate,
+         logd_batch_evaluate,
+         1
+         )
+      ); 
+   logd_evaluator.disallocate(&logd_evaluator);
+   
    return
       numerical_error;
 }
@@ -136,7 +170,7 @@ sublinear_logd_test(void)
    double
       numerical_error = -1.;
 
-   printf("Case 4: batch sublinear sampling log:\n");
+   printf("Case 6: sublinear sampling log:\n");
    logd_evaluator = 
       normalizing_sublinear_sampling_logd(5000000u);
    numerical_error = fmax(
@@ -152,7 +186,7 @@ sublinear_logd_test(void)
       );
    logd_evaluator.disallocate(&logd_evaluator);
    
-   printf("Case 5: batch sublinear sampling log:\n");
+   printf("Case 7: batch sublinear sampling log:\n");
    logd_evaluator = 
       normalizing_sublinear_sampling_logd(5000000u);
    numerical_error = fmax(
@@ -173,6 +207,46 @@ sublinear_logd_test(void)
       numerical_error;
 }
 
+/*
+ * Returns the greatest difference (relative to the value, or absolute below
+ * unity) between the scalar and vector forms of quad_series_logd(N), for each
+ * N < 12, ie. of fewer terms than converge to double precision:
+ */
+static
+double
+quad_series_agreement_test(void)
+{
+   static double
+      x[4099u],
+      batch[4099u];
+   size_t const
+      length = sizeof(x) / sizeof(x[0u]);
+   double
+      numerical_error = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      x[i] = pow(10., -300. + 600. * (double) i / (double) (length - 1u));
+   }
+   for(size_t n = 1u; n< 12u; ++n)
+   {
+      VARRLogDEvaluator
+         evaluator = quad_series_logd(n);
+      evaluator.logd_array(x, batch, length, evaluator.accelerator);
+      for(size_t i = 0u; i< length; ++i)
+      {
+         double const
+            scalar = evaluator.logd(x[i], evaluator.accelerator);
+         numerical_error = fmax(
+            numerical_error,
+            fabs(batch[i] - scalar) / fmax(1., fabs(scalar))
+            );
+      }
+      evaluator.disallocate(&evaluator);
+   }
+   return
+      numerical_error;
+}
+
 UnitTestResult
 test_varr_log(void)
 {
@@ -217,6 +291,24 @@ test_varr_log(void)
    declare_end_of_unit_test();
    }
    
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 8. * DBL_EPSILON;
+   double const
+      numerical_error = quad_series_agreement_test();
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-log/natural-logarithm",
+      "Quad series scalar and batch agree for fewer than 12 terms",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
    return
       result;
 }
@@ -0,0 +1,544 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+#include "varr_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+
+#define OCTANT_TEST_LENGTH ((size_t) 4099u)
+#define OCTANT_TEST_SAMPLES ((size_t) 4096u)
+#define OCTANT_BENCHMARK_LENGTH ((size_t) 1u << 20)
+#define OCTANT_NUMBER_OF_CASES ((size_t) 3u)
+#define OCTANT_REPORT_SIZES ((size_t) 3u)
+
+static size_t const
+   octant_report_samples[OCTANT_REPORT_SIZES] = {
+      (size_t) 1u << 12, (size_t) 1u << 16, (size_t) 1u << 20
+   };
+
+/*
+ * Builds the full period (octant == 0) or octant evaluator of one of 
+ * sin, cos or the phasor, of number_of_samples samples in a table of 
+ * 'format', with the table cache disabled, and evaluates x by its batch 
+ * function (twice, the second time timed) and by its scalar function.  
+ * Assigns the bytes of its table, the seconds of the timed batch 
+ * evaluation, and the greatest difference between its batch and scalar 
+ * functions, and returns its greatest error:
+ */
+typedef double (* OctantRun) (
+   size_t number_of_samples,
+   int octant,
+   VARRTableFormat format,
+   double const * x,
+   size_t length,
+   size_t * bytes,
+   double * seconds,
+   double * discrepancy
+   );
+
+typedef struct tagOctantTestCase {
+   char const *
+      name,
+      * full_name;
+   OctantRun
+      run;
+   // The table bytes per sample per period, in full and octant tables:
+   size_t
+      full_bytes,
+      octant_bytes;
+} OctantTestCase;
+
+static
+size_t
+table_bytes(size_t before)
+{
+   return
+      varr_table_memory_statistics().bytes - before;
+}
+
+static
+double
+seconds_since(clock_t begin)
+{
+   return
+      (double) (clock() - begin) / CLOCKS_PER_SEC;
+}
+
+static
+double
+run_sind(
+   size_t number_of_samples,
+   int octant,
+   VARRTableFormat format,
+   double const * x,
+   size_t length,
+   size_t * bytes,
+   double * seconds,
+   double * discrepancy
+   )
+{
+   size_t const
+      before = varr_table_memory_statistics().bytes;
+   VARRSinDEvaluator
+      evaluator = octant ?
+         octant_sampling_sind_with_table_format(number_of_samples, format)
+         :
+         sampling_sind_with_table_format(number_of_samples, format);
+   double * const
+      out = (double *) malloc(sizeof(double) * length);
+   double
+      error = 0.;
+   *bytes = table_bytes(before);
+   evaluator.sind_array(x, out, length, evaluator.accelerator);
+   clock_t const
+      begin = clock();
+   evaluator.sind_array(x, out, length, evaluator.accelerator);
+   *seconds = seconds_since(begin);
+   *discrepancy = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      error = fmax(error, fabs(out[i] - sin(x[i])));
+      *discrepancy = fmax(
+         *discrepancy,
+         fabs(out[i] - evaluator.sind(x[i], evaluator.accelerator))
+         );
+   }
+   free(out);
+   evaluator.disallocate(&evaluator);
+   return
+      error;
+}
+
+static
+double
+run_cosd(
+   size_t number_of_samples,
+   int octant,
+   VARRTableFormat format,
+   double const * x,
+   size_t length,
+   size_t * bytes,
+   double * seconds,
+   double * discrepancy
+   )
+{
+   size_t const
+      before = varr_table_memory_statistics().bytes;
+   VARRCosDEvaluator
+      evaluator = octant ?
+         octant_sampling_cosd_with_table_format(number_of_samples, format)
+         :
+         sampling_cosd_with_table_format(number_of_samples, format);
+   double * const
+      out = (double *) malloc(sizeof(double) * length);
+   double
+      error = 0.;
+   *bytes = table_bytes(before);
+   evaluator.cosd_array(x, out, length, evaluator.accelerator);
+   clock_t const
+      begin = clock();
+   evaluator.cosd_array(x, out, length, evaluator.accelerator);
+   *seconds = seconds_since(begin);
+   *discrepancy = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      error = fmax(error, fabs(out[i] - cos(x[i])));
+      *discrepancy = fmax(
+         *discrepancy,
+         fabs(out[i] - evaluator.cosd(x[i], evaluator.accelerator))
+         );
+   }
+   free(out);
+   evaluator.disallocate(&evaluator);
+   return
+      error;
+}
+
+static
+double
+run_phasord(
+   size_t number_of_samples,
+   int octant,
+   VARRTableFormat format,
+   double const * x,
+   size_t length,
+   size_t * bytes,
+   double * seconds,
+   double * discrepancy
+   )
+{
+   size_t const
+      before = varr_table_memory_statistics().bytes;
+   VARRPhasorDEvaluator
+      evaluator = octant ?
+         octant_linear_interpolating_phasord_with_table_format(
+            number_of_samples, format
+            )
+         :
+         linear_interpolating_phasord_with_table_format(
+            number_of_samples, format
+            );
+   double complex * const
+      out = (double complex *) malloc(sizeof(double complex) * length);
+   double
+      error = 0.;
+   *bytes = table_bytes(before);
+   evaluator.phasord_array(x, out, length, evaluator.accelerator);
+   clock_t const
+      begin = clock();
+   evaluator.phasord_array(x, out, length, evaluator.accelerator);
+   *seconds = seconds_since(begin);
+   *discrepancy = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      double complex const
+         scalar = evaluator.phasord(x[i], evaluator.accelerator);
+      error = fmax(
+         error,
+         fmax(
+            fabs(creal(out[i]) - cos(x[i])),
+            fabs(cimag(out[i]) - sin(x[i]))
+            )
+         );
+      *discrepancy = fmax(
+         *discrepancy,
+         fmax(
+            fabs(creal(out[i]) - creal(scalar)),
+            fabs(cimag(out[i]) - cimag(scalar))
+            )
+         );
+   }
+   free(out);
+   evaluator.disallocate(&evaluator);
+   return
+      error;
+}
+
+static OctantTestCase const
+   octant_cases[OCTANT_NUMBER_OF_CASES] = {
+      {
+         "octant_sampling_sind", "sampling_sind", run_sind, 8u, 2u
+      },
+      {
+         "octant_sampling_cosd", "sampling_cosd", run_cosd, 8u, 2u
+      },
+      {
+         "octant_linear_interpolating_phasord",
+         "linear_interpolating_phasord",
+         run_phasord,
+         16u,
+         2u
+      }
+   };
+
+/*
+ * Assigns 'length' arguments in [lower, upper), the first of which are the
+ * multiples of pi/4 (the boundaries of the octants) in [-4 pi, 4 pi] that
+ * are in [lower, upper):
+ */
+static
+void
+octant_arguments(double * x, size_t length, double lower, double upper)
+{
+   size_t
+      i = 0u;
+   for(int k = -16; (k<= 16) && (i< length); ++k)
+   {
+      double const
+         boundary = 0.25 * M_PI * (double) k;
+      if((lower <= boundary) && (boundary < upper))
+      {
+         x[i++] = boundary;
+      }
+   }
+   for(; i< length; ++i)
+   {
+      x[i] = lower
+       + (upper - lower) * ((double) rand() / ((double) RAND_MAX + 1.));
+   }
+}
+
+/*
+ * Tests a case, with tables of 'format', for:
+ *
+ *    i.    the accuracy of the octant evaluator of OCTANT_TEST_SAMPLES, 
+ *          which is that of the full period evaluator of as many samples;
+ *    ii.   the accuracy of the octant evaluator in the memory of the full
+ *          period evaluator, which samples four (sin, cos) or eight 
+ *          (phasor) times more finely, and is at least eight times more 
+ *          accurate;
+ *    iii.  the size of the octant table, which is a quarter (sin, cos) or 
+ *          an eighth (phasor) of that of the full period table;
+ *    iv.   the agreement of the batch and scalar functions, over many 
+ *          periods.
+ */
+static
+void
+octant_case_test(
+   UnitTestResult * result,
+   OctantTestCase const * test_case,
+   VARRTableFormat format,
+   double const * x,
+   double const * wide_x
+   )
+{
+   size_t
+      full_bytes,
+      octant_bytes,
+      fine_bytes;
+   double
+      seconds,
+      discrepancy,
+      wide_discrepancy;
+   size_t const
+      refinement = test_case->full_bytes / test_case->octant_bytes;
+   double const
+      full_error = test_case->run(
+         OCTANT_TEST_SAMPLES,
+         0,
+         format,
+         x,
+         OCTANT_TEST_LENGTH,
+         &full_bytes,
+         &seconds,
+         &discrepancy
+         ),
+      octant_error = test_case->run(
+         OCTANT_TEST_SAMPLES,
+         1,
+         format,
+         x,
+         OCTANT_TEST_LENGTH,
+         &octant_bytes,
+         &seconds,
+         &discrepancy
+         ),
+      fine_error = test_case->run(
+         OCTANT_TEST_SAMPLES * refinement,
+         1,
+         format,
+         x,
+         OCTANT_TEST_LENGTH,
+         &fine_bytes,
+         &seconds,
+         &discrepancy
+         ),
+      wide_error = test_case->run(
+         OCTANT_TEST_SAMPLES,
+         1,
+         format,
+         wide_x,
+         OCTANT_TEST_LENGTH,
+         &octant_bytes,
+         &seconds,
+         &wide_discrepancy
+         );
+   char
+      name[192u];
+   printf(
+      "   %s (%s): %zu samples, %zu bytes, error %.3e; %s: %zu bytes, "
+      "error %.3e; %zu samples, %zu bytes, error %.3e\n",
+      test_case->name,
+      varr_table_layout_name(format.layout),
+      OCTANT_TEST_SAMPLES,
+      octant_bytes,
+      octant_error,
+      test_case->full_name,
+      full_bytes,
+      full_error,
+      OCTANT_TEST_SAMPLES * refinement,
+      fine_bytes,
+      fine_error
+      );
+   snprintf(
+      name,
+      sizeof(name),
+      "%s (%s) is as accurate as %s of as many samples",
+      test_case->name,
+      varr_table_layout_name(format.layout),
+      test_case->full_name
+      );
+   numerical_error_unit_test(
+      result, "varr-octant", name, octant_error / full_error, 1.05
+      );
+   snprintf(
+      name,
+      sizeof(name),
+      "%s (%s) is eight times as accurate as %s in equal memory",
+      test_case->name,
+      varr_table_layout_name(format.layout),
+      test_case->full_name
+      );
+   numerical_error_unit_test(
+      result, "varr-octant", name, 8. * fine_error / full_error, 1.
+      );
+   snprintf(
+      name,
+      sizeof(name),
+      "%s (%s) tables are %zu times smaller than those of %s",
+      test_case->name,
+      varr_table_layout_name(format.layout),
+      refinement,
+      test_case->full_name
+      );
+   numerical_error_unit_test(
+      result,
+      "varr-octant",
+      name,
+      fabs(
+         floor((double) full_bytes / (double) octant_bytes + 0.5)
+       - (double) refinement
+         ),
+      0.5
+      );
+   snprintf(
+      name,
+      sizeof(name),
+      "%s (%s) batch and scalar functions agree",
+      test_case->name,
+      varr_table_layout_name(format.layout)
+      );
+   numerical_error_unit_test(
+      result, "varr-octant", name, fmax(discrepancy, wide_discrepancy), 1.e-12
+      );
+   snprintf(
+      name,
+      sizeof(name),
+      "%s (%s) is accurate for |x| <= 1000",
+      test_case->name,
+      varr_table_layout_name(format.layout)
+      );
+   numerical_error_unit_test(
+      result, "varr-octant", name, wide_error, 1.1 * octant_error
+      );
+}
+
+/*
+ * Reports the table bytes, error and throughput of the octant and full 
+ * period evaluators of equal sampling steps (and so of equal accuracy), of
+ * random arguments in [0, 2 pi):
+ */
+static
+void
+octant_benchmark(void)
+{
+   VARRTableFormat const
+      values_format = {
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE
+      };
+   double * const
+      x = (double *) malloc(sizeof(double) * OCTANT_BENCHMARK_LENGTH);
+   octant_arguments(x, OCTANT_BENCHMARK_LENGTH, 0., 2. * M_PI);
+   printf(
+      "Octant and full period tables of equal step, %zu random "
+      "evaluations:\n",
+      OCTANT_BENCHMARK_LENGTH
+      );
+   for(size_t c = 0u; c< OCTANT_NUMBER_OF_CASES; ++c)
+   {
+      for(size_t s = 0u; s< OCTANT_REPORT_SIZES; ++s)
+      {
+         for(int octant = 0; octant<= 1; ++octant)
+         {
+            size_t
+               bytes;
+            double
+               seconds,
+               discrepancy;
+            double const
+               error = octant_cases[c].run(
+                  octant_report_samples[s],
+                  octant,
+                  values_format,
+                  x,
+                  OCTANT_BENCHMARK_LENGTH,
+                  &bytes,
+                  &seconds,
+                  &discrepancy
+                  );
+            printf(
+               "   %-36s %8zu samples %10zu bytes, error %.2e, %6.2f ns "
+               "per evaluation\n",
+               octant ? octant_cases[c].name : octant_cases[c].full_name,
+               octant_report_samples[s],
+               bytes,
+               error,
+               1.e9 * seconds / (double) OCTANT_BENCHMARK_LENGTH
+               );
+         }
+      }
+   }
+   free(x);
+}
+
+UnitTestResult
+test_varr_octant(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   double * const
+      x = (double *) malloc(sizeof(double) * OCTANT_TEST_LENGTH);
+   double * const
+      wide_x = (double *) malloc(sizeof(double) * OCTANT_TEST_LENGTH);
+   int const
+      cached = varr_table_cache_enabled();
+   
+   printf("Octant tests:\n");
+   declare_start_of_unit_test();
+   
+   srand(18u);
+   // The full period sampling_sind and sampling_cosd take 0 <= x < 2 pi:
+   octant_arguments(x, OCTANT_TEST_LENGTH, 0., 2. * M_PI);
+   octant_arguments(wide_x, OCTANT_TEST_LENGTH, -1000., 1000.);
+   varr_set_table_cache_enabled(0);
+   for(
+      int selected = (int) VARR_TABLE_VALUES;
+      selected<= (int) VARR_TABLE_INTERLEAVED;
+      ++selected
+      )
+   {
+      VARRTableFormat const
+         format = {
+            .layout = (VARRTableLayout) selected,
+            .precision = VARR_TABLE_DOUBLE
+         };
+      for(size_t c = 0u; c< OCTANT_NUMBER_OF_CASES; ++c)
+      {
+         octant_case_test(&result, octant_cases + c, format, x, wide_x);
+      }
+   }
+   
+   declare_end_of_unit_test();
+   octant_benchmark();
+   varr_set_table_cache_enabled(cached);
+   
+   free(wide_x);
+   free(x);
+   return
+      result;
+}
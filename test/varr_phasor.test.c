@@ -155,6 +155,50 @@ phasord_test_with_remainder_loop(void)
       numerical_error;
 }
 
+/*
+ * Evaluates the cubic spline phasor, with a table of a small fraction of the
+ * size of the above (to compare its performance with that of the linear 
+ * interpolating phasor):
+ */
+static
+double
+cubic_spline_phasord_test(void)
+{
+   phasord_evaluator =
+      cubic_spline_sampling_phasord(3000u);
+      
+   printf("Scalar evaluation:\n");
+   double
+      numerical_error = 
+         evaluate_performancedc(
+            -6.0 * M_PI,
+            6.0 * M_PI,
+            10000003u,
+            0,
+            phasord_machine_evaluate,
+            phasord_evaluate
+            );
+   
+   // batch evaluation:
+   printf("Vector evaluation:\n");
+   numerical_error = fmax(
+      numerical_error,
+         evaluate_batch_performancedc(
+            -6.0 * M_PI,
+            6.0 * M_PI,
+            10000003u,
+            0,
+            phasord_machine_batch_evaluate,
+            phasord_batch_evaluate
+            )
+         );
+   
+   phasord_evaluator.disallocate(&phasord_evaluator);
+   
+   return
+      numerical_error;
+}
+
 UnitTestResult
 test_varr_phasor(void)
 {
@@ -207,6 +251,28 @@ test_varr_phasor(void)
    combine_test_results(test_outcome, &result);
    }
    
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 1.01e-13;
+   double const
+      numerical_error = cubic_spline_phasord_test();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-phasor/phasor(phi) = exp(i*phi)",
+         "Cubic spline sampling evaluation (with remainder loop)",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
    return
       result;
 }
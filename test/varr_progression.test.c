@@ -0,0 +1,497 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+
+#define PROGRESSION_NUMBER_OF_LENGTHS ((size_t) 6u)
+#define PROGRESSION_TEST_LENGTH ((size_t) 100003u)
+#define PROGRESSION_BENCHMARK_LENGTH ((size_t) 1u << 22)
+#define PROGRESSION_BENCHMARK_SIZES ((size_t) 2u)
+
+static size_t const
+   progression_lengths[PROGRESSION_NUMBER_OF_LENGTHS] = {
+      // Partial and whole blocks (of 64), chunks (of 512) and batches of 
+      // anchors (of 64):
+      0u, 1u, 63u, 512u, 1025u, 100003u
+   },
+   progression_benchmark_lengths[PROGRESSION_BENCHMARK_SIZES] = {
+      (size_t) 1u << 12, PROGRESSION_BENCHMARK_LENGTH
+   };
+
+/*
+ * Returns the worst relative difference between varr_progression_batchd of
+ * the exponential and its batch function on the materialized progression, 
+ * over progression_lengths:
+ */
+static
+double
+batchd_test(void)
+{
+   static double
+      x[PROGRESSION_TEST_LENGTH],
+      out[PROGRESSION_TEST_LENGTH + 1u],
+      expected[PROGRESSION_TEST_LENGTH];
+   VARRExpDEvaluator
+      expd = shifting_linear_sampling_expd(100000u);
+   double const
+      x0 = -5.,
+      dx = 1.e-4;
+   double
+      worst = 0.;
+   for(size_t i = 0u; i< PROGRESSION_TEST_LENGTH; ++i)
+   {
+      x[i] = x0 + dx * (double) i;
+   }
+   expd.expd_array(x, expected, PROGRESSION_TEST_LENGTH, expd.accelerator);
+   for(size_t l = 0u; l< PROGRESSION_NUMBER_OF_LENGTHS; ++l)
+   {
+      size_t const
+         length = progression_lengths[l];
+      out[length] = -12345.;
+      varr_progression_batchd(
+         expd.expd_array, x0, dx, out, length, expd.accelerator
+         );
+      for(size_t i = 0u; i< length; ++i)
+      {
+         worst = fmax(worst, fabs(out[i] - expected[i]) / expected[i]);
+      }
+      if(out[length] != -12345.)
+      {
+         worst = INFINITY;
+      }
+   }
+   expd.disallocate(&expd);
+   return
+      worst;
+}
+
+/*
+ * As batchd_test, for varr_progression_batchf:
+ */
+static
+double
+batchf_test(void)
+{
+   static float
+      x[PROGRESSION_TEST_LENGTH],
+      out[PROGRESSION_TEST_LENGTH + 1u],
+      expected[PROGRESSION_TEST_LENGTH];
+   VARRExpFEvaluator
+      expf = linear_sampling_expf(4096u);
+   float const
+      x0 = -5.f,
+      dx = 1.e-4f;
+   double
+      worst = 0.;
+   for(size_t i = 0u; i< PROGRESSION_TEST_LENGTH; ++i)
+   {
+      x[i] = x0 + dx * (float) i;
+   }
+   expf.expf_array(x, expected, PROGRESSION_TEST_LENGTH, expf.accelerator);
+   for(size_t l = 0u; l< PROGRESSION_NUMBER_OF_LENGTHS; ++l)
+   {
+      size_t const
+         length = progression_lengths[l];
+      out[length] = -12345.f;
+      varr_progression_batchf(
+         expf.expf_array, x0, dx, out, length, expf.accelerator
+         );
+      for(size_t i = 0u; i< length; ++i)
+      {
+         worst = fmax(
+            worst,
+            fabs((double) out[i] - (double) expected[i]) / expected[i]
+            );
+      }
+      if(out[length] != -12345.f)
+      {
+         worst = INFINITY;
+      }
+   }
+   expf.disallocate(&expf);
+   return
+      worst;
+}
+
+/*
+ * Returns how much the worst relative error (against libm, in long double, 
+ * of the exact inputs) of varr_progression_expd exceeds that of the batch 
+ * function of the same evaluator on the materialized progression, over
+ * progression_lengths:
+ */
+static
+double
+expd_test(void)
+{
+   static double
+      x[PROGRESSION_TEST_LENGTH],
+      out[PROGRESSION_TEST_LENGTH + 1u],
+      batch_out[PROGRESSION_TEST_LENGTH];
+   VARRExpDEvaluator
+      expd = scaling_series_expd(256u);
+   double const
+      x0 = -5.,
+      dx = 1.e-4;
+   double
+      worst = -INFINITY;
+   for(size_t i = 0u; i< PROGRESSION_TEST_LENGTH; ++i)
+   {
+      x[i] = x0 + dx * (double) i;
+   }
+   expd.expd_array(x, batch_out, PROGRESSION_TEST_LENGTH, expd.accelerator);
+   for(size_t l = 0u; l< PROGRESSION_NUMBER_OF_LENGTHS; ++l)
+   {
+      size_t const
+         length = progression_lengths[l];
+      double
+         error = 0.,
+         batch_error = 0.;
+      out[length] = -12345.;
+      varr_progression_expd(
+         expd.expd_array, x0, dx, out, length, expd.accelerator
+         );
+      for(size_t i = 0u; i< length; ++i)
+      {
+         long double const
+            expected = expl(
+               (long double) x0 + (long double) dx * (long double) i
+               );
+         error = fmax(error, (double) fabsl((out[i] - expected) / expected));
+         batch_error = fmax(
+            batch_error, (double) fabsl((batch_out[i] - expected) / expected)
+            );
+      }
+      worst = fmax(worst, error - batch_error);
+      if(out[length] != -12345.)
+      {
+         worst = INFINITY;
+      }
+   }
+   printf(
+      "   Progression exponentials exceed the error of the batch by %e\n",
+      worst
+      );
+   expd.disallocate(&expd);
+   return
+      worst;
+}
+
+/*
+ * Returns the worst relative difference between varr_progression_expd and 
+ * the batch function on the materialized progression, for progressions 
+ * that leave the range of normal exponentials (the blocks of which are 
+ * evaluated by the batch function, to the bit), and of steps too large to 
+ * scale by:
+ */
+static
+double
+expd_range_test(void)
+{
+   static double const
+      x0s[3u] = { -720., 720., -1000. },
+      dxs[3u] = { 0.5, -0.5, 20. };
+   static double
+      x[PROGRESSION_TEST_LENGTH],
+      out[PROGRESSION_TEST_LENGTH],
+      expected[PROGRESSION_TEST_LENGTH];
+   size_t const
+      length = (size_t) 4001u;
+   VARRExpDEvaluator
+      expd = scaling_series_expd(256u);
+   double
+      worst = 0.;
+   for(size_t t = 0u; t< 3u; ++t)
+   {
+      for(size_t i = 0u; i< length; ++i)
+      {
+         x[i] = x0s[t] + dxs[t] * (double) i;
+      }
+      expd.expd_array(x, expected, length, expd.accelerator);
+      varr_progression_expd(
+         expd.expd_array, x0s[t], dxs[t], out, length, expd.accelerator
+         );
+      for(size_t i = 0u; i< length; ++i)
+      {
+         if(isnormal(expected[i]))
+         {
+            worst = fmax(worst, fabs(out[i] - expected[i]) / expected[i]);
+         }
+         else if(
+            (out[i] != expected[i]) && !(isnan(out[i]) && isnan(expected[i]))
+            )
+         {
+            worst = INFINITY;
+         }
+      }
+   }
+   expd.disallocate(&expd);
+   return
+      worst;
+}
+
+/*
+ * Returns how much the worst error (against libm, in long double, of the 
+ * exact phases) of varr_progression_phasord exceeds that of the batch
+ * function of the same evaluator on the materialized progression, over
+ * progression_lengths:
+ */
+static
+double
+phasord_test(void)
+{
+   static double
+      x[PROGRESSION_TEST_LENGTH];
+   static double complex
+      out[PROGRESSION_TEST_LENGTH + 1u],
+      batch_out[PROGRESSION_TEST_LENGTH];
+   VARRPhasorDEvaluator
+      phasord = linear_interpolating_phasord(1u << 20);
+   double const
+      x0 = -50.,
+      dx = 3.e-3;
+   double
+      worst = -INFINITY;
+   for(size_t i = 0u; i< PROGRESSION_TEST_LENGTH; ++i)
+   {
+      x[i] = x0 + dx * (double) i;
+   }
+   phasord.phasord_array(
+      x, batch_out, PROGRESSION_TEST_LENGTH, phasord.accelerator
+      );
+   for(size_t l = 0u; l< PROGRESSION_NUMBER_OF_LENGTHS; ++l)
+   {
+      size_t const
+         length = progression_lengths[l];
+      double
+         error = 0.,
+         batch_error = 0.;
+      out[length] = -12345.;
+      varr_progression_phasord(
+         phasord.phasord_array, x0, dx, out, length, phasord.accelerator
+         );
+      for(size_t i = 0u; i< length; ++i)
+      {
+         long double const
+            phi = (long double) x0 + (long double) dx * (long double) i,
+            re = cosl(phi),
+            im = sinl(phi);
+         error = fmax(
+            error,
+            (double) hypotl(creal(out[i]) - re, cimag(out[i]) - im)
+            );
+         batch_error = fmax(
+            batch_error,
+            (double) hypotl(creal(batch_out[i]) - re, cimag(batch_out[i]) - im)
+            );
+      }
+      worst = fmax(worst, error - batch_error);
+      if(out[length] != -12345.)
+      {
+         worst = INFINITY;
+      }
+   }
+   printf(
+      "   Progression phasors exceed the error of the batch by %e\n", worst
+      );
+   phasord.disallocate(&phasord);
+   return
+      worst;
+}
+
+/*
+ * Reports the time per element of the batch functions of the exponential 
+ * and the phasor on a materialized progression, against their progression
+ * entry points (the exponential's generic one, then its scaling one), for
+ * progressions that stay in cache and that do not (of 
+ * progression_benchmark_lengths, evaluated to a total of 
+ * PROGRESSION_BENCHMARK_LENGTH elements):
+ */
+static
+void
+progression_benchmark(void)
+{
+   double * const
+      x = (double *) malloc(sizeof(double) * PROGRESSION_BENCHMARK_LENGTH);
+   double * const
+      out = (double *) malloc(sizeof(double) * PROGRESSION_BENCHMARK_LENGTH);
+   double complex * const
+      phasors = (double complex *) malloc(
+         sizeof(double complex) * PROGRESSION_BENCHMARK_LENGTH
+         );
+   VARRExpDEvaluator
+      expd = shifting_linear_sampling_expd(100000u);
+   VARRPhasorDEvaluator
+      phasord = linear_interpolating_phasord(1u << 20);
+   double const
+      x0 = -5.,
+      dx = 1.e-6;
+   for(size_t i = 0u; i< PROGRESSION_BENCHMARK_LENGTH; ++i)
+   {
+      x[i] = x0 + dx * (double) i;
+   }
+   // The pages of the outputs are faulted in beforehand:
+   expd.expd_array(x, out, PROGRESSION_BENCHMARK_LENGTH, expd.accelerator);
+   phasord.phasord_array(
+      x, phasors, PROGRESSION_BENCHMARK_LENGTH, phasord.accelerator
+      );
+   printf(
+      "Progressions (ns per element, array versus progression):\n"
+      );
+   for(size_t l = 0u; l< PROGRESSION_BENCHMARK_SIZES; ++l)
+   {
+      size_t const
+         length = progression_benchmark_lengths[l],
+         repetitions = PROGRESSION_BENCHMARK_LENGTH / length;
+      double
+         elapsed[5u] = { HUGE_VAL, HUGE_VAL, HUGE_VAL, HUGE_VAL, HUGE_VAL };
+      // The best of three:
+      for(size_t r = 0u; r< 3u; ++r)
+      {
+         double
+            begin = seconds_now();
+         for(size_t k = 0u; k< repetitions; ++k)
+         {
+            expd.expd_array(x, out, length, expd.accelerator);
+         }
+         elapsed[2u] = fmin(elapsed[2u], seconds_now() - begin);
+         begin = seconds_now();
+         for(size_t k = 0u; k< repetitions; ++k)
+         {
+            varr_progression_batchd(
+               expd.expd_array, x0, dx, out, length, expd.accelerator
+               );
+         }
+         elapsed[3u] = fmin(elapsed[3u], seconds_now() - begin);
+         begin = seconds_now();
+         for(size_t k = 0u; k< repetitions; ++k)
+         {
+            varr_progression_expd(
+               expd.expd_array, x0, dx, out, length, expd.accelerator
+               );
+         }
+         elapsed[4u] = fmin(elapsed[4u], seconds_now() - begin);
+         begin = seconds_now();
+         for(size_t k = 0u; k< repetitions; ++k)
+         {
+            phasord.phasord_array(x, phasors, length, phasord.accelerator);
+         }
+         elapsed[0u] = fmin(elapsed[0u], seconds_now() - begin);
+         begin = seconds_now();
+         for(size_t k = 0u; k< repetitions; ++k)
+         {
+            varr_progression_phasord(
+               phasord.phasord_array,
+               x0,
+               dx,
+               phasors,
+               length,
+               phasord.accelerator
+               );
+         }
+         elapsed[1u] = fmin(elapsed[1u], seconds_now() - begin);
+      }
+      for(size_t i = 0u; i< 5u; ++i)
+      {
+         elapsed[i] *= 1.e9 / (double) (repetitions * length);
+      }
+      printf(
+         "   shifting_linear_sampling_expd (%8zu):  %6.3f  %6.3f (%4.2fx)"
+         "  %6.3f (%4.2fx)\n",
+         length,
+         elapsed[2u],
+         elapsed[3u],
+         elapsed[2u] / elapsed[3u],
+         elapsed[4u],
+         elapsed[2u] / elapsed[4u]
+         );
+      printf(
+         "   linear_interpolating_phasord  (%8zu):  %6.3f  %6.3f (%4.2fx)\n",
+         length,
+         elapsed[0u],
+         elapsed[1u],
+         elapsed[0u] / elapsed[1u]
+         );
+   }
+   phasord.disallocate(&phasord);
+   expd.disallocate(&expd);
+   free(phasors);
+   free(out);
+   free(x);
+}
+
+UnitTestResult
+test_varr_progression(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   
+   printf("Arithmetic progression tests:\n");
+   declare_start_of_unit_test();
+   numerical_error_unit_test(
+      &result,
+      "varr-progression",
+      "Progression batches (double) match batches of the progression",
+      batchd_test(),
+      1.e-14
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-progression",
+      "Progression batches (float) match batches of the progression",
+      batchf_test(),
+      2.e-6
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-progression",
+      "Progression exponentials are as accurate as batches of the "
+      "progression",
+      expd_test(),
+      1.e-15
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-progression",
+      "Progression exponentials agree with batches of the progression "
+      "beyond the normal range, and for large steps",
+      expd_range_test(),
+      1.e-12
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-progression",
+      "Progression phasors are as accurate as batches of the progression",
+      phasord_test(),
+      1.e-13
+      );
+   declare_end_of_unit_test();
+   progression_benchmark();
+   
+   return
+      result;
+}
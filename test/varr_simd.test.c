@@ -0,0 +1,899 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <float.h>
+#include <time.h>
+
+#define SIMD_TEST_MAXIMUM_LENGTH ((size_t) 1027u)
+#define SIMD_BENCHMARK_LENGTH ((size_t) 1024u)
+#define SIMD_BENCHMARK_REPETITIONS ((size_t) 20000u)
+#define SIMD_BENCHMARK_ELEMENTS \
+   (SIMD_BENCHMARK_LENGTH * SIMD_BENCHMARK_REPETITIONS)
+
+static size_t const
+   simd_test_lengths[] = {
+      // Every tail length of the AVX2 and AVX-512 strides:
+      0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 12u, 13u, 14u, 15u,
+      16u, 17u, 1027u
+   };
+
+typedef void (* BatchFunction) (double const *, double *, size_t, void const *);
+
+typedef double (* ScalarFunction) (double, void const *);
+
+/*
+ * A real-valued batch function subject to run-time SIMD dispatch, together
+ * with the scalar function of the same evaluator, and an input range:
+ */
+typedef struct tagSimdTestCase {
+   char const *
+      name;
+   BatchFunction
+      batch;
+   ScalarFunction
+      scalar;
+   void const *
+      accelerator;
+   double
+      lower,
+      upper;
+   int
+      log_sampling;
+} SimdTestCase;
+
+static
+VARRExpDEvaluator
+   exp_evaluator,
+   scaling_exp_evaluator;
+
+static
+VARRLogDEvaluator
+   log_evaluator,
+   sublinear_log_evaluator,
+   quad_series_log_evaluator;
+
+static
+VARRSixthRootDEvaluator
+   sixth_root_evaluator,
+   sublinear_sixth_root_evaluator;
+
+static
+VARR3Over4DEvaluator
+   threequarters_evaluator;
+
+static
+VARRAtanDEvaluator
+   atan_evaluator;
+
+static
+VARRSinDEvaluator
+   sin_evaluator,
+   cubic_sin_evaluator;
+
+static
+VARRCosDEvaluator
+   cos_evaluator,
+   cubic_cos_evaluator;
+
+static
+VARRSinCosDEvaluator
+   sincos_evaluator,
+   cubic_sincos_evaluator;
+
+static
+VARRPhasorDEvaluator
+   phasor_evaluator,
+   cubic_phasor_evaluator;
+
+static
+VARRBoundGLBAccelerator
+   linbuf;
+
+/*
+ * The table format of the plain constructors:
+ */
+static
+VARRTableFormat const
+   default_table_format = {
+      .layout = VARR_TABLE_VALUES,
+      .precision = VARR_TABLE_DOUBLE
+   };
+
+/*
+ * Constructs all evaluators (and thus selects their batch functions) for
+ * the current varr_simd_level(), with tables in 'format' where they have a
+ * choice of format, and lists the real-valued ones in 'cases'.  Returns the
+ * number of cases.
+ */
+static
+size_t
+construct_evaluators(SimdTestCase * cases, VARRTableFormat format)
+{
+   exp_evaluator = 
+      shifting_linear_sampling_expd_with_table_format(100000u, format);
+   scaling_exp_evaluator = scaling_series_expd(256u);
+   log_evaluator = 
+      normalizing_linear_sampling_logd_with_table_format(100000u, format);
+   sublinear_log_evaluator = normalizing_sublinear_sampling_logd(100000u);
+   quad_series_log_evaluator = quad_series_logd(100u);
+   sixth_root_evaluator = 
+      linear_sampling_normalizing_sixth_rootd_with_table_format(
+         100000u, format
+         );
+   sublinear_sixth_root_evaluator =
+      sublinear_sampling_normalizing_sixth_rootd(100000u);
+   threequarters_evaluator = 
+      linear_sampling_normalizing_3over4d_with_table_format(100000u, format);
+   atan_evaluator = 
+      clamping_linear_interpolating_atand_with_table_format(100000u, format);
+   sin_evaluator = sampling_sind_with_table_format(100000u, format);
+   cubic_sin_evaluator = cubic_spline_sampling_sind(1000u);
+   cos_evaluator = sampling_cosd_with_table_format(100000u, format);
+   cubic_cos_evaluator = cubic_spline_sampling_cosd(1000u);
+   sincos_evaluator = sampling_sincosd_with_table_format(100000u, format);
+   cubic_sincos_evaluator = cubic_spline_sampling_sincosd(1000u);
+   phasor_evaluator = 
+      linear_interpolating_phasord_with_table_format(100000u, format);
+   cubic_phasor_evaluator = cubic_spline_sampling_phasord(1000u);
+   linbuf = bound_general_linbuf_with_table_format(
+      100000u, -1., 10., cos_delegate, NULL, format
+      );
+   
+   SimdTestCase const
+      all_cases[] = {
+         {
+            "expd_array",
+            exp_evaluator.expd_array,
+            exp_evaluator.expd,
+            exp_evaluator.accelerator,
+            -700., 700., 0
+         },
+         {
+            "expd_array (scaling series)",
+            scaling_exp_evaluator.expd_array,
+            scaling_exp_evaluator.expd,
+            scaling_exp_evaluator.accelerator,
+            -700., 700., 0
+         },
+         {
+            "logd_array (linear)",
+            log_evaluator.logd_array,
+            log_evaluator.logd,
+            log_evaluator.accelerator,
+            1.e-300, 1.e300, 1
+         },
+         {
+            "logd_array (sublinear)",
+            sublinear_log_evaluator.logd_array,
+            sublinear_log_evaluator.logd,
+            sublinear_log_evaluator.accelerator,
+            1.e-300, 1.e300, 1
+         },
+         {
+            "logd_array (quad series)",
+            quad_series_log_evaluator.logd_array,
+            quad_series_log_evaluator.logd,
+            quad_series_log_evaluator.accelerator,
+            1.e-4, 1.e4, 1
+         },
+         {
+            "sixthrootd_array (linear)",
+            sixth_root_evaluator.sixthrootd_array,
+            sixth_root_evaluator.sixthrootd,
+            sixth_root_evaluator.accelerator,
+            1.e-300, 1.e300, 1
+         },
+         {
+            "sixthrootd_array (sublinear)",
+            sublinear_sixth_root_evaluator.sixthrootd_array,
+            sublinear_sixth_root_evaluator.sixthrootd,
+            sublinear_sixth_root_evaluator.accelerator,
+            1.e-300, 1.e300, 1
+         },
+         {
+            "threequartersd_array",
+            threequarters_evaluator.threequartersd_array,
+            threequarters_evaluator.threequartersd,
+            threequarters_evaluator.accelerator,
+            1.e-300, 1.e300, 1
+         },
+         {
+            "atan_array",
+            atan_evaluator.atan_array,
+            atan_evaluator.atan,
+            atan_evaluator.accelerator,
+            -60., 60., 0
+         },
+         {
+            "sind_array",
+            sin_evaluator.sind_array,
+            sin_evaluator.sind,
+            sin_evaluator.accelerator,
+            -1., 7.5, 0
+         },
+         {
+            "sind_array (cubic spline)",
+            cubic_sin_evaluator.sind_array,
+            cubic_sin_evaluator.sind,
+            cubic_sin_evaluator.accelerator,
+            -1., 7.5, 0
+         },
+         {
+            "cosd_array",
+            cos_evaluator.cosd_array,
+            cos_evaluator.cosd,
+            cos_evaluator.accelerator,
+            -1., 7.5, 0
+         },
+         {
+            "cosd_array (cubic spline)",
+            cubic_cos_evaluator.cosd_array,
+            cubic_cos_evaluator.cosd,
+            cubic_cos_evaluator.accelerator,
+            -1., 7.5, 0
+         },
+         {
+            "bound_general_linbuf batch",
+            linbuf.batch,
+            linbuf.scalar,
+            linbuf.accelerator,
+            -2., 11., 0
+         }
+      };
+   size_t const
+      number_of_cases = sizeof(all_cases) / sizeof(all_cases[0u]);
+   for(size_t i = 0u; i< number_of_cases; ++i)
+   {
+      cases[i] = all_cases[i];
+   }
+   return
+      number_of_cases;
+}
+
+static
+void
+release_evaluators(void)
+{
+   exp_evaluator.disallocate(&exp_evaluator);
+   scaling_exp_evaluator.disallocate(&scaling_exp_evaluator);
+   log_evaluator.disallocate(&log_evaluator);
+   sublinear_log_evaluator.disallocate(&sublinear_log_evaluator);
+   quad_series_log_evaluator.disallocate(&quad_series_log_evaluator);
+   sixth_root_evaluator.disallocate(&sixth_root_evaluator);
+   sublinear_sixth_root_evaluator.disallocate(
+      &sublinear_sixth_root_evaluator
+      );
+   threequarters_evaluator.disallocate(&threequarters_evaluator);
+   atan_evaluator.disallocate(&atan_evaluator);
+   sin_evaluator.disallocate(&sin_evaluator);
+   cubic_sin_evaluator.disallocate(&cubic_sin_evaluator);
+   cos_evaluator.disallocate(&cos_evaluator);
+   cubic_cos_evaluator.disallocate(&cubic_cos_evaluator);
+   sincos_evaluator.disallocate(&sincos_evaluator);
+   cubic_sincos_evaluator.disallocate(&cubic_sincos_evaluator);
+   phasor_evaluator.disallocate(&phasor_evaluator);
+   cubic_phasor_evaluator.disallocate(&cubic_phasor_evaluator);
+   linbuf.disallocate(&linbuf);
+}
+
+static
+double
+relative_difference(double observed, double expected)
+{
+   register double const
+      scale = (fabs(expected) > 1.) ? fabs(expected) : 1.;
+   return
+      fabs(observed - expected) / scale;
+}
+
+static
+void
+fill_inputs(
+   double * restrict x,
+   size_t length,
+   double lower,
+   double upper,
+   int log_sampling
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+   {
+      // A multiplicative congruence scatters the samples over the range:
+      double const
+         t = (double) ((i * 7919u) % length) / (double) (length - 1u);
+      x[i] = log_sampling ?
+         exp(log(lower) + t * (log(upper) - log(lower)))
+         :
+         lower + t * (upper - lower);
+   }
+}
+
+/*
+ * Compares a batch function against the scalar function of the same
+ * evaluator, for each of simd_test_lengths, and returns the worst
+ * difference.  Output values past the requested length must not be written.
+ */
+static
+double
+compare_batch_to_scalar(SimdTestCase const * test_case)
+{
+   static double
+      x[SIMD_TEST_MAXIMUM_LENGTH],
+      out[SIMD_TEST_MAXIMUM_LENGTH + 1u];
+   double
+      worst = 0.;
+   fill_inputs(
+      x,
+      SIMD_TEST_MAXIMUM_LENGTH,
+      test_case->lower,
+      test_case->upper,
+      test_case->log_sampling
+      );
+   for(
+      size_t k = 0u;
+      k< sizeof(simd_test_lengths) / sizeof(simd_test_lengths[0u]);
+      ++k
+      )
+   {
+      size_t const
+         length = simd_test_lengths[k];
+      out[length] = -12345.;
+      test_case->batch(x, out, length, test_case->accelerator);
+      for(size_t i = 0u; i< length; ++i)
+      {
+         double const
+            difference = relative_difference(
+               out[i],
+               test_case->scalar(x[i], test_case->accelerator)
+               );
+         worst = (difference > worst) ? difference : worst;
+      }
+      if(out[length] != -12345.)
+      {
+         worst = INFINITY;
+      }
+   }
+   return
+      worst;
+}
+
+static
+double
+compare_phasor_batch_to_scalar(VARRPhasorDEvaluator const * evaluator)
+{
+   static double
+      x[SIMD_TEST_MAXIMUM_LENGTH];
+   static double complex
+      out[SIMD_TEST_MAXIMUM_LENGTH];
+   double
+      worst = 0.;
+   fill_inputs(x, SIMD_TEST_MAXIMUM_LENGTH, -100., 100., 0);
+   for(
+      size_t k = 0u;
+      k< sizeof(simd_test_lengths) / sizeof(simd_test_lengths[0u]);
+      ++k
+      )
+   {
+      size_t const
+         length = simd_test_lengths[k];
+      evaluator->phasord_array(x, out, length, evaluator->accelerator);
+      for(size_t i = 0u; i< length; ++i)
+      {
+         double const
+            difference = cabs(
+               out[i] - evaluator->phasord(x[i], evaluator->accelerator)
+               );
+         worst = (difference > worst) ? difference : worst;
+      }
+   }
+   return
+      worst;
+}
+
+static
+double
+compare_sincos_batch_to_scalar(VARRSinCosDEvaluator const * evaluator)
+{
+   static double
+      x[SIMD_TEST_MAXIMUM_LENGTH],
+      sin_out[SIMD_TEST_MAXIMUM_LENGTH + 1u],
+      cos_out[SIMD_TEST_MAXIMUM_LENGTH + 1u];
+   double
+      worst = 0.,
+      sin_x,
+      cos_x;
+   fill_inputs(x, SIMD_TEST_MAXIMUM_LENGTH, -100., 100., 0);
+   for(
+      size_t k = 0u;
+      k< sizeof(simd_test_lengths) / sizeof(simd_test_lengths[0u]);
+      ++k
+      )
+   {
+      size_t const
+         length = simd_test_lengths[k];
+      sin_out[length] = -12345.;
+      cos_out[length] = -12345.;
+      evaluator->sincosd_array(
+         x, sin_out, cos_out, length, evaluator->accelerator
+         );
+      for(size_t i = 0u; i< length; ++i)
+      {
+         evaluator->sincosd(x[i], &sin_x, &cos_x, evaluator->accelerator);
+         worst = fmax(worst, fabs(sin_out[i] - sin_x));
+         worst = fmax(worst, fabs(cos_out[i] - cos_x));
+      }
+      if((sin_out[length] != -12345.) || (cos_out[length] != -12345.))
+      {
+         worst = INFINITY;
+      }
+   }
+   return
+      worst;
+}
+
+/*
+ * Returns the worst difference between batch and scalar evaluation over all
+ * batch functions that are subject to run-time SIMD dispatch, as selected
+ * for the current varr_simd_level(), with tables in 'format'.
+ */
+static
+double
+simd_level_test(VARRTableFormat format)
+{
+   SimdTestCase
+      cases[16u];
+   size_t const
+      number_of_cases = construct_evaluators(cases, format);
+   double
+      worst = 0.,
+      difference;
+   for(size_t i = 0u; i< number_of_cases; ++i)
+   {
+      difference = compare_batch_to_scalar(cases + i);
+      printf("   %s: %e\n", cases[i].name, difference);
+      worst = fmax(worst, difference);
+   }
+   difference = compare_phasor_batch_to_scalar(&phasor_evaluator);
+   printf("   phasord_array: %e\n", difference);
+   worst = fmax(worst, difference);
+   difference = compare_phasor_batch_to_scalar(&cubic_phasor_evaluator);
+   printf("   phasord_array (cubic spline): %e\n", difference);
+   worst = fmax(worst, difference);
+   difference = compare_sincos_batch_to_scalar(&sincos_evaluator);
+   printf("   sincosd_array: %e\n", difference);
+   worst = fmax(worst, difference);
+   difference = compare_sincos_batch_to_scalar(&cubic_sincos_evaluator);
+   printf("   sincosd_array (cubic spline): %e\n", difference);
+   worst = fmax(worst, difference);
+   release_evaluators();
+   return
+      worst;
+}
+
+/*
+ * Reports the throughput of every batch function at every supported SIMD
+ * level, for batches of SIMD_BENCHMARK_LENGTH (cache resident) elements:
+ */
+static
+void
+simd_benchmark(VARRSimdLevel supported_level)
+{
+   static double
+      x[SIMD_BENCHMARK_LENGTH],
+      out[SIMD_BENCHMARK_LENGTH];
+   static double complex
+      out_complex[SIMD_BENCHMARK_LENGTH];
+   SimdTestCase
+      cases[16u];
+   double
+      timings[3u][17u];
+   size_t
+      number_of_cases = 0u;
+   
+   for(
+      int level = (int) VARR_SIMD_SCALAR;
+      level <= (int) supported_level;
+      ++level
+      )
+   {
+      varr_set_simd_level((VARRSimdLevel) level);
+      number_of_cases = construct_evaluators(cases, default_table_format);
+      for(size_t i = 0u; i< number_of_cases; ++i)
+      {
+         fill_inputs(
+            x,
+            SIMD_BENCHMARK_LENGTH,
+            cases[i].lower,
+            cases[i].upper,
+            cases[i].log_sampling
+            );
+         clock_t const
+            begin = clock();
+         for(size_t r = 0u; r< SIMD_BENCHMARK_REPETITIONS; ++r)
+         {
+            cases[i].batch(
+               x, out, SIMD_BENCHMARK_LENGTH, cases[i].accelerator
+               );
+         }
+         timings[level][i] =
+            timing_in_nanoseconds_per_element(
+               begin, clock(), SIMD_BENCHMARK_ELEMENTS
+               );
+      }
+      VARRPhasorDEvaluator const * const
+         phasor_cases[2u] = { &phasor_evaluator, &cubic_phasor_evaluator };
+      fill_inputs(x, SIMD_BENCHMARK_LENGTH, -100., 100., 0);
+      for(size_t i = 0u; i< 2u; ++i)
+      {
+         clock_t const
+            begin = clock();
+         for(size_t r = 0u; r< SIMD_BENCHMARK_REPETITIONS; ++r)
+         {
+            phasor_cases[i]->phasord_array(
+               x,
+               out_complex,
+               SIMD_BENCHMARK_LENGTH,
+               phasor_cases[i]->accelerator
+               );
+         }
+         timings[level][number_of_cases + i] =
+            timing_in_nanoseconds_per_element(
+               begin, clock(), SIMD_BENCHMARK_ELEMENTS
+               );
+      }
+      cases[number_of_cases].name = "phasord_array";
+      cases[number_of_cases + 1u].name = "phasord_array (cubic spline)";
+      release_evaluators();
+   }
+   
+   printf("Batch throughput (ns per element, speedup over scalar):\n");
+   for(size_t i = 0u; i< number_of_cases + 2u; ++i)
+   {
+      printf("   %-30s", cases[i].name);
+      for(
+         int level = (int) VARR_SIMD_SCALAR;
+         level <= (int) supported_level;
+         ++level
+         )
+      {
+         printf(
+            " %s: %6.3f (%4.2fx)",
+            varr_simd_level_name((VARRSimdLevel) level),
+            timings[level][i],
+            timings[VARR_SIMD_SCALAR][i] / timings[level][i]
+            );
+      }
+      printf("\n");
+   }
+}
+
+/*
+ * A batch function together with a sorted grid on [lower, upper], which is
+ * dense in its table (so that the strides of the batch lie within windows of
+ * the table, and are interpolated from contiguous loads), and crosses a 
+ * boundary of its argument reduction:
+ */
+typedef struct tagSortedTestCase {
+   char const *
+      name;
+   BatchFunction
+      batch;
+   void const *
+      accelerator;
+   double
+      lower,
+      upper;
+} SortedTestCase;
+
+/*
+ * Constructs all evaluators for the current varr_simd_level(), and lists
+ * the sorted grid cases in 'cases'.  Returns the number of cases.
+ */
+static
+size_t
+construct_sorted_cases(SortedTestCase * cases)
+{
+   SimdTestCase
+      simd_cases[16u];
+   construct_evaluators(simd_cases, default_table_format);
+   SortedTestCase const
+      all_cases[] = {
+         {
+            "expd_array",
+            exp_evaluator.expd_array,
+            exp_evaluator.accelerator,
+            0.995, 1.005
+         },
+         {
+            "logd_array (linear)",
+            log_evaluator.logd_array,
+            log_evaluator.accelerator,
+            1.41, 1.418
+         },
+         {
+            "sixthrootd_array (linear)",
+            sixth_root_evaluator.sixthrootd_array,
+            sixth_root_evaluator.accelerator,
+            1.995, 2.005
+         },
+         {
+            "bound_general_linbuf batch",
+            linbuf.batch,
+            linbuf.accelerator,
+            2., 2.1
+         }
+      };
+   size_t const
+      number_of_cases = sizeof(all_cases) / sizeof(all_cases[0u]);
+   for(size_t i = 0u; i< number_of_cases; ++i)
+   {
+      cases[i] = all_cases[i];
+   }
+   return
+      number_of_cases;
+}
+
+/*
+ * Fills x with the sorted grid of a case, and scattered with the same grid
+ * in the order of fill_inputs, scattered[i] = x[(i * 7919) % length]:
+ */
+static
+void
+fill_sorted_inputs(
+   double * restrict x,
+   double * restrict scattered,
+   size_t length,
+   SortedTestCase const * test_case
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+   {
+      x[i] = test_case->lower
+       + (test_case->upper - test_case->lower)
+       * ((double) i / (double) (length - 1u));
+   }
+   for(size_t i = 0u; i< length; ++i)
+   {
+      scattered[i] = x[(i * 7919u) % length];
+   }
+}
+
+/*
+ * Returns the worst difference between the batch evaluation of sorted grids
+ * and of the same inputs scattered (ie. by gathers) over all sorted cases,
+ * for the current varr_simd_level(), which must be zero.
+ */
+static
+double
+sorted_level_test(void)
+{
+   static double
+      x[SIMD_BENCHMARK_LENGTH],
+      scattered[SIMD_BENCHMARK_LENGTH],
+      out[SIMD_BENCHMARK_LENGTH],
+      scattered_out[SIMD_BENCHMARK_LENGTH];
+   SortedTestCase
+      cases[8u];
+   size_t const
+      number_of_cases = construct_sorted_cases(cases),
+      length = SIMD_BENCHMARK_LENGTH;
+   double
+      worst = 0.;
+   for(size_t i = 0u; i< number_of_cases; ++i)
+   {
+      double
+         difference = 0.;
+      fill_sorted_inputs(x, scattered, length, cases + i);
+      cases[i].batch(x, out, length, cases[i].accelerator);
+      cases[i].batch(scattered, scattered_out, length, cases[i].accelerator);
+      for(size_t j = 0u; j< length; ++j)
+      {
+         difference = fmax(
+            difference,
+            fabs(scattered_out[j] - out[(j * 7919u) % length])
+            );
+      }
+      printf("   %s (sorted): %e\n", cases[i].name, difference);
+      worst = fmax(worst, difference);
+   }
+   release_evaluators();
+   return
+      worst;
+}
+
+/*
+ * Reports the throughput of the batch functions of the sorted cases on 
+ * their sorted grids, and on the same inputs scattered, at the supported 
+ * SIMD level:
+ */
+static
+void
+sorted_benchmark(VARRSimdLevel supported_level)
+{
+   static double
+      x[SIMD_BENCHMARK_LENGTH],
+      scattered[SIMD_BENCHMARK_LENGTH],
+      out[SIMD_BENCHMARK_LENGTH];
+   SortedTestCase
+      cases[8u];
+   varr_set_simd_level(supported_level);
+   size_t const
+      number_of_cases = construct_sorted_cases(cases);
+   printf(
+      "Sorted versus scattered batch throughput at SIMD level %s "
+      "(ns per element):\n",
+      varr_simd_level_name(supported_level)
+      );
+   for(size_t i = 0u; i< number_of_cases; ++i)
+   {
+      double
+         timings[2u];
+      fill_sorted_inputs(x, scattered, SIMD_BENCHMARK_LENGTH, cases + i);
+      for(size_t k = 0u; k< 2u; ++k)
+      {
+         double const * const
+            in = (k == 0u) ? x : scattered;
+         clock_t const
+            begin = clock();
+         for(size_t r = 0u; r< SIMD_BENCHMARK_REPETITIONS; ++r)
+         {
+            cases[i].batch(
+               in, out, SIMD_BENCHMARK_LENGTH, cases[i].accelerator
+               );
+         }
+         timings[k] =
+            timing_in_nanoseconds_per_element(
+               begin, clock(), SIMD_BENCHMARK_ELEMENTS
+               );
+      }
+      printf(
+         "   %-30s sorted: %6.3f scattered: %6.3f (%4.2fx)\n",
+         cases[i].name,
+         timings[0u],
+         timings[1u],
+         timings[1u] / timings[0u]
+         );
+   }
+   release_evaluators();
+}
+
+UnitTestResult
+test_varr_simd(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   VARRSimdLevel const
+      supported_level = varr_simd_supported_level();
+   
+   printf(
+      "SIMD dispatch tests (supported level: %s):\n",
+      varr_simd_level_name(supported_level)
+      );
+   for(
+      int level = (int) VARR_SIMD_SCALAR;
+      level <= (int) supported_level;
+      ++level
+      )
+   for(
+      int layout = (int) VARR_TABLE_VALUES;
+      layout <= (int) VARR_TABLE_INTERLEAVED;
+      ++layout
+      )
+   for(
+      int precision = (int) VARR_TABLE_DOUBLE;
+      precision <= (int) VARR_TABLE_FLOAT_CORRECTED;
+      ++precision
+      )
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 1.e-12;
+   char
+      unit_test_name[96];
+   VARRSimdLevel const
+      selected_level = varr_set_simd_level((VARRSimdLevel) level);
+   VARRTableFormat const
+      format = {
+         .layout = (VARRTableLayout) layout,
+         .precision = (VARRTablePrecision) precision
+      };
+   printf("Batch functions at SIMD level %s (%s, %s tables):\n",
+      varr_simd_level_name(selected_level),
+      varr_table_precision_name(format.precision),
+      varr_table_layout_name(format.layout)
+      );
+   snprintf(
+      unit_test_name,
+      sizeof(unit_test_name),
+      "Batch versus scalar evaluation (%s, %s, %s)",
+      varr_simd_level_name(selected_level),
+      varr_table_precision_name(format.precision),
+      varr_table_layout_name(format.layout)
+      );
+   double const
+      numerical_error = 
+         (selected_level == (VARRSimdLevel) level) ?
+            simd_level_test(format)
+            :
+            INFINITY;
+   numerical_error_unit_test(
+      &result,
+      "varr-simd/dispatch",
+      unit_test_name,
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   for(
+      int level = (int) VARR_SIMD_SCALAR;
+      level <= (int) supported_level;
+      ++level
+      )
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = DBL_MIN;
+   char
+      unit_test_name[96];
+   VARRSimdLevel const
+      selected_level = varr_set_simd_level((VARRSimdLevel) level);
+   printf(
+      "Sorted batches at SIMD level %s:\n",
+      varr_simd_level_name(selected_level)
+      );
+   snprintf(
+      unit_test_name,
+      sizeof(unit_test_name),
+      "Sorted versus scattered batch evaluation (%s)",
+      varr_simd_level_name(selected_level)
+      );
+   double const
+      numerical_error = 
+         (selected_level == (VARRSimdLevel) level) ?
+            sorted_level_test()
+            :
+            INFINITY;
+   numerical_error_unit_test(
+      &result,
+      "varr-simd/sorted",
+      unit_test_name,
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   simd_benchmark(supported_level);
+   sorted_benchmark(supported_level);
+   varr_set_simd_level(VARR_SIMD_AVX512);
+   
+   return
+      result;
+}
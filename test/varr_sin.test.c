@@ -22,12 +22,18 @@
 #include "varr_internal.h"
 #include "timings.h"
 
+#include "varr_cos.h"
 #include "varr_sin.h"
 
+#include <float.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 
+#define CUBIC_TEST_LENGTH ((size_t) 100003u)
+#define CUBIC_NUMBER_OF_THREADS ((size_t) 4u)
+
 static
 VARRSinDEvaluator
    sind_evaluator;
@@ -40,6 +46,36 @@ sind_evaluate(double x)
       sind_evaluator.sind(x, sind_evaluator.accelerator);
 }
 
+static
+void
+sind_machine_batch_evaluate(
+   double const * in,
+   double * out,
+   size_t length
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+      out[i] = sin(in[i]);
+   return;
+}
+
+static
+void
+sind_batch_evaluate(
+   double const * in,
+   double * out,
+   size_t length
+   )
+{
+   sind_evaluator.sind_array(
+      in,
+      out,
+      length,
+      sind_evaluator.accelerator
+      );
+   return;
+}
+
 static
 double
 sind_test(void)
@@ -60,6 +96,183 @@ sind_test(void)
       numerical_error;
 }
 
+static
+double
+sind_batch_test(
+   VARRSinDEvaluator (* constructor) (size_t),
+   size_t number_of_samples
+   )
+{
+   sind_evaluator = constructor(number_of_samples);
+   double const
+      numerical_error =
+         evaluate_batch_performanced(
+            0.0,
+            2.0 * M_PI,
+            10000003u,
+            0,
+            sind_machine_batch_evaluate,
+            sind_batch_evaluate,
+            0
+            );
+   sind_evaluator.disallocate(&sind_evaluator);
+   return
+      numerical_error;
+}
+
+static
+double
+cubic_sind_test(void)
+{
+   sind_evaluator = cubic_spline_sampling_sind(20000u);
+   double const
+      numerical_error =
+         evaluate_performanced(
+            0.0,
+            2.0 * M_PI,
+            10000000u,
+            0,
+            sin,
+            sind_evaluate
+            );
+   sind_evaluator.disallocate(&sind_evaluator);
+   return
+      numerical_error;
+}
+
+/*
+ * Returns the greatest difference between the scalar and batch cubic spline
+ * sine and cosine, over a little more than a period:
+ */
+static
+double
+cubic_scalar_batch_test(void)
+{
+   double * const
+      x = (double *) malloc(sizeof(double) * CUBIC_TEST_LENGTH);
+   double * const
+      out = (double *) malloc(sizeof(double) * CUBIC_TEST_LENGTH);
+   VARRSinDEvaluator
+      sin_evaluator = cubic_spline_sampling_sind(20000u);
+   VARRCosDEvaluator
+      cos_evaluator = cubic_spline_sampling_cosd(20000u);
+   double
+      difference = 0.;
+   for(size_t i = 0u; i< CUBIC_TEST_LENGTH; ++i)
+   {
+      x[i] = -0.1 + (2. * M_PI + 0.2) * (double) i / CUBIC_TEST_LENGTH;
+   }
+   sin_evaluator.sind_array(
+      x, out, CUBIC_TEST_LENGTH, sin_evaluator.accelerator
+      );
+   for(size_t i = 0u; i< CUBIC_TEST_LENGTH; ++i)
+   {
+      difference = fmax(
+         difference,
+         fabs(out[i] - sin_evaluator.sind(x[i], sin_evaluator.accelerator))
+         );
+   }
+   cos_evaluator.cosd_array(
+      x, out, CUBIC_TEST_LENGTH, cos_evaluator.accelerator
+      );
+   for(size_t i = 0u; i< CUBIC_TEST_LENGTH; ++i)
+   {
+      difference = fmax(
+         difference,
+         fabs(out[i] - cos_evaluator.cosd(x[i], cos_evaluator.accelerator))
+         );
+   }
+   cos_evaluator.disallocate(&cos_evaluator);
+   sin_evaluator.disallocate(&sin_evaluator);
+   free(out);
+   free(x);
+   return
+      difference;
+}
+
+/*
+ * The scalar cubic spline sine of x, of one evaluator shared by several 
+ * threads, into out:
+ */
+typedef struct tagCubicEvaluation
+{
+   VARRSinDEvaluator const *
+      evaluator;
+   double const *
+      x;
+   double *
+      out;
+} CubicEvaluation;
+
+static
+void *
+cubic_evaluate(void * argument)
+{
+   CubicEvaluation * const
+      evaluation = (CubicEvaluation *) argument;
+   for(size_t i = 0u; i< CUBIC_TEST_LENGTH; ++i)
+   {
+      evaluation->out[i] = evaluation->evaluator->sind(
+         evaluation->x[i], evaluation->evaluator->accelerator
+         );
+   }
+   return NULL;
+}
+
+/*
+ * Returns the greatest difference between the scalar cubic spline sine 
+ * evaluated by one thread, and by CUBIC_NUMBER_OF_THREADS threads at once 
+ * (of the same evaluator, at points in different orders):
+ */
+static
+double
+cubic_concurrent_test(void)
+{
+   pthread_t
+      threads[CUBIC_NUMBER_OF_THREADS];
+   CubicEvaluation
+      evaluations[CUBIC_NUMBER_OF_THREADS];
+   double * const
+      x = (double *) malloc(
+         sizeof(double) * CUBIC_NUMBER_OF_THREADS * CUBIC_TEST_LENGTH
+         );
+   double * const
+      out = (double *) malloc(
+         sizeof(double) * CUBIC_NUMBER_OF_THREADS * CUBIC_TEST_LENGTH
+         );
+   VARRSinDEvaluator
+      evaluator = cubic_spline_sampling_sind(20000u);
+   double
+      difference = 0.;
+   for(size_t i = 0u; i< CUBIC_NUMBER_OF_THREADS * CUBIC_TEST_LENGTH; ++i)
+   {
+      x[i] = 2. * M_PI * ((double) rand() / ((double) RAND_MAX + 1.));
+   }
+   for(size_t t = 0u; t< CUBIC_NUMBER_OF_THREADS; ++t)
+   {
+      evaluations[t].evaluator = &evaluator;
+      evaluations[t].x = x + t * CUBIC_TEST_LENGTH;
+      evaluations[t].out = out + t * CUBIC_TEST_LENGTH;
+      pthread_create(threads + t, NULL, cubic_evaluate, evaluations + t);
+   }
+   for(size_t t = 0u; t< CUBIC_NUMBER_OF_THREADS; ++t)
+   {
+      pthread_join(threads[t], NULL);
+   }
+   for(size_t i = 0u; i< CUBIC_NUMBER_OF_THREADS * CUBIC_TEST_LENGTH; ++i)
+   {
+      difference = fmax(
+         difference,
+         fabs(out[i] - evaluator.sind(x[i], evaluator.accelerator))
+         );
+   }
+   evaluator.disallocate(&evaluator);
+   free(out);
+   free(x);
+   return
+      difference;
+}
+
 UnitTestResult
 test_varr_sin(void)
 {
@@ -85,6 +298,96 @@ test_varr_sin(void)
    declare_end_of_unit_test();
    }
    
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 2.1e-11;
+   double const
+      numerical_error = sind_batch_test(sampling_sind, 500000u);
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sin/sin(x)",
+      "Sampling evaluation (batch)",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 2.36e-12;
+   double const
+      numerical_error = sind_batch_test(cubic_spline_sampling_sind, 20000u);
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sin/sin(x)",
+      "Cubic spline sampling evaluation (batch)",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 2.36e-12;
+   double const
+      numerical_error = cubic_sind_test();
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sin/sin(x)",
+      "Cubic spline sampling evaluation",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 4. * DBL_EPSILON;
+   double const
+      numerical_error = cubic_scalar_batch_test();
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sin/sin(x)",
+      "Cubic spline sampling scalar and batch sin and cos agree",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = DBL_MIN;
+   double const
+      numerical_error = cubic_concurrent_test();
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sin/sin(x)",
+      "Cubic spline sampling evaluation is the same from several threads",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
    return
       result;
 }
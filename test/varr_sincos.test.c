@@ -0,0 +1,190 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr_test.h"
+#include "varr_utils.h"
+#include "varr_internal.h"
+
+#include "varr_sin.h"
+#include "varr_cos.h"
+#include "varr_sincos.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#define SINCOS_TEST_LENGTH ((size_t) 1000003u)
+#define SINCOS_BENCHMARK_REPETITIONS ((size_t) 20u)
+#define SINCOS_BENCHMARK_ELEMENTS \
+   (SINCOS_TEST_LENGTH * SINCOS_BENCHMARK_REPETITIONS)
+
+static double
+   x[SINCOS_TEST_LENGTH],
+   sin_x[SINCOS_TEST_LENGTH],
+   cos_x[SINCOS_TEST_LENGTH];
+
+/*
+ * Returns the worst absolute error of the sine-cosine evaluator, in both its
+ * scalar and batch forms, over several periods (of an odd number of points,
+ * so that batch evaluation ends in a partial stride):
+ */
+static
+double
+sincosd_test(VARRSinCosDEvaluator evaluator)
+{
+   double
+      worst = 0.,
+      scalar_sin_x,
+      scalar_cos_x;
+   for(size_t i = 0u; i< SINCOS_TEST_LENGTH; ++i)
+   {
+      x[i] = -20. + 40. * (double) i / (double) (SINCOS_TEST_LENGTH - 1u);
+   }
+   evaluator.sincosd_array(
+      x, sin_x, cos_x, SINCOS_TEST_LENGTH, evaluator.accelerator
+      );
+   for(size_t i = 0u; i< SINCOS_TEST_LENGTH; ++i)
+   {
+      evaluator.sincosd(
+         x[i], &scalar_sin_x, &scalar_cos_x, evaluator.accelerator
+         );
+      worst = fmax(worst, fabs(scalar_sin_x - sin(x[i])));
+      worst = fmax(worst, fabs(scalar_cos_x - cos(x[i])));
+      worst = fmax(worst, fabs(sin_x[i] - sin(x[i])));
+      worst = fmax(worst, fabs(cos_x[i] - cos(x[i])));
+   }
+   printf("Worst (absolute) numerical difference: %g\n", worst);
+   return
+      worst;
+}
+
+/*
+ * Compares the fused sine-cosine batch function with separate sine and 
+ * cosine batch functions, over the period to which the latter are limited:
+ */
+static
+void
+sincosd_benchmark(void)
+{
+   VARRSinCosDEvaluator
+      sincos_evaluator = sampling_sincosd(100000u);
+   VARRSinDEvaluator
+      sin_evaluator = sampling_sind(100000u);
+   VARRCosDEvaluator
+      cos_evaluator = sampling_cosd(100000u);
+   for(size_t i = 0u; i< SINCOS_TEST_LENGTH; ++i)
+   {
+      x[i] = 2. * M_PI * (double) ((i * 7919u) % SINCOS_TEST_LENGTH)
+       / (double) SINCOS_TEST_LENGTH;
+   }
+   clock_t
+      begin = clock();
+   for(size_t r = 0u; r< SINCOS_BENCHMARK_REPETITIONS; ++r)
+   {
+      sincos_evaluator.sincosd_array(
+         x, sin_x, cos_x, SINCOS_TEST_LENGTH, sincos_evaluator.accelerator
+         );
+   }
+   double const
+      fused =
+         timing_in_nanoseconds_per_element(
+            begin, clock(), SINCOS_BENCHMARK_ELEMENTS
+            );
+   begin = clock();
+   for(size_t r = 0u; r< SINCOS_BENCHMARK_REPETITIONS; ++r)
+   {
+      sin_evaluator.sind_array(
+         x, sin_x, SINCOS_TEST_LENGTH, sin_evaluator.accelerator
+         );
+      cos_evaluator.cosd_array(
+         x, cos_x, SINCOS_TEST_LENGTH, cos_evaluator.accelerator
+         );
+   }
+   double const
+      separate =
+         timing_in_nanoseconds_per_element(
+            begin, clock(), SINCOS_BENCHMARK_ELEMENTS
+            );
+   printf(
+      "Timing (ns per element): sincosd_array: %.3f; "
+      "sind_array and cosd_array: %.3f\n",
+      fused,
+      separate
+      );
+   sincos_evaluator.disallocate(&sincos_evaluator);
+   sin_evaluator.disallocate(&sin_evaluator);
+   cos_evaluator.disallocate(&cos_evaluator);
+}
+
+UnitTestResult
+test_varr_sincos(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   
+   printf("sin(x), cos(x) numerical tests:\n");
+   
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 9.87e-10;
+   VARRSinCosDEvaluator
+      evaluator = sampling_sincosd(100000u);
+   double const
+      numerical_error = sincosd_test(evaluator);
+   evaluator.disallocate(&evaluator);
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sincos/sin(x), cos(x)",
+      "Sampling evaluation",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   sincosd_benchmark();
+   declare_end_of_unit_test();
+   }
+   
+   {
+   declare_start_of_unit_test();
+   static double const
+      worst_allowed_numerical_error = 8.12e-12;
+   VARRSinCosDEvaluator
+      evaluator = cubic_spline_sampling_sincosd(1000u);
+   double const
+      numerical_error = sincosd_test(evaluator);
+   evaluator.disallocate(&evaluator);
+   result.test_message = create_message_specific_to_numerical_error_test_case(
+      "varr-sincos/sin(x), cos(x)",
+      "Cubic spline sampling evaluation",
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   update_test_results_for_numerical_error_test_case(
+      &result, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   }
+   
+   return
+      result;
+}
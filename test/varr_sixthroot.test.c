@@ -59,6 +59,23 @@ sixthrootd_machine_batch_evaluate(
    return;
 }
 
+/*
+ * pow(x, 1./6.) is not an accurate reference far from unity, where the 
+ * rounding of 1./6. is significant (about 6e-15 at x = 1e-300):
+ */
+static
+void
+sixthrootd_machine_cbrt_sqrt_batch_evaluate(
+   double const * restrict in,
+   double * restrict out,
+   size_t length
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+      out[i] = cbrt(sqrt(in[i]));
+   return;
+}
+
 static
 void
 sixthrootd_batch_evaluate(
@@ -190,6 +207,37 @@ sixthrootd_test_batch_evaluation_with_remainder_loop_in_place(void)
       numerical_error;
 }
 
+static
+double
+sixthrootd_test_full_domain_batch_evaluation(void)
+{
+   double
+      numerical_error = -1.0;
+   
+   sixthrootd_evaluator =
+      linear_sampling_normalizing_sixth_rootd(3000000u);
+   
+   // batch evaluation, over (almost) all positive normal doubles:
+   printf("Vector evaluation:\n");
+   numerical_error = fmax(
+      numerical_error,
+      evaluate_batch_performanced(
+         1.e-300,
+         1.e300,
+         50000003u,
+         1,
+         sixthrootd_machine_cbrt_sqrt_batch_evaluate,
+         sixthrootd_batch_evaluate,
+         0
+         )
+      );
+   
+   sixthrootd_evaluator.disallocate(&sixthrootd_evaluator);
+   
+   return
+      numerical_error;
+}
+
 static
 double
 sixthrootd_sublinear_test(void)
@@ -335,6 +383,26 @@ test_varr_sixthroot(void)
    combine_test_results(test_outcome, &result);
    }
    
+   {
+   UnitTestResult
+      test_outcome = create_test_results();
+   declare_start_of_unit_test();
+   double const
+      numerical_error = sixthrootd_test_full_domain_batch_evaluation();
+   test_outcome.test_message = 
+      create_message_specific_to_numerical_error_test_case(
+         "varr-sixthroot/pow(x, 1/6) (batch evaluation, full domain)",
+         "Sampling evaluation",
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &test_outcome, numerical_error, worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+   combine_test_results(test_outcome, &result);
+   }
+   
    {
    static double const
       worst_allowed_numerical_error = 1.12e-07;
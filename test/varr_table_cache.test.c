@@ -0,0 +1,278 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include <pthread.h>
+
+#define CACHE_TEST_SAMPLES ((size_t) 1000u)
+#define CACHE_TEST_LENGTH ((size_t) 4099u)
+#define CACHE_CONCURRENT_SAMPLES ((size_t) 1u << 20)
+#define CACHE_NUMBER_OF_THREADS ((size_t) 8u)
+#define CACHE_BENCHMARK_SAMPLES ((size_t) 1u << 22)
+
+static
+void
+print_statistics(char const * label, VARRTableCacheStatistics statistics)
+{
+   printf(
+      "   %s: %zu tables, %zu references, %zu bytes, %zu hits, %zu misses\n",
+      label,
+      statistics.tables,
+      statistics.references,
+      statistics.bytes,
+      statistics.hits,
+      statistics.misses
+      );
+}
+
+/*
+ * Returns the worst difference of the batch functions of two sine 
+ * evaluators over [0, 2 pi]:
+ */
+static
+double
+sind_difference(VARRSinDEvaluator const * a, VARRSinDEvaluator const * b)
+{
+   static double
+      x[CACHE_TEST_LENGTH],
+      a_out[CACHE_TEST_LENGTH],
+      b_out[CACHE_TEST_LENGTH];
+   double
+      worst = 0.;
+   for(size_t i = 0u; i< CACHE_TEST_LENGTH; ++i)
+   {
+      x[i] = 6.283185307179586 * (double) i / (double) CACHE_TEST_LENGTH;
+   }
+   a->sind_array(x, a_out, CACHE_TEST_LENGTH, a->accelerator);
+   b->sind_array(x, b_out, CACHE_TEST_LENGTH, b->accelerator);
+   for(size_t i = 0u; i< CACHE_TEST_LENGTH; ++i)
+   {
+      worst = fmax(worst, fabs(a_out[i] - b_out[i]));
+   }
+   return
+      worst;
+}
+
+static
+void *
+construct_logd(void * evaluator)
+{
+   *(VARRLogDEvaluator *) evaluator = 
+      normalizing_linear_sampling_logd(CACHE_CONCURRENT_SAMPLES);
+   return NULL;
+}
+
+/*
+ * Constructs CACHE_NUMBER_OF_THREADS evaluators of the same table in as many
+ * threads at once, and returns the number of tables that were built (which
+ * should be one) less one, plus the worst difference of their results:
+ */
+static
+double
+concurrent_construction_test(void)
+{
+   pthread_t
+      threads[CACHE_NUMBER_OF_THREADS];
+   VARRLogDEvaluator
+      evaluators[CACHE_NUMBER_OF_THREADS];
+   double
+      x[CACHE_TEST_LENGTH],
+      first_out[CACHE_TEST_LENGTH],
+      out[CACHE_TEST_LENGTH],
+      worst = 0.;
+   VARRTableCacheStatistics const
+      before = varr_table_cache_statistics();
+   for(size_t i = 0u; i< CACHE_NUMBER_OF_THREADS; ++i)
+   {
+      pthread_create(threads + i, NULL, construct_logd, evaluators + i);
+   }
+   for(size_t i = 0u; i< CACHE_NUMBER_OF_THREADS; ++i)
+   {
+      pthread_join(threads[i], NULL);
+   }
+   VARRTableCacheStatistics const
+      after = varr_table_cache_statistics();
+   print_statistics("after concurrent construction", after);
+   for(size_t i = 0u; i< CACHE_TEST_LENGTH; ++i)
+   {
+      x[i] = 1.e-3 + (double) i;
+   }
+   evaluators[0u].logd_array(
+      x, first_out, CACHE_TEST_LENGTH, evaluators[0u].accelerator
+      );
+   for(size_t i = 1u; i< CACHE_NUMBER_OF_THREADS; ++i)
+   {
+      evaluators[i].logd_array(
+         x, out, CACHE_TEST_LENGTH, evaluators[i].accelerator
+         );
+      for(size_t j = 0u; j< CACHE_TEST_LENGTH; ++j)
+      {
+         worst = fmax(worst, fabs(out[j] - first_out[j]));
+      }
+   }
+   for(size_t i = 0u; i< CACHE_NUMBER_OF_THREADS; ++i)
+   {
+      evaluators[i].disallocate(evaluators + i);
+   }
+   return
+      count_error(before.misses, after.misses, 1u)
+    + count_error(before.hits, after.hits, CACHE_NUMBER_OF_THREADS - 1u)
+    + worst;
+}
+
+static
+double
+elapsed_milliseconds(clock_t begin, clock_t end)
+{
+   return
+      (end - begin) * (1.e3 / CLOCKS_PER_SEC);
+}
+
+/*
+ * Reports the time taken to construct an evaluator of a table that is 
+ * cached, against one that is not:
+ */
+static
+void
+cache_benchmark(void)
+{
+   clock_t
+      begin = clock();
+   VARRSinDEvaluator
+      first = sampling_sind(CACHE_BENCHMARK_SAMPLES);
+   double const
+      first_time = elapsed_milliseconds(begin, clock());
+   begin = clock();
+   VARRSinDEvaluator
+      second = sampling_sind(CACHE_BENCHMARK_SAMPLES);
+   double const
+      second_time = elapsed_milliseconds(begin, clock());
+   printf(
+      "Construction of sampling_sind(%zu): %.3f ms (built), %.6f ms "
+      "(shared)\n",
+      CACHE_BENCHMARK_SAMPLES,
+      first_time,
+      second_time
+      );
+   second.disallocate(&second);
+   first.disallocate(&first);
+}
+
+UnitTestResult
+test_varr_table_cache(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   
+   printf("Table cache tests:\n");
+   declare_start_of_unit_test();
+   
+   VARRTableCacheStatistics const
+      baseline = varr_table_cache_statistics();
+   print_statistics("baseline", baseline);
+   VARRSinDEvaluator
+      sin_a = sampling_sind(CACHE_TEST_SAMPLES),
+      sin_b = sampling_sind(CACHE_TEST_SAMPLES);
+   VARRLogDEvaluator
+      linear_log = normalizing_linear_sampling_logd(CACHE_TEST_SAMPLES),
+      sublinear_log = normalizing_sublinear_sampling_logd(CACHE_TEST_SAMPLES);
+   VARRTableCacheStatistics const
+      shared = varr_table_cache_statistics();
+   print_statistics("shared", shared);
+   numerical_error_unit_test(
+      &result,
+      "varr-table-cache",
+      "Evaluators of equal keys share their tables",
+      count_error(baseline.tables, shared.tables, 2u)
+    + count_error(baseline.references, shared.references, 4u)
+    + count_error(baseline.hits, shared.hits, 2u),
+      0.5
+      );
+   
+   varr_set_table_cache_enabled(0);
+   VARRSinDEvaluator
+      sin_private = sampling_sind(CACHE_TEST_SAMPLES);
+   varr_set_table_cache_enabled(1);
+   VARRTableCacheStatistics const
+      private = varr_table_cache_statistics();
+   print_statistics("private", private);
+   numerical_error_unit_test(
+      &result,
+      "varr-table-cache",
+      "Evaluators do not share tables while the cache is disabled",
+      count_error(shared.tables, private.tables, 1u)
+    + count_error(shared.hits, private.hits, 0u),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-table-cache",
+      "Shared and private tables agree",
+      sind_difference(&sin_a, &sin_private),
+      DBL_MIN
+      );
+   
+   sin_a.disallocate(&sin_a);
+   numerical_error_unit_test(
+      &result,
+      "varr-table-cache",
+      "Tables outlive all but the last of their evaluators",
+      sind_difference(&sin_b, &sin_private),
+      DBL_MIN
+      );
+   sin_b.disallocate(&sin_b);
+   sin_private.disallocate(&sin_private);
+   linear_log.disallocate(&linear_log);
+   sublinear_log.disallocate(&sublinear_log);
+   VARRTableCacheStatistics const
+      released = varr_table_cache_statistics();
+   print_statistics("released", released);
+   numerical_error_unit_test(
+      &result,
+      "varr-table-cache",
+      "Tables are released with their last evaluator",
+      count_error(baseline.tables, released.tables, 0u)
+    + count_error(baseline.references, released.references, 0u)
+    + count_error(baseline.bytes, released.bytes, 0u),
+      0.5
+      );
+   
+   numerical_error_unit_test(
+      &result,
+      "varr-table-cache",
+      "Concurrent construction builds a table once",
+      concurrent_construction_test(),
+      DBL_MIN
+      );
+   
+   declare_end_of_unit_test();
+   cache_benchmark();
+   
+   return
+      result;
+}
@@ -0,0 +1,532 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_internal.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FILE_TEST_SAMPLES ((size_t) 1u << 16)
+#define FILE_TEST_LENGTH ((size_t) 4099u)
+#define FILE_TEST_TABLES ((size_t) 4u)
+#define FILE_BENCHMARK_SAMPLES ((size_t) 1u << 22)
+
+/*
+ * The evaluators of the tables that are saved and loaded, one of each kind
+ * of table:
+ */
+typedef struct tagFileTestEvaluators
+{
+   VARRPhasorDEvaluator
+      linear_phasor,
+      cubic_phasor;
+   VARRExpDEvaluator
+      exp;
+   VARRSinFEvaluator
+      sin;
+} FileTestEvaluators;
+
+typedef struct tagFileTestOutputs
+{
+   double complex
+      linear_phasor[FILE_TEST_LENGTH],
+      cubic_phasor[FILE_TEST_LENGTH];
+   double
+      exp[FILE_TEST_LENGTH];
+   float
+      sin[FILE_TEST_LENGTH];
+} FileTestOutputs;
+
+static
+FileTestEvaluators
+construct_evaluators(void)
+{
+   FileTestEvaluators
+      evaluators;
+   evaluators.linear_phasor = linear_interpolating_phasord(FILE_TEST_SAMPLES);
+   evaluators.cubic_phasor = cubic_spline_sampling_phasord(FILE_TEST_SAMPLES);
+   evaluators.exp = shifting_linear_sampling_expd(FILE_TEST_SAMPLES);
+   evaluators.sin = sampling_sinf(FILE_TEST_SAMPLES);
+   return
+      evaluators;
+}
+
+static
+void
+release_evaluators(FileTestEvaluators * evaluators)
+{
+   evaluators->linear_phasor.disallocate(&evaluators->linear_phasor);
+   evaluators->cubic_phasor.disallocate(&evaluators->cubic_phasor);
+   evaluators->exp.disallocate(&evaluators->exp);
+   evaluators->sin.disallocate(&evaluators->sin);
+}
+
+static
+void
+evaluate(FileTestEvaluators const * evaluators, FileTestOutputs * out)
+{
+   static double
+      x[FILE_TEST_LENGTH];
+   static float
+      x_float[FILE_TEST_LENGTH];
+   for(size_t i = 0u; i< FILE_TEST_LENGTH; ++i)
+   {
+      x[i] = -600. + 1300. * (double) i / (double) FILE_TEST_LENGTH;
+      x_float[i] = (float) (0.1 * x[i]);
+   }
+   evaluators->linear_phasor.phasord_array(
+      x,
+      out->linear_phasor,
+      FILE_TEST_LENGTH,
+      evaluators->linear_phasor.accelerator
+      );
+   evaluators->cubic_phasor.phasord_array(
+      x,
+      out->cubic_phasor,
+      FILE_TEST_LENGTH,
+      evaluators->cubic_phasor.accelerator
+      );
+   evaluators->exp.expd_array(
+      x, out->exp, FILE_TEST_LENGTH, evaluators->exp.accelerator
+      );
+   evaluators->sin.sinf_array(
+      x_float, out->sin, FILE_TEST_LENGTH, evaluators->sin.accelerator
+      );
+}
+
+/*
+ * Returns the number of results that are not bitwise identical:
+ */
+static
+double
+output_differences(FileTestOutputs const * a, FileTestOutputs const * b)
+{
+   return
+      (double) (
+         (memcmp(a->linear_phasor, b->linear_phasor, 
+            sizeof(a->linear_phasor)) != 0)
+       + (memcmp(a->cubic_phasor, b->cubic_phasor, 
+            sizeof(a->cubic_phasor)) != 0)
+       + (memcmp(a->exp, b->exp, sizeof(a->exp)) != 0)
+       + (memcmp(a->sin, b->sin, sizeof(a->sin)) != 0)
+         );
+}
+
+/*
+ * Overwrites the last byte of the first table file in 'directory', and 
+ * returns zero, or returns nonzero if there is none:
+ */
+static
+int
+corrupt_table_file(char const * directory)
+{
+   DIR * const
+      listing = opendir(directory);
+   struct dirent const *
+      file;
+   char
+      path[4096u];
+   int
+      result = 1;
+   while((listing != NULL) && ((file = readdir(listing)) != NULL))
+   {
+      if(strstr(file->d_name, ".varrtable") == NULL)
+      {
+         continue;
+      }
+      snprintf(path, sizeof(path), "%s/%s", directory, file->d_name);
+      int const
+         descriptor = open(path, O_RDWR);
+      struct stat
+         status;
+      if((descriptor >= 0) && (fstat(descriptor, &status) == 0))
+      {
+         unsigned char
+            byte;
+         if(
+            (lseek(descriptor, status.st_size - 1, SEEK_SET) >= 0)
+            && (read(descriptor, &byte, 1u) == 1)
+            && (lseek(descriptor, status.st_size - 1, SEEK_SET) >= 0)
+            )
+         {
+            byte ^= 0xffu;
+            result = (write(descriptor, &byte, 1u) != 1);
+         }
+      }
+      if(descriptor >= 0)
+      {
+         close(descriptor);
+      }
+      break;
+   }
+   if(listing != NULL)
+   {
+      closedir(listing);
+   }
+   return
+      result;
+}
+
+/*
+ * Applies patch(header) to the header of each table file in 'directory' of
+ * a name that begins with 'prefix', and returns the number of files patched:
+ */
+static
+size_t
+patch_table_files(
+   char const * directory,
+   char const * prefix,
+   void (* patch) (VARRTableFileHeader *)
+   )
+{
+   DIR * const
+      listing = opendir(directory);
+   struct dirent const *
+      file;
+   char
+      path[4096u];
+   size_t
+      result = (size_t) 0u;
+   while((listing != NULL) && ((file = readdir(listing)) != NULL))
+   {
+      if(
+         (strstr(file->d_name, ".varrtable") == NULL)
+         || strncmp(file->d_name, prefix, strlen(prefix))
+         )
+      {
+         continue;
+      }
+      snprintf(path, sizeof(path), "%s/%s", directory, file->d_name);
+      int const
+         descriptor = open(path, O_RDWR);
+      VARRTableFileHeader
+         header;
+      if(
+         (descriptor >= 0)
+         && (read(descriptor, &header, sizeof(header))
+            == (ssize_t) sizeof(header))
+         && (lseek(descriptor, 0, SEEK_SET) == 0)
+         )
+      {
+         patch(&header);
+         result += (write(descriptor, &header, sizeof(header))
+            == (ssize_t) sizeof(header));
+      }
+      if(descriptor >= 0)
+      {
+         close(descriptor);
+      }
+   }
+   if(listing != NULL)
+   {
+      closedir(listing);
+   }
+   return
+      result;
+}
+
+/*
+ * Patches of headers: a section that is shorter than its table, a table of
+ * the contents of another version of the library, and a table (of an array
+ * of cubic spline coefficients) of one element fewer than its key implies,
+ * which is a valid file, of a table that the evaluators of its key do not 
+ * use:
+ */
+
+static
+void
+shorten_section(VARRTableFileHeader * header)
+{
+   header->bytes[0u] -= (uint64_t) 8u;
+}
+
+static
+void
+change_contents(VARRTableFileHeader * header)
+{
+   ++header->contents;
+}
+
+static
+void
+remove_element(VARRTableFileHeader * header)
+{
+   --header->number_of_values;
+   header->bytes[0u] -= header->width;
+}
+
+static
+void
+remove_table_files(char const * directory)
+{
+   DIR * const
+      listing = opendir(directory);
+   struct dirent const *
+      file;
+   char
+      path[4096u];
+   while((listing != NULL) && ((file = readdir(listing)) != NULL))
+   {
+      if(file->d_name[0u] != '.')
+      {
+         snprintf(path, sizeof(path), "%s/%s", directory, file->d_name);
+         unlink(path);
+      }
+   }
+   if(listing != NULL)
+   {
+      closedir(listing);
+   }
+   rmdir(directory);
+}
+
+static
+double
+elapsed_milliseconds(clock_t begin, clock_t end)
+{
+   return
+      (end - begin) * (1.e3 / CLOCKS_PER_SEC);
+}
+
+/*
+ * Reports the time taken to construct an evaluator of a table that is 
+ * built, against one of a table that is loaded from a file:
+ */
+static
+void
+file_benchmark(char const * directory)
+{
+   clock_t
+      begin = clock();
+   VARRSinDEvaluator
+      evaluator = sampling_sind(FILE_BENCHMARK_SAMPLES);
+   double const
+      built_time = elapsed_milliseconds(begin, clock());
+   varr_save_tables(directory);
+   evaluator.disallocate(&evaluator);
+   begin = clock();
+   varr_load_tables(directory, 0);
+   evaluator = sampling_sind(FILE_BENCHMARK_SAMPLES);
+   double const
+      loaded_time = elapsed_milliseconds(begin, clock());
+   printf(
+      "Construction of sampling_sind(%zu): %.3f ms (built), %.3f ms "
+      "(loaded)\n",
+      FILE_BENCHMARK_SAMPLES,
+      built_time,
+      loaded_time
+      );
+   evaluator.disallocate(&evaluator);
+   varr_unload_tables();
+}
+
+UnitTestResult
+test_varr_table_file(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   static FileTestOutputs
+      built_outputs,
+      loaded_outputs;
+   char
+      directory[64u];
+   snprintf(
+      directory, sizeof(directory), "/tmp/varr-table-files-%ld", 
+      (long) getpid()
+      );
+   
+   printf("Table file tests:\n");
+   declare_start_of_unit_test();
+   
+   if(mkdir(directory, (mode_t) 0700) != 0)
+   {
+      numerical_error_unit_test(
+         &result,
+         "varr-table-file",
+         "Creation of the test directory",
+         1.,
+         0.5
+         );
+      declare_end_of_unit_test();
+      return
+         result;
+   }
+   VARRTableCacheStatistics const
+      baseline = varr_table_cache_statistics();
+   FileTestEvaluators
+      evaluators = construct_evaluators();
+   evaluate(&evaluators, &built_outputs);
+   int const
+      saved = varr_save_tables(directory);
+   release_evaluators(&evaluators);
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Every cached table is saved",
+      fabs((double) saved - (double) FILE_TEST_TABLES),
+      0.5
+      );
+   
+   int const
+      loaded = varr_load_tables(directory, 1);
+   VARRTableCacheStatistics const
+      after_loading = varr_table_cache_statistics();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Every saved table is loaded",
+      fabs((double) loaded - (double) saved),
+      0.5
+      );
+   evaluators = construct_evaluators();
+   VARRTableCacheStatistics const
+      after_construction = varr_table_cache_statistics();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Evaluators use the loaded tables",
+      count_error(after_loading.misses, after_construction.misses, 0u)
+    + count_error(
+         after_loading.hits, after_construction.hits, FILE_TEST_TABLES
+         ),
+      0.5
+      );
+   evaluate(&evaluators, &loaded_outputs);
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Loaded tables agree bitwise with built tables",
+      output_differences(&built_outputs, &loaded_outputs),
+      0.5
+      );
+   release_evaluators(&evaluators);
+   size_t const
+      unloaded = varr_unload_tables();
+   VARRTableCacheStatistics const
+      released = varr_table_cache_statistics();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Loaded tables are unmapped when unloaded",
+      fabs((double) unloaded - (double) loaded)
+    + count_error(baseline.tables, released.tables, 0u)
+    + count_error(baseline.bytes, released.bytes, 0u),
+      0.5
+      );
+   
+   int const
+      corrupted = corrupt_table_file(directory),
+      verified = varr_load_tables(directory, 1);
+   varr_unload_tables();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Corrupt table files are rejected on verification",
+      (double) corrupted + fabs((double) verified - (double) (saved - 1)),
+      0.5
+      );
+   
+   // The corrupt file is rewritten:
+   evaluators = construct_evaluators();
+   varr_save_tables(directory);
+   release_evaluators(&evaluators);
+   size_t const
+      shortened = patch_table_files(directory, "exp", shorten_section);
+   int const
+      loaded_shortened = varr_load_tables(directory, 0);
+   varr_unload_tables();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Table files of sections of other sizes are rejected",
+      count_error(0u, shortened, 1u)
+    + fabs((double) loaded_shortened - (double) (saved - 1)),
+      0.5
+      );
+   
+   evaluators = construct_evaluators();
+   varr_save_tables(directory);
+   release_evaluators(&evaluators);
+   size_t const
+      changed = patch_table_files(directory, "sin", change_contents);
+   int const
+      loaded_changed = varr_load_tables(directory, 0);
+   varr_unload_tables();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Table files of other table contents are rejected",
+      count_error(0u, changed, 1u)
+    + fabs((double) loaded_changed - (double) (saved - 1)),
+      0.5
+      );
+   
+   evaluators = construct_evaluators();
+   varr_save_tables(directory);
+   release_evaluators(&evaluators);
+   size_t const
+      removed = patch_table_files(
+         directory, "phasor-cubic", remove_element
+         );
+   int const
+      loaded_removed = varr_load_tables(directory, 0);
+   VARRTableCacheStatistics const
+      before_mismatch = varr_table_cache_statistics();
+   evaluators = construct_evaluators();
+   VARRTableCacheStatistics const
+      after_mismatch = varr_table_cache_statistics();
+   evaluate(&evaluators, &loaded_outputs);
+   release_evaluators(&evaluators);
+   varr_unload_tables();
+   numerical_error_unit_test(
+      &result,
+      "varr-table-file",
+      "Loaded tables of other sizes are not used by evaluators",
+      count_error(0u, removed, 1u)
+    + fabs((double) loaded_removed - (double) saved)
+    + count_error(
+         before_mismatch.hits, after_mismatch.hits, FILE_TEST_TABLES - 1u
+         )
+    + output_differences(&built_outputs, &loaded_outputs),
+      0.5
+      );
+   
+   declare_end_of_unit_test();
+   remove_table_files(directory);
+   if(mkdir(directory, (mode_t) 0700) == 0)
+   {
+      file_benchmark(directory);
+      remove_table_files(directory);
+   }
+   
+   return
+      result;
+}
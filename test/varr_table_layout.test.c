@@ -0,0 +1,502 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+
+#define LAYOUT_TEST_LENGTH ((size_t) 4099u)
+#define LAYOUT_BENCHMARK_LENGTH ((size_t) 65536u)
+#define LAYOUT_BENCHMARK_REPETITIONS ((size_t) 32u)
+#define LAYOUT_BENCHMARK_ELEMENTS \
+   (LAYOUT_BENCHMARK_LENGTH * LAYOUT_BENCHMARK_REPETITIONS)
+#define LAYOUT_NUMBER_OF_CASES ((size_t) 10u)
+#define LAYOUT_NUMBER_OF_FORMATS ((size_t) 6u)
+
+#define LAYOUT_BENCHMARK_SIZES ((size_t) 4u)
+
+static size_t const
+   layout_benchmark_samples[LAYOUT_BENCHMARK_SIZES] = {
+      1000u, 10000u, 100000u, 1000000u
+   };
+
+typedef void (* BatchFunction) (double const *, double *, size_t, void const *);
+
+/*
+ * A table layout and precision (see varr_table_layout.h), and its name in 
+ * reports:
+ */
+typedef struct tagTableFormat {
+   char const *
+      name;
+   VARRTableFormat
+      format;
+} TableFormat;
+
+static TableFormat const
+   table_formats[LAYOUT_NUMBER_OF_FORMATS] = {
+      { "double", { VARR_TABLE_VALUES, VARR_TABLE_DOUBLE } },
+      { "double/i", { VARR_TABLE_INTERLEAVED, VARR_TABLE_DOUBLE } },
+      { "float", { VARR_TABLE_VALUES, VARR_TABLE_FLOAT } },
+      { "float/i", { VARR_TABLE_INTERLEAVED, VARR_TABLE_FLOAT } },
+      { "corr.", { VARR_TABLE_VALUES, VARR_TABLE_FLOAT_CORRECTED } },
+      { "corr./i", { VARR_TABLE_INTERLEAVED, VARR_TABLE_FLOAT_CORRECTED } }
+   };
+
+/*
+ * A batch function of an evaluator that interpolates linearly in a sampling
+ * table, and an input range.  Batch functions of 'width' 2 write two outputs
+ * per input (eg. the real and imaginary parts of a phasor).
+ */
+typedef struct tagLayoutTestCase {
+   char const *
+      name;
+   BatchFunction
+      batch;
+   void const *
+      accelerator;
+   size_t
+      width;
+   double
+      lower,
+      upper;
+   int
+      log_sampling;
+} LayoutTestCase;
+
+/*
+ * All evaluators with a choice of table layout and precision, for one 
+ * format and one number of samples:
+ */
+typedef struct tagLayoutTestEvaluators {
+   VARRExpDEvaluator
+      exp;
+   VARRLogDEvaluator
+      log;
+   VARRSixthRootDEvaluator
+      sixth_root;
+   VARR3Over4DEvaluator
+      threequarters;
+   VARRAtanDEvaluator
+      atan;
+   VARRSinDEvaluator
+      sin;
+   VARRCosDEvaluator
+      cos;
+   VARRSinCosDEvaluator
+      sincos;
+   VARRPhasorDEvaluator
+      phasor;
+   VARRBoundGLBAccelerator
+      linbuf;
+} LayoutTestEvaluators;
+
+static
+void
+sincos_batch(
+   double const * x,
+   double * out,
+   size_t length,
+   void const * evaluator
+   )
+{
+   VARRSinCosDEvaluator const * const
+      sincos = (VARRSinCosDEvaluator const *) evaluator;
+   sincos->sincosd_array(x, out, out + length, length, sincos->accelerator);
+}
+
+static
+void
+phasor_batch(
+   double const * x,
+   double * out,
+   size_t length,
+   void const * evaluator
+   )
+{
+   VARRPhasorDEvaluator const * const
+      phasor = (VARRPhasorDEvaluator const *) evaluator;
+   phasor->phasord_array(
+      x, (double complex *) out, length, phasor->accelerator
+      );
+}
+
+/*
+ * Constructs the evaluators of 'format' with 'number_of_samples' samples,
+ * and lists them in 'cases' (of LAYOUT_NUMBER_OF_CASES elements).
+ */
+static
+void
+construct_evaluators(
+   LayoutTestEvaluators * evaluators,
+   LayoutTestCase * cases,
+   size_t number_of_samples,
+   TableFormat const * format
+   )
+{
+   VARRTableFormat const
+      table_format = format->format;
+   evaluators->exp = shifting_linear_sampling_expd_with_table_format(
+      number_of_samples, table_format
+      );
+   evaluators->log = normalizing_linear_sampling_logd_with_table_format(
+      number_of_samples, table_format
+      );
+   evaluators->sixth_root =
+      linear_sampling_normalizing_sixth_rootd_with_table_format(
+         number_of_samples, table_format
+         );
+   evaluators->threequarters =
+      linear_sampling_normalizing_3over4d_with_table_format(
+         number_of_samples, table_format
+         );
+   evaluators->atan = clamping_linear_interpolating_atand_with_table_format(
+      number_of_samples, table_format
+      );
+   evaluators->sin = 
+      sampling_sind_with_table_format(number_of_samples, table_format);
+   evaluators->cos = 
+      sampling_cosd_with_table_format(number_of_samples, table_format);
+   evaluators->sincos = 
+      sampling_sincosd_with_table_format(number_of_samples, table_format);
+   evaluators->phasor = linear_interpolating_phasord_with_table_format(
+      number_of_samples, table_format
+      );
+   evaluators->linbuf = bound_general_linbuf_with_table_format(
+      number_of_samples, -1., 10., cos_delegate, NULL, table_format
+      );
+   
+   LayoutTestCase const
+      all_cases[LAYOUT_NUMBER_OF_CASES] = {
+         {
+            "expd_array",
+            evaluators->exp.expd_array,
+            evaluators->exp.accelerator,
+            1u, -700., 700., 0
+         },
+         {
+            "logd_array",
+            evaluators->log.logd_array,
+            evaluators->log.accelerator,
+            1u, 1.e-300, 1.e300, 1
+         },
+         {
+            "sixthrootd_array",
+            evaluators->sixth_root.sixthrootd_array,
+            evaluators->sixth_root.accelerator,
+            1u, 1.e-300, 1.e300, 1
+         },
+         {
+            "threequartersd_array",
+            evaluators->threequarters.threequartersd_array,
+            evaluators->threequarters.accelerator,
+            1u, 1.e-300, 1.e300, 1
+         },
+         {
+            "atan_array",
+            evaluators->atan.atan_array,
+            evaluators->atan.accelerator,
+            1u, -60., 60., 0
+         },
+         {
+            "sind_array",
+            evaluators->sin.sind_array,
+            evaluators->sin.accelerator,
+            1u, -100., 100., 0
+         },
+         {
+            "cosd_array",
+            evaluators->cos.cosd_array,
+            evaluators->cos.accelerator,
+            1u, -100., 100., 0
+         },
+         {
+            "sincosd_array",
+            sincos_batch,
+            &evaluators->sincos,
+            2u, -100., 100., 0
+         },
+         {
+            "phasord_array",
+            phasor_batch,
+            &evaluators->phasor,
+            2u, -100., 100., 0
+         },
+         {
+            "bound_general_linbuf batch",
+            evaluators->linbuf.batch,
+            evaluators->linbuf.accelerator,
+            1u, -2., 11., 0
+         }
+      };
+   for(size_t i = 0u; i< LAYOUT_NUMBER_OF_CASES; ++i)
+   {
+      cases[i] = all_cases[i];
+   }
+}
+
+static
+void
+release_evaluators(LayoutTestEvaluators * evaluators)
+{
+   evaluators->exp.disallocate(&evaluators->exp);
+   evaluators->log.disallocate(&evaluators->log);
+   evaluators->sixth_root.disallocate(&evaluators->sixth_root);
+   evaluators->threequarters.disallocate(&evaluators->threequarters);
+   evaluators->atan.disallocate(&evaluators->atan);
+   evaluators->sin.disallocate(&evaluators->sin);
+   evaluators->cos.disallocate(&evaluators->cos);
+   evaluators->sincos.disallocate(&evaluators->sincos);
+   evaluators->phasor.disallocate(&evaluators->phasor);
+   evaluators->linbuf.disallocate(&evaluators->linbuf);
+}
+
+static
+double
+relative_difference(double observed, double expected)
+{
+   register double const
+      scale = (fabs(expected) > 1.) ? fabs(expected) : 1.;
+   return
+      fabs(observed - expected) / scale;
+}
+
+static
+void
+fill_inputs(
+   double * restrict x,
+   size_t length,
+   double lower,
+   double upper,
+   int log_sampling
+   )
+{
+   for(size_t i = 0u; i< length; ++i)
+   {
+      // A multiplicative congruence scatters the samples over the range:
+      double const
+         t = (double) ((i * 7919u) % length) / (double) (length - 1u);
+      x[i] = log_sampling ?
+         exp(log(lower) + t * (log(upper) - log(lower)))
+         :
+         lower + t * (upper - lower);
+   }
+}
+
+/*
+ * Returns the worst difference between the outputs of the evaluators of
+ * 'format' and of double tables of the VARR_TABLE_VALUES layout, over 
+ * LAYOUT_TEST_LENGTH inputs:
+ */
+static
+double
+format_agreement_test(size_t number_of_samples, TableFormat const * format)
+{
+   static double
+      x[LAYOUT_TEST_LENGTH],
+      expected_out[2u * LAYOUT_TEST_LENGTH],
+      observed_out[2u * LAYOUT_TEST_LENGTH];
+   LayoutTestEvaluators
+      expected_evaluators,
+      observed_evaluators;
+   LayoutTestCase
+      expected_cases[LAYOUT_NUMBER_OF_CASES],
+      observed_cases[LAYOUT_NUMBER_OF_CASES];
+   double
+      worst = 0.;
+   construct_evaluators(
+      &expected_evaluators,
+      expected_cases,
+      number_of_samples,
+      table_formats
+      );
+   construct_evaluators(
+      &observed_evaluators, observed_cases, number_of_samples, format
+      );
+   for(size_t i = 0u; i< LAYOUT_NUMBER_OF_CASES; ++i)
+   {
+      double
+         difference = 0.;
+      fill_inputs(
+         x,
+         LAYOUT_TEST_LENGTH,
+         expected_cases[i].lower,
+         expected_cases[i].upper,
+         expected_cases[i].log_sampling
+         );
+      expected_cases[i].batch(
+         x, expected_out, LAYOUT_TEST_LENGTH, expected_cases[i].accelerator
+         );
+      observed_cases[i].batch(
+         x, observed_out, LAYOUT_TEST_LENGTH, observed_cases[i].accelerator
+         );
+      for(size_t j = 0u; j< expected_cases[i].width * LAYOUT_TEST_LENGTH; ++j)
+      {
+         difference = fmax(
+            difference,
+            relative_difference(observed_out[j], expected_out[j])
+            );
+      }
+      printf("   %s: %e\n", expected_cases[i].name, difference);
+      worst = fmax(worst, difference);
+   }
+   release_evaluators(&expected_evaluators);
+   release_evaluators(&observed_evaluators);
+   return
+      worst;
+}
+
+/*
+ * Adds the result of format_agreement_test, as a unit test, to 'result':
+ */
+static
+void
+format_agreement_unit_test(
+   UnitTestResult * result,
+   size_t number_of_samples,
+   TableFormat const * format,
+   double worst_allowed_numerical_error
+   )
+{
+   declare_start_of_unit_test();
+   char
+      unit_test_name[96];
+   snprintf(
+      unit_test_name,
+      sizeof(unit_test_name),
+      "%s, %s versus double, values tables (%zu samples)",
+      varr_table_precision_name(format->format.precision),
+      varr_table_layout_name(format->format.layout),
+      number_of_samples
+      );
+   printf("%s:\n", unit_test_name);
+   double const
+      numerical_error = format_agreement_test(number_of_samples, format);
+   numerical_error_unit_test(
+      result,
+      "varr-table-layout/agreement",
+      unit_test_name,
+      numerical_error,
+      worst_allowed_numerical_error
+      );
+   declare_end_of_unit_test();
+}
+
+/*
+ * Reports the throughput of every batch function with each table format,
+ * for tables from (L1) cache resident to main memory resident, and inputs
+ * scattered over the whole table:
+ */
+static
+void
+layout_benchmark(void)
+{
+   static double
+      x[LAYOUT_BENCHMARK_LENGTH],
+      out[2u * LAYOUT_BENCHMARK_LENGTH];
+   LayoutTestEvaluators
+      evaluators;
+   LayoutTestCase
+      cases[LAYOUT_NUMBER_OF_CASES];
+   double
+      timings[LAYOUT_NUMBER_OF_FORMATS][LAYOUT_NUMBER_OF_CASES];
+   
+   printf(
+      "Batch throughput by table format (ns per element, %s SIMD level, "
+      "/i: interleaved):\n",
+      varr_simd_level_name(varr_simd_level())
+      );
+   for(size_t k = 0u; k< LAYOUT_BENCHMARK_SIZES; ++k)
+   {
+      for(size_t f = 0u; f< LAYOUT_NUMBER_OF_FORMATS; ++f)
+      {
+         construct_evaluators(
+            &evaluators,
+            cases,
+            layout_benchmark_samples[k],
+            table_formats + f
+            );
+         for(size_t i = 0u; i< LAYOUT_NUMBER_OF_CASES; ++i)
+         {
+            fill_inputs(
+               x,
+               LAYOUT_BENCHMARK_LENGTH,
+               cases[i].lower,
+               cases[i].upper,
+               cases[i].log_sampling
+               );
+            clock_t const
+               begin = clock();
+            for(size_t r = 0u; r< LAYOUT_BENCHMARK_REPETITIONS; ++r)
+            {
+               cases[i].batch(
+                  x, out, LAYOUT_BENCHMARK_LENGTH, cases[i].accelerator
+                  );
+            }
+            timings[f][i] =
+               timing_in_nanoseconds_per_element(
+                  begin, clock(), LAYOUT_BENCHMARK_ELEMENTS
+                  );
+         }
+         release_evaluators(&evaluators);
+      }
+      printf("   %-30zu", layout_benchmark_samples[k]);
+      for(size_t f = 0u; f< LAYOUT_NUMBER_OF_FORMATS; ++f)
+      {
+         printf(" %8s", table_formats[f].name);
+      }
+      printf("\n");
+      for(size_t i = 0u; i< LAYOUT_NUMBER_OF_CASES; ++i)
+      {
+         printf("   %-30s", cases[i].name);
+         for(size_t f = 0u; f< LAYOUT_NUMBER_OF_FORMATS; ++f)
+         {
+            printf(" %8.3f", timings[f][i]);
+         }
+         printf("\n");
+      }
+   }
+}
+
+UnitTestResult
+test_varr_table_layout(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   
+   printf("Table layout tests:\n");
+   format_agreement_unit_test(&result, 1000u, table_formats + 1u, 7.63e-16);
+   format_agreement_unit_test(&result, 100000u, table_formats + 1u, 7.63e-16);
+   format_agreement_unit_test(&result, 100000u, table_formats + 2u, 1.15e-7);
+   format_agreement_unit_test(&result, 100000u, table_formats + 3u, 1.17e-7);
+   format_agreement_unit_test(&result, 100000u, table_formats + 4u, 3.37e-12);
+   format_agreement_unit_test(&result, 100000u, table_formats + 5u, 9.02e-11);
+   
+   layout_benchmark();
+   
+   return
+      result;
+}
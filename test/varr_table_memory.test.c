@@ -0,0 +1,278 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_internal.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#define MEMORY_TEST_ALLOCATIONS ((size_t) 6u)
+#define MEMORY_HUGE_TABLE_BYTES ((size_t) 5u << 20)
+#define MEMORY_BENCHMARK_SAMPLES ((size_t) 1u << 23)
+#define MEMORY_BENCHMARK_LENGTH ((size_t) 1u << 22)
+
+static size_t const
+   __allocation_bytes[MEMORY_TEST_ALLOCATIONS] = {
+      (size_t) 1u,
+      (size_t) 24u,
+      (size_t) 4100u,
+      (size_t) 1u << 20,
+      (size_t) 2u << 20,
+      MEMORY_HUGE_TABLE_BYTES
+   };
+
+static
+void
+print_statistics(char const * label, VARRTableMemoryStatistics statistics)
+{
+   printf(
+      "   %s: %zu tables, %zu bytes, %zu huge page requests, %zu bytes in "
+      "huge pages\n",
+      label,
+      statistics.tables,
+      statistics.bytes,
+      statistics.huge_page_requests,
+      statistics.huge_page_bytes
+      );
+}
+
+/*
+ * Allocates tables of each of __allocation_bytes with the given pages, 
+ * writes them in full, and returns the number of them that are not 64 byte
+ * aligned, or that are not recorded by varr_table_memory_statistics, or 
+ * that are not released by __varr_table_free:
+ */
+static
+double
+allocation_test(VARRTablePages pages)
+{
+   void *
+      tables[MEMORY_TEST_ALLOCATIONS];
+   double
+      errors = 0.;
+   VARRTableFormat const
+      format = {
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE,
+         .pages = pages
+      },
+      previous = __varr_select_table_format(format);
+   VARRTableMemoryStatistics const
+      before = varr_table_memory_statistics();
+   size_t
+      bytes = (size_t) 0u;
+   for(size_t i = 0u; i< MEMORY_TEST_ALLOCATIONS; ++i)
+   {
+      tables[i] = __varr_table_allocate(__allocation_bytes[i]);
+      if(tables[i] == NULL)
+      {
+         errors += 1.;
+         continue;
+      }
+      errors += (double) (((uintptr_t) tables[i] % 64u) != 0u);
+      memset(tables[i], 0xa5, __allocation_bytes[i]);
+      bytes += __allocation_bytes[i];
+   }
+   VARRTableMemoryStatistics const
+      allocated = varr_table_memory_statistics();
+   print_statistics(varr_table_pages_name(pages), allocated);
+   errors += count_error(
+      before.tables, allocated.tables, MEMORY_TEST_ALLOCATIONS
+      )
+    + count_error(before.bytes, allocated.bytes, bytes);
+   for(size_t i = 0u; i< MEMORY_TEST_ALLOCATIONS; ++i)
+   {
+      __varr_table_free(tables[i]);
+   }
+   VARRTableMemoryStatistics const
+      released = varr_table_memory_statistics();
+   errors += count_error(before.tables, released.tables, 0u)
+    + count_error(before.bytes, released.bytes, 0u);
+   __varr_select_table_format(previous);
+   return
+      errors;
+}
+
+/*
+ * Returns the number of tables (of at least a huge page) for which huge 
+ * pages were not requested, and reports whether they were obtained:
+ */
+static
+double
+huge_page_request_test(VARRTablePages pages)
+{
+   VARRTableFormat const
+      format = {
+         .layout = VARR_TABLE_VALUES,
+         .precision = VARR_TABLE_DOUBLE,
+         .pages = pages
+      },
+      previous = __varr_select_table_format(format);
+   VARRTableMemoryStatistics const
+      before = varr_table_memory_statistics();
+   void * const
+      table = __varr_table_allocate(MEMORY_HUGE_TABLE_BYTES);
+   if(table != NULL)
+   {
+      memset(table, 0x5a, MEMORY_HUGE_TABLE_BYTES);
+   }
+   VARRTableMemoryStatistics const
+      after = varr_table_memory_statistics();
+   printf(
+      "   %s pages: %zu of %zu bytes in huge pages\n",
+      varr_table_pages_name(pages),
+      after.huge_page_bytes - before.huge_page_bytes,
+      MEMORY_HUGE_TABLE_BYTES
+      );
+   __varr_table_free(table);
+   __varr_select_table_format(previous);
+   return
+      count_error(before.huge_page_requests, after.huge_page_requests, 1u);
+}
+
+/*
+ * Reports the throughput of random lookups into a table of 
+ * MEMORY_BENCHMARK_SAMPLES samples (64 MB) with each of VARRTablePages, and
+ * whether huge pages were obtained.  Tables are built privately (with the 
+ * table cache disabled), so that each is allocated as selected.
+ */
+static
+void
+memory_benchmark(void)
+{
+   double * const
+      x = (double *) malloc(sizeof(double) * MEMORY_BENCHMARK_LENGTH);
+   double * const
+      out = (double *) malloc(sizeof(double) * MEMORY_BENCHMARK_LENGTH);
+   int const
+      cached = varr_table_cache_enabled();
+   srand(6u);
+   for(size_t i = 0u; i< MEMORY_BENCHMARK_LENGTH; ++i)
+   {
+      x[i] = 6.283185307179586 * ((double) rand() / (double) RAND_MAX);
+   }
+   varr_set_table_cache_enabled(0);
+   printf(
+      "Random lookups into sampling_sind(%zu), %zu evaluations:\n",
+      MEMORY_BENCHMARK_SAMPLES,
+      MEMORY_BENCHMARK_LENGTH
+      );
+   for(
+      int pages = (int) VARR_TABLE_PAGES_DEFAULT;
+      pages<= (int) VARR_TABLE_PAGES_EXPLICIT;
+      ++pages
+      )
+   {
+      VARRTableFormat const
+         format = {
+            .layout = VARR_TABLE_VALUES,
+            .precision = VARR_TABLE_DOUBLE,
+            .pages = (VARRTablePages) pages
+         };
+      VARRSinDEvaluator
+         evaluator = sampling_sind_with_table_format(
+            MEMORY_BENCHMARK_SAMPLES, format
+            );
+      VARRTableMemoryStatistics const
+         statistics = varr_table_memory_statistics();
+      // The first pass faults the table in:
+      evaluator.sind_array(
+         x, out, MEMORY_BENCHMARK_LENGTH, evaluator.accelerator
+         );
+      clock_t const
+         begin = clock();
+      evaluator.sind_array(
+         x, out, MEMORY_BENCHMARK_LENGTH, evaluator.accelerator
+         );
+      double const
+         seconds = (double) (clock() - begin) / CLOCKS_PER_SEC;
+      printf(
+         "   %-12s %8.3f ns per evaluation, %zu MB of %zu MB in huge "
+         "pages\n",
+         varr_table_pages_name((VARRTablePages) pages),
+         1.e9 * seconds / (double) MEMORY_BENCHMARK_LENGTH,
+         statistics.huge_page_bytes >> 20,
+         statistics.bytes >> 20
+         );
+      evaluator.disallocate(&evaluator);
+   }
+   varr_set_table_cache_enabled(cached);
+   free(out);
+   free(x);
+}
+
+UnitTestResult
+test_varr_table_memory(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   
+   printf("Table memory tests:\n");
+   declare_start_of_unit_test();
+   
+   for(
+      int pages = (int) VARR_TABLE_PAGES_DEFAULT;
+      pages<= (int) VARR_TABLE_PAGES_EXPLICIT;
+      ++pages
+      )
+   {
+      char
+         name[128u];
+      snprintf(
+         name,
+         sizeof(name),
+         "Tables of %s pages are aligned, recorded and released",
+         varr_table_pages_name((VARRTablePages) pages)
+         );
+      numerical_error_unit_test(
+         &result,
+         "varr-table-memory",
+         name,
+         allocation_test((VARRTablePages) pages),
+         0.5
+         );
+   }
+   numerical_error_unit_test(
+      &result,
+      "varr-table-memory",
+      "Huge pages are requested for transparent huge page tables",
+      huge_page_request_test(VARR_TABLE_PAGES_TRANSPARENT),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-table-memory",
+      "Huge pages are requested for explicit huge page tables",
+      huge_page_request_test(VARR_TABLE_PAGES_EXPLICIT),
+      0.5
+      );
+   
+   declare_end_of_unit_test();
+   memory_benchmark();
+   
+   return
+      result;
+}
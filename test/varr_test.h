@@ -93,6 +93,9 @@ test_varr_log(void);
 UnitTestResult
 test_varr_sin(void);
 
+UnitTestResult
+test_varr_sincos(void);
+
 UnitTestResult
 test_varr_exp(void);
 
@@ -102,4 +105,34 @@ test_varr_general_bound_linbuf(void);
 UnitTestResult
 test_varr_sequence_analysis(void);
 
+UnitTestResult
+test_varr_simd(void);
+
+UnitTestResult
+test_varr_table_layout(void);
+
+UnitTestResult
+test_varr_float(void);
+
+UnitTestResult
+test_varr_table_cache(void);
+
+UnitTestResult
+test_varr_table_file(void);
+
+UnitTestResult
+test_varr_table_memory(void);
+
+UnitTestResult
+test_varr_allocator(void);
+
+UnitTestResult
+test_varr_octant(void);
+
+UnitTestResult
+test_varr_thread_pool(void);
+
+UnitTestResult
+test_varr_progression(void);
+
 #endif /* __VARR_TEST_H__ */
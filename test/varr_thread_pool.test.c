@@ -0,0 +1,1113 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "varr.h"
+#include "varr_internal.h"
+#include "varr_test.h"
+#include "varr_utils.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <float.h>
+#include <time.h>
+
+#define POOL_TEST_THREADS ((size_t) 4u)
+#define POOL_TEST_SAMPLES ((size_t) 100003u)
+#define POOL_TEST_LENGTH ((size_t) 10007u)
+#define POOL_NUMBER_OF_RANGES ((size_t) 5u)
+#define POOL_NUMBER_OF_CASES ((size_t) 5u)
+#define POOL_REPORT_SIZES ((size_t) 3u)
+#define POOL_REPORT_THREADS ((size_t) 4u)
+#define POOL_NUMBER_OF_LENGTHS ((size_t) 5u)
+#define POOL_STEALING_CHUNKS ((size_t) 64u)
+#define POOL_CHUNK ((size_t) 4096u)
+#define POOL_SCALING_LENGTH ((size_t) 1u << 23)
+#define POOL_STREAMING_LENGTHS ((size_t) 6u)
+#define POOL_STREAMING_OFFSETS ((size_t) 16u)
+#define POOL_STREAMING_KINDS ((size_t) 4u)
+#define POOL_STREAMING_SIZES ((size_t) 2u)
+#define POOL_PROBE_LENGTH ((size_t) 1u << 16)
+
+static size_t const
+   pool_counts[POOL_NUMBER_OF_RANGES] = { 0u, 1u, 4095u, 4096u, 100003u },
+   pool_grains[POOL_NUMBER_OF_RANGES] = { 1u, 7u, 4096u, 333u, 1u << 20 },
+   pool_report_samples[POOL_REPORT_SIZES] = {
+      (size_t) 1u << 16, (size_t) 1u << 20, (size_t) 1u << 22
+   },
+   pool_report_threads[POOL_REPORT_THREADS] = { 1u, 2u, 4u, 0u },
+   pool_batch_lengths[POOL_NUMBER_OF_LENGTHS] = {
+      0u, 1u, 4095u, 4097u, 1000003u
+   },
+   pool_streaming_lengths[POOL_STREAMING_LENGTHS] = {
+      0u, 1u, 7u, 33u, 4097u, 20011u
+   },
+   pool_streaming_sizes[POOL_STREAMING_SIZES] = {
+      (size_t) 1u << 16, (size_t) 1u << 24
+   };
+
+/*
+ * Counts the visits of each index, and (if 'nested') visits each index of 
+ * the range again by a nested __varr_parallel_for:
+ */
+typedef struct tagPoolVisits
+{
+   unsigned *
+      visits;
+   int
+      nested;
+} PoolVisits;
+
+static
+void
+visit(size_t begin, size_t end, void const * argument)
+{
+   PoolVisits const * const
+      visits = (PoolVisits const *) argument;
+   for(size_t i = begin; i< end; ++i)
+   {
+      // Distinct indices are visited by distinct threads:
+      ++visits->visits[i];
+   }
+   if(visits->nested)
+   {
+      PoolVisits const
+         nested = { visits->visits + begin, 0 };
+      __varr_parallel_for(
+         varr_table_construction_threads(), end - begin, 3u, visit, &nested
+         );
+   }
+}
+
+/*
+ * Returns the number of indices of each of pool_counts not visited once 
+ * (or twice, if 'nested') by __varr_parallel_for:
+ */
+static
+double
+coverage_test(int nested)
+{
+   double
+      errors = 0.;
+   for(size_t r = 0u; r< POOL_NUMBER_OF_RANGES; ++r)
+   {
+      PoolVisits const
+         visits = {
+            (unsigned *) calloc(pool_counts[r] + 1u, sizeof(unsigned)),
+            nested
+         };
+      __varr_parallel_for(
+         varr_table_construction_threads(),
+         pool_counts[r],
+         pool_grains[r],
+         visit,
+         &visits
+         );
+      for(size_t i = 0u; i< pool_counts[r]; ++i)
+      {
+         errors += (double) (visits.visits[i] != (nested ? 2u : 1u));
+      }
+      free(visits.visits);
+   }
+   return
+      errors;
+}
+
+/*
+ * As cos_delegate, counting its calls from threads other than 
+ * delegate_caller:
+ */
+static pthread_t
+   delegate_caller;
+
+static size_t
+   foreign_delegate_calls = (size_t) 0u;
+
+static
+double
+counting_cos_delegate(double x, void * argument)
+{
+   if(!pthread_equal(pthread_self(), delegate_caller))
+   {
+      __atomic_add_fetch(&foreign_delegate_calls, 1u, __ATOMIC_RELAXED);
+   }
+   return
+      cos_delegate(x, argument);
+}
+
+/*
+ * Returns the number of calls of the delegate of a linbuf from threads other
+ * than the constructing thread, with the default linbuf construction threads
+ * and POOL_TEST_THREADS table construction threads:
+ */
+static
+double
+serial_delegate_test(void)
+{
+   double
+      frequency = 3.;
+   varr_set_table_construction_threads(POOL_TEST_THREADS);
+   delegate_caller = pthread_self();
+   foreign_delegate_calls = (size_t) 0u;
+   VARRBoundGLBAccelerator
+      evaluator = bound_general_linbuf(
+         POOL_TEST_SAMPLES, 0., 2., counting_cos_delegate, &frequency
+         );
+   varr_prefetch_linbuf(&evaluator, 0., 2.);
+   evaluator.disallocate(&evaluator);
+   evaluator = lazy_bound_general_linbuf(
+      POOL_TEST_SAMPLES, 0., 2., counting_cos_delegate, &frequency
+      );
+   varr_prefetch_linbuf(&evaluator, 0., 2.);
+   evaluator.disallocate(&evaluator);
+   return
+      (double) __atomic_load_n(&foreign_delegate_calls, __ATOMIC_RELAXED);
+}
+
+/*
+ * Constructs one of several evaluators of 'number_of_samples', and assigns
+ * its batch values of x (two per x for the phasor) to 'out':
+ */
+typedef void (* PoolConstruction) (
+   size_t number_of_samples,
+   double const * x,
+   double * out,
+   size_t length
+   );
+
+static
+void
+construct_sind(
+   size_t number_of_samples,
+   double const * x,
+   double * out,
+   size_t length
+   )
+{
+   VARRSinDEvaluator
+      evaluator = sampling_sind(number_of_samples);
+   evaluator.sind_array(x, out, length, evaluator.accelerator);
+   evaluator.disallocate(&evaluator);
+}
+
+static
+void
+construct_expd(
+   size_t number_of_samples,
+   double const * x,
+   double * out,
+   size_t length
+   )
+{
+   VARRExpDEvaluator
+      evaluator = shifting_linear_sampling_expd(number_of_samples);
+   evaluator.expd_array(x, out, length, evaluator.accelerator);
+   evaluator.disallocate(&evaluator);
+}
+
+static
+void
+construct_phasord(
+   size_t number_of_samples,
+   double const * x,
+   double * out,
+   size_t length
+   )
+{
+   VARRPhasorDEvaluator
+      evaluator = linear_interpolating_phasord(number_of_samples);
+   evaluator.phasord_array(
+      x, (double complex *) out, length, evaluator.accelerator
+      );
+   evaluator.disallocate(&evaluator);
+}
+
+static
+void
+construct_cubic_phasord(
+   size_t number_of_samples,
+   double const * x,
+   double * out,
+   size_t length
+   )
+{
+   VARRPhasorDEvaluator
+      evaluator = cubic_spline_sampling_phasord(number_of_samples);
+   evaluator.phasord_array(
+      x, (double complex *) out, length, evaluator.accelerator
+      );
+   evaluator.disallocate(&evaluator);
+}
+
+static
+void
+construct_linbuf(
+   size_t number_of_samples,
+   double const * x,
+   double * out,
+   size_t length
+   )
+{
+   double
+      frequency = 3.;
+   VARRBoundGLBAccelerator
+      evaluator = bound_general_linbuf(
+         number_of_samples, 0., 2., cos_delegate, &frequency
+         );
+   evaluator.batch(x, out, length, evaluator.accelerator);
+   evaluator.disallocate(&evaluator);
+}
+
+typedef struct tagPoolTestCase {
+   char const *
+      name;
+   PoolConstruction
+      construct;
+} PoolTestCase;
+
+static PoolTestCase const
+   pool_cases[POOL_NUMBER_OF_CASES] = {
+      { "sampling_sind", construct_sind },
+      { "shifting_linear_sampling_expd", construct_expd },
+      { "linear_interpolating_phasord", construct_phasord },
+      { "cubic_spline_sampling_phasord", construct_cubic_phasord },
+      { "bound_general_linbuf", construct_linbuf }
+   };
+
+/*
+ * Returns the greatest difference between the values of the evaluators of a
+ * case constructed serially and on POOL_TEST_THREADS threads (of which real
+ * evaluators assign only the first half):
+ */
+static
+double
+parallel_construction_test(PoolTestCase const * test_case, double const * x)
+{
+   double * const
+      serial = (double *) calloc(2u * POOL_TEST_LENGTH, sizeof(double));
+   double * const
+      parallel = (double *) calloc(2u * POOL_TEST_LENGTH, sizeof(double));
+   double
+      difference = 0.;
+   varr_set_table_construction_threads(1u);
+   varr_set_linbuf_construction_threads(1u);
+   test_case->construct(POOL_TEST_SAMPLES, x, serial, POOL_TEST_LENGTH);
+   varr_set_table_construction_threads(POOL_TEST_THREADS);
+   varr_set_linbuf_construction_threads(POOL_TEST_THREADS);
+   test_case->construct(POOL_TEST_SAMPLES, x, parallel, POOL_TEST_LENGTH);
+   varr_set_linbuf_construction_threads(1u);
+   for(size_t i = 0u; i< 2u * POOL_TEST_LENGTH; ++i)
+   {
+      difference = fmax(difference, fabs(serial[i] - parallel[i]));
+   }
+   free(parallel);
+   free(serial);
+   return
+      difference;
+}
+
+/*
+ * Returns the greatest difference between the rotations of 
+ * __varr_sample_rotations and the cosines and sines of libm:
+ */
+static
+double
+rotation_test(void)
+{
+   double const
+      step = 2. * M_PI / (double) POOL_TEST_SAMPLES;
+   double * const
+      values = __varr_sample_rotations(step, POOL_TEST_SAMPLES + 2u, 0u);
+   double
+      error = 0.;
+   for(size_t i = 0u; i< POOL_TEST_SAMPLES + 2u; ++i)
+   {
+      error = fmax(
+         error,
+         fmax(
+            fabs(values[2u * i] - cos(step * (double) i)),
+            fabs(values[2u * i + 1u] - sin(step * (double) i))
+            )
+         );
+   }
+   free(values);
+   return
+      error;
+}
+
+/*
+ * Reports the construction time of each case for pool_report_samples and 
+ * pool_report_threads (0 being the default), and that of the phasor table by
+ * rotation against cexp, serially:
+ */
+static
+void
+construction_benchmark(void)
+{
+   double
+      x[1u],
+      out[2u];
+   x[0u] = 1.;
+   printf(
+      "Table construction, milliseconds by samples and threads (of %zu by "
+      "default):\n",
+      varr_set_table_construction_threads(0u)
+      );
+   for(size_t c = 0u; c< POOL_NUMBER_OF_CASES; ++c)
+   {
+      for(size_t s = 0u; s< POOL_REPORT_SIZES; ++s)
+      {
+         printf(
+            "   %-30s %8zu samples:", 
+            pool_cases[c].name,
+            pool_report_samples[s]
+            );
+         for(size_t t = 0u; t< POOL_REPORT_THREADS; ++t)
+         {
+            size_t const
+               threads = varr_set_table_construction_threads(
+                  pool_report_threads[t]
+                  );
+            varr_set_linbuf_construction_threads(threads);
+            double const
+               begin = seconds_now();
+            pool_cases[c].construct(pool_report_samples[s], x, out, 1u);
+            printf(
+               " %9.2f (%zu)", 1.e3 * (seconds_now() - begin), threads
+               );
+         }
+         printf("\n");
+      }
+   }
+   varr_set_table_construction_threads(1u);
+   varr_set_linbuf_construction_threads(1u);
+   size_t const
+      samples = pool_report_samples[POOL_REPORT_SIZES - 1u];
+   double const
+      step = 2. * M_PI / (double) samples;
+   double complex * const
+      phasors = (double complex *) malloc(sizeof(double complex) * samples);
+   double
+      begin = seconds_now();
+   for(size_t i = 0u; i< samples; ++i)
+   {
+      phasors[i] = cexp(I * step * (double) i);
+   }
+   double const
+      libm_seconds = seconds_now() - begin;
+   begin = seconds_now();
+   double * const
+      rotations = __varr_sample_rotations(step, samples, 0u);
+   printf(
+      "   %zu phasors, serially: %.2f ms by cexp, %.2f ms by rotation\n",
+      samples,
+      1.e3 * libm_seconds,
+      1.e3 * (seconds_now() - begin)
+      );
+   free(rotations);
+   free(phasors);
+}
+
+/*
+ * Returns the greatest difference between the batch values of evaluators of
+ * sin and the phasor, of doubles and floats, evaluated serially and in 
+ * parallel by 'pool', for inputs of each of pool_batch_lengths:
+ */
+static
+double
+parallel_batch_test(VARRThreadPool * pool)
+{
+   size_t const
+      length = pool_batch_lengths[POOL_NUMBER_OF_LENGTHS - 1u];
+   double * const
+      x = (double *) malloc(sizeof(double) * length);
+   float * const
+      xf = (float *) malloc(sizeof(float) * length);
+   double complex * const
+      serial = (double complex *) malloc(sizeof(double complex) * length);
+   double complex * const
+      parallel = (double complex *) malloc(sizeof(double complex) * length);
+   float complex * const
+      serialf = (float complex *) malloc(sizeof(float complex) * length);
+   float complex * const
+      parallelf = (float complex *) malloc(sizeof(float complex) * length);
+   VARRSinDEvaluator
+      sind = sampling_sind(4096u);
+   VARRSinFEvaluator
+      sinf = sampling_sinf(4096u);
+   VARRPhasorDEvaluator
+      phasord = linear_interpolating_phasord(4096u);
+   VARRPhasorFEvaluator
+      phasorf = linear_interpolating_phasorf(4096u);
+   double
+      difference = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      x[i] = 20. * ((double) rand() / ((double) RAND_MAX + 1.)) - 10.;
+      xf[i] = (float) x[i];
+   }
+   for(size_t l = 0u; l< POOL_NUMBER_OF_LENGTHS; ++l)
+   {
+      size_t const
+         n = pool_batch_lengths[l];
+      // Real outputs are compared through the first n doubles or floats:
+      double * const
+         serial_real = (double *) serial;
+      double * const
+         parallel_real = (double *) parallel;
+      float * const
+         serialf_real = (float *) serialf;
+      float * const
+         parallelf_real = (float *) parallelf;
+      sind.sind_array(x, serial_real, n, sind.accelerator);
+      varr_parallel_batchd(
+         pool, sind.sind_array, x, parallel_real, n, sind.accelerator
+         );
+      sinf.sinf_array(xf, serialf_real, n, sinf.accelerator);
+      varr_parallel_batchf(
+         pool, sinf.sinf_array, xf, parallelf_real, n, sinf.accelerator
+         );
+      for(size_t i = 0u; i< n; ++i)
+      {
+         difference = fmax(
+            difference, fabs(serial_real[i] - parallel_real[i])
+            );
+         difference = fmax(
+            difference, fabs((double) (serialf_real[i] - parallelf_real[i]))
+            );
+      }
+      phasord.phasord_array(x, serial, n, phasord.accelerator);
+      varr_parallel_batch_phasord(
+         pool, phasord.phasord_array, x, parallel, n, phasord.accelerator
+         );
+      phasorf.phasorf_array(xf, serialf, n, phasorf.accelerator);
+      varr_parallel_batch_phasorf(
+         pool, phasorf.phasorf_array, xf, parallelf, n, phasorf.accelerator
+         );
+      for(size_t i = 0u; i< n; ++i)
+      {
+         difference = fmax(difference, cabs(serial[i] - parallel[i]));
+         difference = fmax(
+            difference, (double) cabsf(serialf[i] - parallelf[i])
+            );
+      }
+   }
+   phasorf.disallocate(&phasorf);
+   phasord.disallocate(&phasord);
+   sinf.disallocate(&sinf);
+   sind.disallocate(&sind);
+   free(parallelf);
+   free(serialf);
+   free(parallel);
+   free(serial);
+   free(xf);
+   free(x);
+   return
+      difference;
+}
+
+/*
+ * A batch function that records the thread that evaluates each chunk of 
+ * POOL_STEALING_CHUNKS chunks, and sleeps for those of the first quarter 
+ * (the initial share of the calling thread, of a pool of four threads):
+ */
+static
+pthread_t
+   stealing_threads[POOL_STEALING_CHUNKS];
+
+static
+void
+stealing_batch(double const * x, double * out, size_t length, void const * p)
+{
+   size_t const
+      chunk = (size_t) (x - (double const *) p) / POOL_CHUNK;
+   struct timespec const
+      delay = { 0, 1000000l };
+   stealing_threads[chunk] = pthread_self();
+   if(chunk < POOL_STEALING_CHUNKS / 4u)
+   {
+      nanosleep(&delay, NULL);
+   }
+   for(size_t i = 0u; i< length; ++i)
+   {
+      out[i] = x[i];
+   }
+}
+
+/*
+ * Returns one if the chunks of the first quarter of a batch on 'pool' were
+ * all evaluated by the same thread (ie. none were stolen), and zero if not:
+ */
+static
+double
+stealing_test(VARRThreadPool * pool)
+{
+   size_t const
+      length = POOL_STEALING_CHUNKS * POOL_CHUNK;
+   double * const
+      x = (double *) calloc(length, sizeof(double));
+   double * const
+      out = (double *) malloc(sizeof(double) * length);
+   int
+      stolen = 0;
+   varr_parallel_batchd(pool, stealing_batch, x, out, length, x);
+   for(size_t c = 1u; c< POOL_STEALING_CHUNKS / 4u; ++c)
+   {
+      stolen |= !pthread_equal(stealing_threads[c], stealing_threads[0u]);
+   }
+   free(out);
+   free(x);
+   return
+      stolen ? 0. : 1.;
+}
+
+/*
+ * Reports the throughput of the batch sampling_sind on pools of 1, 2, 4, ...
+ * threads up to the number of online processors (and four at least), 
+ * pinned and not:
+ */
+static
+void
+scaling_benchmark(void)
+{
+   double * const
+      x = (double *) malloc(sizeof(double) * POOL_SCALING_LENGTH);
+   double * const
+      out = (double *) malloc(sizeof(double) * POOL_SCALING_LENGTH);
+   VARRSinDEvaluator
+      sind = sampling_sind(1u << 20);
+   VARRThreadPool * const
+      processors = varr_create_thread_pool(0u, 0);
+   size_t const
+      most = varr_thread_pool_threads(processors);
+   double
+      one_thread = 0.;
+   varr_destroy_thread_pool(processors);
+   for(size_t i = 0u; i< POOL_SCALING_LENGTH; ++i)
+   {
+      x[i] = 20. * ((double) rand() / ((double) RAND_MAX + 1.)) - 10.;
+   }
+   // The pages of out are faulted in beforehand:
+   sind.sind_array(x, out, POOL_SCALING_LENGTH, sind.accelerator);
+   printf(
+      "Parallel batch sampling_sind of %zu inputs (%zu online processors):"
+      "\n",
+      POOL_SCALING_LENGTH,
+      most
+      );
+   for(size_t threads = 1u; ; threads *= 2u)
+   {
+      if(threads > most && threads > 4u)
+      {
+         threads = (most > 4u) ? most : 4u;
+      }
+      for(int pin = 0; pin< 2; ++pin)
+      {
+         VARRThreadPool * const
+            pool = varr_create_thread_pool(threads, pin);
+         double
+            elapsed = HUGE_VAL;
+         // The best of three:
+         for(size_t r = 0u; r< 3u; ++r)
+         {
+            double const
+               begin = seconds_now();
+            varr_parallel_batchd(
+               pool,
+               sind.sind_array,
+               x,
+               out,
+               POOL_SCALING_LENGTH,
+               sind.accelerator
+               );
+            elapsed = fmin(elapsed, seconds_now() - begin);
+         }
+         if(threads == 1u && !pin)
+         {
+            one_thread = elapsed;
+         }
+         printf(
+            "   %3zu threads%s: %.3f ns per input, %.2fx one thread\n",
+            threads,
+            pin ? " (pinned)" : "",
+            1.e9 * elapsed / (double) POOL_SCALING_LENGTH,
+            one_thread / elapsed
+            );
+         varr_destroy_thread_pool(pool);
+      }
+      if(threads >= most && threads >= 4u)
+      {
+         break;
+      }
+   }
+   sind.disallocate(&sind);
+   free(out);
+   free(x);
+}
+
+/*
+ * The evaluators of streaming_batch_test, of which 'kind' 0 to 3 evaluate
+ * sin, sin of floats, the phasor and the phasor of floats:
+ */
+typedef struct tagPoolStreamingEvaluators
+{
+   VARRSinDEvaluator
+      sind;
+   VARRSinFEvaluator
+      sinf;
+   VARRPhasorDEvaluator
+      phasord;
+   VARRPhasorFEvaluator
+      phasorf;
+} PoolStreamingEvaluators;
+
+static size_t const
+   pool_streaming_bytes[POOL_STREAMING_KINDS] = {
+      sizeof(double),
+      sizeof(float),
+      sizeof(double complex),
+      sizeof(float complex)
+   };
+
+/*
+ * Evaluates the batch of 'kind' for the n inputs x (of doubles, or floats)
+ * into out, by the batch function, or in parallel on 'pool':
+ */
+static
+void
+streaming_evaluate(
+   PoolStreamingEvaluators const * evaluators,
+   size_t kind,
+   VARRThreadPool * pool,
+   int parallel,
+   double const * x,
+   float const * xf,
+   void * out,
+   size_t n
+   )
+{
+   switch(kind)
+   {
+   case 0u:
+      if(parallel)
+      {
+         varr_parallel_batchd(
+            pool,
+            evaluators->sind.sind_array,
+            x,
+            (double *) out,
+            n,
+            evaluators->sind.accelerator
+            );
+         return;
+      }
+      evaluators->sind.sind_array(
+         x, (double *) out, n, evaluators->sind.accelerator
+         );
+      return;
+   case 1u:
+      if(parallel)
+      {
+         varr_parallel_batchf(
+            pool,
+            evaluators->sinf.sinf_array,
+            xf,
+            (float *) out,
+            n,
+            evaluators->sinf.accelerator
+            );
+         return;
+      }
+      evaluators->sinf.sinf_array(
+         xf, (float *) out, n, evaluators->sinf.accelerator
+         );
+      return;
+   case 2u:
+      if(parallel)
+      {
+         varr_parallel_batch_phasord(
+            pool,
+            evaluators->phasord.phasord_array,
+            x,
+            (double complex *) out,
+            n,
+            evaluators->phasord.accelerator
+            );
+         return;
+      }
+      evaluators->phasord.phasord_array(
+         x, (double complex *) out, n, evaluators->phasord.accelerator
+         );
+      return;
+   default:
+      if(parallel)
+      {
+         varr_parallel_batch_phasorf(
+            pool,
+            evaluators->phasorf.phasorf_array,
+            xf,
+            (float complex *) out,
+            n,
+            evaluators->phasorf.accelerator
+            );
+         return;
+      }
+      evaluators->phasorf.phasorf_array(
+         xf, (float complex *) out, n, evaluators->phasorf.accelerator
+         );
+      return;
+   }
+}
+
+/*
+ * Returns the number of batches of the evaluators of each kind, constructed
+ * for each supported SIMD level, of which the outputs streamed (by the 
+ * batch function, and in parallel on 'pool') differ from those stored as 
+ * usual, or that store outside their outputs, for each of 
+ * pool_streaming_lengths and each offset of out (by the size of its reals,
+ * and so at every alignment to a cache line, of which complex outputs at an
+ * odd offset are not aligned to their size):
+ */
+static
+double
+streaming_batch_test(VARRThreadPool * pool)
+{
+   size_t const
+      length = pool_streaming_lengths[POOL_STREAMING_LENGTHS - 1u],
+      bytes = sizeof(double complex) * (length + POOL_STREAMING_OFFSETS);
+   double * const
+      x = (double *) malloc(sizeof(double) * length);
+   float * const
+      xf = (float *) malloc(sizeof(float) * length);
+   unsigned char * const
+      expected = (unsigned char *) malloc(bytes);
+   unsigned char * const
+      streamed = (unsigned char *) malloc(bytes);
+   unsigned char * const
+      untouched = (unsigned char *) malloc(bytes);
+   VARRSimdLevel const
+      supported = varr_simd_supported_level();
+   size_t const
+      previous = varr_streaming_batch_bytes();
+   double
+      errors = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      x[i] = 20. * ((double) rand() / ((double) RAND_MAX + 1.)) - 10.;
+      xf[i] = (float) x[i];
+   }
+   memset(untouched, 0xa5, bytes);
+   for(int level = VARR_SIMD_SCALAR; level<= (int) supported; ++level)
+   {
+      varr_set_simd_level((VARRSimdLevel) level);
+      PoolStreamingEvaluators
+         evaluators = {
+            .sind = sampling_sind(4096u),
+            .sinf = sampling_sinf(4096u),
+            .phasord = linear_interpolating_phasord(4096u),
+            .phasorf = linear_interpolating_phasorf(4096u)
+         };
+      for(size_t kind = 0u; kind< POOL_STREAMING_KINDS; ++kind)
+      {
+         // The size of the reals of the outputs, by which they are offset:
+         size_t const
+            real = (kind % 2u) ? sizeof(float) : sizeof(double);
+         for(size_t l = 0u; l< POOL_STREAMING_LENGTHS; ++l)
+         {
+            size_t const
+               n = pool_streaming_lengths[l],
+               output = pool_streaming_bytes[kind] * n;
+            varr_set_streaming_batch_bytes((size_t) 0u);
+            streaming_evaluate(
+               &evaluators, kind, pool, 0, x, xf, (void *) expected, n
+               );
+            for(size_t o = 0u; o< POOL_STREAMING_OFFSETS; ++o)
+            {
+               for(int parallel = 0; parallel< 2; ++parallel)
+               {
+                  memset(streamed, 0xa5, bytes);
+                  varr_set_streaming_batch_bytes((size_t) 1u);
+                  streaming_evaluate(
+                     &evaluators,
+                     kind,
+                     pool,
+                     parallel,
+                     x,
+                     xf,
+                     (void *) (streamed + real * o),
+                     n
+                     );
+                  varr_set_streaming_batch_bytes((size_t) 0u);
+                  errors += (double) (
+                     memcmp(streamed + real * o, expected, output)
+                     || memcmp(streamed, untouched, real * o)
+                     || memcmp(
+                        streamed + real * o + output,
+                        untouched,
+                        bytes - real * o - output
+                        )
+                     );
+               }
+            }
+         }
+      }
+      evaluators.phasorf.disallocate(&evaluators.phasorf);
+      evaluators.phasord.disallocate(&evaluators.phasord);
+      evaluators.sinf.disallocate(&evaluators.sinf);
+      evaluators.sind.disallocate(&evaluators.sind);
+   }
+   varr_set_simd_level(VARR_SIMD_AVX512);
+   varr_set_streaming_batch_bytes(previous);
+   free(untouched);
+   free(streamed);
+   free(expected);
+   free(xf);
+   free(x);
+   return
+      errors;
+}
+
+/*
+ * Returns the seconds per input of the scalar sampling_sind of 'sind' for 
+ * the POOL_PROBE_LENGTH inputs x, and accumulates its values to *sum (so 
+ * that they are evaluated):
+ */
+static
+double
+probe_table(VARRSinDEvaluator const * sind, double const * x, double * sum)
+{
+   double const
+      begin = seconds_now();
+   for(size_t i = 0u; i< POOL_PROBE_LENGTH; ++i)
+   {
+      *sum += sind->sind(x[i], sind->accelerator);
+   }
+   return
+      (seconds_now() - begin) / (double) POOL_PROBE_LENGTH;
+}
+
+/*
+ * Reports the bandwidth of the outputs of the batch sampling_sind (of a 
+ * table of 8 MB), in parallel on a thread per online processor, stored as
+ * usual and streamed, for outputs within the last level cache and far 
+ * larger, and then the time of a probe of the table at random (by the 
+ * scalar evaluator), which is as long as lines of the table were evicted 
+ * by the batch:
+ */
+static
+void
+streaming_benchmark(void)
+{
+   size_t const
+      length = pool_streaming_sizes[POOL_STREAMING_SIZES - 1u];
+   double * const
+      x = (double *) malloc(sizeof(double) * length);
+   double * const
+      out = (double *) malloc(sizeof(double) * length);
+   double * const
+      probes = (double *) malloc(sizeof(double) * POOL_PROBE_LENGTH);
+   VARRSinDEvaluator
+      sind = sampling_sind(1u << 20);
+   VARRThreadPool * const
+      pool = varr_create_thread_pool(0u, 0);
+   size_t const
+      previous = varr_streaming_batch_bytes();
+   double
+      sum = 0.;
+   for(size_t i = 0u; i< length; ++i)
+   {
+      x[i] = 2. * M_PI * ((double) rand() / ((double) RAND_MAX + 1.));
+   }
+   for(size_t i = 0u; i< POOL_PROBE_LENGTH; ++i)
+   {
+      probes[i] = 2. * M_PI * ((double) rand() / ((double) RAND_MAX + 1.));
+   }
+   // The pages of out are faulted in beforehand:
+   sind.sind_array(x, out, length, sind.accelerator);
+   printf(
+      "Streamed parallel batch sampling_sind (%zu threads), and a probe of "
+      "its table after the batch:\n",
+      varr_thread_pool_threads(pool)
+      );
+   for(size_t s = 0u; s< POOL_STREAMING_SIZES; ++s)
+   {
+      size_t const
+         n = pool_streaming_sizes[s];
+      for(int streaming = 0; streaming< 2; ++streaming)
+      {
+         double
+            elapsed = HUGE_VAL,
+            probe = HUGE_VAL;
+         varr_set_streaming_batch_bytes(
+            streaming ? (size_t) 1u : (size_t) 0u
+            );
+         // The best of five, each followed by a probe of the table:
+         for(size_t r = 0u; r< 5u; ++r)
+         {
+            probe_table(&sind, probes, &sum);
+            double const
+               begin = seconds_now();
+            varr_parallel_batchd(
+               pool, sind.sind_array, x, out, n, sind.accelerator
+               );
+            elapsed = fmin(elapsed, seconds_now() - begin);
+            probe = fmin(probe, probe_table(&sind, probes, &sum));
+         }
+         printf(
+            "   %9zu KB of outputs, %s: %6.2f GB/s, probe %.2f ns\n",
+            (sizeof(double) * n) >> 10,
+            streaming ? "streamed" : "stored  ",
+            1.e-9 * (double) (sizeof(double) * n) / elapsed,
+            1.e9 * probe
+            );
+      }
+   }
+   // The probes are used:
+   printf("   (sum of the probes %g)\n", sum);
+   varr_set_streaming_batch_bytes(previous);
+   varr_destroy_thread_pool(pool);
+   sind.disallocate(&sind);
+   free(probes);
+   free(out);
+   free(x);
+}
+
+UnitTestResult
+test_varr_thread_pool(void)
+{
+   UnitTestResult
+      result = create_test_results();
+   double * const
+      x = (double *) malloc(sizeof(double) * POOL_TEST_LENGTH);
+   int const
+      cached = varr_table_cache_enabled();
+   size_t const
+      threads = varr_table_construction_threads();
+   char
+      name[160u];
+   
+   printf("Thread pool tests:\n");
+   declare_start_of_unit_test();
+   
+   srand(19u);
+   for(size_t i = 0u; i< POOL_TEST_LENGTH; ++i)
+   {
+      x[i] = 2. * ((double) rand() / ((double) RAND_MAX + 1.));
+   }
+   varr_set_table_cache_enabled(0);
+   varr_set_table_construction_threads(POOL_TEST_THREADS);
+   numerical_error_unit_test(
+      &result,
+      "varr-thread-pool",
+      "Parallel loops visit each index once",
+      coverage_test(0),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-thread-pool",
+      "Nested parallel loops visit each index once",
+      coverage_test(1),
+      0.5
+      );
+   for(size_t c = 0u; c< POOL_NUMBER_OF_CASES; ++c)
+   {
+      snprintf(
+         name,
+         sizeof(name),
+         "%s is the same constructed on %zu threads as on one",
+         pool_cases[c].name,
+         POOL_TEST_THREADS
+         );
+      numerical_error_unit_test(
+         &result,
+         "varr-thread-pool",
+         name,
+         parallel_construction_test(pool_cases + c, x),
+         DBL_MIN
+         );
+   }
+   numerical_error_unit_test(
+      &result,
+      "varr-thread-pool",
+      "The delegates of linbufs are called from the constructing thread "
+      "alone by default",
+      serial_delegate_test(),
+      0.5
+      );
+   numerical_error_unit_test(
+      &result,
+      "varr-thread-pool",
+      "Phasors sampled by rotation are within eight ulps of libm",
+      rotation_test(),
+      8. * DBL_EPSILON
+      );
+   
+   
+   for(int pin = 0; pin< 2; ++pin)
+   {
+      VARRThreadPool * const
+         pool = varr_create_thread_pool(POOL_TEST_THREADS, pin);
+      snprintf(
+         name,
+         sizeof(name),
+         "Batches are the same evaluated on %zu%s threads as on one",
+         varr_thread_pool_threads(pool),
+         pin ? " pinned" : ""
+         );
+      numerical_error_unit_test(
+         &result, "varr-thread-pool", name, parallel_batch_test(pool), DBL_MIN
+         );
+      numerical_error_unit_test(
+         &result,
+         "varr-thread-pool",
+         pin ?
+            "Streamed batches are the same as stored batches (pinned)"
+            :
+            "Streamed batches are the same as stored batches",
+         streaming_batch_test(pool),
+         0.5
+         );
+      numerical_error_unit_test(
+         &result,
+         "varr-thread-pool",
+         pin ? 
+            "Threads steal the chunks of a slow thread (pinned)"
+            :
+            "Threads steal the chunks of a slow thread",
+         stealing_test(pool),
+         0.5
+         );
+      varr_destroy_thread_pool(pool);
+   }
+   
+   declare_end_of_unit_test();
+   construction_benchmark();
+   scaling_benchmark();
+   streaming_benchmark();
+   varr_set_table_construction_threads(threads);
+   varr_set_table_cache_enabled(cached);
+   
+   free(x);
+   return
+      result;
+}
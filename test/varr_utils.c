@@ -18,7 +18,11 @@
  *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "varr_utils.h"
+
 #include <complex.h>
+#include <math.h>
+#include <time.h>
 
 void
 preserve(double * p)
@@ -31,3 +35,65 @@ preserve_complex(double complex * p)
 {
    return;
 }
+
+double
+timing_in_nanoseconds_per_element(
+   clock_t begin,
+   clock_t end,
+   size_t elements
+   )
+{
+   return
+      (end - begin) * (1.e9 / CLOCKS_PER_SEC) / (double) elements;
+}
+
+double
+seconds_now(void)
+{
+   struct timespec
+      now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return
+      (double) now.tv_sec + 1.e-9 * (double) now.tv_nsec;
+}
+
+double
+count_error(size_t before, size_t after, size_t expected)
+{
+   return
+      fabs((double) (after - before) - (double) expected);
+}
+
+double
+cos_delegate(double x, void * argument)
+{
+   return
+      (argument == NULL) ?
+         cos(x)
+         :
+         cos(*((double const *) argument) * x);
+}
+
+void
+numerical_error_unit_test(
+   UnitTestResult * result,
+   char const * test_group_name,
+   char const * unit_test_name,
+   double numerical_error,
+   double worst_allowed_numerical_error
+   )
+{
+   UnitTestResult
+      unit_test_result = create_test_results();
+   unit_test_result.test_message =
+      create_message_specific_to_numerical_error_test_case(
+         test_group_name,
+         unit_test_name,
+         numerical_error,
+         worst_allowed_numerical_error
+         );
+   update_test_results_for_numerical_error_test_case(
+      &unit_test_result, numerical_error, worst_allowed_numerical_error
+      );
+   combine_test_results(unit_test_result, result);
+}
@@ -21,7 +21,11 @@
 #ifndef __VARR_UTILS_H__
 #define __VARR_UTILS_H__
 
+#include "varr_test.h"
+
 #include <complex.h>
+#include <stddef.h>
+#include <time.h>
 
 void
 preserve(double *);
@@ -29,4 +33,48 @@ preserve(double *);
 void
 preserve_complex(double complex *);
 
+/*
+ * Returns the nanoseconds per element of 'elements' evaluations, timed by 
+ * clock() from 'begin' to 'end':
+ */
+double
+timing_in_nanoseconds_per_element(
+   clock_t begin,
+   clock_t end,
+   size_t elements
+   );
+
+/*
+ * Returns the time of the monotonic clock, in seconds:
+ */
+double
+seconds_now(void);
+
+/*
+ * Returns the difference of the changes in a count from 'before' to 'after',
+ * and 'expected', as a double:
+ */
+double
+count_error(size_t before, size_t after, size_t expected);
+
+/*
+ * A bound_general_linbuf delegate: cos(x), or cos(k * x) if 'argument' 
+ * points to a double k.
+ */
+double
+cos_delegate(double x, void * argument);
+
+/*
+ * Adds a numerical error test case, 'unit_test_name' of the test group 
+ * 'test_group_name', to 'result':
+ */
+void
+numerical_error_unit_test(
+   UnitTestResult * result,
+   char const * test_group_name,
+   char const * unit_test_name,
+   double numerical_error,
+   double worst_allowed_numerical_error
+   );
+
 #endif /* __VARR_UTILS_H__ */
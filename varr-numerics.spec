@@ -13,8 +13,6 @@ BuildRequires: cmake3-data
 BuildRequires: pkgconfig
 BuildRequires: make
 BuildRequires: gcc
-BuildRequires: gsl-devel
-Requires:      gsl
 
 %description
 %{summary}
@@ -22,7 +20,6 @@ Requires:      gsl
 %package devel
 Summary: %{summary} -- development package
 Requires: %{name} = %{version}
-Requires: gsl-devel
 %description devel
 %{summary}
 
@@ -21,10 +21,6 @@
 #ifndef __VARR_H__
 #define __VARR_H__
 
-#define __VARR_HAS_AVX__
-
-// #define __VARR_USE_AVX512__
-
 #include "varr_all.h"
 
 #endif /* __VARR_H__ */
@@ -28,7 +28,8 @@
  * function, pow(x, 3./4.).
  * 
  * This implementation provides a scalar real pow(x, 3./4.) root function 
- * named 'threequartersd'.
+ * named 'threequartersd' and a vector real pow(x, 3./4.) function named
+ * 'threequartersd_array'.
  */
 typedef struct tagVARR3Over4DEvaluator
 {
@@ -42,6 +43,32 @@ typedef struct tagVARR3Over4DEvaluator
    double (* threequartersd) (double, void const * accelerator);
    
    int (* disallocate) (struct tagVARR3Over4DEvaluator *);
+   
+   /*
+    * A vectorized VARR real pow(x, 3./4.) function.  The meaning of arguments 
+    * to this method are as follows:
+    * 
+    *    i..   'in' - a const array of doubles, being the values of x to 
+    *          process;
+    *    ii.   'out' - an array of doubles of (at least) the same length as 
+    *          (i.), being the values of pow(x, 3./4.) to assign;
+    *    iii.  'length' - the length of the arrays (i.) and (ii.) above.
+    *,   iv.   'accelerator' - the value of the above enclosed (void *) 
+    *          accelerator.
+    *
+    * It is the responsibility of the caller to ensure that the arrays (i.) and 
+    * (ii.) both have size (iii.).
+    *
+    * It is not necessary for the arrays (i.) or (ii.) to have any specific
+    * alignments.  If this library is compiled without AVX extensions enabled,
+    * this method will delegate to the above scalar VARR implementation of 
+    * the real pow(x, 3./4.) function.
+    */
+   void (* threequartersd_array) (
+      double const * in, double * out,
+      size_t length, 
+      void const * accelerator
+      );
 } VARR3Over4DEvaluator;
 
 /*
@@ -50,7 +77,7 @@ typedef struct tagVARR3Over4DEvaluator
  * for further information.
  *
  * This implementation uses linear interpolation techniques combined with 
- * sampling and a modified De-Bruijn-like method to compute the value of 
+ * sampling and IEEE-754 exponent range reduction to compute the value of 
  * pow(x, 3./4.).
  * 
  * This function allocates a sampling grid of real pow(x, 3./4.) values.
@@ -62,8 +89,10 @@ typedef struct tagVARR3Over4DEvaluator
  * sampling points requested.
  *
  * When evaluating pow(x, 3/4.) (VARR3Over4DEvaluator.threequartersd(x)) using 
- * this method, all arguments x must be finite real numbers confined to the 
- * range 10**-18 < x < 10**+18.
+ * this method, all arguments x must be positive normal (ie. neither subnormal
+ * nor infinite) real numbers, DBL_MIN <= x <= DBL_MAX.  x is split as 
+ * m * 2**k from its exponent and mantissa fields, and pow(m, 3/4.) is 
+ * sampled for 1 <= m <= 2.
  */
 VARR3Over4DEvaluator
 linear_sampling_normalizing_3over4d(size_t number_of_samples);
@@ -29,8 +29,18 @@
 #include "varr_log.h"
 #include "varr_phasor.h"
 #include "varr_sin.h"
+#include "varr_sincos.h"
 #include "varr_sixth_root.h"
 #include "varr_3_over_4.h"
 #include "varr_general_bound_linbuf.h"
+#include "varr_simd.h"
+#include "varr_table_layout.h"
+#include "varr_table_cache.h"
+#include "varr_table_file.h"
+#include "varr_table_memory.h"
+#include "varr_allocator.h"
+#include "varr_octant.h"
+#include "varr_thread_pool.h"
+#include "varr_progression.h"
 
 #endif /* __VARR_ALL_H__ */
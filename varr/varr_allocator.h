@@ -0,0 +1,249 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_ALLOCATOR_H__
+#define __VARR_ALLOCATOR_H__
+
+#include <stddef.h>
+
+#include "varr_3_over_4.h"
+#include "varr_atan.h"
+#include "varr_cos.h"
+#include "varr_exp.h"
+#include "varr_general_bound_linbuf.h"
+#include "varr_log.h"
+#include "varr_octant.h"
+#include "varr_phasor.h"
+#include "varr_sin.h"
+#include "varr_sincos.h"
+#include "varr_sixth_root.h"
+
+/*
+ * A source of memory for the evaluators of the *_with_allocator 
+ * constructors below, eg. an arena, pinned memory, or a shared segment:
+ *
+ *    i.    'allocate' returns 'bytes' bytes, aligned for any type (as 
+ *          malloc), or NULL;
+ *    ii.   'allocate_aligned' returns 'bytes' bytes aligned to 'alignment' (a
+ *          power of two, no more than 64), or NULL;
+ *    iii.  'release' releases the memory of either, and may be NULL (eg. 
+ *          for an arena that is released as a whole);
+ *
+ * each of which is passed 'context'.  If 'contiguous' is nonzero, the 
+ * accelerator of an evaluator and all of its tables are placed in a single 
+ * block of 'allocate_aligned', which is released (once) when the evaluator 
+ * is disallocated.  The size of the block is computed beforehand, from the
+ * number of samples and the table format, and the evaluator is then 
+ * constructed once, in the block.
+ *
+ * Evaluators of an allocator do not share their tables (see 
+ * varr_table_cache.h): each holds a copy of the cached table in its own 
+ * memory.  Each allocation is preceded by a header of VARR's (of up to 64
+ * bytes), and VARR keeps a few bytes of bookkeeping of its own per 
+ * allocation, so that an evaluator must still be disallocated before its 
+ * memory is released.  The allocator is copied, and need not outlive the call.
+ */
+typedef struct tagVARRAllocator {
+   void * (* allocate) (size_t bytes, void * context);
+   void * (* allocate_aligned) (
+      size_t alignment,
+      size_t bytes,
+      void * context
+      );
+   void (* release) (void * memory, void * context);
+   void *
+      context;
+   int
+      contiguous;
+} VARRAllocator;
+
+/*
+ * As the constructors of the same names (without the suffix), with the 
+ * memory of the evaluator from 'allocator'.  These constructors are thread
+ * safe as their counterparts are.
+ */
+
+VARRExpDEvaluator
+shifting_linear_sampling_expd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRExpDEvaluator
+scaling_series_expd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRExpFEvaluator
+linear_sampling_expf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRLogDEvaluator
+normalizing_linear_sampling_logd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRLogDEvaluator
+normalizing_sublinear_sampling_logd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRLogFEvaluator
+normalizing_linear_sampling_logf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSinDEvaluator
+sampling_sind_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSinDEvaluator
+cubic_spline_sampling_sind_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSinFEvaluator
+sampling_sinf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRCosDEvaluator
+sampling_cosd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRCosDEvaluator
+cubic_spline_sampling_cosd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRCosFEvaluator
+sampling_cosf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSinCosDEvaluator
+sampling_sincosd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSinCosDEvaluator
+cubic_spline_sampling_sincosd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRPhasorDEvaluator
+cubic_spline_sampling_phasord_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRPhasorDEvaluator
+linear_interpolating_phasord_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRPhasorFEvaluator
+linear_interpolating_phasorf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSinDEvaluator
+octant_sampling_sind_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRCosDEvaluator
+octant_sampling_cosd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRPhasorDEvaluator
+octant_linear_interpolating_phasord_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRAtanDEvaluator
+clamping_linear_interpolating_atand_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRAtanFEvaluator
+reflecting_linear_interpolating_atanf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSixthRootDEvaluator
+linear_sampling_normalizing_sixth_rootd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSixthRootDEvaluator
+sublinear_sampling_normalizing_sixth_rootd_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRSixthRootFEvaluator
+linear_sampling_normalizing_sixth_rootf_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARR3Over4DEvaluator
+linear_sampling_normalizing_3over4d_with_allocator(
+   size_t number_of_samples,
+   VARRAllocator const * allocator
+   );
+
+VARRBoundGLBAccelerator
+bound_general_linbuf_with_allocator(
+   size_t number_of_samples,
+   double min_x,
+   double max_x,
+   double (* delegate) (double x, void *),
+   void * specialization,
+   VARRAllocator const * allocator
+   );
+
+#endif /* __VARR_ALLOCATOR_H__ */
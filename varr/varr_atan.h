@@ -94,4 +94,40 @@ typedef struct tagVARRAtanDEvaluator {
 VARRAtanDEvaluator
 clamping_linear_interpolating_atand(size_t number_of_samples);
 
+/*
+ * An object that provides a single precision VARR implementation of the real
+ * arctangent function, with the scalar and vector functions 'atanf' and 
+ * 'atanf_array', which are as 'atan' and 'atan_array' of VARRAtanDEvaluator
+ * for floats.  The vector function processes 8 (AVX2) or 16 (AVX-512) 
+ * floats per instruction.
+ */
+typedef struct tagVARRAtanFEvaluator {
+   void const * accelerator;
+   
+   float (* atanf) (float, void const * accelerator);
+   
+   void (* atanf_array) (
+      float const * in, float * out, 
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRAtanFEvaluator *);
+   
+} VARRAtanFEvaluator;
+
+/*
+ * Returns an object that provides a single precision VARR implementation of
+ * the real arctangent function.  See documentation for the type 
+ * VARRAtanFEvaluator for further information.
+ *
+ * Unlike clamping_linear_interpolating_atand, this method does not clamp x:
+ * atan(x) is reflected as atan(x) = sign(x) (pi/2 - atan(1/|x|)) for |x| > 1,
+ * and atan is interpolated linearly on [0, 1], in a float table of 
+ * 'number_of_samples' (which must be at least two) samples of 8 bytes each.
+ * 4096 samples (32 KB) are accurate to about 1.5e-7.
+ */
+VARRAtanFEvaluator
+reflecting_linear_interpolating_atanf(size_t number_of_samples);
+
 #endif /* __VARR_ATAN_H__ */
@@ -26,8 +26,11 @@
 /*
  * An object that provides a VARR implementation of the real cosine function.
  * 
- * This implementation provides a scalar cosine function, 'cosd', a function 
- * accepting one real number, x, and returning a VARR approximation of cos(x)
+ * This implementation provides scalar and vector cosine functions as 
+ * follows:
+ *    i.    'cosd' - a function accepting one real number, x, and returning 
+ *          a VARR approximation of cos(x);
+ *    ii.   'cosd_array' - a vectorized version of (i.).
  */
 typedef struct tagVARRCosDEvaluator {
    void const * accelerator;
@@ -39,6 +42,32 @@ typedef struct tagVARRCosDEvaluator {
    double (* cosd) (double, void const * accelerator);
    
    int (* disallocate) (struct tagVARRCosDEvaluator *);
+   
+   /*
+    * A vectorized VARR real cosine function.  The meaning of arguments to 
+    * this method are as follows:
+    * 
+    *    i.    'in' - a const array of doubles, being the values of x to 
+    *          process;
+    *    ii.   'out' - an array of doubles of (at least) the same length as 
+    *          (i.), being the values of cos(x) to assign;
+    *    iii.  'length' - the length of the arrays (i.) and (ii.) above;
+    *    iv.   'accelerator' - the value of the above enclosed (void *) 
+    *          accelerator.
+    *
+    * It is the responsibility of the caller to ensure that the arrays (i.) and 
+    * (ii.) both have size (iii.).  The outputs agree with those of the scalar 
+    * function, 'cosd', to within rounding.
+    *
+    * It is not necessary for the arrays (i.) or (ii.) to have any specific
+    * alignments.  The SIMD instruction set used by this method is selected at 
+    * run time (see varr_simd.h).
+    */
+   void (* cosd_array) (
+      double const * in, double * out,
+      size_t length, 
+      void const * accelerator
+      );
 } VARRCosDEvaluator;
 
 /*
@@ -76,4 +105,41 @@ sampling_cosd(size_t number_of_samples);
 VARRCosDEvaluator
 cubic_spline_sampling_cosd(size_t number_of_samples);
 
+/*
+ * An object that provides a single precision VARR implementation of the real
+ * cosine function, with the scalar and vector functions 'cosf' and 
+ * 'cosf_array', which are as 'cosd' and 'cosd_array' of VARRCosDEvaluator 
+ * for floats.  The vector function processes 8 (AVX2) or 16 (AVX-512) 
+ * floats per instruction.
+ */
+typedef struct tagVARRCosFEvaluator {
+   void const * accelerator;
+   
+   float (* cosf) (float, void const * accelerator);
+   
+   void (* cosf_array) (
+      float const * in, float * out,
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRCosFEvaluator *);
+} VARRCosFEvaluator;
+
+/*
+ * Returns an object that provides a single precision VARR implementation of
+ * the real cosine function.  See documentation for the type 
+ * VARRCosFEvaluator for further information.
+ *
+ * x is reduced modulo 2 pi, and cos is interpolated linearly over one 
+ * period, in a float table of 'number_of_samples' (which must be at least 
+ * two) samples of 8 bytes each.  4096 samples (32 KB) are accurate to about
+ * 6e-7 for |x| <= 1000, which is the resolution of the float sampling 
+ * coordinate; more samples do not improve on this.  The reduction is 
+ * accurate for |x| < 10**4, beyond which the error grows in proportion to
+ * |x|.
+ */
+VARRCosFEvaluator
+sampling_cosf(size_t number_of_samples);
+
 #endif /* __VARR_COS_H__ */
@@ -95,4 +95,63 @@ typedef struct tagVARRExpDEvaluator {
 VARRExpDEvaluator
 shifting_linear_sampling_expd(size_t number_of_samples);
 
+/*
+ * Returns an object that provides a VARR implementation of the real 
+ * exponential function.   See documentation for the type VARRExpDEvaluator
+ * for further information.
+ * 
+ * This function reduces x by log(2)/N, exp(x) = 2**k * 2**(j/N) * exp(r) for
+ * 0 <= j < N and 0 <= r < log(2)/N, where 2**k is written directly to the 
+ * exponent bits of a tabulated 2**(j/N), and exp(r) is evaluated by a short
+ * series.  The table size, N, is the argument 'number_of_samples' rounded up
+ * to a power of two (at most 2**20).  Its evaluation therefore takes a single
+ * table lookup, from a table of 8 N bytes.  N = 256 (a 2 KB table) is 
+ * accurate to about the rounding of double precision arithmetic, and N = 64
+ * to about 3e-15.
+ *
+ * The evaluators of this object return zero for x < -708.39, where exp(x)
+ * would be subnormal, and do not return meaningful values for x > 709.78.
+ */
+VARRExpDEvaluator
+scaling_series_expd(size_t number_of_samples);
+
+/*
+ * An object that provides a single precision VARR implementation of the real
+ * exponential function, with the scalar and vector functions 'expf' and 
+ * 'expf_array', which are as 'expd' and 'expd_array' of VARRExpDEvaluator 
+ * for floats.  The vector function processes 8 (AVX2) or 16 (AVX-512) floats
+ * per instruction.
+ */
+typedef struct tagVARRExpFEvaluator {
+   void const * accelerator;
+   
+   float (* expf) (float, void const * accelerator);
+   
+   void (* expf_array) (
+      float const * in, float * out,
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRExpFEvaluator *);
+} VARRExpFEvaluator;
+
+/*
+ * Returns an object that provides a single precision VARR implementation of
+ * the real exponential function.  See documentation for the type 
+ * VARRExpFEvaluator for further information.
+ * 
+ * This function reduces x by log(2), exp(x) = 2**k * 2**f for 0 <= f < 1,
+ * where 2**k is written directly to the exponent bits of 2**f, and 2**f is
+ * interpolated linearly in a float table of 'number_of_samples' (which must
+ * be at least two) samples on [0, 1].  The table takes 8 bytes per sample;
+ * 4096 samples (32 KB) are accurate to about 1.1e-7 (relative), near the 
+ * rounding of single precision arithmetic.
+ *
+ * The evaluators of this object clamp x to [-87.33, 88.72], the range of
+ * normal float values of exp(x).
+ */
+VARRExpFEvaluator
+linear_sampling_expf(size_t number_of_samples);
+
 #endif /* __VARR_EXP_H__ */
@@ -87,13 +87,18 @@ typedef struct tagVARRBoundGLBAccelerator {
  * to the number of sampling points requested.  The numerical accuracy of the 
  * VARR function that is generated by this method generally increases with the 
  * number of sampling points requested if d is smooth and does not vary 
- * aggressively in x.
+ * aggressively in x.  The delegate is called from the calling thread, unless
+ * varr_set_linbuf_construction_threads (see varr_thread_pool.h) selects 
+ * more threads to sample the grid, when it must be thread safe.
  *
  * This function does not return meaningful values if the inputs min_x or max_x
  * are not finite real numbers for which min_x < max_x. The 
  * VARRBoundGLBAccelerator object returned by this method will clamp any finite
  * evaluation point (x) into the range [min_x, max_x].
  * 
+ * If the grid or the evaluator cannot be allocated, the 'accelerator' of the
+ * object returned is NULL (and its 'disallocate' returns 1).
+ * 
  * It is the responsibility of the caller to ensure that pointer arguments 
  * supplied reference valid objects and are not null.
  */
@@ -106,4 +111,40 @@ bound_general_linbuf(
    void * specialization
    );
 
+/*
+ * As bound_general_linbuf, but the sampling grid is filled lazily, in blocks
+ * of 512 samples (a 4 KB page): the delegate is evaluated for the samples of
+ * a block when the first point (x) that is interpolated from them is 
+ * evaluated, and construction evaluates only the blocks of min_x and max_x.
+ * Blocks are filled once, by whichever thread evaluates them first (any 
+ * other waits for it), and are read without locking once filled.  The values
+ * of the grid are those of bound_general_linbuf, in double precision and 
+ * VARR_TABLE_VALUES layout (see varr_table_layout.h).  The 
+ * delegate must be thread safe if the linbuf is evaluated (or prefetched, 
+ * below) from several threads, and stay valid for as long as the linbuf.
+ */
+VARRBoundGLBAccelerator
+lazy_bound_general_linbuf(
+   size_t number_of_samples,
+   double min_x,
+   double max_x,
+   double (* delegate) (double x, void *),
+   void * specialization
+   );
+
+/*
+ * Fills the blocks of the sampling grid of a linbuf of 
+ * lazy_bound_general_linbuf that are needed to evaluate the points [from_x,
+ * to_x] (clamped to [min_x, max_x]), on varr_linbuf_construction_threads()
+ * threads (see varr_thread_pool.h), and returns 0, or 1 if 'linbuf' (or its
+ * accelerator) is NULL.  The grids of bound_general_linbuf are filled 
+ * already.
+ */
+int
+varr_prefetch_linbuf(
+   VARRBoundGLBAccelerator const * linbuf,
+   double from_x,
+   double to_x
+   );
+
 #endif /* __VARR_GENERAL_BOUND_LINBUF_H__ */
@@ -23,39 +23,981 @@
 
 #include "varr.h"
 
-#ifdef __VARR_USE_AVX512__
-#ifndef __VARR_HAS_AVX__
-#define __VARR_HAS_AVX__
-#endif
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Batch (array) functions are compiled once per SIMD target and selected at
+ * run time (see varr_simd.h).  Run time selection requires GCC (or clang)
+ * function multi-versioning on x86-64; elsewhere, or if
+ * __VARR_NO_SIMD_DISPATCH__ is defined, only the scalar variants are built.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+   && !defined(__VARR_NO_SIMD_DISPATCH__)
+#define __VARR_HAS_SIMD_DISPATCH__
 #endif
 
-#ifdef __VARR_HAS_AVX__
+#define __VARR_SIMD_TARGET_AVX2__ 1
+#define __VARR_SIMD_TARGET_AVX512__ 2
 
+#ifdef __VARR_HAS_SIMD_DISPATCH__
 #include <x86intrin.h>
-
-#ifndef __VARR_USE_AVX512__
-typedef
-   __m256d
-   avxd_array_t;
-#define __AVX_DOUBLE_STRIDE__ ((size_t) 4u)
-#define _avxd_stride_max _mm256_max_pd
-#define _avxd_stride_min _mm256_min_pd
-#define _avxd_stride_floor _mm256_floor_pd
-#define _avxd_stride_set _mm256_set_pd
-#define _avxd_stride_set_duplicates _mm256_set1_pd
+#define __varr_simd_select(name) \
+   ((varr_simd_level() >= VARR_SIMD_AVX512) ? name##_avx512 : \
+      ((varr_simd_level() >= VARR_SIMD_AVX2) ? name##_avx2 : name##_scalar))
 #else
-typedef
-   __m512d
-   avxd_array_t;
-#define __AVX_DOUBLE_STRIDE__ ((size_t) 8u)
-#define _avxd_stride_max _mm512_max_pd
-#define _avxd_stride_min _mm512_min_pd
-#define _avxd_stride_floor _mm512_floor_pd
-#define _avxd_stride_set _mm512_set_pd
-#define _avxd_stride_set_duplicates _mm512_set1_pd
-#endif
+#define __varr_simd_select(name) name##_scalar
 #endif
 
+/*
+ * The size of the outputs of a batch from which the SIMD batch kernels of 
+ * this thread store them by non-temporal stores, or zero (see 
+ * varr_set_streaming_batch_bytes in varr_simd.h):
+ */
+extern __thread size_t
+   __varr_streaming_batch_bytes;
+
+/*
+ * Returns nonzero if a batch of 'length' outputs of 'bytes' bytes each, at 
+ * 'out', is to be stored by non-temporal stores aligned to 'alignment' 
+ * bytes, and then assigns the number of outputs before the first aligned 
+ * one to *head.  Outputs that cannot be aligned (eg. double complex values
+ * at an odd multiple of 8 bytes) are stored as usual.
+ */
+static inline
+int
+__varr_streaming_batch(
+   void const * out,
+   size_t length,
+   size_t bytes,
+   size_t alignment,
+   size_t * head
+   )
+{
+   size_t const
+      misalignment = (size_t) ((uintptr_t) out % alignment);
+   if(
+      (__varr_streaming_batch_bytes == (size_t) 0u)
+      || (length * bytes < __varr_streaming_batch_bytes)
+      || (misalignment % bytes != (size_t) 0u)
+      )
+   {
+      return 0;
+   }
+   *head = ((alignment - misalignment) % alignment) / bytes;
+   if(*head > length)
+   {
+      *head = length;
+   }
+   return 1;
+}
+
+/*
+ * Returns the coefficients of the natural cubic spline through the
+ * 'number_of_samples' (at least two) uniformly spaced 'values', as four
+ * doubles per interval: on interval i, with t in [0, 1] the fractional
+ * position within that interval, the spline is
+ *
+ *    c[4i] + t * (c[4i + 1] + t * (c[4i + 2] + t * c[4i + 3])).
+ *
+ * This is the spline of GSL's gsl_interp_cspline, in a form suitable for
+ * vectorized (gathering) evaluation.  The result is allocated with malloc.
+ */
+double *
+__varr_natural_cubic_spline_coefficients(
+   double const * values,
+   size_t number_of_samples
+   );
+
+/*
+ * Returns the value of a spline of __varr_natural_cubic_spline_coefficients
+ * at a fraction 'alpha' of interval 'index', by Horner's scheme, as the 
+ * batch evaluators do:
+ */
+static inline
+double
+__varr_evaluate_cubic_spline(
+   double const * const coefficients,
+   size_t const index,
+   double const alpha
+   )
+{
+   register double const * const
+      coefficient = coefficients + (size_t) 4u * index;
+   return
+      coefficient[0u] + alpha * (
+         coefficient[1u] + alpha * (coefficient[2u] + alpha * coefficient[3u])
+         );
+}
+
+/*
+ * Returns the coefficients, in the same form, of a cubic spline through the
+ * samples function(i * step) on 'number_of_intervals' intervals from zero.
+ * The spline is cut from a natural spline through a longer range of samples,
+ * so that it does not suffer from the natural end conditions, ie. so that 
+ * it is as accurate at its ends as in its interior.
+ */
+double *
+__varr_padded_cubic_spline_coefficients(
+   double (* function) (double),
+   double step,
+   size_t number_of_intervals
+   );
+
+#define __VARR_CACHE_LINE_BYTES__ ((size_t) 64u)
+
+/*
+ * Returns 'bytes' of memory for a table, 64 byte aligned, and backed by the 
+ * pages of __varr_table_format() (see varr_table_memory.h), or NULL.  Every 
+ * table (including the sections of the images of the table cache) is 
+ * allocated so, and is released by __varr_table_free.
+ */
+void *
+__varr_table_allocate(size_t bytes);
+
+/*
+ * Releases a table of __varr_table_allocate, or does nothing for NULL.
+ */
+void
+__varr_table_free(void * table);
+
+/*
+ * The phases of the construction of an evaluator with a VARRAllocator (see 
+ * varr_allocator.h), as returned by __varr_allocation_phase: none (of 
+ * evaluators of the heap), the measurement of the size of the block of a 
+ * contiguous evaluator, or the allocation of private memory (individually or
+ * from the block).
+ */
+#define __VARR_ALLOCATION_NONE__ 0
+#define __VARR_ALLOCATION_MEASURING__ 1
+#define __VARR_ALLOCATION_PRIVATE__ 2
+
+/*
+ * Returns 'bytes' of memory for an evaluator (eg. for its accelerator), 
+ * aligned to 'alignment' (a power of two), of the allocator of the 
+ * evaluator under construction in this thread, or of the heap.  The memory 
+ * is preceded by a header that tells __varr_free, which releases it, where 
+ * it came from.
+ */
+void *
+__varr_allocate(size_t alignment, size_t bytes);
+
+/*
+ * Releases memory of __varr_allocate, or does nothing for NULL.
+ */
+void
+__varr_free(void * memory);
+
+/*
+ * Begins the construction of an evaluator with 'allocator' in this thread,
+ * in the measuring phase if allocator->contiguous is set, and returns the 
+ * construction that it interrupts (if any) for __varr_end_allocation.
+ */
+void *
+__varr_begin_allocation(VARRAllocator const * allocator);
+
+int
+__varr_allocation_phase(void);
+
+/*
+ * Ends the measuring phase: the measured allocations of the construction 
+ * that follows are placed in a block of the allocator.
+ */
+void
+__varr_place_allocation(void);
+
+/*
+ * Records an allocation of 'bytes' (eg. of __varr_allocate, or of a private 
+ * copy of a cached table) of the contiguous evaluator being measured, if 
+ * any, so that its block is measured without constructing it.
+ */
+void
+__varr_allocation_measure(size_t bytes);
+
+/*
+ * Suspends the construction in progress in this thread, if any (eg. while 
+ * a shared table is built), and returns it for __varr_resume_allocation.
+ */
+void *
+__varr_suspend_allocation(void);
+
+void
+__varr_resume_allocation(void * construction);
+
+void
+__varr_end_allocation(void * previous);
+
+/*
+ * Defines constructor##_with_allocator (see varr_allocator.h), of 
+ * constructor(size_t), the allocations of which are measured by 
+ * measure_##constructor(size_t) (eg. with __varr_measure_shared_sample_table)
+ * for a contiguous evaluator, which is then constructed once, in its block:
+ */
+#define __VARR_CONSTRUCTOR_WITH_ALLOCATOR__(evaluator_type, constructor) \
+   evaluator_type \
+   constructor##_with_allocator( \
+      size_t number_of_samples, \
+      VARRAllocator const * allocator \
+      ) \
+   { \
+      void * const \
+         previous = __varr_begin_allocation(allocator); \
+      if(__varr_allocation_phase() == __VARR_ALLOCATION_MEASURING__) \
+      { \
+         measure_##constructor(number_of_samples); \
+         __varr_place_allocation(); \
+      } \
+      evaluator_type const \
+         result = constructor(number_of_samples); \
+      __varr_end_allocation(previous); \
+      return \
+         result; \
+   }
+
+/*
+ * Calls body(begin, end, argument) for consecutive ranges [begin, end) of 
+ * 'grain' indices (but the last) that partition [0, count), on up to 
+ * 'threads' threads of the construction pool of varr_thread_pool.h (eg. 
+ * varr_table_construction_threads()), including the calling thread, and 
+ * returns once all have returned.  While the pool is busy (eg. if called 
+ * from 'body'), or if 'threads' is one, body is called once, for [0, count),
+ * on the calling thread.
+ */
+void
+__varr_parallel_for(
+   size_t threads,
+   size_t count,
+   size_t grain,
+   void (* body) (size_t begin, size_t end, void const * argument),
+   void const * argument
+   );
+
+/*
+ * Returns the 'number_of_values' samples function(start_x + step_x * i, 
+ * argument), evaluated by __varr_parallel_for on 
+ * varr_table_construction_threads() threads (and so concurrently), 
+ * allocated with malloc, or NULL.
+ */
+double *
+__varr_sample_grid(
+   double (* function) (double x, void * argument),
+   void * argument,
+   double start_x,
+   double step_x,
+   size_t number_of_values
+   );
+
+/*
+ * As __varr_sample_grid, on 'threads' threads, eg. 
+ * varr_linbuf_construction_threads() for the delegates of users:
+ */
+double *
+__varr_sample_grid_on(
+   size_t threads,
+   double (* function) (double x, void * argument),
+   void * argument,
+   double start_x,
+   double step_x,
+   size_t number_of_values
+   );
+
+/*
+ * Returns the 'number_of_values' pairs (cos(step_phi * i), sin(step_phi * 
+ * i)), or (sin, cos) if cos_component is one, by rotation of every 64th 
+ * pair, which is taken from libm.  Each is within a few ulps of libm.  
+ * The result is allocated with malloc, or is NULL.
+ */
+double *
+__varr_sample_rotations(
+   double step_phi,
+   size_t number_of_values,
+   size_t cos_component
+   );
+
+/*
+ * Returns the table format (see varr_table_layout.h) of the evaluator under 
+ * construction in this thread: that of the *_with_table_format constructor 
+ * in progress, if any, or else VARR_TABLE_VALUES, VARR_TABLE_DOUBLE and 
+ * VARR_TABLE_PAGES_DEFAULT.
+ */
+VARRTableFormat
+__varr_table_format(void);
+
+/*
+ * Selects 'format' (made valid) for the evaluators constructed in this 
+ * thread, and returns the format that it replaces, for restoring afterwards.
+ */
+VARRTableFormat
+__varr_select_table_format(VARRTableFormat format);
+
+/*
+ * Defines constructor##_with_table_format (see varr_table_layout.h), of 
+ * constructor(size_t):
+ */
+#define __VARR_CONSTRUCTOR_WITH_TABLE_FORMAT__(evaluator_type, constructor) \
+   evaluator_type \
+   constructor##_with_table_format( \
+      size_t number_of_samples, \
+      VARRTableFormat format \
+      ) \
+   { \
+      VARRTableFormat const \
+         previous = __varr_select_table_format(format); \
+      evaluator_type const \
+         result = constructor(number_of_samples); \
+      __varr_select_table_format(previous); \
+      return \
+         result; \
+   }
+
+/*
+ * Returns the table of VARR_TABLE_INTERLEAVED layout (see 
+ * varr_table_layout.h) of the 'number_of_samples' (at least two) samples in
+ * 'values', of 'width' doubles each: row i of the result holds the 'width'
+ * doubles of sample i followed by their differences to sample i + 1, for
+ * i < number_of_samples - 1.  The result is allocated with 
+ * __varr_table_allocate, or is NULL.
+ */
+double *
+__varr_interleaved_table(
+   double const * values,
+   size_t number_of_samples,
+   size_t width
+   );
+
+/*
+ * A sampling table of either VARRTableLayout and VARRTablePrecision (see
+ * varr_table_layout.h), of samples of 'width' (one or two) doubles each.
+ * Either 'values' (VARR_TABLE_DOUBLE) or 'floats' is set, as laid out by
+ * 'layout'.  With VARR_TABLE_FLOAT_CORRECTED, component j of sample i is
+ * moreover corrected by correction_scale * corrections[i * width + j] (in
+ * either layout).  A table obtained from the table cache (see 
+ * __varr_shared_sample_table) refers to the cached table by 'shared', and 
+ * does not own its arrays.
+ */
+typedef struct tagVARRSampleTable
+{
+   VARRTableLayout
+      layout;
+   VARRTablePrecision
+      precision;
+   size_t
+      width;
+   double const *
+      values;
+   float const *
+      floats;
+   int16_t const *
+      corrections;
+   double
+      correction_scale;
+   void const *
+      shared;
+} VARRSampleTable;
+
+/*
+ * Returns the table of the given layout and precision of the 
+ * 'number_of_samples' (at least two) samples in 'values', of 'width' doubles
+ * each.  'values' must be allocated with malloc, and is released (the table
+ * is allocated with __varr_table_allocate).  The table is released by 
+ * __varr_free_sample_table.
+ */
+VARRSampleTable
+__varr_sample_table(
+   double * values,
+   size_t number_of_samples,
+   size_t width,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   );
+
+/*
+ * Records the allocations that __varr_sample_table makes for a table of the
+ * given size, layout and precision with __varr_allocation_measure, so that 
+ * the block of a contiguous evaluator is measured without sampling it.
+ */
+void
+__varr_measure_sample_table(
+   size_t number_of_samples,
+   size_t width,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   );
+
+/*
+ * Measures the allocations of bound_general_linbuf(number_of_samples, ...),
+ * as __varr_measure_sample_table.
+ */
+void
+__varr_measure_bound_general_linbuf(size_t number_of_samples);
+
+/*
+ * Releases a table returned by __varr_sample_table, or (to the table cache)
+ * by __varr_shared_sample_table.
+ */
+void
+__varr_free_sample_table(VARRSampleTable * table);
+
+/*
+ * The key of a table of the process-wide table cache (see 
+ * varr_table_cache.h).  Tables of equal keys are identical, and are shared 
+ * by the evaluators that use them: 'function' and 'method' (string literals,
+ * eg. "log" and "normalizing sampling") name the sampled function and the
+ * grid of its samples, which is determined by 'number_of_samples' (the 
+ * argument of the constructor) over the domain [lower, upper] (which is 
+ * recorded by table files, see varr_table_file.h).  Tables that do not 
+ * depend on the VARRTableLayout or VARRTablePrecision are keyed by 
+ * VARR_TABLE_VALUES and VARR_TABLE_DOUBLE.
+ */
+typedef struct tagVARRTableKey
+{
+   char const *
+      function;
+   char const *
+      method;
+   size_t
+      number_of_samples;
+   VARRTableLayout
+      layout;
+   VARRTablePrecision
+      precision;
+   double
+      lower,
+      upper;
+} VARRTableKey;
+
+#define __VARR_TABLE_SECTIONS__ 2u
+
+/*
+ * The version of the contents of the tables that evaluators build, which is
+ * recorded in table files: it is to be incremented by any change to the
+ * values of the table of a key, so that files of older tables are not loaded.
+ */
+#define __VARR_TABLE_CONTENTS_VERSION__ 1u
+
+/*
+ * The memory of a cached table: up to __VARR_TABLE_SECTIONS__ arrays
+ * ('sections', of 'bytes' bytes each, or NULL), and the parameters needed to
+ * interpret them ('width', 'number_of_values' and 'scale', eg. of a 
+ * VARRSampleTable, or the bytes of each element and the number of elements 
+ * of an array).  Sections are allocated with __varr_table_allocate.  A table
+ * is saved to, and mapped from, a table file as its image.
+ */
+typedef struct tagVARRTableImage
+{
+   void *
+      sections[__VARR_TABLE_SECTIONS__];
+   size_t
+      bytes[__VARR_TABLE_SECTIONS__];
+   size_t
+      width,
+      number_of_values;
+   double
+      scale;
+} VARRTableImage;
+
+/*
+ * A kind of cached table: build(key, argument, image) computes the image of
+ * the table of 'key' (with sections allocated by malloc or posix_memalign),
+ * and returns zero on success; fits(argument, image) returns nonzero if an 
+ * image (eg. mapped from a file) is of the width and number of values of 
+ * those that build makes of 'argument'; section_bytes(key, image, i) returns
+ * the bytes of section i of an image of the width and number of values of
+ * 'image', or SIZE_MAX if these are not those of any image of the kind;
+ * view(key, image) returns the table that evaluators read from the sections
+ * of an image, whether built or mapped from a file, and release_view (which 
+ * may be NULL) releases it (but not the sections, which are released by the
+ * cache).  'identifier' identifies the kind in table files.
+ */
+typedef struct tagVARRTableKind
+{
+   uint32_t
+      identifier;
+   int (* build) (VARRTableKey const *, void const *, VARRTableImage *);
+   int (* fits) (void const *, VARRTableImage const *);
+   size_t (* section_bytes) (
+      VARRTableKey const *, VARRTableImage const *, size_t
+      );
+   void * (* view) (VARRTableKey const *, VARRTableImage const *);
+   void (* release_view) (void *);
+} VARRTableKind;
+
+#define __VARR_TABLE_KIND_SAMPLES__ 1u
+#define __VARR_TABLE_KIND_FLOATS__ 2u
+#define __VARR_TABLE_KIND_ARRAY__ 3u
+
+/*
+ * Returns the kind of the given identifier, or NULL.
+ */
+VARRTableKind const *
+__varr_table_kind(uint32_t identifier);
+
+/*
+ * Returns nonzero if each section of 'image' is of the bytes that 
+ * kind->section_bytes implies for 'key' and the image.
+ */
+int
+__varr_table_image_is_valid(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   VARRTableImage const * image
+   );
+
+#define __VARR_TABLE_FILE_NAME_LENGTH__ ((size_t) 64u)
+
+/*
+ * The header of a table file (see varr_table_file.c).  The sections of the
+ * image of the table follow at their 'offsets' (multiples of 64 bytes from 
+ * the start of the file), and 'checksum' is that of the sections.  
+ * 'contents' is the __VARR_TABLE_CONTENTS_VERSION__ of the writer.  
+ * 'function' and 'method' are nul terminated.
+ */
+typedef struct tagVARRTableFileHeader
+{
+   char
+      magic[8u];
+   uint32_t
+      version,
+      byte_order,
+      kind,
+      layout,
+      precision,
+      contents;
+   uint64_t
+      number_of_samples,
+      width,
+      number_of_values;
+   double
+      lower,
+      upper,
+      scale;
+   uint64_t
+      offsets[__VARR_TABLE_SECTIONS__],
+      bytes[__VARR_TABLE_SECTIONS__],
+      checksum;
+   char
+      function[__VARR_TABLE_FILE_NAME_LENGTH__],
+      method[__VARR_TABLE_FILE_NAME_LENGTH__];
+} VARRTableFileHeader;
+
+/*
+ * Returns the (view of the) cached table of 'key', and takes a reference to
+ * it.  If the table is not cached, it is built by kind->build(key, argument,
+ * &image), and its sections are released once the last reference to it is 
+ * returned by __varr_table_cache_release.  Returns NULL if the build fails.
+ *
+ * This function is thread safe: concurrent requests for a table of the same
+ * key wait for a single build.  Tables are read only once built.  While the
+ * cache is disabled (see varr_set_table_cache_enabled), every request builds
+ * a table of its own, which is still released by __varr_table_cache_release.
+ * So does a request for the key of a cached table of another kind, or that
+ * does not fit 'argument' (eg. a table of a file of another size).
+ */
+void *
+__varr_table_cache_acquire(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   void const * argument
+   );
+
+/*
+ * Returns a reference to 'table' (of __varr_table_cache_acquire), and 
+ * releases the table if it was the last.  'table' may be NULL.
+ */
+void
+__varr_table_cache_release(void const * table);
+
+/*
+ * Inserts the table of 'key' and 'kind', of the given image, the sections of
+ * which lie in the read only 'mapping' (of 'mapping_bytes' bytes, see 
+ * varr_table_file.c), with a reference that is held until 
+ * __varr_table_cache_unpin.  The mapping is unmapped with the table.  Returns
+ * zero on success, or nonzero (and unmaps the mapping) if the key is cached 
+ * already.
+ */
+int
+__varr_table_cache_insert_mapped(
+   VARRTableKey const * key,
+   VARRTableKind const * kind,
+   VARRTableImage const * image,
+   void * mapping,
+   size_t mapping_bytes
+   );
+
+/*
+ * Returns the references of __varr_table_cache_insert_mapped, and returns 
+ * the number of tables of which they were the last references.
+ */
+size_t
+__varr_table_cache_unpin(void);
+
+/*
+ * Calls visit(key, kind, image, context) for each shared table of the cache,
+ * with the cache locked, and returns the number of calls for which visit 
+ * returned zero.
+ */
+size_t
+__varr_table_cache_visit(
+   int (* visit) (
+      VARRTableKey const *,
+      VARRTableKind const *,
+      VARRTableImage const *,
+      void *
+      ),
+   void * context
+   );
+
+/*
+ * Returns the (cached) table of the given key, as built by 
+ * __varr_sample_table(sample(key->number_of_samples), number_of_values, 
+ * width, key->layout, key->precision), where sample(number_of_samples) 
+ * returns the number_of_values samples, of 'width' doubles each, allocated
+ * with malloc.  The table is released by __varr_free_sample_table.
+ */
+VARRSampleTable
+__varr_shared_sample_table(
+   VARRTableKey const * key,
+   double * (* sample) (size_t),
+   size_t number_of_values,
+   size_t width
+   );
+
+/*
+ * As __varr_shared_sample_table, for the float tables of 
+ * __varr_float_interleaved_table.  The table is released by 
+ * __varr_table_cache_release.
+ */
+float const *
+__varr_shared_float_table(
+   VARRTableKey const * key,
+   double * (* sample) (size_t),
+   size_t number_of_values,
+   size_t width
+   );
+
+/*
+ * Returns the (cached) array of the given key, as built by build(key, 
+ * argument), which returns an array of 'number_of_elements' elements of
+ * 'element_bytes' bytes each, allocated with __varr_table_allocate, or NULL.
+ * The array is released by __varr_table_cache_release.
+ */
+void const *
+__varr_shared_array(
+   VARRTableKey const * key,
+   size_t element_bytes,
+   size_t number_of_elements,
+   void * (* build) (VARRTableKey const *, void const *),
+   void const * argument
+   );
+
+/*
+ * Measure, with __varr_allocation_measure, the private copies that the 
+ * contiguous evaluator being measured (if any) makes of the tables of 
+ * __varr_shared_sample_table, __varr_shared_float_table and 
+ * __varr_shared_array of the given sizes, without building the tables.
+ */
+void
+__varr_measure_shared_sample_table(
+   size_t number_of_values,
+   size_t width,
+   VARRTableLayout layout,
+   VARRTablePrecision precision
+   );
+
+void
+__varr_measure_shared_float_table(size_t number_of_values, size_t width);
+
+void
+__varr_measure_shared_array(size_t element_bytes, size_t number_of_elements);
+
+/*
+ * Returns component j of the value at a fraction 'alpha' of the way from 
+ * sample 'index' of a table to the next sample:
+ */
+static inline
+double
+__varr_interpolate_component(
+   VARRSampleTable const * const table,
+   size_t const index,
+   double const alpha,
+   size_t const j
+   )
+{
+   register size_t const
+      width = table->width;
+   if(table->precision == VARR_TABLE_DOUBLE)
+   {
+      register double const * const
+         values = table->values;
+      if(table->layout == VARR_TABLE_INTERLEAVED)
+      {
+         return
+            values[2u * width * index + j]
+          + alpha * values[2u * width * index + width + j];
+      }
+      return
+         values[width * index + j] * (1. - alpha)
+       + values[width * (index + 1u) + j] * alpha;
+   }
+   register float const * const
+      floats = table->floats;
+   register double
+      lower,
+      upper;
+   if(table->layout == VARR_TABLE_INTERLEAVED)
+   {
+      lower = (double) floats[2u * width * index + j];
+      upper = (double) floats[2u * width * index + width + j];
+   }
+   else
+   {
+      lower = (double) floats[width * index + j];
+      upper = (double) floats[width * (index + 1u) + j];
+   }
+   if(table->precision == VARR_TABLE_FLOAT_CORRECTED)
+   {
+      register double const
+         scale = table->correction_scale;
+      lower += scale * (double) table->corrections[width * index + j];
+      if(table->layout == VARR_TABLE_VALUES)
+      {
+         upper += 
+            scale * (double) table->corrections[width * (index + 1u) + j];
+      }
+   }
+   return
+      (table->layout == VARR_TABLE_INTERLEAVED) ?
+         lower + alpha * upper
+         :
+         lower * (1. - alpha) + upper * alpha;
+}
+
+/*
+ * Returns the value at a fraction 'alpha' of the way from sample 'index' of
+ * a table (of width one) to the next sample:
+ */
+static inline
+double
+__varr_interpolate(
+   VARRSampleTable const * const table,
+   size_t const index,
+   double const alpha
+   )
+{
+   return
+      __varr_interpolate_component(table, index, alpha, 0u);
+}
+
+/*
+ * Returns the float table of the 'number_of_samples' (at least two) samples
+ * in 'values', of 'width' doubles each, for the single precision evaluators
+ * (eg. linear_sampling_expf).  As for __varr_interleaved_table, row i of the
+ * result holds the 'width' samples i, rounded to float, followed by their 
+ * differences to sample i + 1; the differences are taken from the rounded
+ * samples, so that interpolation ends at sample i + 1 to within the rounding
+ * of the difference.  The result is allocated with __varr_table_allocate, or
+ * is NULL.
+ */
+float *
+__varr_float_interleaved_table(
+   double const * values,
+   size_t number_of_samples,
+   size_t width
+   );
+
+/*
+ * Returns component j of the value at a fraction 'alpha' of the way from 
+ * sample 'index' of a table of __varr_float_interleaved_table to the next
+ * sample:
+ */
+static inline
+float
+__varr_interpolate_float_component(
+   float const * const table,
+   size_t const width,
+   size_t const index,
+   float const alpha,
+   size_t const j
+   )
+{
+   return
+      table[2u * width * index + j]
+    + alpha * table[2u * width * index + width + j];
+}
+
+/*
+ * IEEE-754 range reduction of a positive normal double x = m * 2**k, reading
+ * k and m from the exponent and mantissa fields of x (without reciprocals or
+ * conversion of x to an integer).  See also the vector forms of these, 
+ * _avxd_stride_exponent_field et al., in varr_simd_target.h.
+ */
+#define __VARR_EXPONENT_BIAS__ 1023
+#define __VARR_NUMBER_OF_EXPONENTS__ 2048u
+#define __VARR_MANTISSA_MASK__ 0x000FFFFFFFFFFFFFull
+#define __VARR_SQRT_HALF_BITS__ 0x3FE6A09E667F3BCDull   // sqrt(1/2), rounded 
+                                                        // down
+
+static inline
+uint64_t
+__varr_double_bits(double x)
+{
+   uint64_t
+      bits;
+   memcpy(&bits, &x, sizeof(bits));
+   return
+      bits;
+}
+
+static inline
+double
+__varr_bits_double(uint64_t bits)
+{
+   double
+      x;
+   memcpy(&x, &bits, sizeof(x));
+   return
+      x;
+}
+
+/*
+ * Returns the exponent field, k + 1023, of x; this indexes tables with
+ * __VARR_NUMBER_OF_EXPONENTS__ entries (one per exponent):
+ */
+static inline
+unsigned
+__varr_exponent_field(double x)
+{
+   return
+      (unsigned) (__varr_double_bits(x) >> 52);
+}
+
+/*
+ * Returns m, 1 <= m < 2:
+ */
+static inline
+double
+__varr_mantissa(double x)
+{
+   return
+      __varr_bits_double(
+         (__varr_double_bits(x) & __VARR_MANTISSA_MASK__)
+       | __varr_double_bits(1.)
+         );
+}
+
+/*
+ * Returns k, and assigns m, for sqrt(1/2) <= m < sqrt(2) (ie. with m centred
+ * on unity, as suits the logarithm).  The bits of x are offset so that 
+ * mantissae from sqrt(1/2) carry into the exponent field:
+ */
+static inline
+double
+__varr_centred_exponent_split(double x, double * mantissa)
+{
+   register uint64_t const
+      bits = __varr_double_bits(x)
+           + (__varr_double_bits(1.) - __VARR_SQRT_HALF_BITS__);
+   *mantissa = __varr_bits_double(
+      (bits & __VARR_MANTISSA_MASK__) + __VARR_SQRT_HALF_BITS__
+      );
+   return
+      (double) ((int) (bits >> 52) - __VARR_EXPONENT_BIAS__);
+}
+
+/*
+ * The same range reduction of a positive normal float x = m * 2**k:
+ */
+#define __VARR_FLOAT_EXPONENT_BIAS__ 127
+#define __VARR_NUMBER_OF_FLOAT_EXPONENTS__ 256u
+#define __VARR_FLOAT_MANTISSA_MASK__ 0x007FFFFFu
+#define __VARR_FLOAT_SQRT_HALF_BITS__ 0x3F3504F3u       // sqrt(1/2), rounded
+                                                        // down
+
+static inline
+uint32_t
+__varr_float_bits(float x)
+{
+   uint32_t
+      bits;
+   memcpy(&bits, &x, sizeof(bits));
+   return
+      bits;
+}
+
+static inline
+float
+__varr_bits_float(uint32_t bits)
+{
+   float
+      x;
+   memcpy(&x, &bits, sizeof(x));
+   return
+      x;
+}
+
+/*
+ * Returns the exponent field, k + 127, of x:
+ */
+static inline
+unsigned
+__varr_float_exponent_field(float x)
+{
+   return
+      (unsigned) (__varr_float_bits(x) >> 23);
+}
+
+/*
+ * Returns m, 1 <= m < 2:
+ */
+static inline
+float
+__varr_float_mantissa(float x)
+{
+   return
+      __varr_bits_float(
+         (__varr_float_bits(x) & __VARR_FLOAT_MANTISSA_MASK__)
+       | __varr_float_bits(1.f)
+         );
+}
+
+/*
+ * Returns k, and assigns m, for sqrt(1/2) <= m < sqrt(2):
+ */
+static inline
+float
+__varr_float_centred_exponent_split(float x, float * mantissa)
+{
+   register uint32_t const
+      bits = __varr_float_bits(x)
+           + (__varr_float_bits(1.f) - __VARR_FLOAT_SQRT_HALF_BITS__);
+   *mantissa = __varr_bits_float(
+      (bits & __VARR_FLOAT_MANTISSA_MASK__) + __VARR_FLOAT_SQRT_HALF_BITS__
+      );
+   return
+      (float) ((int) (bits >> 23) - __VARR_FLOAT_EXPONENT_BIAS__);
+}
+
+/*
+ * 2 pi, split for the reduction of a float x = 2 pi k + r, for 0 <= r < 2 pi,
+ * by the single precision trigonometric evaluators: k * __VARR_FLOAT_2PI_HIGH__
+ * is exact for |k| < 2**16.  The scalar evaluators reduce x in double 
+ * precision instead.
+ */
+#define __VARR_FLOAT_2PI_HIGH__ 6.28125f
+#define __VARR_FLOAT_2PI_LOW__ 1.93530717958647692528e-3f
+
+static inline
+double
+__varr_float_reduce_2pi(float x)
+{
+   register double const
+      __2pi = 6.28318530717958647693;
+   return
+      (double) x - __2pi * floor((double) x * (1. / __2pi));
+}
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -75,7 +75,7 @@ typedef struct tagVARRLogDEvaluator {
  * VARRLogDEvaluator for further information.
  *
  * This implementation uses linear interpolation techniques combined with 
- * sampling and a modified De-Bruijn-like method to compute the real 
+ * sampling and IEEE-754 exponent range reduction to compute the real 
  * natural logarithm.
  * 
  * This function allocates a sampling grid of real natural logarithm values.
@@ -87,8 +87,10 @@ typedef struct tagVARRLogDEvaluator {
  * sampling points requested.
  *
  * When evaluating log(x) (VARRLogDEvaluator.logd(x)) using this method, all 
- * arguments x must be finite real numbers confined to the range 2**-63 < x 
- * < 2**+63.
+ * arguments x must be positive normal (ie. neither subnormal nor infinite)
+ * real numbers, DBL_MIN <= x <= DBL_MAX.  x is split as m * 2**k from its
+ * exponent and mantissa fields, and log(m) is sampled for 
+ * sqrt(1/2) <= m <= sqrt(2).
  */
 VARRLogDEvaluator
 normalizing_linear_sampling_logd(size_t number_of_samples);
@@ -111,8 +113,10 @@ normalizing_linear_sampling_logd(size_t number_of_samples);
  * is markedly less than its linear (interpolating) sampling VARR variant.
  *
  * When evaluating log(x) (VARRLogDEvaluator.logd(x)) using this method, all 
- * arguments x must be finite real numbers confined to the range 2**-63 < x 
- * < 2**+63.
+ * arguments x must be positive normal (ie. neither subnormal nor infinite)
+ * real numbers, DBL_MIN <= x <= DBL_MAX.  x is split as m * 2**k from its
+ * exponent and mantissa fields, and log(m) is sampled for 
+ * sqrt(1/2) <= m <= sqrt(2).
  */
 VARRLogDEvaluator
 normalizing_sublinear_sampling_logd(size_t number_of_samples);
@@ -125,21 +129,59 @@ normalizing_sublinear_sampling_logd(size_t number_of_samples);
  * This method uses a power series to compute the natural logarithm.  The number
  * of terms comprising this power series is indicated by the argument
  * 'number_of_iterations', which should be nonzero.  This power series 
- * consists of positive integer powers of (y - 1)**2/(y + 1)**2 where 
- * y = x/10**q and q is selected so that |y| < 1.  The rate of convergence of 
- * this power series, for any given x, is generally proportional to the value of
- * 'number_of_iterations'.
+ * consists of positive integer powers of (m - 1)**2/(m + 1)**2 where 
+ * x = m * 2**k and sqrt(1/2) <= m < sqrt(2), as read from the exponent and 
+ * mantissa fields of x.  The series then converges to double precision 
+ * within 12 terms; further terms do not change its sum.
  * 
  * This function allocates minimal memory or no memory.  The numerical accuracy
  * of the natural logarithm function that is generated by this method generally 
- * increases with the number of iterations requested.
+ * increases with the number of iterations requested.  The scalar and vector
+ * forms evaluate the same terms, and agree to within rounding for any number
+ * of iterations.
  *
  * 'number_of_iterations' must be nonzero and must not exceed 500.   When 
  * evaluating log(x) (VARRLogDEvaluator.logd(x)) using this method, all 
- * arguments x must be finite real numbers confined to the range 10**-5 < x 
- * < 10**5.
+ * arguments x must be positive normal doubles (DBL_MIN <= x <= DBL_MAX).
  */
 VARRLogDEvaluator
 quad_series_logd(size_t number_of_iterations);
 
+/*
+ * An object that provides a single precision VARR implementation of the real
+ * natural logarithm function, with the scalar and vector functions 'logf' 
+ * and 'logf_array', which are as 'logd' and 'logd_array' of 
+ * VARRLogDEvaluator for floats.  The vector function processes 8 (AVX2) or
+ * 16 (AVX-512) floats per instruction.
+ */
+typedef struct tagVARRLogFEvaluator {
+   void const * accelerator;
+   
+   float (* logf) (float, void const * accelerator);
+   
+   void (* logf_array) (
+      float const * in, float * out,
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRLogFEvaluator *);
+} VARRLogFEvaluator;
+
+/*
+ * Returns an object that provides a single precision VARR implementation of
+ * the real natural logarithm function.  See documentation for the type 
+ * VARRLogFEvaluator for further information.
+ *
+ * As for normalizing_linear_sampling_logd, x is split as m * 2**k from the
+ * exponent and mantissa fields of the float x, and log(m) is interpolated 
+ * linearly for sqrt(1/2) <= m <= sqrt(2), in a float table of 
+ * 'number_of_samples' (which must be at least two) samples of 8 bytes each.
+ * 4096 samples (32 KB) are accurate to about 6e-8.
+ *
+ * All arguments x must be positive normal floats, FLT_MIN <= x <= FLT_MAX.
+ */
+VARRLogFEvaluator
+normalizing_linear_sampling_logf(size_t number_of_samples);
+
 #endif /* __VARR_LOG_H__ */
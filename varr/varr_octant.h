@@ -0,0 +1,63 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_OCTANT_H__
+#define __VARR_OCTANT_H__
+
+#include <stddef.h>
+
+#include "varr_cos.h"
+#include "varr_phasor.h"
+#include "varr_sin.h"
+
+/*
+ * Symmetry reduced counterparts of sampling_sind, sampling_cosd and 
+ * linear_interpolating_phasord.  Each of these tabulates sine and cosine 
+ * over the first octant, [0, pi/4], only: x is reduced modulo 2 pi, and 
+ * then to the first octant by reflection, and the sine and cosine so 
+ * interpolated are swapped and negated as the octant of x requires.  The
+ * three share a single table (of (sin, cos) pairs) for equal 
+ * 'number_of_samples', see varr_table_cache.h.
+ *
+ * 'number_of_samples' is the number of samples per period, and is rounded 
+ * up to a multiple of 8 (and to at least 8).  The sampling step, and so the
+ * accuracy of linear interpolation, is that of the full period tables of the
+ * same number of samples, of which these tables are an eighth 
+ * (linear_interpolating_phasord) or a quarter (sampling_sind and 
+ * sampling_cosd) of the size: in equal memory, they sample four to eight 
+ * times more finely, and are some sixteen to sixty four times more accurate.
+ * The reduction costs some ten vector operations per stride, see the 
+ * benchmarks of test/varr_octant.test.c.
+ *
+ * Unlike sampling_sind and sampling_cosd, these evaluators accept any finite
+ * x, which is reduced as by sampling_sincosd.  The scalar and vector 
+ * functions agree to within rounding.
+ */
+
+VARRSinDEvaluator
+octant_sampling_sind(size_t number_of_samples);
+
+VARRCosDEvaluator
+octant_sampling_cosd(size_t number_of_samples);
+
+VARRPhasorDEvaluator
+octant_linear_interpolating_phasord(size_t number_of_samples);
+
+#endif /* __VARR_OCTANT_H__ */
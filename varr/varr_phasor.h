@@ -84,23 +84,16 @@ typedef struct tagVARRPhasorDEvaluator {
  * phasor function.   See documentation for the type VARRPhasorDEvaluator
  * for further information.
  * 
- * This function delegates to a pair of real-valued cubic spline evaluators, one
- * for the sine function and another for the cosine.  The value of the complex
- * phasor is assembled of the results of these delegates.  These delegates both 
- * allocate sampling grids of real (double) values.  The sizes
- * of these sampling grids are as indicated by the argument 'number_of_samples',
- * which must be nonzero.  The amount of memory allocated by this function is
- * approximately proportional to the number of sampling points requested.  The
- * numerical accuracy of the complex phasor function that is generated by this
- * method generally increases with the number of sampling points requested.
- *
- * See documentation of the VARR cubic spline sine evaluator, and of the VARR
- * cubic spline cosine evaluator, for further information.
- *
- * The evaluator returned by this method does not provide a vector
- * phasord_array function (VARRPhasorDEvaluator::phasord_array), and as such no 
- * calls to phasord_array should be made against the evaluator that is returned
- * by this method.
+ * This function allocates a single table of the complex coefficients of a
+ * cubic spline over one period, the real and imaginary parts of which 
+ * interpolate the cosine and sine functions.  The number of spline intervals
+ * is as indicated by the argument 'number_of_samples', which must be nonzero.
+ * The amount of memory allocated by this function is approximately 
+ * proportional to the number of sampling points requested.  The numerical 
+ * accuracy of the complex phasor function that is generated by this method
+ * generally increases with the number of sampling points requested, and is
+ * much greater than that of linear_interpolating_phasord for the same number
+ * of samples.
  */
 VARRPhasorDEvaluator
 cubic_spline_sampling_phasord(size_t number_of_samples);
@@ -120,4 +113,40 @@ cubic_spline_sampling_phasord(size_t number_of_samples);
 VARRPhasorDEvaluator
 linear_interpolating_phasord(size_t number_of_samples);
 
+/*
+ * An object that provides a single precision VARR implementation of the 
+ * complex phasor function, with the scalar and vector functions 'phasorf' 
+ * and 'phasorf_array', which are as 'phasord' and 'phasord_array' of 
+ * VARRPhasorDEvaluator for floats and float complex values.  The vector 
+ * function processes 8 (AVX2) or 16 (AVX-512) phases per instruction.
+ */
+typedef struct tagVARRPhasorFEvaluator {
+   void const * accelerator;
+   
+   float complex (* phasorf) (float phi, void const * accelerator);
+   
+   void (* phasorf_array) (
+      float const * in, float complex * out,
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRPhasorFEvaluator *);
+   
+} VARRPhasorFEvaluator;
+
+/*
+ * Returns an object that provides a single precision VARR implementation of
+ * the complex phasor function.  See documentation for the type 
+ * VARRPhasorFEvaluator for further information.
+ * 
+ * The phase is reduced modulo 2 pi, as for sampling_sinf, and the cosine and
+ * sine are interpolated linearly in a single float table of 
+ * 'number_of_samples' (which must be nonzero) intervals per period, of 16 
+ * bytes each.  4096 samples (64 KB) are accurate to about 6e-7, as for 
+ * sampling_sinf.
+ */
+VARRPhasorFEvaluator
+linear_interpolating_phasorf(size_t number_of_samples);
+
 #endif /* __VARR_PHASOR_H__ */
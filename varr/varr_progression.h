@@ -0,0 +1,106 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_PROGRESSION_H__
+#define __VARR_PROGRESSION_H__
+
+#include <complex.h>
+#include <stddef.h>
+
+/*
+ * Evaluates the batch function 'batch' of an evaluator (eg. 
+ * VARRExpDEvaluator.expd_array, with its accelerator 'accelerator') for the
+ * 'length' inputs x0 + k * dx of an arithmetic progression into out[k], 
+ * without an array of inputs: the inputs are generated in vector registers,
+ * each from its own index k (so that they do not drift), by chunks of 512 
+ * (4 KB, which stay in the first level cache), each of which is passed to 
+ * 'batch' in turn.  Only the outputs are thus written to (and read from) 
+ * memory, rather than the inputs as well.
+ */
+void
+varr_progression_batchd(
+   void (* batch) (double const *, double *, size_t, void const *),
+   double x0,
+   double dx,
+   double * out,
+   size_t length,
+   void const * accelerator
+   );
+
+/*
+ * As varr_progression_batchd, for the batch functions of evaluators of 
+ * floats, for the inputs x0 + k * dx evaluated in single precision (for 
+ * progressions of less than 2**31 inputs):
+ */
+void
+varr_progression_batchf(
+   void (* batch) (float const *, float *, size_t, void const *),
+   float x0,
+   float dx,
+   float * out,
+   size_t length,
+   void const * accelerator
+   );
+
+/*
+ * Evaluates the exponentials of the 'length' inputs x0 + k * dx into out[k]
+ * by scaling, without a lookup per input: the exponentials of every 64th 
+ * input (the anchors of their blocks) are evaluated by the batch function 
+ * 'batch' of an evaluator (eg. VARRExpDEvaluator.expd_array, with its 
+ * accelerator 'accelerator'), and the exponential of x0 + (a + j) * dx is 
+ * that of anchor a scaled by exp(j dx), from a table of the 64 scales taken
+ * from libm.  Each exponential is thus within an ulp or so of the scaling 
+ * of its anchor, whatever its distance to the first.  Blocks of which the 
+ * exponentials are not all normal, and progressions of which the scales 
+ * are not, are evaluated by 'batch' (as by varr_progression_batchd).
+ */
+void
+varr_progression_expd(
+   void (* batch) (double const *, double *, size_t, void const *),
+   double x0,
+   double dx,
+   double * out,
+   size_t length,
+   void const * accelerator
+   );
+
+/*
+ * Evaluates the phasors of the 'length' phases x0 + k * dx into out[k] by
+ * rotation, without a lookup per phase: the phasors of every 64th phase (the
+ * anchors of their blocks) are evaluated by the batch function 'batch' of 
+ * an evaluator (eg. VARRPhasorDEvaluator.phasord_array, with its 
+ * accelerator 'accelerator'), and the phasor of phase x0 + (a + j) * dx is
+ * that of anchor a rotated by exp(i j dx), from a table of the 64 rotations
+ * taken from libm.  As each rotation is within an ulp or so of unit modulus,
+ * each phasor is within a few ulps of the rotation of its anchor, whatever
+ * its distance to the first, and so as accurate as the evaluator (to within
+ * the rounding of the phases themselves).
+ */
+void
+varr_progression_phasord(
+   void (* batch) (double const *, double complex *, size_t, void const *),
+   double x0,
+   double dx,
+   double complex * out,
+   size_t length,
+   void const * accelerator
+   );
+
+#endif /* __VARR_PROGRESSION_H__ */
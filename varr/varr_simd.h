@@ -0,0 +1,101 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_SIMD_H__
+#define __VARR_SIMD_H__
+
+#include <stddef.h>
+
+/*
+ * The instruction set extensions for which VARR batch (array) functions are
+ * compiled.  Every batch function is built for each of these targets, and
+ * the constructors of VARR evaluators (eg. shifting_linear_sampling_expd)
+ * select the best variant supported by the executing processor at run time.
+ * Values are ordered, such that a greater value denotes a wider target.
+ */
+typedef enum tagVARRSimdLevel {
+   VARR_SIMD_SCALAR = 0,                  // portable scalar code
+   VARR_SIMD_AVX2 = 1,                    // AVX2 and FMA, 4 doubles per vector
+   VARR_SIMD_AVX512 = 2                   // AVX-512F, 8 doubles per vector
+} VARRSimdLevel;
+
+/*
+ * Returns the widest SIMD target supported by both this build of the library
+ * and the executing processor (and its operating system).
+ */
+VARRSimdLevel
+varr_simd_supported_level(void);
+
+/*
+ * Returns the SIMD target that is selected by VARR evaluators constructed
+ * from this point on.  This is the lesser of varr_simd_supported_level() and
+ * any limit set by varr_set_simd_level.
+ */
+VARRSimdLevel
+varr_simd_level(void);
+
+/*
+ * Limits the SIMD target selected by VARR evaluators that are constructed
+ * after this call to (at most) 'level', and returns the resulting value of
+ * varr_simd_level().  Evaluators that have already been constructed are not
+ * affected.  A limit of VARR_SIMD_AVX512 restores automatic selection.
+ *
+ * This function is not thread safe with respect to concurrent construction
+ * of VARR evaluators.
+ */
+VARRSimdLevel
+varr_set_simd_level(VARRSimdLevel level);
+
+/*
+ * Returns a short human-readable name for 'level', eg. "avx2".
+ */
+char const *
+varr_simd_level_name(VARRSimdLevel level);
+
+/*
+ * Sets the size, in bytes, of the outputs of a batch (eg. 8 * length for 
+ * VARRSinDEvaluator.sind_array) from which the SIMD batch functions called
+ * by this thread store them by non-temporal (streaming) stores, and returns
+ * the previous size.  Zero, the default, stores every batch as usual.
+ *
+ * Ordinary stores first read each line of the outputs into the cache, 
+ * evicting lines of the tables of evaluators to make room; streaming stores
+ * write whole lines to memory directly, so are meant for outputs larger 
+ * than the last level cache, which are not read again soon.  Each streamed
+ * batch stores its outputs up to the first vector aligned one as usual, the
+ * others by aligned streaming stores (but for a partial last stride), and 
+ * fences them before returning.  The scalar batch functions, and those of 
+ * sampling_sincosd and cubic_spline_sampling_sincosd (of two outputs), 
+ * always store as usual.
+ *
+ * The batches of varr_parallel_batch* (see varr_thread_pool.h) are streamed
+ * if all of the outputs of the batch reach the size set by the calling 
+ * thread, and its chunks then stream on every thread.
+ */
+size_t
+varr_set_streaming_batch_bytes(size_t bytes);
+
+/*
+ * Returns the size set by varr_set_streaming_batch_bytes for this thread:
+ */
+size_t
+varr_streaming_batch_bytes(void);
+
+#endif /* __VARR_SIMD_H__ */
@@ -0,0 +1,123 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_SINCOS_H__
+#define __VARR_SINCOS_H__
+
+#include <stddef.h>
+
+/*
+ * An object that provides a VARR implementation of the real sine and cosine
+ * functions of the same argument.  Both are taken from a single table, in
+ * which sine and cosine samples are interleaved, so that each evaluation
+ * computes a single table index.
+ * 
+ * This implementation provides scalar and vector sine-cosine functions as 
+ * follows:
+ *    i.    'sincosd' - a function accepting one real number, x, and assigning
+ *          VARR approximations of sin(x) and cos(x);
+ *    ii.   'sincosd_array' - a vectorized version of (i.), which assigns the
+ *          sines and cosines to separate arrays.
+ */
+typedef struct tagVARRSinCosDEvaluator {
+   void const * accelerator;
+   
+   /*
+    * A VARR real sine-cosine function.  The first argument to this method is
+    * the number, x, for which sin(x) and cos(x) are to be evaluated.  These
+    * are assigned to the second and third arguments respectively.
+    *
+    * This function does not return meaningful values if the input, x, is not 
+    * a finite real number.
+    */
+   void (* sincosd) (
+      double x, double * sin_x, double * cos_x,
+      void const * accelerator
+      );
+   
+   /*
+    * A vectorized VARR real sine-cosine function.  The meaning of arguments to
+    * this method are as follows:
+    * 
+    *    i.    'in' - a const array of doubles, being the values of x to 
+    *          process;
+    *    ii.   'sin_out' - an array of doubles of (at least) the same length 
+    *          as (i.), being the values of sin(x) to assign;
+    *    iii.  'cos_out' - an array of doubles of (at least) the same length 
+    *          as (i.), being the values of cos(x) to assign;
+    *    iv.   'length' - the length of the arrays (i.), (ii.) and (iii.) 
+    *          above;
+    *    v.    'accelerator' - the value of the above enclosed (void *) 
+    *          accelerator.
+    *
+    * This function does not return meaningful values if the inputs (i.) are
+    * not finite real numbers.  It is the responsibility of the caller to ensure
+    * that the arrays (i.), (ii.) and (iii.) all have size (iv.).  The output 
+    * arrays must not overlap one another, but either may be the input array.
+    *
+    * It is not necessary for the arrays (i.), (ii.) or (iii.) to have any 
+    * specific alignments.  The SIMD instruction set used by this method is 
+    * selected at run time (see varr_simd.h).
+    */
+   void (* sincosd_array) (
+      double const * in, double * sin_out, double * cos_out,
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRSinCosDEvaluator *);
+} VARRSinCosDEvaluator;
+
+/*
+ * Returns an object that provides a VARR implementation of the real sine and
+ * cosine functions.   See documentation for the type VARRSinCosDEvaluator
+ * for further information.
+ * 
+ * This function allocates a single sampling grid of interleaved sine and 
+ * cosine values over one period, by linear interpolation of which both 
+ * functions are evaluated.  The size of this sampling grid is indicated by the
+ * argument 'number_of_samples', which must be nonzero.  The amount of memory
+ * allocated by this function is approximately proportional to the number of 
+ * sampling points requested.  The numerical accuracy of the functions that are
+ * generated by this method generally increases with the number of sampling 
+ * points requested.
+ */
+VARRSinCosDEvaluator
+sampling_sincosd(size_t number_of_samples);
+
+/*
+ * Returns an object that provides a VARR implementation of the real sine and
+ * cosine functions.   See documentation for the type VARRSinCosDEvaluator
+ * for further information.
+ * 
+ * This method uses cubic spline techniques to compute the sine and cosine, 
+ * from a single table of interleaved spline coefficients over one period.  
+ * The amount of memory allocated is generally proportional to the value of 
+ * 'number_of_samples', which must be nonzero.  The numerical accuracy of the
+ * functions that are generated by this method generally increases with the 
+ * number of sampling points requested.
+ *
+ * Unlike the cubic spline sine and cosine evaluators, this method does not use
+ * GSL.
+ */
+VARRSinCosDEvaluator
+cubic_spline_sampling_sincosd(size_t number_of_samples);
+
+#endif /* __VARR_SINCOS_H__ */
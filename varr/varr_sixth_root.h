@@ -75,7 +75,7 @@ typedef struct tagVARRSixthRootDEvaluator {
  * for further information.
  *
  * This implementation uses linear interpolation techniques combined with 
- * sampling and a modified De-Bruijn-like method to compute the real 
+ * sampling and IEEE-754 exponent range reduction to compute the real 
  * sixth root.
  * 
  * This function allocates a sampling grid of real sixth root values.
@@ -87,8 +87,10 @@ typedef struct tagVARRSixthRootDEvaluator {
  * sampling points requested.
  *
  * When evaluating pow(x, 1/6.) (VARRSixthRootDEvaluator.sixthrootd(x)) using 
- * this method, all arguments x must be finite real numbers confined to the 
- * range 10**-18 < x < 10**+18.
+ * this method, all arguments x must be positive normal (ie. neither subnormal
+ * nor infinite) real numbers, DBL_MIN <= x <= DBL_MAX.  x is split as 
+ * m * 2**k from its exponent and mantissa fields, and pow(m, 1/6.) is 
+ * sampled for 1 <= m <= 2.
  */
 VARRSixthRootDEvaluator
 linear_sampling_normalizing_sixth_rootd(size_t number_of_samples);
@@ -96,4 +98,41 @@ linear_sampling_normalizing_sixth_rootd(size_t number_of_samples);
 VARRSixthRootDEvaluator
 sublinear_sampling_normalizing_sixth_rootd(size_t number_of_samples);
 
+/*
+ * An object that provides a single precision VARR implementation of the real
+ * sixth root function, with the scalar and vector functions 'sixthrootf' and
+ * 'sixthrootf_array', which are as 'sixthrootd' and 'sixthrootd_array' of 
+ * VARRSixthRootDEvaluator for floats.  The vector function processes 8 
+ * (AVX2) or 16 (AVX-512) floats per instruction.
+ */
+typedef struct tagVARRSixthRootFEvaluator {
+   void const * accelerator;
+   
+   float (* sixthrootf) (float, void const * accelerator);
+   
+   void (* sixthrootf_array) (
+      float const * in, float * out,
+      size_t length, 
+      void const * accelerator
+      );
+   
+   int (* disallocate) (struct tagVARRSixthRootFEvaluator *);
+} VARRSixthRootFEvaluator;
+
+/*
+ * Returns an object that provides a single precision VARR implementation of
+ * the real sixth root function.  See documentation for the type 
+ * VARRSixthRootFEvaluator for further information.
+ *
+ * As for linear_sampling_normalizing_sixth_rootd, x is split as m * 2**k 
+ * from the exponent and mantissa fields of the float x, and pow(m, 1/6.) is 
+ * interpolated linearly for 1 <= m <= 2, in a float table of 
+ * 'number_of_samples' (which must be at least two) samples of 8 bytes each.
+ * 4096 samples (32 KB) are accurate to about 1.6e-7 (relative).
+ * 
+ * All arguments x must be positive normal floats, FLT_MIN <= x <= FLT_MAX.
+ */
+VARRSixthRootFEvaluator
+linear_sampling_normalizing_sixth_rootf(size_t number_of_samples);
+
 #endif /* __VARR_SIXTH_ROOT_H__ */
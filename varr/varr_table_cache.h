@@ -0,0 +1,80 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_TABLE_CACHE_H__
+#define __VARR_TABLE_CACHE_H__
+
+#include <stddef.h>
+
+/*
+ * The sampling tables of VARR evaluators are kept in a process-wide cache,
+ * keyed by the sampled function, the sampling method, the number of samples,
+ * and the VARRTableLayout and VARRTablePrecision (see varr_table_layout.h).
+ * Evaluators constructed with equal keys (eg. two sampling_sind(1024) 
+ * evaluators, or normalizing_linear_sampling_logd and 
+ * normalizing_sublinear_sampling_logd of the same number of samples) share 
+ * a single read only table, which is computed once, and which is released 
+ * when the last of these evaluators is disallocated.
+ *
+ * Construction and disallocation of evaluators are thread safe with respect
+ * to the cache.  Evaluators of bound_general_linbuf, whose tables depend on
+ * their delegates, do not share their tables.
+ */
+
+/*
+ * The state of the table cache: the number of tables held, the total number
+ * of references to them (ie. of evaluators that use them), and their total 
+ * size in bytes, as well as the number of requests for tables that were 
+ * served from the cache ('hits') or built ('misses') since the start of the
+ * process.
+ */
+typedef struct tagVARRTableCacheStatistics {
+   size_t
+      tables,
+      references,
+      bytes,
+      hits,
+      misses;
+} VARRTableCacheStatistics;
+
+/*
+ * Returns the current state of the table cache.
+ */
+VARRTableCacheStatistics
+varr_table_cache_statistics(void);
+
+/*
+ * Returns nonzero if evaluators constructed from this point on share their
+ * tables.  The cache is enabled by default.
+ */
+int
+varr_table_cache_enabled(void);
+
+/*
+ * Enables (if 'enabled' is nonzero) or disables sharing of the tables of 
+ * evaluators constructed after this call, and returns the resulting value of
+ * varr_table_cache_enabled().  Evaluators constructed while the cache is
+ * disabled build tables of their own, eg. to keep them apart from those of
+ * other threads (on other NUMA nodes); existing tables are not affected.
+ */
+int
+varr_set_table_cache_enabled(int enabled);
+
+#endif /* __VARR_TABLE_CACHE_H__ */
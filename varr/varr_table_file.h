@@ -0,0 +1,87 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_TABLE_FILE_H__
+#define __VARR_TABLE_FILE_H__
+
+#include <stddef.h>
+
+/*
+ * Table files hold the sampling tables of the table cache (see 
+ * varr_table_cache.h), so that processes may map precomputed tables rather
+ * than compute them.  A table file is a versioned header, which records the 
+ * key of its table (function, method, number of samples, domain, layout and
+ * precision), its shape and a checksum of its contents, followed by the 
+ * contents of the table, 64 byte aligned.  Files are native endian, and are
+ * only read by versions of the library of the byte order, the file format 
+ * and the version of the table contents of the writer.  The header records 
+ * the number of values of the table, of which the size of the contents 
+ * follows, so that files of another size are skipped when loaded, and the 
+ * tables of files that are not those of an evaluator (eg. of another number
+ * of values) are not used by it.
+ *
+ * Tables are loaded with mmap, read only and shared, so that loading takes
+ * microseconds, and that processes on a node that load the same files share
+ * their pages in the page cache.  Evaluators constructed after loading use 
+ * the loaded tables wherever their keys match, eg.
+ *
+ *    // once, to prepare the files:
+ *    VARRExpDEvaluator e = shifting_linear_sampling_expd(10000000u);
+ *    varr_save_tables("/scratch/varr");
+ *
+ *    // at the start of each job:
+ *    varr_load_tables("/scratch/varr", 0);
+ *    VARRExpDEvaluator e = shifting_linear_sampling_expd(10000000u);
+ */
+
+/*
+ * Writes every table of the table cache (ie. of every evaluator that exists,
+ * other than those constructed while the cache was disabled) to a table file
+ * in the existing 'directory', replacing any file of the same key.  Files are
+ * written under temporary names and renamed, so that concurrent readers see
+ * either the old or the new file.  Returns the number of files written, or 
+ * -1 if any could not be written.
+ */
+int
+varr_save_tables(char const * directory);
+
+/*
+ * Maps every table file (of suffix ".varrtable") in 'directory' into the 
+ * table cache, and returns the number of tables loaded, or -1 if the 
+ * directory cannot be read.  Files that are not valid table files (of the
+ * sizes their headers imply), or that are of keys that are cached already,
+ * are skipped.  If 'verify' is nonzero, the checksum of each file is
+ * verified, which reads the entire file; otherwise only the header is read
+ * at load time.
+ *
+ * The cache holds loaded tables until varr_unload_tables.
+ */
+int
+varr_load_tables(char const * directory, int verify);
+
+/*
+ * Releases the tables loaded by varr_load_tables.  Tables that are used by
+ * evaluators are unmapped when the last of these evaluators is disallocated.
+ * Returns the number of tables unmapped by this call.
+ */
+size_t
+varr_unload_tables(void);
+
+#endif /* __VARR_TABLE_FILE_H__ */
@@ -0,0 +1,207 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_TABLE_LAYOUT_H__
+#define __VARR_TABLE_LAYOUT_H__
+
+#include <stddef.h>
+
+#include "varr_3_over_4.h"
+#include "varr_atan.h"
+#include "varr_cos.h"
+#include "varr_exp.h"
+#include "varr_general_bound_linbuf.h"
+#include "varr_log.h"
+#include "varr_octant.h"
+#include "varr_phasor.h"
+#include "varr_sin.h"
+#include "varr_sincos.h"
+#include "varr_sixth_root.h"
+#include "varr_table_memory.h"
+
+/*
+ * The memory layouts of the sampling tables of VARR evaluators that 
+ * interpolate linearly between samples v[i] (eg. 
+ * shifting_linear_sampling_expd, clamping_linear_interpolating_atand or
+ * bound_general_linbuf).  The layout of a table is chosen when its evaluator
+ * is constructed, by the *_with_table_format constructors below, and it is
+ * fixed thereafter.  The plain constructors use VARR_TABLE_VALUES.
+ *
+ * With VARR_TABLE_VALUES, the value at a fraction a of the way from sample i
+ * to sample i + 1 is v[i] * (1 - a) + v[i + 1] * a, which reads two doubles 
+ * that may straddle a cache line (and takes two gathers per vector).
+ *
+ * With VARR_TABLE_INTERLEAVED, the table instead holds the pairs 
+ * (v[i], v[i + 1] - v[i]) contiguously, and the value is
+ * v[i] + a * (v[i + 1] - v[i]), ie. one 16 byte load and one fused 
+ * multiply-add.  The table takes (about) twice as much memory.  Results 
+ * agree with those of VARR_TABLE_VALUES to within rounding.
+ */
+typedef enum tagVARRTableLayout {
+   VARR_TABLE_VALUES = 0,                 // v[i]
+   VARR_TABLE_INTERLEAVED = 1             // (v[i], v[i + 1] - v[i])
+} VARRTableLayout;
+
+/*
+ * Returns a short human-readable name for 'layout', eg. "interleaved".
+ */
+char const *
+varr_table_layout_name(VARRTableLayout layout);
+
+/*
+ * The precision in which the same sampling tables are stored.  Evaluation is
+ * in double precision regardless.  The plain constructors use 
+ * VARR_TABLE_DOUBLE.
+ *
+ * With VARR_TABLE_FLOAT, samples are rounded to float, which halves the 
+ * memory (and cache) footprint of a table, at the cost of a relative error 
+ * of up to 2**-24 (6e-8) of the largest sample.  This is worthwhile where 
+ * the error of interpolation is larger anyway (eg. for tables of no more 
+ * than some thousands of samples), or where it is tolerable.
+ *
+ * With VARR_TABLE_FLOAT_CORRECTED, each float sample is accompanied by a 
+ * 16-bit correction (in units of a scale common to the table), which 
+ * recovers another 16 bits of precision, ie. a relative error of about
+ * 2**-40 (1e-12) of the largest sample, for three quarters of the footprint
+ * of a double table.  The corrections apply to the samples only, so that the
+ * differences of an interleaved table keep the error of float storage, about
+ * 2**-24 of the largest difference.
+ *
+ * Either float precision combines with either VARRTableLayout; samples 
+ * (eg. of bound_general_linbuf delegates) outside the range of float are
+ * not supported.
+ */
+typedef enum tagVARRTablePrecision {
+   VARR_TABLE_DOUBLE = 0,                 // double
+   VARR_TABLE_FLOAT = 1,                  // float
+   VARR_TABLE_FLOAT_CORRECTED = 2         // float and int16_t correction
+} VARRTablePrecision;
+
+/*
+ * Returns a short human-readable name for 'precision', eg. "float".
+ */
+char const *
+varr_table_precision_name(VARRTablePrecision precision);
+
+/*
+ * The layout, precision and pages (see varr_table_memory.h) of the table of
+ * an evaluator.  Values that are not of the enumerations are taken as 
+ * VARR_TABLE_VALUES, VARR_TABLE_DOUBLE and VARR_TABLE_PAGES_DEFAULT 
+ * respectively.
+ */
+typedef struct tagVARRTableFormat {
+   VARRTableLayout
+      layout;
+   VARRTablePrecision
+      precision;
+   VARRTablePages
+      pages;
+} VARRTableFormat;
+
+/*
+ * As the constructors of the same names (without the suffix), with the 
+ * table of the evaluator in 'format'.  These constructors are thread safe 
+ * as their counterparts are, and the format of one construction does not 
+ * affect any other.
+ */
+
+VARRExpDEvaluator
+shifting_linear_sampling_expd_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRLogDEvaluator
+normalizing_linear_sampling_logd_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRSinDEvaluator
+sampling_sind_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRCosDEvaluator
+sampling_cosd_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRSinCosDEvaluator
+sampling_sincosd_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRPhasorDEvaluator
+linear_interpolating_phasord_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRSinDEvaluator
+octant_sampling_sind_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRCosDEvaluator
+octant_sampling_cosd_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRPhasorDEvaluator
+octant_linear_interpolating_phasord_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRAtanDEvaluator
+clamping_linear_interpolating_atand_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRSixthRootDEvaluator
+linear_sampling_normalizing_sixth_rootd_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARR3Over4DEvaluator
+linear_sampling_normalizing_3over4d_with_table_format(
+   size_t number_of_samples,
+   VARRTableFormat format
+   );
+
+VARRBoundGLBAccelerator
+bound_general_linbuf_with_table_format(
+   size_t number_of_samples,
+   double min_x,
+   double max_x,
+   double (* delegate) (double, void *),
+   void * delegate_argument,
+   VARRTableFormat format
+   );
+
+#endif /* __VARR_TABLE_LAYOUT_H__ */
@@ -0,0 +1,92 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_TABLE_MEMORY_H__
+#define __VARR_TABLE_MEMORY_H__
+
+#include <stddef.h>
+
+/*
+ * The pages that back the sampling tables of VARR evaluators.  Every table
+ * is 64 byte (cache line) aligned.  Random lookups into tables of megabytes
+ * miss the TLB on most accesses with 4 KB pages, and huge (2 MB) pages, each
+ * of which covers 512 times as much memory per TLB entry, make most of those
+ * misses hits.
+ *
+ * The pages of a table are chosen when its evaluator is constructed, by the 
+ * 'pages' of the VARRTableFormat of a *_with_table_format constructor (see 
+ * varr_table_layout.h).  The plain constructors, and those of evaluators 
+ * without such a counterpart, use VARR_TABLE_PAGES_DEFAULT.
+ *
+ * With VARR_TABLE_PAGES_DEFAULT, tables are allocated on the heap.
+ *
+ * With VARR_TABLE_PAGES_TRANSPARENT, tables of at least 2 MB are mapped 
+ * 2 MB aligned, and advised as candidates for transparent huge pages 
+ * (madvise(MADV_HUGEPAGE)), which the kernel provides if it can (ie. if 
+ * /sys/kernel/mm/transparent_hugepage/enabled is "always" or "madvise", 
+ * and 2 MB of contiguous memory is available).
+ *
+ * With VARR_TABLE_PAGES_EXPLICIT, tables of at least 2 MB are mapped from the
+ * reserved huge pages of the system (mmap(MAP_HUGETLB), see
+ * /proc/sys/vm/nr_hugepages), or, where none are left, as for 
+ * VARR_TABLE_PAGES_TRANSPARENT.
+ *
+ * Whether huge pages were obtained is reported by 
+ * varr_table_memory_statistics.  Tables that exist, including those of the
+ * table cache that later evaluators share (see varr_table_cache.h), keep 
+ * their pages.  Tables loaded from table files (see varr_table_file.h) are 
+ * mapped from the files, and are not affected.
+ */
+typedef enum tagVARRTablePages {
+   VARR_TABLE_PAGES_DEFAULT = 0,          // malloc
+   VARR_TABLE_PAGES_TRANSPARENT = 1,      // madvise(MADV_HUGEPAGE)
+   VARR_TABLE_PAGES_EXPLICIT = 2          // mmap(MAP_HUGETLB)
+} VARRTablePages;
+
+/*
+ * Returns a short human-readable name for 'pages', eg. "transparent".
+ */
+char const *
+varr_table_pages_name(VARRTablePages pages);
+
+/*
+ * The tables allocated by VARR (other than those in the memory of a 
+ * VARRAllocator, see varr_allocator.h): their number and total size, the
+ * number for which huge pages were requested, and the number of their bytes
+ * that are backed by huge pages, either reserved ones, or transparent ones
+ * as reported by the kernel (in /proc/self/smaps).
+ */
+typedef struct tagVARRTableMemoryStatistics {
+   size_t
+      tables,
+      bytes,
+      huge_page_requests,
+      huge_page_bytes;
+} VARRTableMemoryStatistics;
+
+/*
+ * Returns the current state of the tables allocated by VARR.  This reads
+ * /proc/self/smaps if there are tables of transparent huge pages, and is 
+ * not meant to be called often.
+ */
+VARRTableMemoryStatistics
+varr_table_memory_statistics(void);
+
+#endif /* __VARR_TABLE_MEMORY_H__ */
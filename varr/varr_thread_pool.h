@@ -0,0 +1,173 @@
+/*
+ *  This file is part of varr-numerics, an experimental variable resolution
+ *  primitive numerics library.
+ *
+ *  Copyright (C) 2019 Cardiff University
+ *
+ *  varr-numerics is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  varr-numerics is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with varr-numerics.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __VARR_THREAD_POOL_H__
+#define __VARR_THREAD_POOL_H__
+
+#include <complex.h>
+#include <stddef.h>
+
+/*
+ * VARR samples the tables of its evaluators (see varr_table_cache.h) on a 
+ * pool of threads: the samples are split into blocks of some thousands, 
+ * which the calling thread and the threads of the pool evaluate 
+ * concurrently.  The pool is started on the first construction that needs 
+ * it, and its threads otherwise sleep.  Tables are the same (bit for bit) 
+ * for any number of threads.
+ *
+ * The delegates of bound_general_linbuf, which are the user's, are called 
+ * from the calling thread alone by default, and are sampled on the pool only
+ * where varr_set_linbuf_construction_threads selects more threads (when they
+ * must be thread safe).  A construction started while the pool is busy with
+ * another (eg. from another thread, or from a delegate) samples on its 
+ * calling thread alone.
+ */
+
+/*
+ * Returns the number of threads, including the calling thread, that sample
+ * the tables built from this point on.  The default is the number of 
+ * online processors.
+ */
+size_t
+varr_table_construction_threads(void);
+
+/*
+ * Selects the number of threads that sample the tables built after this 
+ * call (one for serial construction, or zero for the default), and returns
+ * the resulting value of varr_table_construction_threads().  The number is
+ * limited to 256.
+ */
+size_t
+varr_set_table_construction_threads(size_t threads);
+
+/*
+ * Returns the number of threads, including the calling thread, that call 
+ * the delegates of the bound_general_linbuf evaluators built from this point
+ * on (and of varr_prefetch_linbuf).  The default is one.
+ */
+size_t
+varr_linbuf_construction_threads(void);
+
+/*
+ * Selects the number of threads that call the delegates of linbufs built 
+ * after this call (one, or zero, for serial construction), and returns the 
+ * resulting value of varr_linbuf_construction_threads().  Delegates must be
+ * thread safe for more than one.  The number is limited to 256.
+ */
+size_t
+varr_set_linbuf_construction_threads(size_t threads);
+
+/*
+ * A pool of threads for the parallel evaluation of batches (below), which 
+ * is reused by each.  The inputs of a batch are split into chunks of 4096,
+ * which are split evenly between the threads of the pool and the calling 
+ * thread; each thread evaluates its own chunks in order, and once it has
+ * none left, steals the second half of those left to another, so that a
+ * thread that falls behind (eg. being preempted) is relieved by the others.
+ */
+typedef struct tagVARRThreadPool VARRThreadPool;
+
+/*
+ * Returns a pool of which 'threads' threads (zero for the number of online
+ * processors, and at most 257) evaluate each batch, including the calling 
+ * thread, ie. that starts threads - 1 threads, or NULL.  If 'pin' is 
+ * nonzero, thread i of the pool is bound to processor i + 1 (modulo the
+ * online processors), leaving processor 0 to the calling thread.  The pool 
+ * is released by varr_destroy_thread_pool.
+ */
+VARRThreadPool *
+varr_create_thread_pool(size_t threads, int pin);
+
+/*
+ * Stops the threads of 'pool', which must not be evaluating a batch, and 
+ * releases it, and returns 0, or 1 if 'pool' is NULL.
+ */
+int
+varr_destroy_thread_pool(VARRThreadPool * pool);
+
+/*
+ * Returns the number of threads that evaluate the batches of 'pool', 
+ * including the calling thread (one, if 'pool' is NULL).
+ */
+size_t
+varr_thread_pool_threads(VARRThreadPool const * pool);
+
+/*
+ * Evaluates the batch function 'batch' of an evaluator (eg. 
+ * VARRSinDEvaluator.sind_array, with its accelerator 'accelerator') for the
+ * 'length' inputs x into out, as batch(x, out, length, accelerator) would, 
+ * in parallel on the threads of 'pool' and the calling thread, and returns
+ * once all are evaluated.  While 'pool' is evaluating another batch (eg. for
+ * another thread, or from 'batch'), or if it is NULL, the batch is 
+ * evaluated by the calling thread alone.  x and out may be the same array 
+ * where they may be for 'batch'.  The outputs are stored by streaming 
+ * stores if they reach the size set by varr_set_streaming_batch_bytes (see
+ * varr_simd.h) for the calling thread.
+ */
+void
+varr_parallel_batchd(
+   VARRThreadPool * pool,
+   void (* batch) (double const *, double *, size_t, void const *),
+   double const * x,
+   double * out,
+   size_t length,
+   void const * accelerator
+   );
+
+/*
+ * As varr_parallel_batchd, for the batch functions of evaluators of floats:
+ */
+void
+varr_parallel_batchf(
+   VARRThreadPool * pool,
+   void (* batch) (float const *, float *, size_t, void const *),
+   float const * x,
+   float * out,
+   size_t length,
+   void const * accelerator
+   );
+
+/*
+ * As varr_parallel_batchd, for the batch functions of phasors:
+ */
+void
+varr_parallel_batch_phasord(
+   VARRThreadPool * pool,
+   void (* batch) (double const *, double complex *, size_t, void const *),
+   double const * x,
+   double complex * out,
+   size_t length,
+   void const * accelerator
+   );
+
+/*
+ * As varr_parallel_batchd, for the batch functions of phasors of floats:
+ */
+void
+varr_parallel_batch_phasorf(
+   VARRThreadPool * pool,
+   void (* batch) (float const *, float complex *, size_t, void const *),
+   float const * x,
+   float complex * out,
+   size_t length,
+   void const * accelerator
+   );
+
+#endif /* __VARR_THREAD_POOL_H__ */